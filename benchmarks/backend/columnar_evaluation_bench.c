@@ -0,0 +1,118 @@
+#include "backend/chunk.h"
+#include "backend/columnar.h"
+#include "backend/value.h"
+#include "backend/vm.h"
+#include "benchmark.h"
+#include "frontend/compiler.h"
+#include "utils/error.h"
+#include "utils/memory.h"
+
+#include <stdbool.h>
+#include <stdio.h>
+#include <stdlib.h>
+
+// *---------------------------------------------*
+// *              MACRO DEFINITIONS              *
+// *---------------------------------------------*
+
+#define ROW_COUNT (1024 * 1024)
+#define INPUT_COUNT 3
+#define EXPRESSION "(price * quantity - discount) / quantity > 10"
+
+// *---------------------------------------------*
+// *              TYPE DEFINITIONS               *
+// *---------------------------------------------*
+
+/// Columnar evaluation benchmark configuration.
+typedef struct {
+  char const *name;
+  bool is_columnar; // whether rows are evaluated by columnar_evaluate (rather than by executing chunk per row)
+} ColumnarEvaluationConfig;
+
+// *---------------------------------------------*
+// *          INTERNAL-LINKAGE OBJECTS           *
+// *---------------------------------------------*
+
+static char const *const input_names[INPUT_COUNT] = {"price", "quantity", "discount"};
+static double *input_columns[INPUT_COUNT];
+static Value *result_column;
+
+// *---------------------------------------------*
+// *         INTERNAL-LINKAGE FUNCTIONS          *
+// *---------------------------------------------*
+
+/// Evaluate EXPRESSION over ROW_COUNT rows according to `context` config.
+/// @return Number of evaluated rows.
+static double evaluate_rows(void *const context) {
+  ColumnarEvaluationConfig const *const config = context;
+
+  VMConfig const vm_config = {
+    .source_file_path = __FILE__,
+    .static_analysis_error_stream = stderr,
+    .bytecode_execution_error_stream = stderr,
+    .source_program_output_stream = stdout,
+    .memory_manager = memory_manage,
+    .input_names = input_names,
+    .input_count = INPUT_COUNT,
+  };
+  VM vm;
+  vm_init(&vm, &vm_config);
+  Chunk chunk;
+  chunk_init(&chunk);
+
+  if (compiler_compile_expression(&vm, EXPRESSION, &chunk) != COMPILER_SUCCESS) {
+    ERROR_INTERNAL("Failed to compile benchmarked expression");
+  }
+
+  if (config->is_columnar) {
+    ColumnarBatch const batch = {
+      .input_columns = (double const *const *)input_columns,
+      .row_count = ROW_COUNT,
+      .result_column = result_column,
+    };
+    if (columnar_evaluate(&vm, &chunk, &batch) != 0) ERROR_INTERNAL("Failed to evaluate benchmarked expression");
+  } else {
+    Value row_inputs[INPUT_COUNT];
+    vm.inputs = row_inputs;
+
+    for (size_t row = 0; row < ROW_COUNT; row++) {
+      for (int i = 0; i < INPUT_COUNT; i++) row_inputs[i] = value_make_number(input_columns[i][row]);
+      if (!vm_execute(&vm, &chunk)) ERROR_INTERNAL("Failed to execute benchmarked expression");
+      result_column[row] = vm_stack_pop(&vm);
+    }
+  }
+
+  chunk_destroy(&chunk);
+  vm_destroy(&vm);
+
+  return ROW_COUNT;
+}
+
+int main(void) {
+  for (int i = 0; i < INPUT_COUNT; i++) {
+    input_columns[i] = malloc(sizeof(double) * ROW_COUNT);
+    if (input_columns[i] == NULL) ERROR_MEMORY_ERRNO();
+  }
+  result_column = malloc(sizeof(Value) * ROW_COUNT);
+  if (result_column == NULL) ERROR_MEMORY_ERRNO();
+
+  for (size_t row = 0; row < ROW_COUNT; row++) {
+    input_columns[0][row] = row % 100 + 0.25; // price
+    input_columns[1][row] = row % 7 + 1;      // quantity
+    input_columns[2][row] = row % 13;         // discount
+  }
+
+  ColumnarEvaluationConfig configs[] = {
+    {.name = "evaluate expression (vm_execute per row)", .is_columnar = false},
+    {.name = "evaluate expression (columnar_evaluate)", .is_columnar = true},
+  };
+
+  for (size_t i = 0; i < sizeof(configs) / sizeof(configs[0]); i++) {
+    benchmark_run(configs[i].name, evaluate_rows, &configs[i], "rows");
+  }
+
+  for (int i = 0; i < INPUT_COUNT; i++) free(input_columns[i]);
+  free(result_column);
+
+  return EXIT_SUCCESS;
+}
@@ -0,0 +1,94 @@
+#include "backend/chunk.h"
+#include "backend/value.h"
+#include "backend/vm.h"
+#include "benchmark.h"
+#include "utils/error.h"
+#include "utils/memory.h"
+
+#include <stdio.h>
+#include <stdlib.h>
+
+// *---------------------------------------------*
+// *              MACRO DEFINITIONS              *
+// *---------------------------------------------*
+
+#define PRINTED_NUMBER_COUNT 0xFFFF // fits chunk constant pool
+#define CHUNK_EXECUTION_COUNT 16
+
+// *---------------------------------------------*
+// *              TYPE DEFINITIONS               *
+// *---------------------------------------------*
+
+/// Function generating `index`-th printed number.
+typedef double(NumberGeneratorFn)(int index);
+
+/// Number printing benchmark configuration.
+typedef struct {
+  char const *name;
+  NumberGeneratorFn *generate_number;
+} NumberPrintingConfig;
+
+// *---------------------------------------------*
+// *          INTERNAL-LINKAGE OBJECTS           *
+// *---------------------------------------------*
+
+static VMConfig vm_config;
+
+// *---------------------------------------------*
+// *         INTERNAL-LINKAGE FUNCTIONS          *
+// *---------------------------------------------*
+
+static double generate_integer(int const index) {
+  return index * 7919 - 100000;
+}
+
+static double generate_fraction(int const index) {
+  return (index + 1) / 7.0;
+}
+
+/// Repeatedly execute chunk printing PRINTED_NUMBER_COUNT numbers generated according to `context` config.
+/// @return Number of printed numbers.
+static double print_numbers(void *const context) {
+  NumberPrintingConfig const *const config = context;
+
+  VM vm;
+  vm_init(&vm, &vm_config);
+  Chunk chunk;
+  chunk_init(&chunk);
+
+  for (int i = 0; i < PRINTED_NUMBER_COUNT; i++) {
+    chunk_append_constant_instruction(&chunk, value_make_number(config->generate_number(i)), 1);
+    chunk_append_instruction(&chunk, CHUNK_OP_PRINT, 1);
+  }
+  chunk_append_instruction(&chunk, CHUNK_OP_RETURN, 1);
+
+  for (int i = 0; i < CHUNK_EXECUTION_COUNT; i++) {
+    if (!vm_execute(&vm, &chunk)) ERROR_INTERNAL("Failed to execute number printing chunk");
+  }
+
+  chunk_destroy(&chunk);
+  vm_destroy(&vm);
+
+  return PRINTED_NUMBER_COUNT * CHUNK_EXECUTION_COUNT;
+}
+
+int main(void) {
+  vm_config.source_file_path = __FILE__;
+  vm_config.bytecode_execution_error_stream = stderr;
+  vm_config.memory_manager = memory_manage;
+  vm_config.source_program_output_stream = fopen("/dev/null", "w");
+  if (vm_config.source_program_output_stream == NULL) ERROR_IO_ERRNO();
+
+  NumberPrintingConfig configs[] = {
+    {.name = "print integers", .generate_number = generate_integer},
+    {.name = "print fractions", .generate_number = generate_fraction},
+  };
+
+  for (size_t i = 0; i < sizeof(configs) / sizeof(configs[0]); i++) {
+    benchmark_run(configs[i].name, print_numbers, &configs[i], "numbers");
+  }
+
+  if (fclose(vm_config.source_program_output_stream)) ERROR_IO_ERRNO();
+
+  return EXIT_SUCCESS;
+}
@@ -0,0 +1,105 @@
+#include "backend/chunk.h"
+#include "backend/vm.h"
+#include "benchmark.h"
+#include "frontend/compiler.h"
+#include "utils/error.h"
+#include "utils/memory.h"
+#include "utils/memory_arena.h"
+
+#include <stdbool.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+// *---------------------------------------------*
+// *              MACRO DEFINITIONS              *
+// *---------------------------------------------*
+
+#define REQUEST_COUNT 5000
+#define REQUEST_STATEMENT_COUNT 200
+#define REQUEST_STATEMENT "\"a\" .. 1 .. \"b\" .. 2 .. \"c\" .. 3 .. \"d\" .. 4;\n" // allocates string objects
+
+#define OBJECT_ARENA_BLOCK_SIZE (64 * 1024)
+
+// *---------------------------------------------*
+// *              TYPE DEFINITIONS               *
+// *---------------------------------------------*
+
+/// Object allocation benchmark configuration.
+typedef struct {
+  char const *name;
+  bool is_arena_allocated; // whether VM objects are allocated from arena (reset per request)
+} ObjectAllocationConfig;
+
+// *---------------------------------------------*
+// *          INTERNAL-LINKAGE OBJECTS           *
+// *---------------------------------------------*
+
+static char *request_source_code;
+
+// *---------------------------------------------*
+// *         INTERNAL-LINKAGE FUNCTIONS          *
+// *---------------------------------------------*
+
+/// Serve REQUEST_COUNT requests (compiling and executing request source code) by single VM recycled between them,
+/// just like server workers do; VM objects are allocated according to `context` config.
+/// @return Number of served requests.
+static double serve_requests(void *const context) {
+  ObjectAllocationConfig const *const config = context;
+
+  MemoryArena object_arena;
+  memory_arena_init(&object_arena, OBJECT_ARENA_BLOCK_SIZE, memory_manage);
+  MemoryAllocator const object_allocator = memory_arena_make_allocator(&object_arena);
+
+  VMConfig const vm_config = {
+    .source_file_path = __FILE__,
+    .static_analysis_error_stream = stderr,
+    .bytecode_execution_error_stream = stderr,
+    .source_program_output_stream = stdout,
+    .memory_manager = memory_manage,
+    .object_allocator = config->is_arena_allocated ? &object_allocator : NULL,
+  };
+  VM vm;
+  vm_init(&vm, &vm_config);
+  Chunk chunk;
+  chunk_init(&chunk);
+
+  for (int i = 0; i < REQUEST_COUNT; i++) {
+    if (compiler_compile(&vm, request_source_code, &chunk) != COMPILER_SUCCESS) {
+      ERROR_INTERNAL("Failed to compile benchmarked source code");
+    }
+    if (!vm_execute(&vm, &chunk)) ERROR_INTERNAL("Failed to execute benchmarked source code");
+
+    chunk_reset(&chunk);
+    vm_recycle(&vm, &vm_config);
+  }
+
+  chunk_destroy(&chunk);
+  vm_destroy(&vm);
+  memory_arena_destroy(&object_arena);
+
+  return REQUEST_COUNT;
+}
+
+int main(void) {
+  size_t const statement_length = strlen(REQUEST_STATEMENT);
+  request_source_code = malloc(statement_length * REQUEST_STATEMENT_COUNT + 1);
+  if (request_source_code == NULL) ERROR_MEMORY_ERRNO();
+  for (int i = 0; i < REQUEST_STATEMENT_COUNT; i++) {
+    memcpy(request_source_code + statement_length * i, REQUEST_STATEMENT, statement_length);
+  }
+  request_source_code[statement_length * REQUEST_STATEMENT_COUNT] = '\0';
+
+  ObjectAllocationConfig configs[] = {
+    {.name = "serve requests (objects managed individually)", .is_arena_allocated = false},
+    {.name = "serve requests (objects allocated from arena)", .is_arena_allocated = true},
+  };
+
+  for (size_t i = 0; i < sizeof(configs) / sizeof(configs[0]); i++) {
+    benchmark_run(configs[i].name, serve_requests, &configs[i], "requests");
+  }
+
+  free(request_source_code);
+
+  return EXIT_SUCCESS;
+}
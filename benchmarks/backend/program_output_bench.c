@@ -0,0 +1,116 @@
+#define _POSIX_C_SOURCE 200809L
+
+#include "backend/chunk.h"
+#include "backend/object.h"
+#include "backend/value.h"
+#include "backend/vm.h"
+#include "benchmark.h"
+#include "utils/error.h"
+#include "utils/memory.h"
+
+#include <stdbool.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+// *---------------------------------------------*
+// *              MACRO DEFINITIONS              *
+// *---------------------------------------------*
+
+#define MAX_PRINTS_PER_CHUNK_EXECUTION 1000000
+
+/// Shell command draining pipe that source program output is written into.
+#define PIPE_DRAINING_COMMAND "cat > /dev/null"
+
+// *---------------------------------------------*
+// *              TYPE DEFINITIONS               *
+// *---------------------------------------------*
+
+/// Program output benchmark configuration.
+typedef struct {
+  char const *name;
+  int printed_string_length; // 0 denotes printing numbers instead
+  int print_count;
+  bool is_async;
+} ProgramOutputConfig;
+
+// *---------------------------------------------*
+// *         INTERNAL-LINKAGE FUNCTIONS          *
+// *---------------------------------------------*
+
+/// Make value (belonging to `vm`) printed according to `config`.
+static Value make_printed_value(VM *const vm, ProgramOutputConfig const *const config) {
+  if (config->printed_string_length == 0) return value_make_number(1234.5);
+
+  char *const content = malloc(config->printed_string_length);
+  if (content == NULL) ERROR_MEMORY_ERRNO();
+  memset(content, 'x', config->printed_string_length);
+
+  ObjectString *const string = object_make_owning_string(vm, content, config->printed_string_length);
+  free(content);
+
+  return value_make_object((Object *)string);
+}
+
+/// Print values (made according to `context` config) into a pipe, by repeatedly executing chunk printing up to
+/// MAX_PRINTS_PER_CHUNK_EXECUTION of them.
+/// @return Number of printed values.
+static double print_values(void *const context) {
+  ProgramOutputConfig const *const config = context;
+  int const prints_per_chunk_execution =
+    config->print_count < MAX_PRINTS_PER_CHUNK_EXECUTION ? config->print_count : MAX_PRINTS_PER_CHUNK_EXECUTION;
+
+  VMConfig const vm_config = {
+    .source_file_path = __FILE__,
+    .bytecode_execution_error_stream = stderr,
+    .source_program_output_stream = popen(PIPE_DRAINING_COMMAND, "w"),
+    .is_source_program_output_async = config->is_async,
+    .memory_manager = memory_manage,
+  };
+  if (vm_config.source_program_output_stream == NULL) ERROR_SYSTEM_ERRNO();
+
+  VM vm;
+  vm_init(&vm, &vm_config);
+  Chunk chunk;
+  chunk_init(&chunk);
+
+  // every print reuses the same constant
+  chunk_append_constant_instruction(&chunk, make_printed_value(&vm, config), 1);
+  chunk_append_instruction(&chunk, CHUNK_OP_PRINT, 1);
+  for (int i = 1; i < prints_per_chunk_execution; i++) {
+    chunk_append_instruction(&chunk, CHUNK_OP_CONSTANT, 1);
+    chunk_append_operand(&chunk, 0);
+    chunk_append_instruction(&chunk, CHUNK_OP_PRINT, 1);
+  }
+  chunk_append_instruction(&chunk, CHUNK_OP_RETURN, 1);
+
+  for (int i = 0; i < config->print_count / prints_per_chunk_execution; i++) {
+    if (!vm_execute(&vm, &chunk)) ERROR_INTERNAL("Failed to execute value printing chunk");
+  }
+
+  chunk_destroy(&chunk);
+  vm_destroy(&vm);
+
+  if (pclose(vm_config.source_program_output_stream) != 0) ERROR_SYSTEM("Failed to drain source program output pipe");
+
+  return config->print_count;
+}
+
+int main(void) {
+  ProgramOutputConfig configs[] = {
+    {.name = "print 10M numbers", .printed_string_length = 0, .print_count = 10000000},
+    {.name = "print 10M 16-byte strings", .printed_string_length = 16, .print_count = 10000000},
+    {.name = "print 100K 4KiB strings", .printed_string_length = 4 * 1024, .print_count = 100000},
+    {.name = "print 10K 64KiB strings", .printed_string_length = 64 * 1024, .print_count = 10000},
+    {.name = "print 10M numbers (async)", .printed_string_length = 0, .print_count = 10000000, .is_async = true},
+    {
+      .name = "print 10K 64KiB strings (async)", .printed_string_length = 64 * 1024, .print_count = 10000, .is_async = true
+    },
+  };
+
+  for (size_t i = 0; i < sizeof(configs) / sizeof(configs[0]); i++) {
+    benchmark_run(configs[i].name, print_values, &configs[i], "values");
+  }
+
+  return EXIT_SUCCESS;
+}
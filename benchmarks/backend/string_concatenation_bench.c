@@ -0,0 +1,105 @@
+#include "backend/chunk.h"
+#include "backend/object.h"
+#include "backend/value.h"
+#include "backend/vm.h"
+#include "benchmark.h"
+#include "utils/error.h"
+#include "utils/memory.h"
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+// *---------------------------------------------*
+// *              MACRO DEFINITIONS              *
+// *---------------------------------------------*
+
+#define LARGE_STRING_LENGTH (10 * 1024 * 1024)
+
+// *---------------------------------------------*
+// *              TYPE DEFINITIONS               *
+// *---------------------------------------------*
+
+/// Incremental string building benchmark configuration.
+typedef struct {
+  int piece_length;
+  int piece_count;
+  bool is_prepending; // prepending corresponds to right-associative '..' chains
+} StringBuildingConfig;
+
+// *---------------------------------------------*
+// *          INTERNAL-LINKAGE OBJECTS           *
+// *---------------------------------------------*
+
+static VMConfig vm_config;
+
+// *---------------------------------------------*
+// *         INTERNAL-LINKAGE FUNCTIONS          *
+// *---------------------------------------------*
+
+/// Build string out of `config` pieces through repeated CHUNK_OP_CONCATENATE execution and flatten it.
+/// @return Number of built string megabytes.
+static double build_string(void *const context) {
+  StringBuildingConfig const *const config = context;
+
+  VM vm;
+  vm_init(&vm, &vm_config);
+  Chunk chunk;
+  chunk_init(&chunk);
+
+  char *const piece_content = malloc(config->piece_length);
+  if (piece_content == NULL) ERROR_MEMORY_ERRNO();
+  memset(piece_content, 'x', config->piece_length);
+  Value const piece = value_make_object((Object *)object_make_owning_string(&vm, piece_content, config->piece_length));
+  free(piece_content);
+
+  if (config->is_prepending) {
+    for (int i = 0; i < config->piece_count; i++) chunk_append_constant_instruction(&chunk, piece, 1);
+    for (int i = 1; i < config->piece_count; i++) chunk_append_instruction(&chunk, CHUNK_OP_CONCATENATE, 1);
+  } else {
+    chunk_append_constant_instruction(&chunk, piece, 1);
+    for (int i = 1; i < config->piece_count; i++) {
+      chunk_append_constant_instruction(&chunk, piece, 1);
+      chunk_append_instruction(&chunk, CHUNK_OP_CONCATENATE, 1);
+    }
+  }
+  chunk_append_instruction(&chunk, CHUNK_OP_RETURN, 1);
+
+  if (!vm_execute(&vm, &chunk)) ERROR_INTERNAL("Failed to execute string building chunk");
+  ObjectString const *const string = value_to_string_object(&vm, vm_stack_pop(&vm));
+  int const string_length = string->length;
+
+  chunk_destroy(&chunk);
+  vm_destroy(&vm);
+
+  return string_length / BENCHMARK_BYTES_PER_MEGABYTE;
+}
+
+int main(void) {
+  vm_config.source_file_path = __FILE__;
+  vm_config.bytecode_execution_error_stream = stderr;
+  vm_config.source_program_output_stream = stdout;
+  vm_config.memory_manager = memory_manage;
+
+  StringBuildingConfig configs[] = {
+    {.piece_length = 1024, .piece_count = LARGE_STRING_LENGTH / 1024, .is_prepending = false},
+    {.piece_length = 1024, .piece_count = LARGE_STRING_LENGTH / 1024, .is_prepending = true},
+    {.piece_length = 16, .piece_count = 0xFFFF, .is_prepending = false},
+    {.piece_length = 16, .piece_count = 0xFFFF, .is_prepending = true},
+  };
+
+  for (size_t i = 0; i < sizeof(configs) / sizeof(configs[0]); i++) {
+    StringBuildingConfig *const config = &configs[i];
+
+    char benchmark_name[64];
+    if (snprintf(
+          benchmark_name, sizeof(benchmark_name), "%s %d %d-byte pieces", config->is_prepending ? "prepend" : "append",
+          config->piece_count, config->piece_length
+        ) < 0)
+      ERROR_IO_ERRNO();
+
+    benchmark_run(benchmark_name, build_string, config, "MB");
+  }
+
+  return EXIT_SUCCESS;
+}
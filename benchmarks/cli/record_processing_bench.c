@@ -0,0 +1,129 @@
+#define _POSIX_C_SOURCE 200809L
+
+#include "benchmark.h"
+#include "common.h"
+#include "utils/error.h"
+
+#include <fcntl.h>
+#include <spawn.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <sys/wait.h>
+#include <unistd.h>
+
+// *---------------------------------------------*
+// *              MACRO DEFINITIONS              *
+// *---------------------------------------------*
+
+#define RECORD_COUNT 200000
+
+// records processed by spawning interpreter per record (fork/exec is orders of magnitude slower)
+#define SPAWNED_RECORD_COUNT 200
+
+/// Interpreter executable spawned by benchmarks (benchmarks are run from repository root).
+#define INTERPRETER_PATH "bin/release/cla"
+
+// *---------------------------------------------*
+// *              TYPE DEFINITIONS               *
+// *---------------------------------------------*
+
+/// Record processing benchmark configuration.
+typedef struct {
+  char const *name;
+  char const *job_count; // NULL denotes spawning interpreter per record (each record embedded into its source file)
+} RecordProcessingConfig;
+
+// *---------------------------------------------*
+// *          INTERNAL-LINKAGE OBJECTS           *
+// *---------------------------------------------*
+
+extern char **environ;
+
+static char records_path[64];
+static char script_path[64];
+static char record_script_path[64];
+
+// *---------------------------------------------*
+// *         INTERNAL-LINKAGE FUNCTIONS          *
+// *---------------------------------------------*
+
+/// Spawn process executing `argv` with stdout redirected to /dev/null, and wait for it to exit.
+/// @return Process exit status.
+static int spawn_and_wait(char const *const *const argv) {
+  posix_spawn_file_actions_t file_actions;
+  posix_spawn_file_actions_init(&file_actions);
+  posix_spawn_file_actions_addopen(&file_actions, STDOUT_FILENO, "/dev/null", O_WRONLY, 0);
+
+  pid_t pid;
+  int const error_number = posix_spawn(&pid, argv[0], &file_actions, NULL, (char *const *)argv, environ);
+  if (error_number != 0) ERROR_SYSTEM("Failed to spawn '%s'" COMMON_MS "%s\n", argv[0], strerror(error_number));
+  posix_spawn_file_actions_destroy(&file_actions);
+
+  int status;
+  if (waitpid(pid, &status, 0) < 0) ERROR_SYSTEM_ERRNO();
+
+  return status;
+}
+
+/// Write `content` into file at `path`.
+static void write_file(char const *const path, char const *const content) {
+  FILE *const file = fopen(path, "w");
+  if (file == NULL) ERROR_IO_ERRNO();
+  fputs(content, file);
+  if (fclose(file) == EOF) ERROR_IO_ERRNO();
+}
+
+/// Process records according to `context` config.
+/// @return Number of processed records.
+static double process_records(void *const context) {
+  RecordProcessingConfig const *const config = context;
+
+  if (config->job_count == NULL) {
+    char const *const argv[] = {INTERPRETER_PATH, record_script_path, NULL};
+    for (int i = 0; i < SPAWNED_RECORD_COUNT; i++) {
+      if (spawn_and_wait(argv) != 0) ERROR_INTERNAL("Failed to process record");
+    }
+    return SPAWNED_RECORD_COUNT;
+  }
+
+  char const *const argv[] = {INTERPRETER_PATH, "--each", records_path, "--jobs", config->job_count, script_path, NULL};
+  if (spawn_and_wait(argv) != 0) ERROR_INTERNAL("Failed to process records");
+
+  return RECORD_COUNT;
+}
+
+int main(void) {
+  snprintf(records_path, sizeof(records_path), "/tmp/cla-record-processing-bench-%ld.csv", (long)getpid());
+  snprintf(script_path, sizeof(script_path), "/tmp/cla-record-processing-bench-%ld.cla", (long)getpid());
+  snprintf(
+    record_script_path, sizeof(record_script_path), "/tmp/cla-record-processing-bench-%ld-1.cla", (long)getpid()
+  );
+
+  FILE *const records_file = fopen(records_path, "w");
+  if (records_file == NULL) ERROR_IO_ERRNO();
+  fputs("id,price,quantity,label\n", records_file);
+  for (int i = 0; i < RECORD_COUNT; i++) {
+    fprintf(records_file, "%d,%d.25,%d,\"item, %d\"\n", i, i % 100, i % 7 + 1, i);
+  }
+  if (fclose(records_file) == EOF) ERROR_IO_ERRNO();
+
+  write_file(script_path, "print label .. \": \" .. price * quantity;\n");
+  write_file(record_script_path, "print \"item, 1\" .. \": \" .. 1.25 * 2;\n");
+
+  RecordProcessingConfig configs[] = {
+    {.name = "fork/exec per record", .job_count = NULL},
+    {.name = "--each single job", .job_count = "1"},
+    {.name = "--each 4 jobs", .job_count = "4"},
+  };
+
+  for (size_t i = 0; i < sizeof(configs) / sizeof(configs[0]); i++) {
+    benchmark_run(configs[i].name, process_records, &configs[i], "records");
+  }
+
+  if (remove(records_path)) ERROR_IO_ERRNO();
+  if (remove(script_path)) ERROR_IO_ERRNO();
+  if (remove(record_script_path)) ERROR_IO_ERRNO();
+
+  return EXIT_SUCCESS;
+}
@@ -0,0 +1,146 @@
+#define _POSIX_C_SOURCE 200809L
+
+#include "benchmark.h"
+#include "cli/server.h"
+#include "common.h"
+#include "utils/error.h"
+
+#include <errno.h>
+#include <fcntl.h>
+#include <signal.h>
+#include <spawn.h>
+#include <stdbool.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <sys/socket.h>
+#include <sys/un.h>
+#include <sys/wait.h>
+#include <time.h>
+#include <unistd.h>
+
+// *---------------------------------------------*
+// *              MACRO DEFINITIONS              *
+// *---------------------------------------------*
+
+#define REQUEST_COUNT 200
+
+/// Interpreter executable spawned by benchmarks (benchmarks are run from repository root).
+#define INTERPRETER_PATH "bin/release/cla"
+
+#define SERVER_STARTUP_POLL_INTERVAL_NS 10000000
+#define SERVER_STARTUP_POLL_LIMIT 500
+
+// *---------------------------------------------*
+// *              TYPE DEFINITIONS               *
+// *---------------------------------------------*
+
+/// Request latency benchmark configuration.
+typedef struct {
+  char const *name;
+  char const *const *spawned_argv; // NULL terminated; NULL denotes issuing requests from benchmark process itself
+} RequestLatencyConfig;
+
+// *---------------------------------------------*
+// *          INTERNAL-LINKAGE OBJECTS           *
+// *---------------------------------------------*
+
+extern char **environ;
+
+static char source_file_path[64];
+static char socket_path[64];
+
+// *---------------------------------------------*
+// *         INTERNAL-LINKAGE FUNCTIONS          *
+// *---------------------------------------------*
+
+/// Spawn process executing `argv` and wait for it to exit.
+/// @return Process exit status.
+static int spawn_and_wait(char const *const *const argv) {
+  pid_t pid;
+  int const error_number = posix_spawn(&pid, argv[0], NULL, NULL, (char *const *)argv, environ);
+  if (error_number != 0) ERROR_SYSTEM("Failed to spawn '%s'" COMMON_MS "%s\n", argv[0], strerror(error_number));
+
+  int status;
+  if (waitpid(pid, &status, 0) < 0) ERROR_SYSTEM_ERRNO();
+
+  return status;
+}
+
+/// Spawn interpreter server listening on `socket_path`, and wait until it accepts connections.
+/// @return Server process ID.
+static pid_t spawn_server(void) {
+  char const *const argv[] = {INTERPRETER_PATH, "--serve", "--socket", socket_path, "--jobs", "1", NULL};
+
+  // silence server startup report
+  posix_spawn_file_actions_t file_actions;
+  posix_spawn_file_actions_init(&file_actions);
+  posix_spawn_file_actions_addopen(&file_actions, STDERR_FILENO, "/dev/null", O_WRONLY, 0);
+
+  pid_t pid;
+  int const error_number = posix_spawn(&pid, argv[0], &file_actions, NULL, (char *const *)argv, environ);
+  if (error_number != 0) ERROR_SYSTEM("Failed to spawn '%s'" COMMON_MS "%s\n", argv[0], strerror(error_number));
+  posix_spawn_file_actions_destroy(&file_actions);
+
+  struct sockaddr_un address = {.sun_family = AF_UNIX};
+  strcpy(address.sun_path, socket_path);
+  for (int i = 0;; i++) {
+    int const probing_socket = socket(AF_UNIX, SOCK_STREAM, 0);
+    if (probing_socket < 0) ERROR_SYSTEM_ERRNO();
+    bool const is_listening = connect(probing_socket, (struct sockaddr const *)&address, sizeof(address)) == 0;
+    close(probing_socket);
+
+    if (is_listening) break;
+    if (i == SERVER_STARTUP_POLL_LIMIT) ERROR_SYSTEM("Server failed to start listening on '%s'", socket_path);
+    nanosleep(&(struct timespec){.tv_nsec = SERVER_STARTUP_POLL_INTERVAL_NS}, NULL);
+  }
+
+  return pid;
+}
+
+/// Issue REQUEST_COUNT requests interpreting the same source file, according to `context` config.
+/// @return Number of issued requests.
+static double issue_requests(void *const context) {
+  RequestLatencyConfig const *const config = context;
+
+  for (int i = 0; i < REQUEST_COUNT; i++) {
+    if (config->spawned_argv == NULL) {
+      if (server_interpret_remotely(socket_path, source_file_path) != ERROR_CODE_SUCCESS) {
+        ERROR_INTERNAL("Failed to interpret source file remotely");
+      }
+    } else if (spawn_and_wait(config->spawned_argv) != 0) ERROR_INTERNAL("Failed to interpret source file");
+  }
+
+  return REQUEST_COUNT;
+}
+
+int main(void) {
+  snprintf(source_file_path, sizeof(source_file_path), "/tmp/cla-request-latency-bench-%ld.cla", (long)getpid());
+  snprintf(socket_path, sizeof(socket_path), "/tmp/cla-request-latency-bench-%ld.sock", (long)getpid());
+
+  // one-line script producing no output
+  FILE *const source_file = fopen(source_file_path, "w");
+  if (source_file == NULL) ERROR_IO_ERRNO();
+  fputs("1 + 2 .. \"abc\";\n", source_file);
+  if (fclose(source_file) == EOF) ERROR_IO_ERRNO();
+
+  pid_t const server_pid = spawn_server();
+
+  char const *const regular_run_argv[] = {INTERPRETER_PATH, source_file_path, NULL};
+  char const *const client_run_argv[] = {INTERPRETER_PATH, "--client", "--socket", socket_path, source_file_path, NULL};
+  RequestLatencyConfig configs[] = {
+    {.name = "fork/exec regular runs", .spawned_argv = regular_run_argv},
+    {.name = "fork/exec client runs", .spawned_argv = client_run_argv},
+    {.name = "in-process server requests", .spawned_argv = NULL},
+  };
+
+  for (size_t i = 0; i < sizeof(configs) / sizeof(configs[0]); i++) {
+    benchmark_run(configs[i].name, issue_requests, &configs[i], "requests");
+  }
+
+  if (kill(server_pid, SIGTERM) < 0) ERROR_SYSTEM_ERRNO();
+  if (waitpid(server_pid, NULL, 0) < 0) ERROR_SYSTEM_ERRNO();
+  if (remove(source_file_path)) ERROR_IO_ERRNO();
+
+  return EXIT_SUCCESS;
+}
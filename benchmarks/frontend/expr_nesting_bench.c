@@ -0,0 +1,105 @@
+#include "backend/chunk.h"
+#include "backend/vm.h"
+#include "benchmark.h"
+#include "frontend/compiler.h"
+#include "utils/error.h"
+#include "utils/memory.h"
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+// *---------------------------------------------*
+// *              MACRO DEFINITIONS              *
+// *---------------------------------------------*
+
+#define NESTING_DEPTH 1000000
+
+// *---------------------------------------------*
+// *              TYPE DEFINITIONS               *
+// *---------------------------------------------*
+
+/// Expression nesting benchmark configuration.
+typedef struct {
+  char const *name;
+  char const *nesting_prefix, *nesting_suffix; // surround innermost 'nil' operand NESTING_DEPTH times
+  char *source_code;
+} ExprNestingConfig;
+
+// *---------------------------------------------*
+// *          INTERNAL-LINKAGE OBJECTS           *
+// *---------------------------------------------*
+
+static VM vm;
+
+// *---------------------------------------------*
+// *         INTERNAL-LINKAGE FUNCTIONS          *
+// *---------------------------------------------*
+
+/// Make expression statement source code nesting `config` prefix and suffix NESTING_DEPTH levels deep.
+/// @return Heap-allocated source code.
+static char *make_source_code(ExprNestingConfig const *const config) {
+  size_t const prefix_length = strlen(config->nesting_prefix);
+  size_t const suffix_length = strlen(config->nesting_suffix);
+
+  char *const source_code = malloc(NESTING_DEPTH * (prefix_length + suffix_length) + sizeof("nil;"));
+  if (source_code == NULL) ERROR_MEMORY_ERRNO();
+
+  size_t source_code_length = 0;
+  for (int i = 0; i < NESTING_DEPTH; i++) {
+    memcpy(source_code + source_code_length, config->nesting_prefix, prefix_length);
+    source_code_length += prefix_length;
+  }
+  memcpy(source_code + source_code_length, "nil", 3);
+  source_code_length += 3;
+  for (int i = 0; i < NESTING_DEPTH; i++) {
+    memcpy(source_code + source_code_length, config->nesting_suffix, suffix_length);
+    source_code_length += suffix_length;
+  }
+  memcpy(source_code + source_code_length, ";", 2);
+
+  return source_code;
+}
+
+/// Compile deeply nested expression held by `context` config.
+/// @return Number of compiled nesting levels.
+static double compile_nested_expr(void *const context) {
+  ExprNestingConfig const *const config = context;
+
+  Chunk chunk;
+  chunk_init(&chunk);
+
+  if (compiler_compile(&vm, config->source_code, &chunk) != COMPILER_SUCCESS)
+    ERROR_INTERNAL("Failed to compile nested expression");
+
+  chunk_destroy(&chunk);
+
+  return NESTING_DEPTH;
+}
+
+int main(void) {
+  VMConfig const vm_config = {
+    .source_file_path = __FILE__,
+    .static_analysis_error_stream = stderr,
+    .source_program_output_stream = stdout,
+    .memory_manager = memory_manage,
+  };
+  vm_init(&vm, &vm_config);
+
+  ExprNestingConfig configs[] = {
+    {.name = "compile 1M nested groupings", .nesting_prefix = "(", .nesting_suffix = ")"},
+    {.name = "compile 1M nested unary operators", .nesting_prefix = "!", .nesting_suffix = ""},
+    {.name = "compile 1M nested binary operators", .nesting_prefix = "true == (", .nesting_suffix = ")"},
+    {.name = "compile 1M nested concatenations", .nesting_prefix = "nil .. (", .nesting_suffix = ")"},
+  };
+
+  for (size_t i = 0; i < sizeof(configs) / sizeof(configs[0]); i++) {
+    configs[i].source_code = make_source_code(&configs[i]);
+    benchmark_run(configs[i].name, compile_nested_expr, &configs[i], "levels");
+    free(configs[i].source_code);
+  }
+
+  vm_destroy(&vm);
+
+  return EXIT_SUCCESS;
+}
@@ -0,0 +1,107 @@
+#include "benchmark.h"
+#include "frontend/lexer.h"
+#include "utils/error.h"
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+// *---------------------------------------------*
+// *              MACRO DEFINITIONS              *
+// *---------------------------------------------*
+
+#define IDENTIFIER_COUNT 2000000
+#define IDENTIFIER_MAX_LENGTH 16
+
+// fixed seed keeps generated source code identical between runs
+#define WORD_SELECTION_SEED 42
+
+// *---------------------------------------------*
+// *              TYPE DEFINITIONS               *
+// *---------------------------------------------*
+
+/// Keyword recognition benchmark configuration.
+typedef struct {
+  char const *name;
+  char const *const *words; // NULL terminated; randomly drawn until IDENTIFIER_COUNT of them are generated
+  char *source_code;
+} KeywordRecognitionConfig;
+
+// *---------------------------------------------*
+// *          INTERNAL-LINKAGE OBJECTS           *
+// *---------------------------------------------*
+
+static char const *const keywords[] = {
+  "true", "false", "var", "nil", "and", "or", "fun", "return", "if", "else", "while", "for", "class", "super", "this",
+  "print", NULL,
+};
+
+// identifiers sharing keyword prefixes, lengths, or first and last characters
+static char const *const keyword_like_identifiers[] = {
+  "thus", "trie", "fare", "vat", "nail", "aid", "our", "fin", "result", "it", "ease", "form", "while_", "clues",
+  "supper", "thin", "paint", "printer", "fun_", "t", NULL,
+};
+
+static char const *const mixed_words[] = {
+  "var", "count", "fun", "fetch", "return", "value", "if", "index", "else", "total", "while", "item", "for", "this",
+  "super", "true", "thus", "nail", "print", "result", NULL,
+};
+
+// *---------------------------------------------*
+// *         INTERNAL-LINKAGE FUNCTIONS          *
+// *---------------------------------------------*
+
+/// Make source code consisting of IDENTIFIER_COUNT words randomly drawn from `config` words.
+/// @return Heap-allocated source code.
+static char *make_source_code(KeywordRecognitionConfig const *const config) {
+  char *const source_code = malloc(IDENTIFIER_COUNT * (IDENTIFIER_MAX_LENGTH + 1) + 1);
+  if (source_code == NULL) ERROR_MEMORY_ERRNO();
+
+  size_t word_count = 0;
+  while (config->words[word_count] != NULL) word_count++;
+
+  srand(WORD_SELECTION_SEED);
+  size_t source_code_length = 0;
+  for (int i = 0; i < IDENTIFIER_COUNT; i++) {
+    char const *const word = config->words[rand() % word_count];
+    size_t const word_length = strlen(word);
+    memcpy(source_code + source_code_length, word, word_length);
+    source_code_length += word_length;
+    source_code[source_code_length++] = ' ';
+  }
+  source_code[source_code_length] = '\0';
+
+  return source_code;
+}
+
+/// Scan identifier-dense source code held by `context` config.
+/// @return Number of scanned identifiers (both regular and reserved).
+static double scan_identifiers(void *const context) {
+  KeywordRecognitionConfig const *const config = context;
+
+  lexer_init(config->source_code);
+
+  for (;;) {
+    LexerToken const token = lexer_scan();
+    if (token.type == LEXER_TOKEN_EOF) break;
+    if (token.type == LEXER_TOKEN_ERROR) ERROR_INTERNAL("Failed to scan identifiers");
+  }
+
+  return IDENTIFIER_COUNT;
+}
+
+int main(void) {
+  KeywordRecognitionConfig configs[] = {
+    {.name = "scan keywords", .words = keywords},
+    {.name = "scan keyword-like identifiers", .words = keyword_like_identifiers},
+    {.name = "scan keywords mixed with identifiers", .words = mixed_words},
+  };
+
+  for (size_t i = 0; i < sizeof(configs) / sizeof(configs[0]); i++) {
+    configs[i].source_code = make_source_code(&configs[i]);
+    benchmark_run(configs[i].name, scan_identifiers, &configs[i], "identifiers");
+    free(configs[i].source_code);
+  }
+
+  return EXIT_SUCCESS;
+}
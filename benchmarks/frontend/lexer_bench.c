@@ -0,0 +1,91 @@
+#include "benchmark.h"
+#include "frontend/lexer.h"
+#include "utils/error.h"
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+// *---------------------------------------------*
+// *              MACRO DEFINITIONS              *
+// *---------------------------------------------*
+
+#define SOURCE_CODE_LENGTH (16 * 1024 * 1024)
+
+// *---------------------------------------------*
+// *              TYPE DEFINITIONS               *
+// *---------------------------------------------*
+
+/// Lexer throughput benchmark configuration.
+typedef struct {
+  char const *name;
+  char const *source_code_line; // repeated until source code reaches SOURCE_CODE_LENGTH
+  char *source_code;
+} LexerThroughputConfig;
+
+// *---------------------------------------------*
+// *         INTERNAL-LINKAGE FUNCTIONS          *
+// *---------------------------------------------*
+
+/// Make source code by repeating `config` line.
+/// @return Heap-allocated source code.
+static char *make_source_code(LexerThroughputConfig const *const config) {
+  char *const source_code = malloc(SOURCE_CODE_LENGTH + 1);
+  if (source_code == NULL) ERROR_MEMORY_ERRNO();
+
+  size_t const line_length = strlen(config->source_code_line);
+  size_t source_code_length = 0;
+  while (source_code_length + line_length <= SOURCE_CODE_LENGTH) {
+    memcpy(source_code + source_code_length, config->source_code_line, line_length);
+    source_code_length += line_length;
+  }
+  source_code[source_code_length] = '\0';
+
+  return source_code;
+}
+
+/// Scan source code held by `context` config until EOF token is reached.
+/// @return Number of scanned source code megabytes.
+static double scan_source_code(void *const context) {
+  LexerThroughputConfig const *const config = context;
+
+  lexer_init(config->source_code);
+
+  for (;;) {
+    LexerToken const token = lexer_scan();
+    if (token.type == LEXER_TOKEN_EOF) break;
+    if (token.type == LEXER_TOKEN_ERROR) ERROR_INTERNAL("Failed to scan source code");
+  }
+
+  return strlen(config->source_code) / BENCHMARK_BYTES_PER_MEGABYTE;
+}
+
+int main(void) {
+  LexerThroughputConfig configs[] = {
+    {
+      .name = "scan code",
+      .source_code_line = "print (1.5 + 22) * 3 .. \"abc\" .. nil == false; # trailing comment\n",
+    },
+    {
+      .name = "scan indented code",
+      .source_code_line = "\n                                \t\t\tprint 1 +\n                                        2;\n",
+    },
+    {
+      .name = "scan comments",
+      .source_code_line = "# a comment line spanning quite a few characters, describing something in detail\n",
+    },
+    {
+      .name = "scan string literals",
+      .source_code_line =
+        "\"a string literal spanning quite a few characters,\nincluding a newline, as well as something else\";\n",
+    },
+  };
+
+  for (size_t i = 0; i < sizeof(configs) / sizeof(configs[0]); i++) {
+    configs[i].source_code = make_source_code(&configs[i]);
+    benchmark_run(configs[i].name, scan_source_code, &configs[i], "MB");
+    free(configs[i].source_code);
+  }
+
+  return EXIT_SUCCESS;
+}
@@ -0,0 +1,119 @@
+#include "backend/chunk.h"
+#include "backend/vm.h"
+#include "benchmark.h"
+#include "frontend/compiler.h"
+#include "utils/error.h"
+#include "utils/memory.h"
+
+#include <stdbool.h>
+#include <stdio.h>
+#include <stdlib.h>
+
+// *---------------------------------------------*
+// *              MACRO DEFINITIONS              *
+// *---------------------------------------------*
+
+#define NUMERIC_LITERAL_COUNT 60000 // fits chunk constant pool
+#define NUMERIC_LITERALS_PER_STATEMENT 16
+#define NUMERIC_LITERAL_MAX_LENGTH 32
+
+// *---------------------------------------------*
+// *              TYPE DEFINITIONS               *
+// *---------------------------------------------*
+
+/// Function writing `index`-th numeric literal into `buffer` (of NUMERIC_LITERAL_MAX_LENGTH size).
+/// @return Numeric literal length.
+typedef int(NumericLiteralGeneratorFn)(int index, char *buffer);
+
+/// Numeric literal compilation benchmark configuration.
+typedef struct {
+  char const *name;
+  NumericLiteralGeneratorFn *generate_numeric_literal;
+  char *source_code;
+} NumericLiteralCompilationConfig;
+
+// *---------------------------------------------*
+// *          INTERNAL-LINKAGE OBJECTS           *
+// *---------------------------------------------*
+
+static VM vm;
+
+// *---------------------------------------------*
+// *         INTERNAL-LINKAGE FUNCTIONS          *
+// *---------------------------------------------*
+
+static int generate_integer(int const index, char *const buffer) {
+  return snprintf(buffer, NUMERIC_LITERAL_MAX_LENGTH, "%d", index * 7919);
+}
+
+static int generate_short_fraction(int const index, char *const buffer) {
+  return snprintf(buffer, NUMERIC_LITERAL_MAX_LENGTH, "%d.%02d", index % 1000, index % 100);
+}
+
+static int generate_long_fraction(int const index, char *const buffer) {
+  return snprintf(buffer, NUMERIC_LITERAL_MAX_LENGTH, "%.17g", (index + 1) / 7.0);
+}
+
+/// Make source code consisting of NUMERIC_LITERAL_COUNT numeric literals generated according to `config`.
+/// Literals are summed up in expression statements holding NUMERIC_LITERALS_PER_STATEMENT literals each.
+/// @return Heap-allocated source code.
+static char *make_source_code(NumericLiteralCompilationConfig const *const config) {
+  size_t const source_code_max_size = NUMERIC_LITERAL_COUNT * (NUMERIC_LITERAL_MAX_LENGTH + 3) + 1;
+  char *const source_code = malloc(source_code_max_size);
+  if (source_code == NULL) ERROR_MEMORY_ERRNO();
+
+  size_t source_code_length = 0;
+  for (int i = 0; i < NUMERIC_LITERAL_COUNT; i++) {
+    int const literal_length = config->generate_numeric_literal(i, source_code + source_code_length);
+    if (literal_length < 0 || literal_length >= NUMERIC_LITERAL_MAX_LENGTH) ERROR_IO_ERRNO();
+    source_code_length += literal_length;
+
+    bool const is_last_in_statement =
+      (i + 1) % NUMERIC_LITERALS_PER_STATEMENT == 0 || i + 1 == NUMERIC_LITERAL_COUNT;
+    source_code_length += sprintf(source_code + source_code_length, is_last_in_statement ? ";\n" : " + ");
+  }
+
+  return source_code;
+}
+
+/// Compile numeric-heavy source code held by `context` config.
+/// @return Number of compiled numeric literals.
+static double compile_numeric_literals(void *const context) {
+  NumericLiteralCompilationConfig const *const config = context;
+
+  Chunk chunk;
+  chunk_init(&chunk);
+
+  if (compiler_compile(&vm, config->source_code, &chunk) != COMPILER_SUCCESS)
+    ERROR_INTERNAL("Failed to compile numeric literals");
+
+  chunk_destroy(&chunk);
+
+  return NUMERIC_LITERAL_COUNT;
+}
+
+int main(void) {
+  VMConfig const vm_config = {
+    .source_file_path = __FILE__,
+    .static_analysis_error_stream = stderr,
+    .source_program_output_stream = stdout,
+    .memory_manager = memory_manage,
+  };
+  vm_init(&vm, &vm_config);
+
+  NumericLiteralCompilationConfig configs[] = {
+    {.name = "compile integers", .generate_numeric_literal = generate_integer},
+    {.name = "compile short fractions", .generate_numeric_literal = generate_short_fraction},
+    {.name = "compile long fractions", .generate_numeric_literal = generate_long_fraction},
+  };
+
+  for (size_t i = 0; i < sizeof(configs) / sizeof(configs[0]); i++) {
+    configs[i].source_code = make_source_code(&configs[i]);
+    benchmark_run(configs[i].name, compile_numeric_literals, &configs[i], "literals");
+    free(configs[i].source_code);
+  }
+
+  vm_destroy(&vm);
+
+  return EXIT_SUCCESS;
+}
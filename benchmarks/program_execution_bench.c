@@ -0,0 +1,111 @@
+#include "backend/chunk.h"
+#include "backend/vm.h"
+#include "benchmark.h"
+#include "frontend/compiler.h"
+#include "program.h"
+#include "utils/error.h"
+#include "utils/memory.h"
+
+#include <stdbool.h>
+#include <stdio.h>
+#include <stdlib.h>
+
+// *---------------------------------------------*
+// *              MACRO DEFINITIONS              *
+// *---------------------------------------------*
+
+#define EVALUATION_COUNT 200000
+
+// *---------------------------------------------*
+// *              TYPE DEFINITIONS               *
+// *---------------------------------------------*
+
+/// Program execution benchmark configuration.
+typedef struct {
+  char const *name;
+  char const *source_code; // evaluated EVALUATION_COUNT times
+  bool is_precompiled;
+} ProgramExecutionConfig;
+
+// *---------------------------------------------*
+// *          INTERNAL-LINKAGE OBJECTS           *
+// *---------------------------------------------*
+
+static ProgramConfig program_config;
+static VMConfig vm_config;
+static VM vm;
+
+// *---------------------------------------------*
+// *         INTERNAL-LINKAGE FUNCTIONS          *
+// *---------------------------------------------*
+
+/// Evaluate source code held by `context` config EVALUATION_COUNT times; either compiling it for every evaluation
+/// (like interpreter_interpret does), or compiling it once and executing resultant program repeatedly.
+/// @return Number of evaluations.
+static double evaluate_source_code(void *const context) {
+  ProgramExecutionConfig const *const config = context;
+
+  if (config->is_precompiled) {
+    Program *program;
+    if (!program_compile(&program_config, config->source_code, &program)) {
+      ERROR_INTERNAL("Failed to compile benchmarked source code");
+    }
+
+    for (int i = 0; i < EVALUATION_COUNT; i++) {
+      if (!program_execute(program, &vm)) ERROR_INTERNAL("Failed to execute benchmarked program");
+    }
+
+    vm_reset(&vm); // VM references program strings
+    program_destroy(program);
+  } else {
+    Chunk chunk;
+    chunk_init(&chunk);
+
+    for (int i = 0; i < EVALUATION_COUNT; i++) {
+      if (compiler_compile(&vm, config->source_code, &chunk) != COMPILER_SUCCESS) {
+        ERROR_INTERNAL("Failed to compile benchmarked source code");
+      }
+      if (!vm_execute(&vm, &chunk)) ERROR_INTERNAL("Failed to execute benchmarked source code");
+      chunk_reset(&chunk);
+    }
+
+    chunk_destroy(&chunk);
+  }
+
+  return EVALUATION_COUNT;
+}
+
+int main(void) {
+  vm_config = (VMConfig){
+    .source_file_path = __FILE__,
+    .static_analysis_error_stream = stderr,
+    .bytecode_execution_error_stream = stderr,
+    .source_program_output_stream = stdout,
+    .memory_manager = memory_manage,
+  };
+  vm_init(&vm, &vm_config);
+  program_config = (ProgramConfig){
+    .source_file_path = __FILE__,
+    .static_analysis_error_stream = stderr,
+    .bytecode_execution_error_stream = stderr,
+    .source_program_output_stream = stdout,
+  };
+
+  // expressions are evaluated for their value alone (no output gets written)
+  char const *const arithmetic_expr = "(1.5 * 4 - 2) / 8 % 3 < 10 == !false;";
+  char const *const string_expr = "\"price: \" .. 42 .. \" \" .. \"USD\" == \"price: 42 USD\";";
+  ProgramExecutionConfig configs[] = {
+    {.name = "compile & execute arithmetic expr", .source_code = arithmetic_expr, .is_precompiled = false},
+    {.name = "execute precompiled arithmetic expr", .source_code = arithmetic_expr, .is_precompiled = true},
+    {.name = "compile & execute string expr", .source_code = string_expr, .is_precompiled = false},
+    {.name = "execute precompiled string expr", .source_code = string_expr, .is_precompiled = true},
+  };
+
+  for (size_t i = 0; i < sizeof(configs) / sizeof(configs[0]); i++) {
+    benchmark_run(configs[i].name, evaluate_source_code, &configs[i], "evaluations");
+  }
+
+  vm_destroy(&vm);
+
+  return EXIT_SUCCESS;
+}
@@ -0,0 +1,46 @@
+#include "benchmark.h"
+
+#include "utils/error.h"
+
+#include <assert.h>
+#include <stdio.h>
+#include <time.h>
+
+// *---------------------------------------------*
+// *         EXTERNAL-LINKAGE FUNCTIONS          *
+// *---------------------------------------------*
+
+/// Get current time.
+/// @return Time in seconds.
+double benchmark_get_time(void) {
+  struct timespec time;
+  if (timespec_get(&time, TIME_UTC) != TIME_UTC) ERROR_SYSTEM("Failed to get current time");
+
+  return time.tv_sec + time.tv_nsec / 1e9;
+}
+
+/// Run `benchmark` with `context` BENCHMARK_REPETITION_COUNT times and report its fastest repetition.
+/// Report includes throughput, expressed in `work_unit` per second.
+void benchmark_run(
+  char const *const benchmark_name, BenchmarkFn *const benchmark, void *const context, char const *const work_unit
+) {
+  assert(benchmark_name != NULL);
+  assert(benchmark != NULL);
+  assert(work_unit != NULL);
+
+  double best_elapsed_time = -1;
+  double work_amount = 0;
+
+  for (int i = 0; i < BENCHMARK_REPETITION_COUNT; i++) {
+    double const start_time = benchmark_get_time();
+    work_amount = benchmark(context);
+    double const elapsed_time = benchmark_get_time() - start_time;
+
+    if (best_elapsed_time < 0 || elapsed_time < best_elapsed_time) best_elapsed_time = elapsed_time;
+  }
+
+  printf(
+    "%-48s %10.3f ms %14.2f %s/s\n", benchmark_name, best_elapsed_time * 1e3, work_amount / best_elapsed_time,
+    work_unit
+  );
+}
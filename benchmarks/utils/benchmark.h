@@ -0,0 +1,31 @@
+#ifndef BENCHMARK_H
+#define BENCHMARK_H
+
+#include <stddef.h>
+
+// *---------------------------------------------*
+// *              MACRO DEFINITIONS              *
+// *---------------------------------------------*
+
+/// Number of times each benchmark gets repeated; the fastest repetition is reported.
+#define BENCHMARK_REPETITION_COUNT 5
+
+#define BENCHMARK_BYTES_PER_MEGABYTE (1024.0 * 1024.0)
+
+// *---------------------------------------------*
+// *              TYPE DEFINITIONS               *
+// *---------------------------------------------*
+
+/// Function performing single benchmark repetition.
+/// @param context Benchmark-specific data.
+/// @return Amount of work done (e.g. bytes or instructions processed).
+typedef double(BenchmarkFn)(void *context);
+
+// *---------------------------------------------*
+// *             FUNCTION PROTOTYPES             *
+// *---------------------------------------------*
+
+double benchmark_get_time(void);
+void benchmark_run(char const *benchmark_name, BenchmarkFn *benchmark, void *context, char const *work_unit);
+
+#endif // BENCHMARK_H
@@ -6,8 +6,16 @@
 
 #include <assert.h>
 #include <limits.h>
+#include <stdbool.h>
 #include <stdint.h>
 
+// *---------------------------------------------*
+// *              MACRO DEFINITIONS              *
+// *---------------------------------------------*
+
+/// Maximum count of chunk constants (constant instruction operand is at most 2 bytes long).
+#define CHUNK_MAX_CONSTANT_COUNT (UINT16_MAX + 1)
+
 // *---------------------------------------------*
 // *              TYPE DEFINITIONS               *
 // *---------------------------------------------*
@@ -41,6 +49,8 @@ typedef enum {
   // complex-instruction opcodes (with operands)
   CHUNK_OP_CONSTANT,
   CHUNK_OP_CONSTANT_2B,
+  CHUNK_OP_CONCATENATE_N, // 1-byte operand count (concatenates that many topmost stack values)
+  CHUNK_OP_INPUT, // 1-byte input slot (pushes VM input value held by that slot)
   CHUNK_OP_COMPLEX_OPCODE_END, // assertion utility
 
   // assertion utilities
@@ -68,6 +78,12 @@ typedef struct {
   ValueList constants;
 } Chunk;
 
+/// Chunk state that chunk can be rolled back to (discarding everything appended since).
+typedef struct {
+  size_t code_count, line_count, constant_count;
+  int last_line_instruction_count;
+} ChunkCheckpoint;
+
 // *---------------------------------------------*
 // *             FUNCTION PROTOTYPES             *
 // *---------------------------------------------*
@@ -77,7 +93,8 @@ void chunk_destroy(Chunk *chunk);
 void chunk_append_instruction(Chunk *chunk, uint8_t opcode, int32_t line);
 void chunk_append_operand(Chunk *chunk, uint8_t operand);
 void chunk_append_multibyte_operand(Chunk *chunk, int byte_count, ...);
-void chunk_append_constant_instruction(Chunk *chunk, Value value, int32_t line);
+bool chunk_append_constant_instruction(Chunk *chunk, Value value, int32_t line);
+int32_t chunk_append_chunk(Chunk *destination, Chunk const *source);
 int32_t chunk_get_instruction_line(Chunk const *chunk, int32_t offset);
 
 // *---------------------------------------------*
@@ -90,4 +107,28 @@ inline void chunk_reset(Chunk *const chunk) {
   chunk_init(chunk);
 }
 
+/// Make checkpoint of current `chunk` state.
+inline ChunkCheckpoint chunk_make_checkpoint(Chunk const *const chunk) {
+  assert(chunk != NULL);
+
+  return (ChunkCheckpoint){
+    .code_count = chunk->code.count,
+    .line_count = chunk->lines.count,
+    .constant_count = chunk->constants.count,
+    .last_line_instruction_count = chunk->lines.count == 0 ? 0 : chunk->lines.data[chunk->lines.count - 1].count,
+  };
+}
+
+/// Roll `chunk` back to `checkpoint` state, discarding instructions and constants appended since.
+inline void chunk_rollback(Chunk *const chunk, ChunkCheckpoint const *const checkpoint) {
+  assert(chunk != NULL);
+  assert(checkpoint != NULL);
+  assert(checkpoint->code_count <= chunk->code.count && "Expected checkpoint to precede current chunk state");
+
+  chunk->code.count = checkpoint->code_count;
+  chunk->lines.count = checkpoint->line_count;
+  chunk->constants.count = checkpoint->constant_count;
+  if (checkpoint->line_count > 0) chunk->lines.data[checkpoint->line_count - 1].count = checkpoint->last_line_instruction_count;
+}
+
 #endif // CHUNK_H
@@ -0,0 +1,36 @@
+#ifndef COLUMNAR_H
+#define COLUMNAR_H
+
+#include "backend/chunk.h"
+#include "backend/value.h"
+#include "backend/vm.h"
+
+#include <stdbool.h>
+#include <stddef.h>
+
+// *---------------------------------------------*
+// *              MACRO DEFINITIONS              *
+// *---------------------------------------------*
+
+/// Count of rows evaluated by each vectorized instruction execution.
+#define COLUMNAR_BLOCK_ROW_COUNT 256
+
+// *---------------------------------------------*
+// *              TYPE DEFINITIONS               *
+// *---------------------------------------------*
+
+/// Rows of numeric inputs (stored column by column) that expression gets evaluated over.
+typedef struct {
+  double const *const *input_columns; // one column per VM input slot, each holding `row_count` numbers
+  size_t row_count;
+  Value *result_column; // receives expression value of every row (nil for rows whose evaluation failed)
+  bool *failure_column; // receives whether evaluation of every row failed (optional, may be NULL)
+} ColumnarBatch;
+
+// *---------------------------------------------*
+// *             FUNCTION PROTOTYPES             *
+// *---------------------------------------------*
+
+size_t columnar_evaluate(VM *vm, Chunk const *chunk, ColumnarBatch const *batch);
+
+#endif // COLUMNAR_H
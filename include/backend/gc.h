@@ -1,32 +1,34 @@
 #ifndef GC_H
 #define GC_H
 
-#include "utils/memory.h"
+#include "backend/vm.h"
+
+#include <stddef.h>
 
 // *---------------------------------------------*
 // *             FUNCTION PROTOTYPES             *
 // *---------------------------------------------*
 
-MemoryManagerFn gc_memory_manage;
-void gc_deallocate_vm_gc_objects(void);
+void *gc_memory_manage(VM *vm, void *object, size_t old_size, size_t new_size);
+void gc_deallocate_vm_gc_objects(VM *vm);
 
 // *---------------------------------------------*
 // *              INLINE FUNCTIONS               *
 // *---------------------------------------------*
 
-/// Allocate garbage-collected object of `new_size`.
-inline void *gc_allocate(size_t const new_size) {
-  return memory_allocate(gc_memory_manage, new_size);
+/// Allocate garbage-collected object of `new_size` belonging to `vm`.
+inline void *gc_allocate(VM *const vm, size_t const new_size) {
+  return gc_memory_manage(vm, NULL, 0, new_size);
 }
 
-/// Reallocate garbage-collected `object` of `old_size` to `new_size`.
-inline void *gc_reallocate(void *const object, size_t const old_size, size_t const new_size) {
-  return memory_reallocate(gc_memory_manage, object, old_size, new_size);
+/// Reallocate garbage-collected `object` of `old_size` (belonging to `vm`) to `new_size`.
+inline void *gc_reallocate(VM *const vm, void *const object, size_t const old_size, size_t const new_size) {
+  return gc_memory_manage(vm, object, old_size, new_size);
 }
 
-/// Deallocate garbage-collected `object` of `old_size`.
-inline void *gc_deallocate(void *const object, size_t const old_size) {
-  return memory_deallocate(gc_memory_manage, object, old_size);
+/// Deallocate garbage-collected `object` of `old_size` belonging to `vm`.
+inline void *gc_deallocate(VM *const vm, void *const object, size_t const old_size) {
+  return gc_memory_manage(vm, object, old_size, 0);
 }
 
 #endif // GC_H
@@ -2,9 +2,11 @@
 #define OBJECT_H
 
 #include "utils/memory.h"
+#include "utils/output_sink.h"
 
 #include <assert.h>
 #include <stdbool.h>
+#include <stdint.h>
 #include <string.h>
 
 // *---------------------------------------------*
@@ -12,18 +14,26 @@
 // *---------------------------------------------*
 
 /// Make `ctype` CLA Object of `object_type`.
+/// @param vm Virtual machine that Object belongs to.
 /// @param ctype Concrete C type of Object to be made.
 /// @param object_type ObjectType value corresponding to `ctype`.
 /// @result Pointer to made Object.
-#define OBJECT_MAKE(ctype, object_type) ((ctype *)object_make(sizeof(ctype), (object_type)))
+#define OBJECT_MAKE(vm, ctype, object_type) ((ctype *)object_make((vm), sizeof(ctype), (object_type)))
+
+/// Minimum rope length; shorter concatenation results are materialized eagerly (as flat strings).
+#define OBJECT_ROPE_MIN_LENGTH 256
 
 // *---------------------------------------------*
 // *              TYPE DEFINITIONS               *
 // *---------------------------------------------*
 
+/// Virtual Machine (defined in backend/vm.h).
+typedef struct VM VM;
+
 /// CLA object type.
 typedef enum {
   OBJECT_STRING,
+  OBJECT_ROPE,
   OBJECT_TYPE_COUNT,
 } ObjectType;
 
@@ -35,23 +45,78 @@ struct Object {
 };
 
 /// CLA string object.
+/// Owning strings are variable-length objects storing their content inline (within `inline_content`),
+/// whereas non-owning ones merely reference content residing in foreign memory (e.g. static storage).
+/// Strings are interned, so each distinct content is represented by exactly one string object.
 typedef struct {
   Object object;
   int length;
+  uint32_t hash;
   bool is_content_owner;
-  char *content;
+  char const *content; // points to `inline_content` if string is a content owner
+  char inline_content[];
 } ObjectString;
 
+/// CLA rope object (lazily concatenated string).
+/// Rope content gets materialized (flattened) only once it's actually needed,
+/// which keeps repeated concatenation linear.
+/// At the language level, ropes are indistinguishable from strings.
+typedef struct {
+  Object object;
+  int length;
+  Object *left, *right;    // string or rope objects; NULL once rope has been flattened
+  ObjectString *flattened; // NULL until rope gets flattened
+} ObjectRope;
+
 // *---------------------------------------------*
 // *             FUNCTION PROTOTYPES             *
 // *---------------------------------------------*
 // Objects are passed by pointers to prevent object slicing
 
-Object *object_make(size_t size, ObjectType type);
-ObjectString *object_make_owning_string(char const *content, int content_length);
-ObjectString *object_make_non_owning_string(char const *content, int content_length);
+Object *object_make(VM *vm, size_t size, ObjectType type);
+ObjectString *object_make_owning_string(VM *vm, char const *content, int content_length);
+ObjectString *object_make_uninitialized_owning_string(VM *vm, int content_length);
+ObjectString *object_intern_owning_string(VM *vm, ObjectString *string);
+ObjectString *object_make_non_owning_string(VM *vm, char const *content, int content_length);
+void object_intern_immortal_string(VM *vm, ObjectString *string);
+Object *object_concatenate(VM *vm, Object *first_string, Object *second_string);
+ObjectString *object_flatten_string(VM *vm, Object const *string);
 char const *object_get_type_string(Object const *object);
 void object_print(Object const *object);
-bool object_equals(Object const *object_a, Object const *object_b);
+void object_write(VM *vm, OutputSink *sink, Object const *object);
+bool object_equals(VM *vm, Object const *object_a, Object const *object_b);
+
+// *---------------------------------------------*
+// *              INLINE FUNCTIONS               *
+// *---------------------------------------------*
+
+/// Determine whether `object` is of string type (either flat string or rope).
+/// @return true if it is, false otherwise.
+inline bool object_is_string(Object const *const object) {
+  assert(object != NULL);
+
+  static_assert(OBJECT_TYPE_COUNT == 2, "Exhaustive ObjectType handling");
+  return object->type == OBJECT_STRING || object->type == OBJECT_ROPE;
+}
+
+/// Get length of `string` object (either flat string or rope).
+/// @return `string` length.
+inline int object_get_string_length(Object const *const string) {
+  assert(string != NULL);
+  assert(object_is_string(string));
+
+  if (string->type == OBJECT_ROPE) return ((ObjectRope *)string)->length;
+  return ((ObjectString *)string)->length;
+}
+
+/// Get flat string standing in for `string` object, if there's one (flattened ropes are represented by their result).
+/// @return Pointer to flat string, or NULL if `string` is an unflattened rope.
+inline ObjectString *object_get_flat_string(Object *const string) {
+  assert(string != NULL);
+  assert(object_is_string(string));
+
+  if (string->type == OBJECT_STRING) return (ObjectString *)string;
+  return ((ObjectRope *)string)->flattened;
+}
 
 #endif // OBJECT_H
@@ -0,0 +1,35 @@
+#ifndef STRING_TABLE_H
+#define STRING_TABLE_H
+
+#include "backend/object.h"
+#include "utils/memory.h"
+
+#include <stdbool.h>
+#include <stddef.h>
+#include <stdint.h>
+
+// *---------------------------------------------*
+// *              TYPE DEFINITIONS               *
+// *---------------------------------------------*
+
+/// Open-addressing (linear probing) hash set of CLA string objects, used for string interning.
+/// @note Table holds weak references; stored strings are neither owned nor kept alive by it.
+typedef struct {
+  ObjectString **entries; // vacant entries are NULL, removed ones hold a tombstone
+  size_t capacity;        // always 0 or a power of 2
+  size_t count;           // occupied entries (tombstones included)
+  MemoryManagerFn *memory_manager;
+} StringTable;
+
+// *---------------------------------------------*
+// *             FUNCTION PROTOTYPES             *
+// *---------------------------------------------*
+
+void string_table_init(StringTable *table, MemoryManagerFn *memory_manager);
+void string_table_destroy(StringTable *table);
+void string_table_clear(StringTable *table);
+ObjectString *string_table_find(StringTable const *table, char const *content, int content_length, uint32_t hash);
+void string_table_insert(StringTable *table, ObjectString *string);
+bool string_table_remove(StringTable *table, ObjectString const *string);
+
+#endif // STRING_TABLE_H
@@ -3,6 +3,7 @@
 
 #include "backend/object.h"
 #include "utils/darray.h"
+#include "utils/output_sink.h"
 
 #include <stdbool.h>
 #include <stdint.h>
@@ -42,8 +43,11 @@ void value_list_init(ValueList *value_list);
 void value_list_append(ValueList *value_list, Value value);
 void value_list_destroy(ValueList *value_list);
 void value_print(Value value);
-bool value_equals(Value value_a, Value value_b);
-ObjectString *value_to_string_object(Value value);
+void value_write(VM *vm, OutputSink *sink, Value value);
+bool value_equals(VM *vm, Value value_a, Value value_b);
+ObjectString *value_to_string_object(VM *vm, Value value);
+void value_intern_immortal_strings(VM *vm);
+Object *value_concatenate(VM *vm, Value const *operands, int operand_count);
 
 // *---------------------------------------------*
 // *              INLINE FUNCTIONS               *
@@ -106,7 +110,7 @@ inline bool value_is_number(Value const value) {
 /// Determine whether CLA `value` is of string type.
 /// @return true if it is, false otherwise.
 inline bool value_is_string(Value const value) {
-  return value.type == VALUE_OBJECT && value.as.object->type == OBJECT_STRING;
+  return value.type == VALUE_OBJECT && object_is_string(value.as.object);
 }
 
 /// Determine whether CLA `value` is falsy.
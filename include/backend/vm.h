@@ -2,49 +2,82 @@
 #define VM_H
 
 #include "backend/chunk.h"
+#include "backend/string_table.h"
 #include "backend/value.h"
+#include "utils/memory.h"
+#include "utils/output_sink.h"
 #include "utils/stack.h"
 
 #include <stdbool.h>
+#include <stddef.h>
 #include <stdint.h>
+#include <stdio.h>
+
+// *---------------------------------------------*
+// *              MACRO DEFINITIONS              *
+// *---------------------------------------------*
+
+/// Maximum count of VM input slots (input instruction operand is a single byte).
+#define VM_MAX_INPUT_COUNT (UINT8_MAX + 1)
 
 // *---------------------------------------------*
 // *              TYPE DEFINITIONS               *
 // *---------------------------------------------*
 
-/// Virtual Machine.
+/// Virtual Machine configuration.
 typedef struct {
+  char const *source_file_path; // reported alongside errors
+  FILE *static_analysis_error_stream;
+  FILE *bytecode_execution_error_stream;
+  FILE *source_program_output_stream;
+  bool is_source_program_output_async;
+  bool is_source_program_output_failure_tolerant; // failed writes get recorded by output sink instead of being fatal
+  MemoryManagerFn *memory_manager; // manages memory of VM internals, and of VM objects unless `object_allocator` is set
+  MemoryAllocator const *object_allocator; // NULL, or allocator managing memory of VM objects (reset along with VM)
+  char const *const *input_names; // names of host-supplied input slots (identifiers referring to them)
+  int input_count; // at most VM_MAX_INPUT_COUNT
+  size_t bytecode_budget; // max count of bytecode bytes executed between budget resets (0 means unlimited)
+  double execution_timeout; // max wall-clock seconds spent executing since budget reset (0 means unlimited)
+} VMConfig;
+
+/// Virtual Machine.
+/// @note Virtual machines share no state, so separate threads can run separate virtual machines concurrently.
+typedef struct VM VM;
+struct VM {
+  VMConfig config;
   Object *gc_objects;
+  StringTable strings; // interned strings (weak references)
   Chunk const *chunk;
   uint8_t const *ip;
   STACK_TYPE(Value) stack;
-} VM;
-
-// *---------------------------------------------*
-// *             OBJECT DECLARATIONS             *
-// *---------------------------------------------*
-
-/// Global Virtual Machine.
-extern VM vm;
+  OutputSink output_sink; // source program output (flushed whenever execution ends)
+  Value const *inputs; // values of configured input slots, supplied by host prior to execution (NULL makes them nil)
+  size_t executed_bytecode_length; // bytecode bytes executed since execution budget reset
+  double execution_time; // wall-clock seconds spent executing since execution budget reset (tracked if timeout is set)
+};
 
 // *---------------------------------------------*
 // *             FUNCTION PROTOTYPES             *
 // *---------------------------------------------*
 
-void vm_init(void);
-void vm_destroy(void);
-void vm_stack_push(Value value);
-Value vm_stack_pop(void);
-bool vm_execute(Chunk const *chunk);
+void vm_init(VM *vm, VMConfig const *config);
+void vm_destroy(VM *vm);
+void vm_recycle(VM *vm, VMConfig const *config);
+void vm_reset_execution_budget(VM *vm);
+void vm_stack_push(VM *vm, Value value);
+Value vm_stack_pop(VM *vm);
+bool vm_execute(VM *vm, Chunk const *chunk);
+bool vm_error_at(VM *vm, ptrdiff_t instruction_offset, char const *format, ...);
 
 // *---------------------------------------------*
 // *              INLINE FUNCTIONS               *
 // *---------------------------------------------*
 
-/// Reset virtual machine back to initialized state.
-inline void vm_reset(void) {
-  vm_destroy();
-  vm_init();
+/// Reset `vm` back to initialized state (preserving its configuration).
+inline void vm_reset(VM *const vm) {
+  VMConfig const config = vm->config;
+  vm_destroy(vm);
+  vm_init(vm, &config);
 }
 
 #endif // VM_H
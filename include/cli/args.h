@@ -1,10 +1,28 @@
 #ifndef ARGS_H
 #define ARGS_H
 
+#include <stdbool.h>
+
+// *---------------------------------------------*
+// *              TYPE DEFINITIONS               *
+// *---------------------------------------------*
+
+/// Processed cli arguments.
+typedef struct {
+  char const **source_file_paths; // heap-allocated; elements point into process's `argv`
+  int source_file_path_count;
+  char const *manifest_path; // file listing source file paths (one per line); NULL unless supplied
+  int job_count; // number of batch mode (or server) worker threads; 0 unless supplied
+  bool is_serving, is_client; // whether server or client mode was requested
+  char const *socket_path; // server socket path; NULL unless supplied
+  char const *records_path; // records file that source file gets executed for ('--each'); NULL unless supplied
+} Args;
+
 // *---------------------------------------------*
 // *             FUNCTION PROTOTYPES             *
 // *---------------------------------------------*
 
-char const *args_process(int argc, char const *const *argv);
+Args args_process(int argc, char const *const *argv);
+void args_destroy(Args *args);
 
 #endif // ARGS_H
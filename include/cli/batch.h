@@ -0,0 +1,20 @@
+#ifndef BATCH_H
+#define BATCH_H
+
+#include "utils/error.h"
+
+// *---------------------------------------------*
+// *              MACRO DEFINITIONS              *
+// *---------------------------------------------*
+
+#define BATCH_MAX_JOB_COUNT 1024
+
+// *---------------------------------------------*
+// *             FUNCTION PROTOTYPES             *
+// *---------------------------------------------*
+
+ErrorCode batch_interpret(
+  char const *const *source_file_paths, int source_file_path_count, char const *manifest_path, int job_count
+);
+
+#endif // BATCH_H
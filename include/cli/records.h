@@ -0,0 +1,20 @@
+#ifndef RECORDS_H
+#define RECORDS_H
+
+#include "backend/vm.h"
+#include "utils/error.h"
+
+// *---------------------------------------------*
+// *              MACRO DEFINITIONS              *
+// *---------------------------------------------*
+
+/// Maximum count of fields of a single record (every field is exposed through a VM input slot).
+#define RECORDS_MAX_FIELD_COUNT VM_MAX_INPUT_COUNT
+
+// *---------------------------------------------*
+// *             FUNCTION PROTOTYPES             *
+// *---------------------------------------------*
+
+ErrorCode records_interpret(char const *records_path, char const *script_path, int job_count);
+
+#endif // RECORDS_H
@@ -0,0 +1,35 @@
+#ifndef SERVER_H
+#define SERVER_H
+
+#include "utils/error.h"
+
+// *---------------------------------------------*
+// *              MACRO DEFINITIONS              *
+// *---------------------------------------------*
+
+/// Name of Unix domain socket used unless specified otherwise (located in user's runtime directory).
+#define SERVER_DEFAULT_SOCKET_NAME "cla.sock"
+
+/// Format of private per-user directory holding default socket if user has no runtime directory (formatted with user
+/// ID).
+#define SERVER_FALLBACK_SOCKET_DIRECTORY_FORMAT "/tmp/cla-%lu"
+
+// *---------------------------------------------*
+// *              TYPE DEFINITIONS               *
+// *---------------------------------------------*
+
+/// Interpreter server listening on Unix domain socket.
+typedef struct {
+  char const *socket_path;
+  int listening_socket;
+} Server;
+
+// *---------------------------------------------*
+// *             FUNCTION PROTOTYPES             *
+// *---------------------------------------------*
+
+void server_listen(Server *server, char const *socket_path);
+ErrorCode server_serve(Server *server, int worker_count);
+ErrorCode server_interpret_remotely(char const *socket_path, char const *source_file_path);
+
+#endif // SERVER_H
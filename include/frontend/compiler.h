@@ -2,8 +2,11 @@
 #define COMPILER_H
 
 #include "backend/chunk.h"
+#include "backend/vm.h"
+#include "utils/darray.h"
 
 #include <stdbool.h>
+#include <stdint.h>
 
 // *---------------------------------------------*
 // *              TYPE DEFINITIONS               *
@@ -16,10 +19,53 @@ typedef enum {
   COMPILER_STATUS_COUNT,
 } CompilerStatus;
 
+/// Source code compiled in batches of whole statements, concurrently with their execution (opaque).
+typedef struct CompilerPipeline CompilerPipeline;
+
+/// Compilation session fed source code line by line, resuming statements cut off by previous line end.
+typedef struct {
+  VM *vm;
+  Chunk *chunk;
+  DARRAY_TYPE(char) pending_source_code; // NUL terminated source code of statement cut off by previous line end
+  int32_t pending_first_line;
+  int pending_first_column;
+} CompilerSession;
+
+/// Compilation stream fed source code in arbitrary blocks, compiling statements once blocks completing them arrive.
+/// Pending source code is scanned for statement boundaries incrementally; scan state carries over between blocks.
+typedef struct {
+  VM *vm;
+  Chunk *chunk;
+  DARRAY_TYPE(char) pending_source_code; // unterminated source code following the last compiled statement boundary
+  int32_t pending_first_line;
+  int pending_first_column;
+  size_t scanned_length; // count of pending source code characters already scanned for statement boundaries
+  int32_t scanned_line; // position following scanned characters
+  int scanned_column;
+  bool is_scanning_string_literal, is_scanning_comment;
+  int scanned_grouping_depth; // parentheses and curly braces
+  size_t boundary_length; // length of pending source code up to the last scanned statement boundary (0 if there's none)
+  int32_t boundary_line; // position following the last scanned statement boundary
+  int boundary_column;
+  bool is_lookahead_known; // whether token following that boundary has begun (and isn't unterminated string literal)
+} CompilerStream;
+
 // *---------------------------------------------*
 // *             FUNCTION PROTOTYPES             *
 // *---------------------------------------------*
 
-CompilerStatus compiler_compile(char const *source_code, Chunk *chunk);
+CompilerStatus compiler_compile(VM *vm, char const *source_code, Chunk *chunk);
+CompilerStatus compiler_compile_parallel(VM *vm, char const *source_code, Chunk *chunk, int max_segment_count);
+CompilerStatus compiler_compile_expression(VM *vm, char const *source_code, Chunk *chunk);
+void compiler_session_init(CompilerSession *session, VM *vm, Chunk *chunk);
+void compiler_session_destroy(CompilerSession *session);
+CompilerStatus compiler_session_compile_line(CompilerSession *session, char const *line);
+void compiler_stream_init(CompilerStream *stream, VM *vm, Chunk *chunk);
+void compiler_stream_destroy(CompilerStream *stream);
+CompilerStatus compiler_stream_feed(CompilerStream *stream, char const *source_code, size_t length);
+CompilerStatus compiler_stream_finish(CompilerStream *stream);
+CompilerPipeline *compiler_pipeline_start(VM *vm, char const *source_code);
+bool compiler_pipeline_take_batch(CompilerPipeline *pipeline, Chunk *chunk, CompilerStatus *status);
+void compiler_pipeline_stop(CompilerPipeline *pipeline);
 
 #endif // COMPILER_H
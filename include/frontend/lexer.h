@@ -1,6 +1,8 @@
 #ifndef LEXER_H
 #define LEXER_H
 
+#include "utils/darray.h"
+
 #include <assert.h>
 #include <limits.h>
 #include <stdint.h>
@@ -89,11 +91,86 @@ typedef struct {
   uint8_t type;
 } LexerToken;
 
+/// Message of LEXER_TOKEN_ERROR token (its lexeme doesn't reside in source code).
+typedef struct {
+  int32_t token_index;
+  char const *message;
+} LexerTokenBufferError;
+
+/// Whole source code tokens, compactly encoded as structure of arrays.
+/// @note Token lines and columns aren't stored; they're computed from lexeme offsets on demand.
+typedef struct {
+  char const *source_code;
+  DARRAY_TYPE(uint32_t) lexeme_offsets; // relative to source_code
+  DARRAY_TYPE(uint32_t) lexeme_lengths; // error tokens hold length of source code spanned by their lexemes
+  DARRAY_TYPE(uint8_t) types;
+  DARRAY_TYPE(LexerTokenBufferError) errors; // sorted by token_index
+  uint32_t line_cursor_offset; // offset of last line computation (lines are mostly computed for subsequent tokens)
+  int32_t line_cursor_line; // line at line_cursor_offset
+  int first_column; // column of source_code beginning
+} LexerTokenBuffer;
+
 // *---------------------------------------------*
 // *             FUNCTION PROTOTYPES             *
 // *---------------------------------------------*
 
 void lexer_init(char const *source_code);
 LexerToken lexer_scan(void);
+void lexer_tokenize(
+  char const *source_code, char const *source_file_path, int32_t first_line, int first_column, LexerTokenBuffer *buffer
+);
+void lexer_token_buffer_destroy(LexerTokenBuffer *buffer);
+int32_t lexer_token_buffer_move_line_cursor(LexerTokenBuffer *buffer, uint32_t offset);
+int lexer_token_buffer_get_column(LexerTokenBuffer const *buffer, int32_t token_index);
+LexerToken lexer_token_buffer_get_token(LexerTokenBuffer *buffer, int32_t token_index);
+
+// *---------------------------------------------*
+// *              INLINE FUNCTIONS               *
+// *---------------------------------------------*
+
+/// Get number of `buffer` tokens (including terminating EOF token).
+inline int32_t lexer_token_buffer_get_count(LexerTokenBuffer const *const buffer) {
+  assert(buffer != NULL);
+
+  return buffer->types.count;
+}
+
+/// Get `buffer` token type at `token_index`.
+inline LexerTokenType lexer_token_buffer_get_type(LexerTokenBuffer const *const buffer, int32_t const token_index) {
+  assert(buffer != NULL);
+  assert(token_index >= 0 && (size_t)token_index < buffer->types.count);
+
+  return buffer->types.data[token_index];
+}
+
+/// Get `buffer` token lexeme at `token_index`.
+/// @note Lexeme isn't NUL terminated; error tokens' lexemes should be retrieved with lexer_token_buffer_get_token.
+inline char const *lexer_token_buffer_get_lexeme(LexerTokenBuffer const *const buffer, int32_t const token_index) {
+  assert(buffer != NULL);
+  assert(token_index >= 0 && (size_t)token_index < buffer->lexeme_offsets.count);
+
+  return buffer->source_code + buffer->lexeme_offsets.data[token_index];
+}
+
+/// Get `buffer` token lexeme length at `token_index`.
+inline int lexer_token_buffer_get_lexeme_length(LexerTokenBuffer const *const buffer, int32_t const token_index) {
+  assert(buffer != NULL);
+  assert(token_index >= 0 && (size_t)token_index < buffer->lexeme_lengths.count);
+
+  return buffer->lexeme_lengths.data[token_index];
+}
+
+/// Get `buffer` token line at `token_index`; matches LexerToken.line (line on which token's lexeme ends).
+/// @note Line is computed incrementally from the last computed one, lines of subsequent tokens are therefore cheap.
+inline int32_t lexer_token_buffer_get_line(LexerTokenBuffer *const buffer, int32_t const token_index) {
+  assert(buffer != NULL);
+  assert(token_index >= 0 && (size_t)token_index < buffer->types.count);
+
+  uint32_t const lexeme_end_offset =
+    buffer->lexeme_offsets.data[token_index] + buffer->lexeme_lengths.data[token_index];
+  if (lexeme_end_offset == buffer->line_cursor_offset) return buffer->line_cursor_line;
+
+  return lexer_token_buffer_move_line_cursor(buffer, lexeme_end_offset);
+}
 
 #endif // LEXER_H
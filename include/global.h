@@ -1,3 +1,5 @@
+#include <stdbool.h>
+#include <stddef.h>
 #include <stdio.h>
 
 // *---------------------------------------------*
@@ -10,3 +12,7 @@ extern char const *g_source_file_path;
 extern FILE *g_static_analysis_error_stream;
 extern FILE *g_bytecode_execution_error_stream;
 extern FILE *g_source_program_output_stream;
+extern bool g_is_source_program_output_async;
+extern bool g_is_interpretation_pipelined;
+extern size_t g_execution_bytecode_budget;
+extern double g_execution_timeout;
@@ -1,6 +1,8 @@
 #ifndef INTERPRETER_H
 #define INTERPRETER_H
 
+#include <stdio.h>
+
 // *---------------------------------------------*
 // *              TYPE DEFINITIONS               *
 // *---------------------------------------------*
@@ -20,5 +22,8 @@ typedef enum {
 void interpreter_init(void);
 void interpreter_destroy(void);
 InterpreterStatus interpreter_interpret(char const *source_code);
+InterpreterStatus interpreter_interpret_pipelined(char const *source_code);
+InterpreterStatus interpreter_interpret_stream(FILE *stream);
+InterpreterStatus interpreter_interpret_line(char const *line);
 
 #endif // INTERPRETER_H
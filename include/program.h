@@ -0,0 +1,45 @@
+#ifndef PROGRAM_H
+#define PROGRAM_H
+
+#include "utils/memory.h"
+
+#include <stdbool.h>
+#include <stddef.h>
+#include <stdio.h>
+
+// *---------------------------------------------*
+// *              TYPE DEFINITIONS               *
+// *---------------------------------------------*
+
+/// Compiled source program; immutable, thus executable any number of times by any number of VMs (opaque).
+typedef struct Program Program;
+
+/// Virtual Machine executing programs; its state persists across executions (opaque).
+typedef struct VM VM;
+
+/// Program compilation and VM configuration.
+typedef struct {
+  char const *source_file_path; // reported alongside errors
+  FILE *static_analysis_error_stream;
+  FILE *bytecode_execution_error_stream;
+  FILE *source_program_output_stream;
+  char const *const *input_names; // names of input slots (their values are nil unless supplied on execution)
+  int input_count;
+  size_t bytecode_budget; // max count of bytecode bytes executed by VM between resets (0 means unlimited)
+  double execution_timeout; // max wall-clock seconds spent executing by VM between resets (0 means unlimited)
+  MemoryAllocator const *object_allocator; // NULL, or allocator managing memory of objects made by program VMs
+} ProgramConfig;
+
+// *---------------------------------------------*
+// *             FUNCTION PROTOTYPES             *
+// *---------------------------------------------*
+
+bool program_compile(ProgramConfig const *config, char const *source_code, Program **out_program);
+void program_destroy(Program *program);
+bool program_execute(Program const *program, VM *vm);
+bool program_execute_with_inputs(Program const *program, VM *vm, double const *inputs);
+VM *program_vm_create(ProgramConfig const *config);
+void program_vm_reset(VM *vm);
+void program_vm_destroy(VM *vm);
+
+#endif // PROGRAM_H
@@ -34,8 +34,8 @@
 // *             FUNCTION PROTOTYPES             *
 // *---------------------------------------------*
 
-void debug_token(LexerToken const *token);
-void debug_disassemble_chunk(Chunk const *chunk, char const *name);
-int32_t debug_disassemble_instruction(Chunk const *chunk, int32_t offset);
+void debug_token(LexerToken const *token, char const *source_file_path);
+void debug_disassemble_chunk(Chunk const *chunk, char const *source_file_path, char const *name);
+int32_t debug_disassemble_instruction(Chunk const *chunk, char const *source_file_path, int32_t offset);
 
 #endif // DEBUG_H
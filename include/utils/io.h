@@ -17,7 +17,9 @@ char *io_read_finite_stream_as_str(FILE *stream);
 uint8_t *io_read_finite_seekable_binary_stream(FILE *stream, size_t *out_length);
 char *io_read_finite_seekable_binary_stream_as_str(FILE *stream);
 char *io_read_text_file(char const *filepath);
+char *io_try_read_text_file(char const *filepath);
 void io_clear_file(FILE *stream);
+size_t io_read_available(FILE *stream, void *buffer, size_t capacity);
 
 // *---------------------------------------------*
 // *              INLINE FUNCTIONS               *
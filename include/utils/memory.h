@@ -27,6 +27,20 @@
 /// @return Pointer to (re)allocated `object` or NULL if deallocation was performed.
 typedef void *(MemoryManagerFn)(void *object, size_t old_size, size_t new_size);
 
+/// Function managing `object` memory on behalf of allocator `context`; contextual counterpart of MemoryManagerFn.
+/// @see MemoryManagerFn for further documentation.
+typedef void *(MemoryAllocatorFn)(void *context, void *object, size_t old_size, size_t new_size);
+
+/// Function releasing every object allocated by allocator `context` at once (regardless of their count).
+typedef void(MemoryResetFn)(void *context);
+
+/// Pluggable allocator (e.g. arena, or per-thread pool) installed by embedding host.
+typedef struct {
+  MemoryAllocatorFn *manage;
+  MemoryResetFn *reset; // NULL if allocator doesn't support bulk release
+  void *context; // passed to `manage` and `reset`
+} MemoryAllocator;
+
 // *---------------------------------------------*
 // *             FUNCTION PROTOTYPES             *
 // *---------------------------------------------*
@@ -0,0 +1,54 @@
+#ifndef MEMORY_ARENA_H
+#define MEMORY_ARENA_H
+
+#include "utils/memory.h"
+
+#include <assert.h>
+#include <stddef.h>
+
+// *---------------------------------------------*
+// *              MACRO DEFINITIONS              *
+// *---------------------------------------------*
+
+/// Alignment of every object allocated by arena.
+#define MEMORY_ARENA_ALIGNMENT _Alignof(max_align_t)
+
+// *---------------------------------------------*
+// *              TYPE DEFINITIONS               *
+// *---------------------------------------------*
+
+/// Block of arena memory (opaque).
+typedef struct MemoryArenaBlock MemoryArenaBlock;
+
+/// Bump allocator carving objects out of blocks, releasing all of them at once by reset (deallocation of individual
+/// objects is a no-op, unless it's the most recently allocated one). Blocks are retained across resets.
+/// @note Arena isn't thread-safe.
+typedef struct {
+  MemoryManagerFn *memory_manager; // manages memory of arena blocks
+  size_t block_size; // minimum capacity of arena block
+  MemoryArenaBlock *first_block, *current_block; // block list, and block objects are currently allocated from
+  unsigned char *cursor, *end; // unallocated remainder of current block
+} MemoryArena;
+
+// *---------------------------------------------*
+// *             FUNCTION PROTOTYPES             *
+// *---------------------------------------------*
+
+void memory_arena_init(MemoryArena *arena, size_t block_size, MemoryManagerFn *memory_manager);
+void memory_arena_destroy(MemoryArena *arena);
+MemoryAllocatorFn memory_arena_manage;
+MemoryResetFn memory_arena_reset;
+
+// *---------------------------------------------*
+// *              INLINE FUNCTIONS               *
+// *---------------------------------------------*
+
+/// Make allocator allocating from `arena`.
+/// @return Allocator backed by `arena`.
+inline MemoryAllocator memory_arena_make_allocator(MemoryArena *const arena) {
+  assert(arena != NULL);
+
+  return (MemoryAllocator){.manage = memory_arena_manage, .reset = memory_arena_reset, .context = arena};
+}
+
+#endif // MEMORY_ARENA_H
@@ -3,10 +3,19 @@
 
 #include <stdbool.h>
 
+// *---------------------------------------------*
+// *              MACRO DEFINITIONS              *
+// *---------------------------------------------*
+
+/// Size of buffer capable of holding string representation of any number (including NUL terminator).
+#define NUMBER_STRING_MAX_SIZE 32
+
 // *---------------------------------------------*
 // *             FUNCTION PROTOTYPES             *
 // *---------------------------------------------*
 
 bool number_is_integer(double number);
+int number_to_string(double number, char *buffer);
+bool number_parse(char const *string, int length, double *result);
 
 #endif // NUMBER_H
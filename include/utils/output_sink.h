@@ -0,0 +1,76 @@
+#ifndef OUTPUT_SINK_H
+#define OUTPUT_SINK_H
+
+#include <assert.h>
+#include <stdbool.h>
+#include <stddef.h>
+#include <stdio.h>
+#include <string.h>
+
+// *---------------------------------------------*
+// *              MACRO DEFINITIONS              *
+// *---------------------------------------------*
+
+#define OUTPUT_SINK_BUFFER_SIZE (64 * 1024)
+
+// *---------------------------------------------*
+// *              TYPE DEFINITIONS               *
+// *---------------------------------------------*
+
+/// Writer thread draining sink output (opaque).
+typedef struct OutputSinkAsyncWriter OutputSinkAsyncWriter;
+
+/// Buffered writer batching output destined for a stream into as few system calls as possible.
+/// @note Sink bypasses stream's own buffering; mixing sink and stream writes requires flushing sink in between.
+typedef struct {
+  FILE *stream;
+  int stream_fd; // -1 if stream lacks file descriptor (POSIX only)
+  char *buffer; // OUTPUT_SINK_BUFFER_SIZE bytes
+  size_t count;
+  OutputSinkAsyncWriter *async_writer; // NULL unless sink is asynchronous
+  bool is_failure_tolerant; // failed writes get recorded into `write_errno` instead of terminating the process
+  int write_errno; // errno of the first failed write of failure tolerant sink (subsequent output gets discarded)
+} OutputSink;
+
+// *---------------------------------------------*
+// *             FUNCTION PROTOTYPES             *
+// *---------------------------------------------*
+
+void output_sink_init(OutputSink *sink, FILE *stream, bool is_async);
+void output_sink_tolerate_write_failures(OutputSink *sink);
+void output_sink_destroy(OutputSink *sink);
+void output_sink_flush(OutputSink *sink);
+void output_sink_write_overflowing(OutputSink *sink, char const *data, size_t length);
+
+// *---------------------------------------------*
+// *              INLINE FUNCTIONS               *
+// *---------------------------------------------*
+
+/// Write `data` of `length` into `sink`.
+/// @note `data` does not need to be NUL terminated.
+inline void output_sink_write(OutputSink *const sink, char const *const data, size_t const length) {
+  assert(sink != NULL);
+  assert(data != NULL || length == 0);
+
+  if (length > OUTPUT_SINK_BUFFER_SIZE - sink->count) {
+    output_sink_write_overflowing(sink, data, length);
+    return;
+  }
+
+  memcpy(sink->buffer + sink->count, data, length);
+  sink->count += length;
+}
+
+/// Write `character` into `sink`.
+inline void output_sink_write_char(OutputSink *const sink, char const character) {
+  assert(sink != NULL);
+
+  if (sink->count == OUTPUT_SINK_BUFFER_SIZE) {
+    output_sink_write_overflowing(sink, &character, 1);
+    return;
+  }
+
+  sink->buffer[sink->count++] = character;
+}
+
+#endif // OUTPUT_SINK_H
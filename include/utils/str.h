@@ -5,6 +5,7 @@
 
 #include <assert.h>
 #include <stdbool.h>
+#include <stdint.h>
 #include <stdlib.h>
 
 // *---------------------------------------------*
@@ -16,6 +17,12 @@
 /// @result Length of `string` character array.
 #define STR_ARRAY_LENGTH(string) (sizeof(string) - 1)
 
+/// 32-bit FNV-1a offset basis.
+#define STR_FNV1A_OFFSET_BASIS 2166136261u
+
+/// 32-bit FNV-1a prime.
+#define STR_FNV1A_PRIME 16777619u
+
 // *---------------------------------------------*
 // *              INLINE FUNCTIONS               *
 // *---------------------------------------------*
@@ -45,4 +52,19 @@ inline size_t str_count_lines(char const *string) {
   return line_count;
 }
 
+/// Hash `length` characters of `string` with 32-bit FNV-1a.
+/// @note `string` does not need to be NUL terminated.
+/// @return `string` hash.
+inline uint32_t str_hash(char const *const string, size_t const length) {
+  assert(string != NULL || length == 0);
+
+  uint32_t hash = STR_FNV1A_OFFSET_BASIS;
+  for (size_t i = 0; i < length; i++) {
+    hash ^= (unsigned char)string[i];
+    hash *= STR_FNV1A_PRIME;
+  }
+
+  return hash;
+}
+
 #endif // STR_H
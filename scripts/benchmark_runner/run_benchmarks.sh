@@ -0,0 +1,113 @@
+#!/usr/bin/env bash
+
+source "$(dirname "$0")/../common.sh"
+
+# to get info on this script run it with '-h' flag
+
+##################################################
+#                GLOBAL VARIABLES                #
+##################################################
+
+readonly SCRIPT_NAME=$(basename "$0")
+
+readonly BENCHMARKS_DIR='benchmarks'
+readonly BIN_DIR='bin'
+
+readonly INVALID_FLAG_ERROR_CODE=2
+readonly MAKE_FAILURE_ERROR_CODE=3
+readonly BENCHMARK_FAILURE_ERROR_CODE=4
+
+readonly MANUAL="
+NAME
+       $SCRIPT_NAME - run cla benchmarks
+
+SYNOPSIS
+       $SCRIPT_NAME [-h] [pattern]...
+
+DESCRIPTION
+       Build and run cla benchmarks (executables made out of '${BENCHMARKS_DIR}/**/*_bench.c' files).
+
+       All benchmarks are executed by default.
+       User can narrow them down by supplying pattern arguments.
+       In such case, only benchmarks whose file paths contain at least one pattern will be executed.
+
+       Each benchmark is repeated several times; reported results come from the fastest repetition.
+
+OPTIONS
+       -h
+           Get help, print out the manual and exit.
+
+EXIT CODES
+       Exit code indicates whether $SCRIPT_NAME successfully executed, or failed for some reason.
+       Different exit codes indicate different failure causes:
+
+       0  $SCRIPT_NAME successfully run, without raising any exceptions.
+
+       $GENERIC_ERROR_CODE  Generic (unspecified on this list) failure occurred.
+
+       $INVALID_FLAG_ERROR_CODE  Invalid flag supplied.
+
+       $MAKE_FAILURE_ERROR_CODE  Make failure occurred.
+
+       $BENCHMARK_FAILURE_ERROR_CODE  Benchmark failure occurred.
+
+       $INTERNAL_ERROR_CODE  Developer fuc**d up, blame him!
+"
+
+##################################################
+#               UTILITY FUNCTIONS                #
+##################################################
+
+# Print global MANUAL variable.
+print_manual() {
+  [[ $# -ne 0 ]] && internal_error "print_manual() expects no arguments"
+
+  echo "$MANUAL" | sed -e '1d' -e '$d'
+}
+
+# Determine whether `benchmark_filepath` matches at least one of `patterns` (empty `patterns` match everything).
+# @return 0 if it does, 1 otherwise.
+matches_patterns() {
+  [[ $# -lt 1 ]] && internal_error "matches_patterns() expects 'benchmark_filepath' and 'patterns' arguments"
+
+  local -r benchmark_filepath="$1"
+  shift
+
+  [[ $# -eq 0 ]] && return 0
+
+  local pattern
+  for pattern in "$@"; do
+    [[ "$benchmark_filepath" == *"$pattern"* ]] && return 0
+  done
+
+  return 1
+}
+
+##################################################
+#             EXECUTION ENTRY POINT              #
+##################################################
+
+# handle flags
+while getopts ':h' FLAG; do
+  case "$FLAG" in
+  h) print_manual && exit 0 ;;
+  ?) error "Invalid flag '-${OPTARG}' supplied" $INVALID_FLAG_ERROR_CODE ;;
+  esac
+done
+
+# remove flags, leaving script arguments
+shift $((OPTIND - 1))
+
+make benchmarks 1>/dev/null || exit $MAKE_FAILURE_ERROR_CODE
+
+BENCHMARK_FILEPATHS=$(find "$BENCHMARKS_DIR" -type f -name '*_bench.c' | sort)
+readonly BENCHMARK_FILEPATHS
+
+for BENCHMARK_FILEPATH in $BENCHMARK_FILEPATHS; do
+  matches_patterns "$BENCHMARK_FILEPATH" "$@" || continue
+
+  echo "# ${BENCHMARK_FILEPATH}"
+  "./${BIN_DIR}/benchmarks/${BENCHMARK_FILEPATH::-2}" || exit $BENCHMARK_FAILURE_ERROR_CODE # remove '.c' extension
+done
+
+exit 0
@@ -1,7 +1,5 @@
 #include "backend/chunk.h"
 
-#include "backend/gc.h"
-#include "global.h"
 #include "utils/error.h"
 #include "utils/memory.h"
 
@@ -14,6 +12,8 @@
 // *---------------------------------------------*
 
 void chunk_reset(Chunk *chunk);
+ChunkCheckpoint chunk_make_checkpoint(Chunk const *chunk);
+void chunk_rollback(Chunk *chunk, ChunkCheckpoint const *checkpoint);
 
 // *---------------------------------------------*
 // *         INTERNAL-LINKAGE FUNCTIONS          *
@@ -45,8 +45,8 @@ static inline int32_t chunk_append_constant(Chunk *const chunk, Value const valu
 void chunk_init(Chunk *const chunk) {
   assert(chunk != NULL);
 
-  DARRAY_INIT(&chunk->code, sizeof(uint8_t), gc_memory_manage);
-  DARRAY_INIT(&chunk->lines, sizeof(ChunkLineCount), gc_memory_manage);
+  DARRAY_INIT(&chunk->code, sizeof(uint8_t), memory_manage);
+  DARRAY_INIT(&chunk->lines, sizeof(ChunkLineCount), memory_manage);
   value_list_init(&chunk->constants);
 }
 
@@ -106,22 +106,98 @@ void chunk_append_multibyte_operand(Chunk *const chunk, int byte_count, ...) {
 }
 
 /// Append `value` constant and corresponding instruction along with its `line` to `chunk`.
-void chunk_append_constant_instruction(Chunk *const chunk, Value const value, int32_t const line) {
+/// @return true if appending succeeded, false if `chunk` constant pool is full (`chunk` is left unchanged).
+bool chunk_append_constant_instruction(Chunk *const chunk, Value const value, int32_t const line) {
   assert(chunk != NULL);
 
+  if (chunk->constants.count == CHUNK_MAX_CONSTANT_COUNT) return false;
   uint32_t const constant_index = chunk_append_constant(chunk, value);
 
-  if (constant_index > 0xFFFFul)
-    ERROR_MEMORY(COMMON_FILE_LINE_FORMAT COMMON_MS "Exceeded chunk constant pool limit", g_source_file_path, line);
-
   if (constant_index > UCHAR_MAX) {
     chunk_append_instruction(chunk, CHUNK_OP_CONSTANT_2B, line);
     chunk_append_multibyte_operand(chunk, 2, memory_get_byte(constant_index, 0), memory_get_byte(constant_index, 1));
-    return;
+    return true;
   }
 
   chunk_append_instruction(chunk, CHUNK_OP_CONSTANT, line);
   chunk_append_operand(chunk, constant_index);
+  return true;
+}
+
+/// Append `source` chunk instructions to `destination`, merging `source` constants and lines into `destination` ones.
+/// @note Constant instructions are re-encoded, as their constant indices change.
+/// @return 0 if appending succeeded, line of `source` constant instruction that didn't fit into `destination` constant
+/// pool otherwise (`destination` is then left partially appended).
+int32_t chunk_append_chunk(Chunk *const destination, Chunk const *const source) {
+  assert(destination != NULL);
+  assert(source != NULL);
+  assert(destination != source);
+
+  size_t line_index = 0;
+  int line_instruction_index = 0;
+
+  for (size_t offset = 0; offset < source->code.count;) {
+    assert(line_index < source->lines.count && "Expected every instruction to have a line");
+    int32_t const line = source->lines.data[line_index].line;
+    if (++line_instruction_index == source->lines.data[line_index].count) {
+      line_index++;
+      line_instruction_index = 0;
+    }
+
+    uint8_t const opcode = source->code.data[offset];
+
+    static_assert(CHUNK_OP_OPCODE_COUNT == 24, "Exhaustive ChunkOpCode handling");
+    switch (opcode) {
+      case CHUNK_OP_RETURN:
+      case CHUNK_OP_PRINT:
+      case CHUNK_OP_POP:
+      case CHUNK_OP_NEGATE:
+      case CHUNK_OP_ADD:
+      case CHUNK_OP_SUBTRACT:
+      case CHUNK_OP_MULTIPLY:
+      case CHUNK_OP_DIVIDE:
+      case CHUNK_OP_MODULO:
+      case CHUNK_OP_NOT:
+      case CHUNK_OP_NIL:
+      case CHUNK_OP_TRUE:
+      case CHUNK_OP_FALSE:
+      case CHUNK_OP_EQUAL:
+      case CHUNK_OP_NOT_EQUAL:
+      case CHUNK_OP_LESS:
+      case CHUNK_OP_LESS_EQUAL:
+      case CHUNK_OP_GREATER:
+      case CHUNK_OP_GREATER_EQUAL:
+      case CHUNK_OP_CONCATENATE: {
+        chunk_append_instruction(destination, opcode, line);
+        offset += 1;
+        break;
+      }
+      case CHUNK_OP_CONSTANT: {
+        uint8_t const constant_index = source->code.data[offset + 1];
+        if (!chunk_append_constant_instruction(destination, source->constants.data[constant_index], line)) return line;
+        offset += 2;
+        break;
+      }
+      case CHUNK_OP_CONSTANT_2B: {
+        uint8_t const constant_index_LSB = source->code.data[offset + 1];
+        uint8_t const constant_index_MSB = source->code.data[offset + 2];
+        uint32_t const constant_index = memory_concatenate_bytes(2, constant_index_MSB, constant_index_LSB);
+        if (!chunk_append_constant_instruction(destination, source->constants.data[constant_index], line)) return line;
+        offset += 3;
+        break;
+      }
+      case CHUNK_OP_CONCATENATE_N:
+      case CHUNK_OP_INPUT: {
+        chunk_append_instruction(destination, opcode, line);
+        chunk_append_operand(destination, source->code.data[offset + 1]);
+        offset += 2;
+        break;
+      }
+      default: ERROR_INTERNAL("Unknown chunk opcode '%d'", opcode);
+    }
+  }
+
+  return 0;
 }
 
 /// Get line corresponding to `chunk` instruction located at byte `offset`.
@@ -136,7 +212,7 @@ int32_t chunk_get_instruction_line(Chunk const *const chunk, int32_t const offse
   int32_t instruction_index = 0;
   int32_t loop_offset = 0;
 
-  static_assert(CHUNK_OP_OPCODE_COUNT == 22, "Exhaustive ChunkOpCode handling");
+  static_assert(CHUNK_OP_OPCODE_COUNT == 24, "Exhaustive ChunkOpCode handling");
   while (loop_offset < offset) {
     switch (chunk->code.data[loop_offset]) {
       case CHUNK_OP_RETURN:
@@ -162,7 +238,9 @@ int32_t chunk_get_instruction_line(Chunk const *const chunk, int32_t const offse
         loop_offset += 1;
         break;
       }
-      case CHUNK_OP_CONSTANT: {
+      case CHUNK_OP_CONSTANT:
+      case CHUNK_OP_CONCATENATE_N:
+      case CHUNK_OP_INPUT: {
         loop_offset += 2;
         break;
       }
@@ -0,0 +1,501 @@
+#include "backend/columnar.h"
+
+#include "utils/error.h"
+#include "utils/memory.h"
+
+#include <assert.h>
+#include <math.h>
+#include <stdbool.h>
+#include <stdlib.h>
+#include <string.h>
+
+// *---------------------------------------------*
+// *              MACRO DEFINITIONS              *
+// *---------------------------------------------*
+
+/// Define function applying `expression` (of `a` and `b` operand elements) over a block of rows.
+#define DEFINE_BLOCK_OPERATION(name, expression)                                                            \
+  static void name(double *restrict const result, double const *const a_column, double const *const b_column) { \
+    for (int i = 0; i < COLUMNAR_BLOCK_ROW_COUNT; i++) {                                                  \
+      double const a = a_column[i];                                                                        \
+      double const b = b_column[i];                                                                        \
+      result[i] = (expression);                                                                            \
+    }                                                                                                      \
+  }
+
+// *---------------------------------------------*
+// *              TYPE DEFINITIONS               *
+// *---------------------------------------------*
+
+/// Evaluation stack entry, holding values of a block of rows (all of them have the same type, as inputs are numbers).
+typedef struct {
+  ValueType type;
+  double const *numbers; // number, or bool (1 or 0) of every row; NULL for nil columns
+} ColumnarColumn;
+
+/// Function applying binary operation over a block of rows.
+typedef void(ColumnarOperationFn)(double *restrict result, double const *a_column, double const *b_column);
+
+/// Vectorized evaluation state.
+typedef struct {
+  VM *vm;
+  Chunk const *chunk;
+  ColumnarBatch const *batch;
+  ColumnarColumn *stack;
+  double *buffers; // two blocks per stack slot (result of slot operation never overwrites its operands)
+  double *padded_inputs; // input columns of the last (partial) block, padded to COLUMNAR_BLOCK_ROW_COUNT rows
+  ptrdiff_t failure_offsets[COLUMNAR_BLOCK_ROW_COUNT]; // instruction that block row failed at (-1 if it didn't)
+  ptrdiff_t type_error_offset; // instruction failing every row due to its operand types (-1 if there's none)
+  ValueType type_error_operand_types[2];
+} ColumnarEvaluation;
+
+// *---------------------------------------------*
+// *         INTERNAL-LINKAGE FUNCTIONS          *
+// *---------------------------------------------*
+
+/// Negate every `column` number over a block of rows.
+static void negate_block(double *restrict const result, double const *const column) {
+  for (int i = 0; i < COLUMNAR_BLOCK_ROW_COUNT; i++) result[i] = -column[i];
+}
+
+/// Logically negate every `column` bool (1 or 0) over a block of rows.
+static void not_block(double *restrict const result, double const *const column) {
+  for (int i = 0; i < COLUMNAR_BLOCK_ROW_COUNT; i++) result[i] = column[i] == 0;
+}
+
+DEFINE_BLOCK_OPERATION(add_block, a + b)
+DEFINE_BLOCK_OPERATION(subtract_block, a - b)
+DEFINE_BLOCK_OPERATION(multiply_block, a * b)
+DEFINE_BLOCK_OPERATION(divide_block, a / b)
+DEFINE_BLOCK_OPERATION(modulo_block, fmod(a, b))
+DEFINE_BLOCK_OPERATION(equal_block, a == b)
+DEFINE_BLOCK_OPERATION(not_equal_block, a != b)
+DEFINE_BLOCK_OPERATION(less_block, a < b)
+DEFINE_BLOCK_OPERATION(less_equal_block, a <= b)
+DEFINE_BLOCK_OPERATION(greater_block, a > b)
+DEFINE_BLOCK_OPERATION(greater_equal_block, a >= b)
+
+/// Determine whether `chunk` can be evaluated in vectorized mode by VM with `input_count` input slots; that is, it
+/// consists of a single expression operating on numbers, bools and nils (terminated with RETURN).
+/// @param max_stack_depth Receives maximum depth that evaluation stack reaches.
+/// @return true if it can, false otherwise.
+static bool is_vectorizable(Chunk const *const chunk, int const input_count, int *const max_stack_depth) {
+  assert(chunk != NULL);
+  assert(max_stack_depth != NULL);
+
+  int stack_depth = 0;
+  *max_stack_depth = 0;
+
+  for (size_t offset = 0; offset < chunk->code.count;) {
+    uint8_t const opcode = chunk->code.data[offset];
+
+    static_assert(CHUNK_OP_OPCODE_COUNT == 24, "Exhaustive ChunkOpCode handling");
+    switch (opcode) {
+      case CHUNK_OP_RETURN: return stack_depth == 1;
+      case CHUNK_OP_PRINT:
+      case CHUNK_OP_POP:
+      case CHUNK_OP_CONCATENATE:
+      case CHUNK_OP_CONCATENATE_N: return false;
+      case CHUNK_OP_CONSTANT:
+      case CHUNK_OP_CONSTANT_2B: {
+        uint32_t const constant_index =
+          opcode == CHUNK_OP_CONSTANT
+            ? chunk->code.data[offset + 1]
+            : memory_concatenate_bytes(2, chunk->code.data[offset + 2], chunk->code.data[offset + 1]);
+        if (chunk->constants.data[constant_index].type == VALUE_OBJECT) return false;
+
+        stack_depth++;
+        offset += opcode == CHUNK_OP_CONSTANT ? 2 : 3;
+        break;
+      }
+      case CHUNK_OP_INPUT: {
+        assert(chunk->code.data[offset + 1] < input_count && "Expected input slot to be declared by VM configuration");
+        stack_depth++;
+        offset += 2;
+        break;
+      }
+      case CHUNK_OP_NIL:
+      case CHUNK_OP_TRUE:
+      case CHUNK_OP_FALSE: {
+        stack_depth++;
+        offset += 1;
+        break;
+      }
+      case CHUNK_OP_NEGATE:
+      case CHUNK_OP_NOT: {
+        offset += 1;
+        break;
+      }
+      case CHUNK_OP_ADD:
+      case CHUNK_OP_SUBTRACT:
+      case CHUNK_OP_MULTIPLY:
+      case CHUNK_OP_DIVIDE:
+      case CHUNK_OP_MODULO:
+      case CHUNK_OP_EQUAL:
+      case CHUNK_OP_NOT_EQUAL:
+      case CHUNK_OP_LESS:
+      case CHUNK_OP_LESS_EQUAL:
+      case CHUNK_OP_GREATER:
+      case CHUNK_OP_GREATER_EQUAL: {
+        stack_depth--;
+        offset += 1;
+        break;
+      }
+      default: ERROR_INTERNAL("Unknown chunk opcode '%d'", opcode);
+    }
+
+    if (stack_depth > *max_stack_depth) *max_stack_depth = stack_depth;
+  }
+
+  return false;
+}
+
+/// Get `evaluation` block buffer of stack slot at `depth`, that doesn't hold `operand` numbers.
+/// @return Block buffer.
+static double *get_result_buffer(ColumnarEvaluation const *const evaluation, int const depth, double const *operand) {
+  double *const buffer = evaluation->buffers + (size_t)depth * 2 * COLUMNAR_BLOCK_ROW_COUNT;
+  return buffer == operand ? buffer + COLUMNAR_BLOCK_ROW_COUNT : buffer;
+}
+
+/// Push `value` column onto `evaluation` stack at `depth`, broadcasting `value` over block rows.
+static void push_value(ColumnarEvaluation *const evaluation, int const depth, Value const value) {
+  assert(value.type != VALUE_OBJECT);
+
+  ColumnarColumn *const column = &evaluation->stack[depth];
+  column->type = value.type;
+  if (value.type == VALUE_NIL) {
+    column->numbers = NULL;
+    return;
+  }
+
+  double *const numbers = get_result_buffer(evaluation, depth, NULL);
+  double const number = value.type == VALUE_NUMBER ? value.as.number : value.as.boolean;
+  for (int i = 0; i < COLUMNAR_BLOCK_ROW_COUNT; i++) numbers[i] = number;
+  column->numbers = numbers;
+}
+
+/// Fail every `evaluation` block row (that hasn't failed yet) at instruction located at `offset`, whose operands are
+/// of `a_type` and `b_type` (VALUE_TYPE_COUNT for unary instructions).
+static void fail_block(
+  ColumnarEvaluation *const evaluation, ptrdiff_t const offset, ValueType const a_type, ValueType const b_type
+) {
+  evaluation->type_error_offset = offset;
+  evaluation->type_error_operand_types[0] = a_type;
+  evaluation->type_error_operand_types[1] = b_type;
+
+  for (int i = 0; i < COLUMNAR_BLOCK_ROW_COUNT; i++) {
+    if (evaluation->failure_offsets[i] == -1) evaluation->failure_offsets[i] = offset;
+  }
+}
+
+/// Fail `evaluation` block rows (that haven't failed yet) whose `divisor_column` number is zero, at instruction
+/// located at `offset`.
+static void fail_rows_with_zero_divisor(
+  ColumnarEvaluation *const evaluation, ptrdiff_t const offset, double const *const divisor_column
+) {
+  int zero_divisor_count = 0;
+  for (int i = 0; i < COLUMNAR_BLOCK_ROW_COUNT; i++) zero_divisor_count += divisor_column[i] == 0;
+  if (zero_divisor_count == 0) return;
+
+  for (int i = 0; i < COLUMNAR_BLOCK_ROW_COUNT; i++) {
+    if (divisor_column[i] == 0 && evaluation->failure_offsets[i] == -1) evaluation->failure_offsets[i] = offset;
+  }
+}
+
+/// Get block operation applied by binary numeric `opcode`.
+/// @return Operation function.
+static ColumnarOperationFn *get_numeric_operation(uint8_t const opcode) {
+  switch (opcode) {
+    case CHUNK_OP_ADD: return add_block;
+    case CHUNK_OP_SUBTRACT: return subtract_block;
+    case CHUNK_OP_MULTIPLY: return multiply_block;
+    case CHUNK_OP_DIVIDE: return divide_block;
+    case CHUNK_OP_MODULO: return modulo_block;
+    case CHUNK_OP_LESS: return less_block;
+    case CHUNK_OP_LESS_EQUAL: return less_equal_block;
+    case CHUNK_OP_GREATER: return greater_block;
+    case CHUNK_OP_GREATER_EQUAL: return greater_equal_block;
+
+    default: ERROR_INTERNAL("Unknown binary numeric chunk opcode '%d'", opcode);
+  }
+}
+
+/// Evaluate `evaluation` chunk over block of rows beginning at `first_row`, whose inputs are `input_columns`, and write
+/// expression values of `row_count` rows into result column (evaluation of padding rows gets discarded).
+/// Block evaluation stops at instruction failing every row due to its operand types (see fail_block).
+static void evaluate_block(
+  ColumnarEvaluation *const evaluation, double const *const *const input_columns, size_t const first_row,
+  int const row_count
+) {
+  Chunk const *const chunk = evaluation->chunk;
+  ColumnarColumn *const stack = evaluation->stack;
+  uint8_t const *ip = chunk->code.data;
+  int depth = 0;
+
+  for (int i = 0; i < COLUMNAR_BLOCK_ROW_COUNT; i++) evaluation->failure_offsets[i] = -1;
+
+  for (;;) {
+    ptrdiff_t const offset = ip - chunk->code.data;
+    uint8_t const opcode = *ip++;
+
+    static_assert(CHUNK_OP_OPCODE_COUNT == 24, "Exhaustive ChunkOpCode handling");
+    switch (opcode) {
+      case CHUNK_OP_RETURN: {
+        ColumnarColumn const result = stack[0];
+        Value *const result_column = evaluation->batch->result_column + first_row;
+
+        for (int i = 0; i < row_count; i++) {
+          if (evaluation->failure_offsets[i] != -1 || result.type == VALUE_NIL) result_column[i] = value_make_nil();
+          else if (result.type == VALUE_BOOL) result_column[i] = value_make_bool(result.numbers[i] != 0);
+          else result_column[i] = value_make_number(result.numbers[i]);
+        }
+        return;
+      }
+      case CHUNK_OP_CONSTANT: {
+        push_value(evaluation, depth++, chunk->constants.data[*ip++]);
+        break;
+      }
+      case CHUNK_OP_CONSTANT_2B: {
+        uint32_t const constant_index = memory_concatenate_bytes(2, ip[1], ip[0]);
+        ip += 2;
+        push_value(evaluation, depth++, chunk->constants.data[constant_index]);
+        break;
+      }
+      case CHUNK_OP_NIL: {
+        push_value(evaluation, depth++, value_make_nil());
+        break;
+      }
+      case CHUNK_OP_TRUE: {
+        push_value(evaluation, depth++, value_make_bool(true));
+        break;
+      }
+      case CHUNK_OP_FALSE: {
+        push_value(evaluation, depth++, value_make_bool(false));
+        break;
+      }
+      case CHUNK_OP_INPUT: {
+        stack[depth++] = (ColumnarColumn){.type = VALUE_NUMBER, .numbers = input_columns[*ip++]};
+        break;
+      }
+      case CHUNK_OP_NEGATE: {
+        ColumnarColumn *const operand = &stack[depth - 1];
+        if (operand->type != VALUE_NUMBER) {
+          fail_block(evaluation, offset, operand->type, VALUE_TYPE_COUNT);
+          return;
+        }
+
+        double *restrict const result = get_result_buffer(evaluation, depth - 1, operand->numbers);
+        negate_block(result, operand->numbers);
+        operand->numbers = result;
+        break;
+      }
+      case CHUNK_OP_NOT: {
+        ColumnarColumn *const operand = &stack[depth - 1];
+        if (operand->type != VALUE_BOOL) {
+          // numbers are truthy, nils are falsy
+          push_value(evaluation, depth - 1, value_make_bool(operand->type == VALUE_NIL));
+          break;
+        }
+
+        double *restrict const result = get_result_buffer(evaluation, depth - 1, operand->numbers);
+        not_block(result, operand->numbers);
+        operand->numbers = result;
+        break;
+      }
+      case CHUNK_OP_EQUAL:
+      case CHUNK_OP_NOT_EQUAL: {
+        ColumnarColumn *const a = &stack[depth - 2];
+        ColumnarColumn const b = stack[--depth];
+        bool const is_equal_opcode = opcode == CHUNK_OP_EQUAL;
+
+        if (a->type != b.type || a->type == VALUE_NIL) {
+          // values of different types are never equal, whereas nils always are
+          push_value(evaluation, depth - 1, value_make_bool((a->type == b.type) == is_equal_opcode));
+          break;
+        }
+
+        double *restrict const result = get_result_buffer(evaluation, depth - 1, a->numbers);
+        (is_equal_opcode ? equal_block : not_equal_block)(result, a->numbers, b.numbers);
+        *a = (ColumnarColumn){.type = VALUE_BOOL, .numbers = result};
+        break;
+      }
+      case CHUNK_OP_ADD:
+      case CHUNK_OP_SUBTRACT:
+      case CHUNK_OP_MULTIPLY:
+      case CHUNK_OP_DIVIDE:
+      case CHUNK_OP_MODULO:
+      case CHUNK_OP_LESS:
+      case CHUNK_OP_LESS_EQUAL:
+      case CHUNK_OP_GREATER:
+      case CHUNK_OP_GREATER_EQUAL: {
+        ColumnarColumn *const a = &stack[depth - 2];
+        ColumnarColumn const b = stack[--depth];
+        if (a->type != VALUE_NUMBER || b.type != VALUE_NUMBER) {
+          fail_block(evaluation, offset, a->type, b.type);
+          return;
+        }
+        if (opcode == CHUNK_OP_DIVIDE || opcode == CHUNK_OP_MODULO) {
+          fail_rows_with_zero_divisor(evaluation, offset, b.numbers);
+        }
+
+        double *restrict const result = get_result_buffer(evaluation, depth - 1, a->numbers);
+        get_numeric_operation(opcode)(result, a->numbers, b.numbers);
+
+        bool const is_comparison = opcode != CHUNK_OP_ADD && opcode != CHUNK_OP_SUBTRACT &&
+                                   opcode != CHUNK_OP_MULTIPLY && opcode != CHUNK_OP_DIVIDE &&
+                                   opcode != CHUNK_OP_MODULO;
+        *a = (ColumnarColumn){.type = is_comparison ? VALUE_BOOL : VALUE_NUMBER, .numbers = result};
+        break;
+      }
+      default: ERROR_INTERNAL("Unknown chunk opcode '%d'", opcode);
+    }
+  }
+}
+
+/// Report failure of `evaluation` row, that failed at instruction located at `offset`.
+static void report_row_failure(ColumnarEvaluation const *const evaluation, ptrdiff_t const offset) {
+  VM *const vm = evaluation->vm;
+  uint8_t const opcode = evaluation->chunk->code.data[offset];
+  ValueType const *const types = evaluation->type_error_operand_types;
+
+  if (offset != evaluation->type_error_offset) {
+    assert(opcode == CHUNK_OP_DIVIDE || opcode == CHUNK_OP_MODULO);
+    vm_error_at(vm, offset, opcode == CHUNK_OP_DIVIDE ? "Illegal division by zero" : "Illegal modulo by zero");
+    return;
+  }
+
+  // messages match the ones reported by vm_execute
+  char const *const a_type = value_get_type_string((Value){.type = types[0]});
+  if (opcode == CHUNK_OP_NEGATE) {
+    vm_error_at(vm, offset, "Expected negation operand to be a number (got '%s')", a_type);
+    return;
+  }
+
+  char const *operation_name;
+  switch (opcode) {
+    case CHUNK_OP_ADD: operation_name = "addition"; break;
+    case CHUNK_OP_SUBTRACT: operation_name = "subtraction"; break;
+    case CHUNK_OP_MULTIPLY: operation_name = "multiplication"; break;
+    case CHUNK_OP_DIVIDE: operation_name = "division"; break;
+    case CHUNK_OP_MODULO: operation_name = "modulo"; break;
+    case CHUNK_OP_LESS: operation_name = "less-than"; break;
+    case CHUNK_OP_LESS_EQUAL: operation_name = "less-than-or-equal"; break;
+    case CHUNK_OP_GREATER: operation_name = "greater-than"; break;
+    case CHUNK_OP_GREATER_EQUAL: operation_name = "greater-than-or-equal"; break;
+
+    default: ERROR_INTERNAL("Unknown binary numeric chunk opcode '%d'", opcode);
+  }
+  vm_error_at(
+    vm, offset, "Expected %s operands to be numbers (got '%s' and '%s')", operation_name, a_type,
+    value_get_type_string((Value){.type = types[1]})
+  );
+}
+
+/// Evaluate `chunk` over `batch` rows by `vm` in vectorized mode (see is_vectorizable), one instruction over a block
+/// of rows at a time.
+/// @return Number of rows whose evaluation failed.
+static size_t evaluate_vectorized(
+  VM *const vm, Chunk const *const chunk, ColumnarBatch const *const batch, int const max_stack_depth
+) {
+  int const input_count = vm->config.input_count;
+  ColumnarEvaluation evaluation = {.vm = vm, .chunk = chunk, .batch = batch};
+
+  evaluation.stack = malloc(sizeof(ColumnarColumn) * max_stack_depth);
+  evaluation.buffers = malloc(sizeof(double) * 2 * COLUMNAR_BLOCK_ROW_COUNT * max_stack_depth);
+  evaluation.padded_inputs = calloc((size_t)input_count * COLUMNAR_BLOCK_ROW_COUNT, sizeof(double));
+  if (evaluation.stack == NULL || evaluation.buffers == NULL) ERROR_MEMORY_ERRNO();
+  if (evaluation.padded_inputs == NULL && input_count > 0) ERROR_MEMORY_ERRNO();
+
+  double const *input_columns[VM_MAX_INPUT_COUNT];
+  size_t failed_row_count = 0;
+
+  vm->chunk = chunk; // errors are reported against it
+  for (size_t first_row = 0; first_row < batch->row_count; first_row += COLUMNAR_BLOCK_ROW_COUNT) {
+    size_t const remaining_row_count = batch->row_count - first_row;
+    int const row_count =
+      remaining_row_count < COLUMNAR_BLOCK_ROW_COUNT ? remaining_row_count : COLUMNAR_BLOCK_ROW_COUNT;
+
+    for (int i = 0; i < input_count; i++) {
+      if (row_count == COLUMNAR_BLOCK_ROW_COUNT) input_columns[i] = batch->input_columns[i] + first_row;
+      else {
+        double *const padded_input = evaluation.padded_inputs + (size_t)i * COLUMNAR_BLOCK_ROW_COUNT;
+        memcpy(padded_input, batch->input_columns[i] + first_row, sizeof(double) * row_count);
+        input_columns[i] = padded_input;
+      }
+    }
+
+    evaluation.type_error_offset = -1;
+    evaluate_block(&evaluation, input_columns, first_row, row_count);
+
+    // failures are reported in row order
+    for (int i = 0; i < row_count; i++) {
+      bool const is_failed = evaluation.failure_offsets[i] != -1;
+      if (batch->failure_column != NULL) batch->failure_column[first_row + i] = is_failed;
+      if (!is_failed) continue;
+
+      batch->result_column[first_row + i] = value_make_nil();
+      report_row_failure(&evaluation, evaluation.failure_offsets[i]);
+      failed_row_count++;
+    }
+  }
+
+  free(evaluation.padded_inputs);
+  free(evaluation.buffers);
+  free(evaluation.stack);
+
+  return failed_row_count;
+}
+
+/// Evaluate `chunk` over `batch` rows by `vm`, executing it once per row.
+/// @return Number of rows whose evaluation failed.
+static size_t evaluate_row_by_row(VM *const vm, Chunk const *const chunk, ColumnarBatch const *const batch) {
+  int const input_count = vm->config.input_count;
+  Value row_inputs[VM_MAX_INPUT_COUNT];
+  size_t failed_row_count = 0;
+
+  for (size_t row = 0; row < batch->row_count; row++) {
+    for (int i = 0; i < input_count; i++) row_inputs[i] = value_make_number(batch->input_columns[i][row]);
+    vm->inputs = row_inputs;
+
+    size_t const stack_count = vm->stack.count;
+    bool const is_failed = !vm_execute(vm, chunk);
+    if (!is_failed) batch->result_column[row] = vm_stack_pop(vm);
+    else {
+      batch->result_column[row] = value_make_nil();
+      failed_row_count++;
+    }
+    if (batch->failure_column != NULL) batch->failure_column[row] = is_failed;
+    vm->stack.count = stack_count;
+  }
+
+  vm->inputs = NULL;
+
+  return failed_row_count;
+}
+
+// *---------------------------------------------*
+// *         EXTERNAL-LINKAGE FUNCTIONS          *
+// *---------------------------------------------*
+
+/// Evaluate expression `chunk` (see compiler_compile_expression) by `vm` over every `batch` row, whose inputs are
+/// supplied to `vm` input slots, and write expression values into `batch` result column.
+/// Chunks operating solely on numbers, bools and nils are evaluated in vectorized mode: one instruction over a block of
+/// COLUMNAR_BLOCK_ROW_COUNT rows at a time, by loops meant to be vectorized by compiler (SIMD). Remaining chunks (e.g.
+/// ones concatenating strings) are executed once per row.
+/// @note Rows whose evaluation fails are reported individually (in row order) and flagged in `batch` failure column
+/// (if there's one), and evaluation of other rows proceeds.
+/// @return Number of rows whose evaluation failed.
+size_t columnar_evaluate(VM *const vm, Chunk const *const chunk, ColumnarBatch const *const batch) {
+  assert(vm != NULL);
+  assert(chunk != NULL);
+  assert(batch != NULL);
+  assert(batch->input_columns != NULL || vm->config.input_count == 0);
+  assert(batch->result_column != NULL || batch->row_count == 0);
+
+  int max_stack_depth;
+  if (is_vectorizable(chunk, vm->config.input_count, &max_stack_depth)) {
+    return evaluate_vectorized(vm, chunk, batch, max_stack_depth);
+  }
+
+  return evaluate_row_by_row(vm, chunk, batch);
+}
@@ -2,31 +2,38 @@
 
 #include "backend/object.h"
 #include "backend/vm.h"
-#include "utils/memory.h"
+#include "utils/error.h"
+
+#include <assert.h>
 
 // *---------------------------------------------*
 // *             FUNCTION PROTOTYPES             *
 // *---------------------------------------------*
 
-void *gc_allocate(size_t new_size);
-void *gc_reallocate(void *object, size_t old_size, size_t new_size);
-void *gc_deallocate(void *object, size_t old_size);
+void *gc_allocate(VM *vm, size_t new_size);
+void *gc_reallocate(VM *vm, void *object, size_t old_size, size_t new_size);
+void *gc_deallocate(VM *vm, void *object, size_t old_size);
 
 // *---------------------------------------------*
 // *         INTERNAL-LINKAGE FUNCTIONS          *
 // *---------------------------------------------*
 
-/// Deallocate garbage-collected CLA `object`.
-static void gc_deallocate_cla_object(Object *const object) {
+/// Deallocate garbage-collected CLA `object` belonging to `vm`.
+static void gc_deallocate_cla_object(VM *const vm, Object *const object) {
+  assert(vm != NULL);
   assert(object != NULL);
 
-  static_assert(OBJECT_TYPE_COUNT == 1, "Exhaustive ObjectType handling");
+  static_assert(OBJECT_TYPE_COUNT == 2, "Exhaustive ObjectType handling");
   switch (object->type) {
     case OBJECT_STRING: {
       ObjectString const *const object_string = (ObjectString *)object;
 
-      if (object_string->is_content_owner) gc_deallocate(object_string->content, object_string->length);
-      gc_deallocate(object, sizeof(*object_string));
+      size_t const inline_content_size = object_string->is_content_owner ? object_string->length : 0;
+      gc_deallocate(vm, object, sizeof(*object_string) + inline_content_size);
+      break;
+    }
+    case OBJECT_ROPE: {
+      gc_deallocate(vm, object, sizeof(ObjectRope));
       break;
     }
 
@@ -38,21 +45,36 @@ static void gc_deallocate_cla_object(Object *const object) {
 // *        EXTERNAL-LINKAGE FUNCTIONS           *
 // *---------------------------------------------*
 
-/// Garbage collecting MemoryManagerFn implementation.
+/// Garbage collecting counterpart of MemoryManagerFn, managing `object` memory on behalf of `vm`.
+/// Memory itself is managed by `vm` object allocator, or by `vm` memory manager if it has none.
 /// @note Memory of objects tracked by garbage collector must be managed exclusively by this function (from the get-go).
 /// @see MemoryManagerFn for further documentation.
-void *gc_memory_manage(void *const object, size_t const old_size, size_t const new_size) {
+void *gc_memory_manage(VM *const vm, void *const object, size_t const old_size, size_t const new_size) {
+  assert(vm != NULL);
+
   // TODO: implement garbage collecting
 
-  return memory_manage(object, old_size, new_size);
+  MemoryAllocator const *const allocator = vm->config.object_allocator;
+  if (allocator != NULL) return allocator->manage(allocator->context, object, old_size, new_size);
+
+  return vm->config.memory_manager(object, old_size, new_size);
 }
 
-/// Deallocate garbage-collected CLA Objects belonging to VM.
-void gc_deallocate_vm_gc_objects(void) {
-  for (Object *current_object = vm.gc_objects; current_object != NULL;) {
+/// Deallocate garbage-collected CLA Objects belonging to `vm`.
+/// If `vm` object allocator supports bulk release, objects get released by resetting it (without being walked).
+void gc_deallocate_vm_gc_objects(VM *const vm) {
+  assert(vm != NULL);
+
+  MemoryAllocator const *const allocator = vm->config.object_allocator;
+  if (allocator != NULL && allocator->reset != NULL) {
+    allocator->reset(allocator->context);
+    return;
+  }
+
+  for (Object *current_object = vm->gc_objects; current_object != NULL;) {
     Object *const next_object = current_object->next;
 
-    gc_deallocate_cla_object(current_object);
+    gc_deallocate_cla_object(vm, current_object);
 
     current_object = next_object;
   }
@@ -1,80 +1,342 @@
 #include "backend/object.h"
 
 #include "backend/gc.h"
+#include "backend/string_table.h"
 #include "backend/vm.h"
+#include "utils/error.h"
 #include "utils/io.h"
+#include "utils/memory.h"
+#include "utils/output_sink.h"
+#include "utils/stack.h"
+#include "utils/str.h"
+
+#include <limits.h>
 
 // *---------------------------------------------*
-// *        EXTERNAL-LINKAGE FUNCTIONS           *
+// *             FUNCTION PROTOTYPES             *
 // *---------------------------------------------*
 
-/// Make CLA object of `size` and `type`.
-/// @return Pointer to made Object.
-Object *object_make(size_t const size, ObjectType const type) {
-  Object *const object = gc_allocate(size);
+bool object_is_string(Object const *object);
+int object_get_string_length(Object const *string);
+ObjectString *object_get_flat_string(Object *string);
+
+// *---------------------------------------------*
+// *         INTERNAL-LINKAGE FUNCTIONS          *
+// *---------------------------------------------*
+
+/// Allocate CLA object of `size` and `type` belonging to `vm` without tracking it.
+/// @return Pointer to allocated Object.
+static inline Object *object_allocate(VM *const vm, size_t const size, ObjectType const type) {
+  Object *const object = gc_allocate(vm, size);
   object->type = type;
+  object->next = NULL;
+
+  return object;
+}
+
+/// Track `object` by linking it into `vm` garbage-collected object list.
+static inline void object_track(VM *const vm, Object *const object) {
+  assert(vm != NULL);
+  assert(object != NULL);
 
-  object->next = vm.gc_objects;
-  vm.gc_objects = object;
+  object->next = vm->gc_objects;
+  vm->gc_objects = object;
+}
+
+/// Track fully initialized string `object` and intern it within `vm`.
+static inline void object_register_string(VM *const vm, ObjectString *const object) {
+  assert(vm != NULL);
+  assert(object != NULL);
+
+  object_track(vm, (Object *)object);
+  string_table_insert(&vm->strings, object);
+}
+
+/// Make flat CLA string object from `first_string` and `second_string` concatenation.
+/// @return Pointer to interned string object.
+static ObjectString *object_concatenate_flat_strings(
+  VM *const vm, ObjectString const *const first_string, ObjectString const *const second_string
+) {
+  assert(first_string != NULL);
+  assert(second_string != NULL);
+
+  ObjectString *const new_string =
+    object_make_uninitialized_owning_string(vm, first_string->length + second_string->length);
+  memcpy(new_string->inline_content, first_string->content, first_string->length);
+  memcpy(new_string->inline_content + first_string->length, second_string->content, second_string->length);
+
+  return object_intern_owning_string(vm, new_string);
+}
+
+/// Make CLA rope object from `left` and `right` string objects.
+/// @return Pointer to made rope object.
+static ObjectRope *object_make_rope(VM *const vm, Object *const left, Object *const right) {
+  assert(left != NULL);
+  assert(right != NULL);
+
+  ObjectRope *const rope = OBJECT_MAKE(vm, ObjectRope, OBJECT_ROPE);
+  rope->length = object_get_string_length(left) + object_get_string_length(right);
+  rope->left = left;
+  rope->right = right;
+  rope->flattened = NULL;
+
+  return rope;
+}
+
+// *---------------------------------------------*
+// *        EXTERNAL-LINKAGE FUNCTIONS           *
+// *---------------------------------------------*
+
+/// Make CLA object of `size` and `type` belonging to `vm`.
+/// @return Pointer to made Object.
+Object *object_make(VM *const vm, size_t const size, ObjectType const type) {
+  Object *const object = object_allocate(vm, size, type);
+  object_track(vm, object);
 
   return object;
 }
 
-/// Make CLA string object from `content` of `content_length`.
-/// Resultant string object is a `content` owner.
+/// Make CLA string object belonging to `vm` from `content` of `content_length`.
+/// Resultant string object is a `content` owner, unless string with the same content has already been interned.
 /// @note `content` does not need to be NUL terminated.
-/// @return Pointer to made string object.
-ObjectString *object_make_owning_string(char const *const content, int const content_length) {
+/// @return Pointer to interned string object.
+ObjectString *object_make_owning_string(VM *const vm, char const *const content, int const content_length) {
+  assert(vm != NULL);
   assert(content != NULL);
   assert(content_length >= 0);
 
-  ObjectString *const string_object = OBJECT_MAKE(ObjectString, OBJECT_STRING);
+  uint32_t const hash = str_hash(content, content_length);
+  ObjectString *const interned_string = string_table_find(&vm->strings, content, content_length, hash);
+  if (interned_string != NULL) return interned_string;
+
+  ObjectString *const string_object = object_make_uninitialized_owning_string(vm, content_length);
+  memcpy(string_object->inline_content, content, content_length);
+  string_object->hash = hash;
+  object_register_string(vm, string_object);
+
+  return string_object;
+}
+
+/// Make CLA string object belonging to `vm`, capable of storing `content_length` long content.
+/// Resultant string object is a content owner; its `inline_content` is left uninitialized for caller to fill.
+/// @note Resultant string object is neither interned nor tracked by the garbage collector until it gets passed to
+/// `object_intern_owning_string`.
+/// @return Pointer to made string object.
+ObjectString *object_make_uninitialized_owning_string(VM *const vm, int const content_length) {
+  assert(content_length >= 0);
+
+  ObjectString *const string_object =
+    (ObjectString *)object_allocate(vm, sizeof(ObjectString) + content_length, OBJECT_STRING);
   string_object->length = content_length;
   string_object->is_content_owner = true;
-  string_object->content = gc_allocate(content_length);
-  memcpy(string_object->content, content, content_length);
+  string_object->content = string_object->inline_content;
 
   return string_object;
 }
 
-/// Make CLA string object from `content` of `content_length`.
-/// Resultant string object is not a `content` owner.
+/// Intern `string` made by `object_make_uninitialized_owning_string` (after its `inline_content` has been filled)
+/// within `vm`. If string with the same content has already been interned, `string` gets deallocated in favor of it.
+/// @return Pointer to interned string object.
+ObjectString *object_intern_owning_string(VM *const vm, ObjectString *const string) {
+  assert(vm != NULL);
+  assert(string != NULL);
+  assert(string->is_content_owner);
+
+  uint32_t const hash = str_hash(string->content, string->length);
+  ObjectString *const interned_string = string_table_find(&vm->strings, string->content, string->length, hash);
+  if (interned_string != NULL) {
+    gc_deallocate(vm, string, sizeof(*string) + string->length);
+    return interned_string;
+  }
+
+  string->hash = hash;
+  object_register_string(vm, string);
+
+  return string;
+}
+
+/// Make CLA string object belonging to `vm` from `content` of `content_length`.
+/// Resultant string object is not a `content` owner, thus `content` must outlive `vm`.
 /// @note `content` does not need to be NUL terminated.
-/// @return Pointer to made string object.
-ObjectString *object_make_non_owning_string(char const *const content, int const content_length) {
+/// @return Pointer to interned string object.
+ObjectString *object_make_non_owning_string(VM *const vm, char const *const content, int const content_length) {
+  assert(vm != NULL);
   assert(content != NULL);
   assert(content_length >= 0);
 
-  ObjectString *const string_object = OBJECT_MAKE(ObjectString, OBJECT_STRING);
+  uint32_t const hash = str_hash(content, content_length);
+  ObjectString *const interned_string = string_table_find(&vm->strings, content, content_length, hash);
+  if (interned_string != NULL) return interned_string;
+
+  ObjectString *const string_object = (ObjectString *)object_allocate(vm, sizeof(ObjectString), OBJECT_STRING);
   string_object->length = content_length;
+  string_object->hash = hash;
   string_object->is_content_owner = false;
-  string_object->content = (char *)content;
+  string_object->content = content;
+  object_register_string(vm, string_object);
 
   return string_object;
 }
 
+/// Intern statically allocated (immortal) non-owning `string` within `vm`.
+/// Immortal strings are never tracked by the garbage collector, so they must be (re)interned on each VM initialization.
+/// @note Immortal strings are shared by all virtual machines, hence they're never written to (`string` hash must be
+/// precomputed).
+void object_intern_immortal_string(VM *const vm, ObjectString *const string) {
+  assert(vm != NULL);
+  assert(string != NULL);
+  assert(!string->is_content_owner);
+  assert(string->object.next == NULL && "Expected immortal string not to be tracked");
+  assert(string->hash == str_hash(string->content, string->length) && "Expected precomputed immortal string hash");
+
+  string_table_insert(&vm->strings, string);
+}
+
+/// Concatenate `first_string` and `second_string` objects (either flat strings or ropes) belonging to `vm`.
+/// Short results are materialized right away, whereas long ones are represented by ropes (flattened on demand).
+/// @return Pointer to string object holding concatenation result.
+Object *object_concatenate(VM *const vm, Object *const first_string, Object *const second_string) {
+  assert(first_string != NULL);
+  assert(second_string != NULL);
+
+  int const first_length = object_get_string_length(first_string);
+  int const second_length = object_get_string_length(second_string);
+  if (first_length > INT_MAX - second_length) ERROR_MEMORY("Exceeded maximum string length (%d)", INT_MAX);
+
+  ObjectString *const first_flat_string = object_get_flat_string(first_string);
+  ObjectString *const second_flat_string = object_get_flat_string(second_string);
+
+  // ropes are never shorter than OBJECT_ROPE_MIN_LENGTH, so short results always consist of flat strings
+  if (first_length + second_length < OBJECT_ROPE_MIN_LENGTH) {
+    return (Object *)object_concatenate_flat_strings(vm, first_flat_string, second_flat_string);
+  }
+
+  // coalesce short leaves, so that repeated appending/prepending of short strings doesn't yield a rope per character
+  if (first_flat_string == NULL && second_flat_string != NULL) {
+    ObjectRope *const first_rope = (ObjectRope *)first_string;
+    ObjectString *const last_leaf = object_get_flat_string(first_rope->right);
+
+    if (last_leaf != NULL && last_leaf->length + second_length < OBJECT_ROPE_MIN_LENGTH) {
+      Object *const new_last_leaf = (Object *)object_concatenate_flat_strings(vm, last_leaf, second_flat_string);
+      return (Object *)object_make_rope(vm, first_rope->left, new_last_leaf);
+    }
+  }
+  if (first_flat_string != NULL && second_flat_string == NULL) {
+    ObjectRope *const second_rope = (ObjectRope *)second_string;
+    ObjectString *const first_leaf = object_get_flat_string(second_rope->left);
+
+    if (first_leaf != NULL && first_length + first_leaf->length < OBJECT_ROPE_MIN_LENGTH) {
+      Object *const new_first_leaf = (Object *)object_concatenate_flat_strings(vm, first_flat_string, first_leaf);
+      return (Object *)object_make_rope(vm, new_first_leaf, second_rope->right);
+    }
+  }
+
+  return (Object *)object_make_rope(vm, first_string, second_string);
+}
+
+/// Flatten `string` object (either flat string or rope) belonging to `vm` into interned flat string.
+/// Flattening result gets cached in the rope, so its content is materialized at most once.
+/// @note Ropes are logically immutable (caching aside), hence `string` is accepted as const.
+/// @return Pointer to flat string object with `string` content.
+ObjectString *object_flatten_string(VM *const vm, Object const *const string) {
+  assert(string != NULL);
+  assert(object_is_string(string));
+
+  if (string->type == OBJECT_STRING) return (ObjectString *)string;
+
+  ObjectRope *const rope = (ObjectRope *)string;
+  if (rope->flattened != NULL) return rope->flattened;
+
+  ObjectString *const flattened = object_make_uninitialized_owning_string(vm, rope->length);
+
+  // ropes can be arbitrarily deep, so they're traversed iteratively (filling content from its end)
+  STACK_DEFINE(Object const *, pending_nodes, memory_manage);
+  STACK_PUSH(&pending_nodes, string);
+
+  int content_end = rope->length;
+  while (pending_nodes.count > 0) {
+    Object *const node = (Object *)STACK_POP(&pending_nodes);
+    ObjectString const *const leaf = object_get_flat_string(node);
+
+    if (leaf == NULL) {
+      STACK_PUSH(&pending_nodes, ((ObjectRope *)node)->left);
+      STACK_PUSH(&pending_nodes, ((ObjectRope *)node)->right);
+      continue;
+    }
+
+    content_end -= leaf->length;
+    memcpy(flattened->inline_content + content_end, leaf->content, leaf->length);
+  }
+  assert(content_end == 0);
+
+  STACK_DESTROY(&pending_nodes);
+
+  rope->flattened = object_intern_owning_string(vm, flattened);
+  rope->left = NULL;
+  rope->right = NULL;
+
+  return rope->flattened;
+}
+
 /// Get string with description of `object` type.
 /// @return `object` type string.
 char const *object_get_type_string(Object const *const object) {
   assert(object != NULL);
 
-  static_assert(OBJECT_TYPE_COUNT == 1, "Exhaustive ObjectType handling");
+  static_assert(OBJECT_TYPE_COUNT == 2, "Exhaustive ObjectType handling");
   switch (object->type) {
-    case OBJECT_STRING: return "string";
+    case OBJECT_STRING:
+    case OBJECT_ROPE: return "string";
 
     default: ERROR_INTERNAL("Unknown ObjectType '%d'", object->type);
   }
 }
 
-/// Print `object`.
+/// Print `object` into source program output stream.
+/// @note Meant for debugging purposes; source program output goes through `object_write`.
+/// Ropes are printed leaf by leaf, so that printing doesn't alter the virtual machine `object` belongs to.
 void object_print(Object const *const object) {
   assert(object != NULL);
 
-  static_assert(OBJECT_TYPE_COUNT == 1, "Exhaustive ObjectType handling");
+  static_assert(OBJECT_TYPE_COUNT == 2, "Exhaustive ObjectType handling");
+  switch (object->type) {
+    case OBJECT_STRING:
+    case OBJECT_ROPE: {
+      STACK_DEFINE(Object const *, pending_nodes, memory_manage);
+      STACK_PUSH(&pending_nodes, object);
+
+      while (pending_nodes.count > 0) {
+        Object *const node = (Object *)STACK_POP(&pending_nodes);
+        ObjectString const *const leaf = object_get_flat_string(node);
+
+        if (leaf == NULL) {
+          STACK_PUSH(&pending_nodes, ((ObjectRope *)node)->right);
+          STACK_PUSH(&pending_nodes, ((ObjectRope *)node)->left);
+          continue;
+        }
+
+        io_fprintf(g_source_program_output_stream, "%.*s", (int)leaf->length, leaf->content);
+      }
+
+      STACK_DESTROY(&pending_nodes);
+      break;
+    }
+
+    default: ERROR_INTERNAL("Unknown ObjectType '%d'", object->type);
+  }
+}
+
+/// Write `object` (belonging to `vm`) string representation into `sink`.
+void object_write(VM *const vm, OutputSink *const sink, Object const *const object) {
+  assert(sink != NULL);
+  assert(object != NULL);
+
+  static_assert(OBJECT_TYPE_COUNT == 2, "Exhaustive ObjectType handling");
   switch (object->type) {
-    case OBJECT_STRING: {
-      ObjectString const *const string_object = (ObjectString *)object;
-      io_fprintf(g_source_program_output_stream, "%.*s", (int)string_object->length, string_object->content);
+    case OBJECT_STRING:
+    case OBJECT_ROPE: {
+      ObjectString const *const string_object = object_flatten_string(vm, object);
+      output_sink_write(sink, string_object->content, string_object->length);
       break;
     }
 
@@ -82,22 +344,24 @@ void object_print(Object const *const object) {
   }
 }
 
-/// Determine whether `object_a` equals `object_b`.
+/// Determine whether `object_a` equals `object_b` (both belonging to `vm`).
 /// @return true if it does, false otherwise.
-bool object_equals(Object const *const object_a, Object const *const object_b) {
+bool object_equals(VM *const vm, Object const *const object_a, Object const *const object_b) {
   assert(object_a != NULL);
   assert(object_b != NULL);
 
-  if (object_a->type != object_b->type) return false;
+  // flat strings and ropes are both of string type
+  if (object_a->type != object_b->type && !(object_is_string(object_a) && object_is_string(object_b))) return false;
 
-  static_assert(OBJECT_TYPE_COUNT == 1, "Exhaustive ObjectType handling");
+  static_assert(OBJECT_TYPE_COUNT == 2, "Exhaustive ObjectType handling");
   switch (object_a->type) {
-    case OBJECT_STRING: {
-      ObjectString const *const string_object_a = (ObjectString *)object_a;
-      ObjectString const *const string_object_b = (ObjectString *)object_b;
+    case OBJECT_STRING:
+    case OBJECT_ROPE: {
+      if (object_a == object_b) return true;
+      if (object_get_string_length(object_a) != object_get_string_length(object_b)) return false;
 
-      if (string_object_a->length != string_object_b->length) return false;
-      return memcmp(string_object_a->content, string_object_b->content, string_object_a->length) == 0;
+      // flat strings are interned, so equal content implies identity
+      return object_flatten_string(vm, object_a) == object_flatten_string(vm, object_b);
     }
 
     default: ERROR_INTERNAL("Unknown ObjectType '%d'", object_a->type);
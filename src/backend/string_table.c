@@ -0,0 +1,157 @@
+#include "backend/string_table.h"
+
+#include "utils/memory.h"
+
+#include <assert.h>
+#include <string.h>
+
+// *---------------------------------------------*
+// *              MACRO DEFINITIONS              *
+// *---------------------------------------------*
+
+#define STRING_TABLE_INITIAL_CAPACITY 32
+#define STRING_TABLE_GROWTH_FACTOR 2
+
+/// Determine whether `table` holding `count` occupied entries exceeds maximum load factor (0.75).
+#define STRING_TABLE_EXCEEDS_MAX_LOAD(table, count) ((count) * 4 > (table)->capacity * 3)
+
+/// Marker occupying entries of removed strings (keeps probe sequences intact).
+#define STRING_TABLE_TOMBSTONE (&string_table_tombstone)
+
+// *---------------------------------------------*
+// *          INTERNAL-LINKAGE OBJECTS           *
+// *---------------------------------------------*
+
+static ObjectString string_table_tombstone;
+
+// *---------------------------------------------*
+// *         INTERNAL-LINKAGE FUNCTIONS          *
+// *---------------------------------------------*
+
+/// Get index of the first entry in `string` probe sequence which is either vacant, or holds a tombstone.
+/// @note `entries` must contain at least one vacant entry.
+static size_t string_table_find_insertion_index(
+  ObjectString *const *const entries, size_t const capacity, ObjectString const *const string
+) {
+  assert(entries != NULL);
+  assert(string != NULL);
+
+  for (size_t index = string->hash & (capacity - 1);; index = (index + 1) & (capacity - 1)) {
+    if (entries[index] == NULL || entries[index] == STRING_TABLE_TOMBSTONE) return index;
+  }
+}
+
+/// Grow `table` to next capacity, dropping tombstones in the process.
+static void string_table_grow(StringTable *const table) {
+  assert(table != NULL);
+
+  size_t const new_capacity =
+    table->capacity == 0 ? STRING_TABLE_INITIAL_CAPACITY : table->capacity * STRING_TABLE_GROWTH_FACTOR;
+  size_t const new_entries_size = new_capacity * sizeof(*table->entries);
+
+  ObjectString **const new_entries = memory_allocate(table->memory_manager, new_entries_size);
+  memset(new_entries, 0, new_entries_size);
+
+  size_t new_count = 0;
+  for (size_t i = 0; i < table->capacity; i++) {
+    ObjectString *const string = table->entries[i];
+    if (string == NULL || string == STRING_TABLE_TOMBSTONE) continue;
+
+    new_entries[string_table_find_insertion_index(new_entries, new_capacity, string)] = string;
+    new_count++;
+  }
+
+  memory_deallocate(table->memory_manager, table->entries, table->capacity * sizeof(*table->entries));
+
+  table->entries = new_entries;
+  table->capacity = new_capacity;
+  table->count = new_count;
+}
+
+// *---------------------------------------------*
+// *         EXTERNAL-LINKAGE FUNCTIONS          *
+// *---------------------------------------------*
+
+/// Initialize string `table`, whose entries get managed by `memory_manager`.
+/// @note Entries are allocated lazily.
+void string_table_init(StringTable *const table, MemoryManagerFn *const memory_manager) {
+  assert(table != NULL);
+  assert(memory_manager != NULL);
+
+  *table = (StringTable){.memory_manager = memory_manager};
+}
+
+/// Release string `table` resources and set it to uninitialized state.
+/// @note Stored strings are left intact.
+void string_table_destroy(StringTable *const table) {
+  assert(table != NULL);
+
+  memory_deallocate(table->memory_manager, table->entries, table->capacity * sizeof(*table->entries));
+
+  *table = (StringTable){0};
+}
+
+/// Remove every string from string `table`, retaining its capacity.
+void string_table_clear(StringTable *const table) {
+  assert(table != NULL);
+
+  if (table->capacity > 0) memset(table->entries, 0, table->capacity * sizeof(*table->entries));
+  table->count = 0;
+}
+
+/// Find string with `content` of `content_length` and `hash` in string `table`.
+/// @note `content` does not need to be NUL terminated.
+/// @return Pointer to found string or NULL if there's none.
+ObjectString *string_table_find(
+  StringTable const *const table, char const *const content, int const content_length, uint32_t const hash
+) {
+  assert(table != NULL);
+  assert(content != NULL);
+  assert(content_length >= 0);
+
+  if (table->capacity == 0) return NULL;
+
+  for (size_t index = hash & (table->capacity - 1);; index = (index + 1) & (table->capacity - 1)) {
+    ObjectString *const string = table->entries[index];
+
+    if (string == NULL) return NULL;
+    if (string == STRING_TABLE_TOMBSTONE) continue;
+
+    if (string->hash == hash && string->length == content_length &&
+        memcmp(string->content, content, content_length) == 0)
+      return string;
+  }
+}
+
+/// Insert `string` into string `table`.
+/// @note `string` must not be already present in `table`.
+void string_table_insert(StringTable *const table, ObjectString *const string) {
+  assert(table != NULL);
+  assert(string != NULL);
+  assert(string_table_find(table, string->content, string->length, string->hash) == NULL && "Duplicate string");
+
+  if (table->capacity == 0 || STRING_TABLE_EXCEEDS_MAX_LOAD(table, table->count + 1)) string_table_grow(table);
+
+  size_t const index = string_table_find_insertion_index(table->entries, table->capacity, string);
+  if (table->entries[index] == NULL) table->count++; // reused tombstones are already accounted for
+  table->entries[index] = string;
+}
+
+/// Remove `string` from string `table` (leaving a tombstone behind).
+/// Meant for dropping weak references to strings that are about to be deallocated.
+/// @return true if `string` was present in `table`, false otherwise.
+bool string_table_remove(StringTable *const table, ObjectString const *const string) {
+  assert(table != NULL);
+  assert(string != NULL);
+
+  if (table->capacity == 0) return false;
+
+  for (size_t index = string->hash & (table->capacity - 1);; index = (index + 1) & (table->capacity - 1)) {
+    if (table->entries[index] == NULL) return false;
+
+    if (table->entries[index] == string) {
+      table->entries[index] = STRING_TABLE_TOMBSTONE;
+      return true;
+    }
+  }
+}
@@ -1,13 +1,41 @@
 #include "backend/value.h"
 
-#include "backend/gc.h"
 #include "backend/object.h"
 #include "utils/error.h"
 #include "utils/io.h"
+#include "utils/memory.h"
 #include "utils/number.h"
+#include "utils/output_sink.h"
+#include "utils/str.h"
 
 #include <assert.h>
-#include <stdio.h>
+#include <limits.h>
+#include <stdint.h>
+#include <string.h>
+
+// *---------------------------------------------*
+// *              MACRO DEFINITIONS              *
+// *---------------------------------------------*
+
+/// Initializer of statically allocated (immortal) CLA string object with `string_literal` content.
+/// @param string_hash Precomputed `string_literal` hash (immortal strings are shared by all virtual machines, and
+/// therefore never written to).
+#define VALUE_IMMORTAL_STRING_INITIALIZER(string_literal, string_hash)                                              \
+  {                                                                                                                 \
+    .object = {.next = NULL, .type = OBJECT_STRING}, .length = STR_ARRAY_LENGTH(string_literal),                    \
+    .hash = (string_hash), .is_content_owner = false, .content = (string_literal),                                  \
+  }
+
+// *---------------------------------------------*
+// *              TYPE DEFINITIONS               *
+// *---------------------------------------------*
+
+/// String form of concatenation operand.
+typedef struct {
+  Object *string;      // string object standing in for operand; NULL if operand has been formatted into `content`
+  char const *content; // NULL if operand is an unflattened rope
+  int length;
+} ValueConcatenationPiece;
 
 // *---------------------------------------------*
 // *             FUNCTION PROTOTYPES             *
@@ -25,6 +53,28 @@ bool value_is_string(Value value);
 
 bool value_is_falsy(Value value);
 
+// *---------------------------------------------*
+// *          INTERNAL-LINKAGE OBJECTS           *
+// *---------------------------------------------*
+
+// hashes are 32-bit FNV-1a ones (see str_hash)
+static ObjectString value_nil_string = VALUE_IMMORTAL_STRING_INITIALIZER("nil", 0x0DA3F8ECu);
+static ObjectString value_true_string = VALUE_IMMORTAL_STRING_INITIALIZER("true", 0x4DB211E5u);
+static ObjectString value_false_string = VALUE_IMMORTAL_STRING_INITIALIZER("false", 0x0B069958u);
+
+// *---------------------------------------------*
+// *         INTERNAL-LINKAGE FUNCTIONS          *
+// *---------------------------------------------*
+
+/// Get immortal string object representing nil or bool `value`.
+/// @return Pointer to interned immortal string object.
+static inline ObjectString *value_get_immortal_string(Value const value) {
+  assert(value_is_nil(value) || value_is_bool(value));
+
+  if (value_is_nil(value)) return &value_nil_string;
+  return value.as.boolean ? &value_true_string : &value_false_string;
+}
+
 // *---------------------------------------------*
 // *        EXTERNAL-LINKAGE FUNCTIONS           *
 // *---------------------------------------------*
@@ -47,7 +97,7 @@ char const *value_get_type_string(Value const value) {
 void value_list_init(ValueList *const value_list) {
   assert(value_list != NULL);
 
-  DARRAY_INIT(value_list, sizeof(Value), gc_memory_manage);
+  DARRAY_INIT(value_list, sizeof(Value), memory_manage);
 }
 
 /// Release `value_list` resources and set it to uninitialized state.
@@ -66,7 +116,8 @@ void value_list_append(ValueList *const value_list, Value const value) {
   DARRAY_PUSH(value_list, value);
 }
 
-/// Print `value`.
+/// Print `value` into source program output stream.
+/// @note Meant for debugging purposes; source program output goes through `value_write`.
 void value_print(Value const value) {
 #define PRINTF(...) io_fprintf(g_source_program_output_stream, __VA_ARGS__);
 
@@ -81,7 +132,9 @@ void value_print(Value const value) {
       break;
     }
     case VALUE_NUMBER: {
-      PRINTF("%g", value.as.number);
+      char string_representation[NUMBER_STRING_MAX_SIZE];
+      number_to_string(value.as.number, string_representation);
+      PRINTF("%s", string_representation);
       break;
     }
     case VALUE_OBJECT: {
@@ -95,9 +148,36 @@ void value_print(Value const value) {
 #undef PRINTF
 }
 
-/// Determine whether `value_a` equals `value_b`.
+/// Write `value` (belonging to `vm`) string representation into `sink`.
+void value_write(VM *const vm, OutputSink *const sink, Value const value) {
+  assert(sink != NULL);
+
+  static_assert(VALUE_TYPE_COUNT == 4, "Exhaustive ValueType handling");
+  switch (value.type) {
+    case VALUE_NIL:
+    case VALUE_BOOL: {
+      ObjectString const *const string = value_get_immortal_string(value);
+      output_sink_write(sink, string->content, string->length);
+      break;
+    }
+    case VALUE_NUMBER: {
+      char string_representation[NUMBER_STRING_MAX_SIZE];
+      int const string_representation_length = number_to_string(value.as.number, string_representation);
+      output_sink_write(sink, string_representation, string_representation_length);
+      break;
+    }
+    case VALUE_OBJECT: {
+      object_write(vm, sink, value.as.object);
+      break;
+    }
+
+    default: ERROR_INTERNAL("Unknown ValueType '%d'", value.type);
+  }
+}
+
+/// Determine whether `value_a` equals `value_b` (both belonging to `vm`).
 /// @return true if it does, false otherwise.
-bool value_equals(Value const value_a, Value const value_b) {
+bool value_equals(VM *const vm, Value const value_a, Value const value_b) {
   if (value_a.type != value_b.type) return false;
 
   static_assert(VALUE_TYPE_COUNT == 4, "Exhaustive ValueType handling");
@@ -105,48 +185,33 @@ bool value_equals(Value const value_a, Value const value_b) {
     case VALUE_NIL: return true;
     case VALUE_BOOL: return value_a.as.boolean == value_b.as.boolean;
     case VALUE_NUMBER: return value_a.as.number == value_b.as.number;
-    case VALUE_OBJECT: return object_equals(value_a.as.object, value_b.as.object);
+    case VALUE_OBJECT: return object_equals(vm, value_a.as.object, value_b.as.object);
 
     default: ERROR_INTERNAL("Unknown ValueType '%d'", value_a.type);
   }
 }
 
-/// Create string object from `value`.
-/// @note If `value` is of string type, it gets returned as is.
+/// Create string object belonging to `vm` from `value`.
+/// @note If `value` is a flat string, it gets returned as is (ropes get flattened).
 /// @return Created string object.
-ObjectString *value_to_string_object(Value const value) {
+ObjectString *value_to_string_object(VM *const vm, Value const value) {
   static_assert(VALUE_TYPE_COUNT == 4, "Exhaustive ValueType handling");
   switch (value.type) {
-    case VALUE_NIL: {
-      return object_make_non_owning_string("nil", 3);
-    }
+    case VALUE_NIL:
     case VALUE_BOOL: {
-      if (value.as.boolean == true) return object_make_non_owning_string("true", 4);
-      return object_make_non_owning_string("false", 5);
+      return value_get_immortal_string(value);
     }
     case VALUE_NUMBER: {
-      char const *const format_specifier = "%g";
-
-      char dummy_buffer[1]; // required by snprintf spec
-      int const string_representation_length = snprintf(dummy_buffer, 0, format_specifier, value.as.number);
-      if (string_representation_length < 0) ERROR_IO_ERRNO();
-      size_t const string_representation_size = string_representation_length + 1; // account for NUL terminator
+      char string_representation[NUMBER_STRING_MAX_SIZE];
+      int const string_representation_length = number_to_string(value.as.number, string_representation);
 
-      char *string_representation = gc_allocate(string_representation_size);
-      int const bytes_printed =
-        snprintf(string_representation, string_representation_size, format_specifier, value.as.number);
-      if (bytes_printed < 0 || bytes_printed != string_representation_length) ERROR_IO_ERRNO();
-
-      // truncate redundant NUL terminator
-      string_representation =
-        gc_reallocate(string_representation, string_representation_size, string_representation_length);
-
-      return object_make_non_owning_string(string_representation, string_representation_length);
+      return object_make_owning_string(vm, string_representation, string_representation_length);
     }
     case VALUE_OBJECT: {
-      static_assert(OBJECT_TYPE_COUNT == 1, "Exhaustive ObjectType handling");
+      static_assert(OBJECT_TYPE_COUNT == 2, "Exhaustive ObjectType handling");
       switch (value.as.object->type) {
-        case OBJECT_STRING: return (ObjectString *)value.as.object;
+        case OBJECT_STRING:
+        case OBJECT_ROPE: return object_flatten_string(vm, value.as.object);
 
         default: ERROR_INTERNAL("Unknown ObjectType '%d'", value.as.object->type);
       }
@@ -155,3 +220,73 @@ ObjectString *value_to_string_object(Value const value) {
     default: ERROR_INTERNAL("Unknown ValueType '%d'", value.type);
   }
 }
+
+/// Intern immortal string objects representing nil and bool values within `vm`.
+/// @note Meant to be called on each VM initialization (right after its string table gets initialized).
+void value_intern_immortal_strings(VM *const vm) {
+  object_intern_immortal_string(vm, &value_nil_string);
+  object_intern_immortal_string(vm, &value_true_string);
+  object_intern_immortal_string(vm, &value_false_string);
+}
+
+/// Concatenate `operand_count` `operands` (in order), converting non-string ones into their string representations.
+/// Short results, as well as N-ary concatenation results built from flat strings, are materialized with a single
+/// allocation and copy pass (non-string operands don't get string objects of their own).
+/// Remaining results are represented by ropes, so that repeated binary concatenation stays linear.
+/// @return Pointer to string object (belonging to `vm`) holding concatenation result.
+Object *value_concatenate(VM *const vm, Value const *const operands, int const operand_count) {
+  assert(operands != NULL);
+  assert(operand_count >= 2 && operand_count <= UINT8_MAX);
+
+  ValueConcatenationPiece pieces[UINT8_MAX];
+  char number_strings[UINT8_MAX][NUMBER_STRING_MAX_SIZE];
+
+  // resolve operands into string pieces
+  int total_length = 0;
+  bool contains_unflattened_rope = false;
+  for (int i = 0; i < operand_count; i++) {
+    Value const operand = operands[i];
+    ValueConcatenationPiece *const piece = &pieces[i];
+
+    if (value_is_number(operand)) {
+      piece->string = NULL;
+      piece->content = number_strings[i];
+      piece->length = number_to_string(operand.as.number, number_strings[i]);
+    } else {
+      piece->string = value_is_string(operand) ? operand.as.object : (Object *)value_get_immortal_string(operand);
+
+      ObjectString const *const flat_string = object_get_flat_string(piece->string);
+      piece->content = flat_string == NULL ? NULL : flat_string->content;
+      piece->length = object_get_string_length(piece->string);
+      if (flat_string == NULL) contains_unflattened_rope = true;
+    }
+
+    if (total_length > INT_MAX - piece->length) ERROR_MEMORY("Exceeded maximum string length (%d)", INT_MAX);
+    total_length += piece->length;
+  }
+
+  // ropes are never shorter than OBJECT_ROPE_MIN_LENGTH, so short results always consist of flat pieces
+  if (total_length < OBJECT_ROPE_MIN_LENGTH || (operand_count > 2 && !contains_unflattened_rope)) {
+    ObjectString *const new_string = object_make_uninitialized_owning_string(vm, total_length);
+
+    char *content_end = new_string->inline_content;
+    for (int i = 0; i < operand_count; i++) {
+      memcpy(content_end, pieces[i].content, pieces[i].length);
+      content_end += pieces[i].length;
+    }
+
+    return (Object *)object_intern_owning_string(vm, new_string);
+  }
+
+  // fold pieces from right to left ('..' is right-associative)
+  Object *result = NULL;
+  for (int i = operand_count - 1; i >= 0; i--) {
+    Object *const string = pieces[i].string != NULL
+                             ? pieces[i].string
+                             : (Object *)object_make_owning_string(vm, pieces[i].content, pieces[i].length);
+
+    result = result == NULL ? string : object_concatenate(vm, string, result);
+  }
+
+  return result;
+}
@@ -3,19 +3,21 @@
 #include "backend/gc.h"
 #include "backend/object.h"
 #include "backend/value.h"
-#include "global.h"
 #include "utils/debug.h"
 #include "utils/error.h"
 #include "utils/io.h"
 #include "utils/memory.h"
+#include "utils/output_sink.h"
 #include "utils/stack.h"
 
 #include <assert.h>
+#include <limits.h>
 #include <math.h>
 #include <stdarg.h>
 #include <stddef.h>
 #include <stdio.h>
 #include <string.h>
+#include <time.h>
 
 // *---------------------------------------------*
 // *              MACRO DEFINITIONS              *
@@ -23,91 +25,109 @@
 
 #define VM_STACK_INITIAL_CAPACITY 256
 #define VM_STACK_GROWTH_FACTOR 2
-#define VM_STACK_TOP STACK_TOP(&vm.stack)
+#define VM_STACK_TOP STACK_TOP(&vm->stack)
 
-#define READ_INSTRUCTION_BYTE() (*vm.ip++)
+#define READ_INSTRUCTION_BYTE() (*vm->ip++)
 
-#define GET_INSTRUCTION_OFFSET(instruction_byte_length) (vm.ip - vm.chunk->code.data - (instruction_byte_length))
+#define GET_INSTRUCTION_OFFSET(instruction_byte_length) (vm->ip - vm->chunk->code.data - (instruction_byte_length))
 
 #define ASSERT_MIN_VM_STACK_COUNT(expected_min_vm_stack_count) \
-  assert(vm.stack.count >= (expected_min_vm_stack_count) && "Attempt to access nonexistent vm.stack frame")
+  assert(vm->stack.count >= (expected_min_vm_stack_count) && "Attempt to access nonexistent vm->stack frame")
 
-// *---------------------------------------------*
-// *             FUNCTION PROTOTYPES             *
-// *---------------------------------------------*
+/// Count of statements executed between consecutive execution timeout checks (reading clock is comparatively costly).
+#define VM_TIMEOUT_CHECK_INTERVAL 256
 
-void vm_reset(void);
+/// Enforce `vm` execution budget at statement boundary (statement-ending instruction was just executed).
+/// Bytecode has no jumps, so instruction pointer only advances; exceeding bytecode budget is detected by comparing it
+/// against `budget_end_ip`, whereas execution timeout is checked every VM_TIMEOUT_CHECK_INTERVAL statements.
+#define ENFORCE_EXECUTION_BUDGET()                                                                         \
+  do {                                                                                                     \
+    if (vm->ip > budget_end_ip || --timeout_check_countdown == 0) {                                        \
+      if (!vm_check_execution_budget(vm, budget_end_ip, deadline, &timeout_check_countdown)) return false; \
+    }                                                                                                      \
+  } while (0)
 
 // *---------------------------------------------*
-// *          EXTERNAL-LINKAGE OBJECTS           *
+// *             FUNCTION PROTOTYPES             *
 // *---------------------------------------------*
 
-VM vm;
+void vm_reset(VM *vm);
 
 // *---------------------------------------------*
 // *         INTERNAL-LINKAGE FUNCTIONS          *
 // *---------------------------------------------*
 
-/// Handle bytecode execution error at `instruction_offset` with `format` message and `format_args`.
-/// @return false (meant to be forwarded as an execution failure indication).
-static bool vm_error_at(ptrdiff_t const instruction_offset, char const *const format, ...) {
-  assert(instruction_offset >= 0);
-  assert(format != NULL);
-
-  va_list format_args;
-  va_start(format_args, format);
-  int32_t const instruction_line = chunk_get_instruction_line(vm.chunk, instruction_offset);
-
-  io_fprintf(
-    g_bytecode_execution_error_stream, "[EXECUTION_ERROR]" COMMON_MS COMMON_FILE_LINE_FORMAT COMMON_MS,
-    g_source_file_path, instruction_line
-  );
-  if (vfprintf(g_bytecode_execution_error_stream, format, format_args) < 0) ERROR_IO_ERRNO();
-  io_fprintf(g_bytecode_execution_error_stream, "\n");
+/// Concatenate `operand_count` topmost vm->stack values (replacing them with the result) as an instruction located at
+/// `instruction_offset`.
+/// @return true if concatenation succeeded, false otherwise.
+static bool vm_concatenate(VM *const vm, int const operand_count, ptrdiff_t const instruction_offset) {
+  assert(operand_count >= 2);
+  ASSERT_MIN_VM_STACK_COUNT((size_t)operand_count);
+
+  Value const *const operands = vm->stack.data + vm->stack.count - operand_count;
+  Value const penultimate_operand = operands[operand_count - 2];
+  Value const last_operand = operands[operand_count - 1];
+
+  // '..' is right-associative, so only the innermost (last) concatenation can lack a string operand
+  if (!value_is_string(penultimate_operand) && !value_is_string(last_operand)) {
+    return vm_error_at(
+      vm, instruction_offset, "Expected at least one string-concatenation operand to be a string (got '%s' and '%s')",
+      value_get_type_string(penultimate_operand), value_get_type_string(last_operand)
+    );
+  }
 
-  va_end(format_args);
+  Object *const result = value_concatenate(vm, operands, operand_count);
+  vm->stack.count -= operand_count - 1;
+  VM_STACK_TOP = value_make_object(result);
 
-  return false;
+  return true;
 }
 
-// *---------------------------------------------*
-// *         EXTERNAL-LINKAGE FUNCTIONS          *
-// *---------------------------------------------*
+/// Get current wall-clock time in seconds.
+static double vm_get_current_time(void) {
+  struct timespec time;
+  if (timespec_get(&time, TIME_UTC) != TIME_UTC) ERROR_SYSTEM("Failed to get current time");
 
-/// Initialize virtual machine.
-void vm_init(void) {
-  STACK_INIT_EXPLICIT(&vm.stack, sizeof(Value), gc_memory_manage, VM_STACK_INITIAL_CAPACITY, VM_STACK_GROWTH_FACTOR);
-  vm.gc_objects = NULL;
+  return time.tv_sec + time.tv_nsec / 1e9;
 }
 
-/// Release virtual machine resources and set it to uninitialized state.
-void vm_destroy(void) {
-  gc_deallocate_vm_gc_objects();
-
-  STACK_DESTROY(&vm.stack);
-
-  vm = (VM){0};
-}
+/// Check whether `vm` execution (of statement ending at vm->ip) stays within bytecode budget (ending at
+/// `budget_end_ip`), and before execution `deadline` (0 if there's none); rearms `timeout_check_countdown`.
+/// @return true if execution is within its budget, false otherwise (execution error gets reported).
+static bool vm_check_execution_budget(
+  VM *const vm, uint8_t const *const budget_end_ip, double const deadline, int *const timeout_check_countdown
+) {
+  if (vm->ip > budget_end_ip) {
+    return vm_error_at(
+      vm, GET_INSTRUCTION_OFFSET(1), "Execution budget of %zu bytecode bytes exceeded", vm->config.bytecode_budget
+    );
+  }
 
-/// Push `value` on top of virtual machine stack.
-void vm_stack_push(Value const value) {
-  STACK_PUSH(&vm.stack, value);
-}
+  if (deadline == 0) *timeout_check_countdown = INT_MAX;
+  else if (vm_get_current_time() > deadline) {
+    return vm_error_at(
+      vm, GET_INSTRUCTION_OFFSET(1), "Execution timeout of %g seconds exceeded", vm->config.execution_timeout
+    );
+  } else *timeout_check_countdown = VM_TIMEOUT_CHECK_INTERVAL;
 
-/// Pop value from virtual machine stack.
-/// @return Popped value.
-Value vm_stack_pop(void) {
-  return STACK_POP(&vm.stack);
+  return true;
 }
 
-/// Execute bytecode `chunk`; virtual machine state persists across `chunk` executions.
+/// Run `vm` chunk from its beginning (at `start_time`, 0 if there's no timeout), within execution budget that's left to
+/// `vm` (see vm_execute).
 /// @return true if execution succeeded, false otherwise.
-bool vm_execute(Chunk const *const chunk) {
-  assert(chunk != NULL);
-
-  // configure vm for chunk execution
-  vm.chunk = chunk;
-  vm.ip = chunk->code.data;
+static bool vm_run(VM *const vm, double const start_time) {
+  Chunk const *const chunk = vm->chunk;
+
+  // configure execution budget (its consumed part is accounted by vm_execute)
+  size_t const bytecode_budget = vm->config.bytecode_budget;
+  size_t const bytecode_budget_left =
+    vm->executed_bytecode_length < bytecode_budget ? bytecode_budget - vm->executed_bytecode_length : 0;
+  uint8_t const *const budget_end_ip =
+    bytecode_budget == 0 || bytecode_budget_left > chunk->code.count ? chunk->code.data + chunk->code.count
+                                                                     : chunk->code.data + bytecode_budget_left;
+  double const deadline = start_time == 0 ? 0 : start_time + vm->config.execution_timeout - vm->execution_time;
+  int timeout_check_countdown = deadline == 0 ? INT_MAX : VM_TIMEOUT_CHECK_INTERVAL;
 
 #ifdef DEBUG_VM
   io_puts("\n== DEBUG_VM ==");
@@ -116,54 +136,60 @@ bool vm_execute(Chunk const *const chunk) {
   for (;;) {
 #ifdef DEBUG_VM
     io_printf("[ ");
-    for (size_t i = 0; i < vm.stack.count;) {
-      value_print(vm.stack.data[i]);
-      if (++i < vm.stack.count) io_printf(", ");
+    for (size_t i = 0; i < vm->stack.count;) {
+      value_print(vm->stack.data[i]);
+      if (++i < vm->stack.count) io_printf(", ");
     }
     io_puts(" ]");
-    debug_disassemble_instruction(vm.chunk, vm.ip - vm.chunk->code.data);
+    debug_disassemble_instruction(vm->chunk, vm->config.source_file_path, vm->ip - vm->chunk->code.data);
 #endif
-    assert(vm.ip < vm.chunk->code.data + vm.chunk->code.count && "Instruction pointer out of bounds");
+    assert(vm->ip < vm->chunk->code.data + vm->chunk->code.count && "Instruction pointer out of bounds");
     uint8_t const opcode = READ_INSTRUCTION_BYTE();
 
-    static_assert(CHUNK_OP_OPCODE_COUNT == 22, "Exhaustive ChunkOpCode handling");
+    static_assert(CHUNK_OP_OPCODE_COUNT == 24, "Exhaustive ChunkOpCode handling");
     switch (opcode) {
       case CHUNK_OP_RETURN: {
+        output_sink_flush(&vm->output_sink);
         return true; // successful chunk execution
       }
       case CHUNK_OP_PRINT: {
-        value_print(vm_stack_pop());
-        io_fprintf(g_source_program_output_stream, "\n");
+        value_write(vm, &vm->output_sink, vm_stack_pop(vm));
+        output_sink_write_char(&vm->output_sink, '\n');
+#ifdef DEBUG_VM
+        output_sink_flush(&vm->output_sink); // keep output interleaved with execution trace
+#endif
+        ENFORCE_EXECUTION_BUDGET();
         break;
       }
       case CHUNK_OP_POP: {
-        vm_stack_pop();
+        vm_stack_pop(vm);
+        ENFORCE_EXECUTION_BUDGET();
         break;
       }
       case CHUNK_OP_CONSTANT: {
-        Value constant = vm.chunk->constants.data[READ_INSTRUCTION_BYTE()];
-        vm_stack_push(constant);
+        Value constant = vm->chunk->constants.data[READ_INSTRUCTION_BYTE()];
+        vm_stack_push(vm, constant);
         break;
       }
       case CHUNK_OP_CONSTANT_2B: {
         uint8_t const constant_index_LSB = READ_INSTRUCTION_BYTE();
         uint8_t const constant_index_MSB = READ_INSTRUCTION_BYTE();
         uint32_t const constant_index = memory_concatenate_bytes(2, constant_index_MSB, constant_index_LSB);
-        Value const constant = vm.chunk->constants.data[constant_index];
+        Value const constant = vm->chunk->constants.data[constant_index];
 
-        vm_stack_push(constant);
+        vm_stack_push(vm, constant);
         break;
       }
       case CHUNK_OP_NIL: {
-        vm_stack_push(value_make_nil());
+        vm_stack_push(vm, value_make_nil());
         break;
       }
       case CHUNK_OP_TRUE: {
-        vm_stack_push(value_make_bool(true));
+        vm_stack_push(vm, value_make_bool(true));
         break;
       }
       case CHUNK_OP_FALSE: {
-        vm_stack_push(value_make_bool(false));
+        vm_stack_push(vm, value_make_bool(false));
         break;
       }
       case CHUNK_OP_NEGATE: {
@@ -171,7 +197,7 @@ bool vm_execute(Chunk const *const chunk) {
 
         if (!value_is_number(VM_STACK_TOP)) {
           return vm_error_at(
-            GET_INSTRUCTION_OFFSET(1), "Expected negation operand to be a number (got '%s')",
+            vm, GET_INSTRUCTION_OFFSET(1), "Expected negation operand to be a number (got '%s')",
             value_get_type_string(VM_STACK_TOP)
           );
         }
@@ -181,10 +207,10 @@ bool vm_execute(Chunk const *const chunk) {
       case CHUNK_OP_ADD: {
         ASSERT_MIN_VM_STACK_COUNT(2);
 
-        Value const second_operand = vm_stack_pop();
+        Value const second_operand = vm_stack_pop(vm);
         if (!value_is_number(VM_STACK_TOP) || !value_is_number(second_operand)) {
           return vm_error_at(
-            GET_INSTRUCTION_OFFSET(1), "Expected addition operands to be numbers (got '%s' and '%s')",
+            vm, GET_INSTRUCTION_OFFSET(1), "Expected addition operands to be numbers (got '%s' and '%s')",
             value_get_type_string(VM_STACK_TOP), value_get_type_string(second_operand)
           );
         }
@@ -194,10 +220,10 @@ bool vm_execute(Chunk const *const chunk) {
       case CHUNK_OP_SUBTRACT: {
         ASSERT_MIN_VM_STACK_COUNT(2);
 
-        Value const second_operand = vm_stack_pop();
+        Value const second_operand = vm_stack_pop(vm);
         if (!value_is_number(VM_STACK_TOP) || !value_is_number(second_operand)) {
           return vm_error_at(
-            GET_INSTRUCTION_OFFSET(1), "Expected subtraction operands to be numbers (got '%s' and '%s')",
+            vm, GET_INSTRUCTION_OFFSET(1), "Expected subtraction operands to be numbers (got '%s' and '%s')",
             value_get_type_string(VM_STACK_TOP), value_get_type_string(second_operand)
           );
         }
@@ -207,10 +233,10 @@ bool vm_execute(Chunk const *const chunk) {
       case CHUNK_OP_MULTIPLY: {
         ASSERT_MIN_VM_STACK_COUNT(2);
 
-        Value const second_operand = vm_stack_pop();
+        Value const second_operand = vm_stack_pop(vm);
         if (!value_is_number(VM_STACK_TOP) || !value_is_number(second_operand)) {
           return vm_error_at(
-            GET_INSTRUCTION_OFFSET(1), "Expected multiplication operands to be numbers (got '%s' and '%s')",
+            vm, GET_INSTRUCTION_OFFSET(1), "Expected multiplication operands to be numbers (got '%s' and '%s')",
             value_get_type_string(VM_STACK_TOP), value_get_type_string(second_operand)
           );
         }
@@ -220,28 +246,32 @@ bool vm_execute(Chunk const *const chunk) {
       case CHUNK_OP_DIVIDE: {
         ASSERT_MIN_VM_STACK_COUNT(2);
 
-        Value const second_operand = vm_stack_pop();
+        Value const second_operand = vm_stack_pop(vm);
         if (!value_is_number(VM_STACK_TOP) || !value_is_number(second_operand)) {
           return vm_error_at(
-            GET_INSTRUCTION_OFFSET(1), "Expected division operands to be numbers (got '%s' and '%s')",
+            vm, GET_INSTRUCTION_OFFSET(1), "Expected division operands to be numbers (got '%s' and '%s')",
             value_get_type_string(VM_STACK_TOP), value_get_type_string(second_operand)
           );
         }
-        if (second_operand.as.number == 0) return vm_error_at(GET_INSTRUCTION_OFFSET(1), "Illegal division by zero");
+        if (second_operand.as.number == 0) {
+          return vm_error_at(vm, GET_INSTRUCTION_OFFSET(1), "Illegal division by zero");
+        }
         VM_STACK_TOP.as.number = VM_STACK_TOP.as.number / second_operand.as.number;
         break;
       }
       case CHUNK_OP_MODULO: {
         ASSERT_MIN_VM_STACK_COUNT(2);
 
-        Value const second_operand = vm_stack_pop();
+        Value const second_operand = vm_stack_pop(vm);
         if (!value_is_number(VM_STACK_TOP) || !value_is_number(second_operand)) {
           return vm_error_at(
-            GET_INSTRUCTION_OFFSET(1), "Expected modulo operands to be numbers (got '%s' and '%s')",
+            vm, GET_INSTRUCTION_OFFSET(1), "Expected modulo operands to be numbers (got '%s' and '%s')",
             value_get_type_string(VM_STACK_TOP), value_get_type_string(second_operand)
           );
         }
-        if (second_operand.as.number == 0) return vm_error_at(GET_INSTRUCTION_OFFSET(1), "Illegal modulo by zero");
+        if (second_operand.as.number == 0) {
+          return vm_error_at(vm, GET_INSTRUCTION_OFFSET(1), "Illegal modulo by zero");
+        }
         VM_STACK_TOP.as.number = fmod(VM_STACK_TOP.as.number, second_operand.as.number);
         break;
       }
@@ -254,24 +284,24 @@ bool vm_execute(Chunk const *const chunk) {
       case CHUNK_OP_EQUAL: {
         ASSERT_MIN_VM_STACK_COUNT(2);
 
-        Value const second_operand = vm_stack_pop();
-        VM_STACK_TOP = value_make_bool(value_equals(VM_STACK_TOP, second_operand));
+        Value const second_operand = vm_stack_pop(vm);
+        VM_STACK_TOP = value_make_bool(value_equals(vm, VM_STACK_TOP, second_operand));
         break;
       }
       case CHUNK_OP_NOT_EQUAL: {
         ASSERT_MIN_VM_STACK_COUNT(2);
 
-        Value const second_operand = vm_stack_pop();
-        VM_STACK_TOP = value_make_bool(!value_equals(VM_STACK_TOP, second_operand));
+        Value const second_operand = vm_stack_pop(vm);
+        VM_STACK_TOP = value_make_bool(!value_equals(vm, VM_STACK_TOP, second_operand));
         break;
       }
       case CHUNK_OP_LESS: {
         ASSERT_MIN_VM_STACK_COUNT(2);
 
-        Value const second_operand = vm_stack_pop();
+        Value const second_operand = vm_stack_pop(vm);
         if (!value_is_number(VM_STACK_TOP) || !value_is_number(second_operand)) {
           return vm_error_at(
-            GET_INSTRUCTION_OFFSET(1), "Expected less-than operands to be numbers (got '%s' and '%s')",
+            vm, GET_INSTRUCTION_OFFSET(1), "Expected less-than operands to be numbers (got '%s' and '%s')",
             value_get_type_string(VM_STACK_TOP), value_get_type_string(second_operand)
           );
         }
@@ -281,10 +311,10 @@ bool vm_execute(Chunk const *const chunk) {
       case CHUNK_OP_LESS_EQUAL: {
         ASSERT_MIN_VM_STACK_COUNT(2);
 
-        Value const second_operand = vm_stack_pop();
+        Value const second_operand = vm_stack_pop(vm);
         if (!value_is_number(VM_STACK_TOP) || !value_is_number(second_operand)) {
           return vm_error_at(
-            GET_INSTRUCTION_OFFSET(1), "Expected less-than-or-equal operands to be numbers (got '%s' and '%s')",
+            vm, GET_INSTRUCTION_OFFSET(1), "Expected less-than-or-equal operands to be numbers (got '%s' and '%s')",
             value_get_type_string(VM_STACK_TOP), value_get_type_string(second_operand)
           );
         }
@@ -294,10 +324,10 @@ bool vm_execute(Chunk const *const chunk) {
       case CHUNK_OP_GREATER: {
         ASSERT_MIN_VM_STACK_COUNT(2);
 
-        Value const second_operand = vm_stack_pop();
+        Value const second_operand = vm_stack_pop(vm);
         if (!value_is_number(VM_STACK_TOP) || !value_is_number(second_operand)) {
           return vm_error_at(
-            GET_INSTRUCTION_OFFSET(1), "Expected greater-than operands to be numbers (got '%s' and '%s')",
+            vm, GET_INSTRUCTION_OFFSET(1), "Expected greater-than operands to be numbers (got '%s' and '%s')",
             value_get_type_string(VM_STACK_TOP), value_get_type_string(second_operand)
           );
         }
@@ -307,10 +337,10 @@ bool vm_execute(Chunk const *const chunk) {
       case CHUNK_OP_GREATER_EQUAL: {
         ASSERT_MIN_VM_STACK_COUNT(2);
 
-        Value const second_operand = vm_stack_pop();
+        Value const second_operand = vm_stack_pop(vm);
         if (!value_is_number(VM_STACK_TOP) || !value_is_number(second_operand)) {
           return vm_error_at(
-            GET_INSTRUCTION_OFFSET(1), "Expected greater-than-or-equal operands to be numbers (got '%s' and '%s')",
+            vm, GET_INSTRUCTION_OFFSET(1), "Expected greater-than-or-equal operands to be numbers (got '%s' and '%s')",
             value_get_type_string(VM_STACK_TOP), value_get_type_string(second_operand)
           );
         }
@@ -318,34 +348,160 @@ bool vm_execute(Chunk const *const chunk) {
         break;
       }
       case CHUNK_OP_CONCATENATE: {
-        ASSERT_MIN_VM_STACK_COUNT(2);
-
-        Value const second_operand = vm_stack_pop();
-
-        if (!value_is_string(VM_STACK_TOP) && !value_is_string(second_operand)) {
-          return vm_error_at(
-            GET_INSTRUCTION_OFFSET(1),
-            "Expected at least one string-concatenation operand to be a string (got '%s' and '%s')",
-            value_get_type_string(VM_STACK_TOP), value_get_type_string(second_operand)
-          );
-        }
-
-        ObjectString const *const first_string = value_to_string_object(VM_STACK_TOP);
-        ObjectString const *const second_string = value_to_string_object(second_operand);
-
-        size_t const new_string_length = first_string->length + second_string->length;
-        char *const new_string_content = gc_allocate(new_string_length);
-        memcpy(new_string_content, first_string->content, first_string->length);
-        memcpy(new_string_content + first_string->length, second_string->content, second_string->length);
-        Value const new_string =
-          value_make_object((Object *)object_make_non_owning_string(new_string_content, new_string_length));
+        if (!vm_concatenate(vm, 2, GET_INSTRUCTION_OFFSET(1))) return false;
+        break;
+      }
+      case CHUNK_OP_CONCATENATE_N: {
+        uint8_t const operand_count = READ_INSTRUCTION_BYTE();
+        if (!vm_concatenate(vm, operand_count, GET_INSTRUCTION_OFFSET(2))) return false;
+        break;
+      }
+      case CHUNK_OP_INPUT: {
+        uint8_t const input_slot = READ_INSTRUCTION_BYTE();
+        assert(input_slot < vm->config.input_count && "Expected input slot to be declared by VM configuration");
 
-        VM_STACK_TOP = new_string;
+        // inputs that weren't supplied are nil
+        vm_stack_push(vm, vm->inputs == NULL ? value_make_nil() : vm->inputs[input_slot]);
         break;
       }
       default: ERROR_INTERNAL("Unknown chunk opcode '%d'", opcode);
     }
   }
 
-  ERROR_INTERNAL("Unreachable code executed; vm.chunk execution is expected to be terminated by OP_RETURN or error");
+  ERROR_INTERNAL("Unreachable code executed; vm->chunk execution is expected to be terminated by OP_RETURN or error");
+}
+
+// *---------------------------------------------*
+// *         EXTERNAL-LINKAGE FUNCTIONS          *
+// *---------------------------------------------*
+
+/// Initialize `vm` according to `config`.
+void vm_init(VM *const vm, VMConfig const *const config) {
+  assert(vm != NULL);
+  assert(config != NULL);
+  assert(config->memory_manager != NULL);
+  assert(config->input_count >= 0 && config->input_count <= VM_MAX_INPUT_COUNT);
+  assert(config->input_names != NULL || config->input_count == 0);
+  assert(config->execution_timeout >= 0);
+
+  vm->config = *config;
+  STACK_INIT_EXPLICIT(
+    &vm->stack, sizeof(Value), config->memory_manager, VM_STACK_INITIAL_CAPACITY, VM_STACK_GROWTH_FACTOR
+  );
+  vm->gc_objects = NULL;
+  string_table_init(&vm->strings, config->memory_manager);
+  value_intern_immortal_strings(vm);
+  output_sink_init(&vm->output_sink, config->source_program_output_stream, config->is_source_program_output_async);
+  if (config->is_source_program_output_failure_tolerant) output_sink_tolerate_write_failures(&vm->output_sink);
+  vm->inputs = NULL;
+  vm_reset_execution_budget(vm);
+}
+
+/// Release `vm` resources and set it to uninitialized state.
+void vm_destroy(VM *const vm) {
+  assert(vm != NULL);
+
+  gc_deallocate_vm_gc_objects(vm);
+  string_table_destroy(&vm->strings);
+
+  STACK_DESTROY(&vm->stack);
+  output_sink_destroy(&vm->output_sink);
+
+  *vm = (VM){0};
+}
+
+/// Reset `vm` back to initialized state according to `config`, reusing memory already allocated by `vm`.
+/// Meant for serving many source programs by a single long-lived VM.
+/// Objects of `vm` are released by its current object allocator (in bulk if it supports it), so `config` may specify
+/// a different one.
+/// @note `config` has to specify the same memory manager as `vm` configuration.
+void vm_recycle(VM *const vm, VMConfig const *const config) {
+  assert(vm != NULL);
+  assert(config != NULL);
+  assert(config->memory_manager == vm->config.memory_manager);
+
+  output_sink_destroy(&vm->output_sink);
+  gc_deallocate_vm_gc_objects(vm);
+  string_table_clear(&vm->strings);
+
+  vm->config = *config;
+  vm->gc_objects = NULL;
+  vm->chunk = NULL;
+  vm->ip = NULL;
+  vm->stack.count = 0;
+  value_intern_immortal_strings(vm);
+  output_sink_init(&vm->output_sink, config->source_program_output_stream, config->is_source_program_output_async);
+  if (config->is_source_program_output_failure_tolerant) output_sink_tolerate_write_failures(&vm->output_sink);
+  vm->inputs = NULL;
+  vm_reset_execution_budget(vm);
+}
+
+/// Reset `vm` execution budget, so that subsequent executions are bound by a fresh one (see vm_execute).
+void vm_reset_execution_budget(VM *const vm) {
+  assert(vm != NULL);
+
+  vm->executed_bytecode_length = 0;
+  vm->execution_time = 0;
+}
+
+/// Handle `vm` bytecode execution error at `instruction_offset` of `vm` chunk, with `format` message and `format_args`.
+/// @return false (meant to be forwarded as an execution failure indication).
+bool vm_error_at(VM *const vm, ptrdiff_t const instruction_offset, char const *const format, ...) {
+  assert(vm != NULL);
+  assert(instruction_offset >= 0);
+  assert(format != NULL);
+
+  // keep source program output ordered before the error
+  output_sink_flush(&vm->output_sink);
+
+  va_list format_args;
+  va_start(format_args, format);
+  int32_t const instruction_line = chunk_get_instruction_line(vm->chunk, instruction_offset);
+
+  FILE *const error_stream = vm->config.bytecode_execution_error_stream;
+  io_fprintf(
+    error_stream, "[EXECUTION_ERROR]" COMMON_MS COMMON_FILE_LINE_FORMAT COMMON_MS, vm->config.source_file_path,
+    instruction_line
+  );
+  if (vfprintf(error_stream, format, format_args) < 0) ERROR_IO_ERRNO();
+  io_fprintf(error_stream, "\n");
+
+  va_end(format_args);
+
+  return false;
+}
+
+/// Push `value` on top of `vm` stack.
+void vm_stack_push(VM *const vm, Value const value) {
+  STACK_PUSH(&vm->stack, value);
+}
+
+/// Pop value from `vm` stack.
+/// @return Popped value.
+Value vm_stack_pop(VM *const vm) {
+  return STACK_POP(&vm->stack);
+}
+
+/// Execute bytecode `chunk` on `vm`; `vm` state persists across `chunk` executions.
+/// Execution fails once it exceeds budget set by `vm` configuration (checked at statement boundaries). The budget
+/// spans all executions since `vm` got initialized, recycled, or had its budget reset (see vm_reset_execution_budget),
+/// so that source code executed in multiple chunks (e.g. pipelined batches) is bound by a single budget. Only time
+/// spent executing counts against the timeout (time passing between executions doesn't).
+/// @return true if execution succeeded, false otherwise.
+bool vm_execute(VM *const vm, Chunk const *const chunk) {
+  assert(vm != NULL);
+  assert(chunk != NULL);
+
+  // configure vm for chunk execution
+  vm->chunk = chunk;
+  vm->ip = chunk->code.data;
+
+  double const start_time = vm->config.execution_timeout > 0 ? vm_get_current_time() : 0;
+  bool const is_successful = vm_run(vm, start_time);
+
+  // bytecode has no jumps, so instruction pointer offset equals count of executed bytecode bytes
+  vm->executed_bytecode_length += vm->ip - chunk->code.data;
+  if (start_time != 0) vm->execution_time += vm_get_current_time() - start_time;
+
+  return is_successful;
 }
@@ -1,10 +1,16 @@
 #include "cli/args.h"
 
+#include "cli/batch.h"
 #include "cli/manual.h"
+#include "global.h"
 #include "utils/error.h"
 
 #include <assert.h>
+#include <math.h>
 #include <stdbool.h>
+#include <stdint.h>
+#include <stdlib.h>
+#include <string.h>
 
 // *---------------------------------------------*
 // *          INTERNAL-LINKAGE OBJECTS           *
@@ -13,14 +19,74 @@
 /// Cli options bitfield.
 static struct {
   unsigned int help : 1;
+  unsigned int async_output : 1;
+  unsigned int pipelined : 1;
+  unsigned int serve : 1;
+  unsigned int client : 1;
 } options;
 
+/// Values supplied to cli options taking them (NULL unless supplied).
+static struct {
+  char const *jobs;
+  char const *manifest;
+  char const *socket;
+  char const *each;
+  char const *budget;
+  char const *timeout;
+} option_values;
+
 // *---------------------------------------------*
 // *         INTERNAL-LINKAGE FUNCTIONS          *
 // *---------------------------------------------*
 
-/// Process `flag_arg` (cli argument that begins with a '-').
-static inline void process_flag_arg(char const *flag_arg) {
+/// Parse `jobs_value` (value supplied to '--jobs' option) into batch mode job count.
+static int parse_job_count(char const *const jobs_value) {
+  assert(jobs_value != NULL);
+
+  char *jobs_value_end;
+  long const job_count = strtol(jobs_value, &jobs_value_end, 10);
+
+  if (*jobs_value == '\0' || *jobs_value_end != '\0' || job_count < 1 || job_count > BATCH_MAX_JOB_COUNT) {
+    ERROR_INVALID_ARG(
+      "Expected '--jobs' value to be an integer in range [1, %d] (got '%s')", BATCH_MAX_JOB_COUNT, jobs_value
+    );
+  }
+
+  return job_count;
+}
+
+/// Parse `budget_value` (value supplied to '--budget' option) into execution bytecode budget.
+static size_t parse_bytecode_budget(char const *const budget_value) {
+  assert(budget_value != NULL);
+
+  char *budget_value_end;
+  unsigned long long const bytecode_budget = strtoull(budget_value, &budget_value_end, 10);
+
+  if (*budget_value < '0' || *budget_value > '9' || *budget_value_end != '\0' || bytecode_budget < 1 ||
+      bytecode_budget > SIZE_MAX) {
+    ERROR_INVALID_ARG("Expected '--budget' value to be a positive integer (got '%s')", budget_value);
+  }
+
+  return bytecode_budget;
+}
+
+/// Parse `timeout_value` (value supplied to '--timeout' option) into execution timeout.
+static double parse_execution_timeout(char const *const timeout_value) {
+  assert(timeout_value != NULL);
+
+  char *timeout_value_end;
+  double const execution_timeout = strtod(timeout_value, &timeout_value_end);
+
+  if (*timeout_value == '\0' || *timeout_value_end != '\0' || !isfinite(execution_timeout) || execution_timeout <= 0) {
+    ERROR_INVALID_ARG("Expected '--timeout' value to be a positive number of seconds (got '%s')", timeout_value);
+  }
+
+  return execution_timeout;
+}
+
+/// Process `flag_arg` (cli argument that begins with a '-'), followed by `next_arg` (NULL if there's none).
+/// @return Whether `next_arg` got consumed as `flag_arg` value.
+static inline bool process_flag_arg(char const *flag_arg, char const *const next_arg) {
   assert(flag_arg != NULL);
   assert(*flag_arg == '-');
 
@@ -34,9 +100,27 @@ static inline void process_flag_arg(char const *flag_arg) {
   if (*flag_arg == '-') {
     char const *long_flag = ++flag_arg;
 
+    // handle long flag taking value
+    char const **option_value = NULL;
+    if (strcmp(long_flag, "jobs") == 0) option_value = &option_values.jobs;
+    else if (strcmp(long_flag, "manifest") == 0) option_value = &option_values.manifest;
+    else if (strcmp(long_flag, "socket") == 0) option_value = &option_values.socket;
+    else if (strcmp(long_flag, "each") == 0) option_value = &option_values.each;
+    else if (strcmp(long_flag, "budget") == 0) option_value = &option_values.budget;
+    else if (strcmp(long_flag, "timeout") == 0) option_value = &option_values.timeout;
+    if (option_value != NULL) {
+      if (next_arg == NULL) ERROR_INVALID_ARG("Command-line flag '--%s' requires a value", long_flag);
+      *option_value = next_arg;
+      return true;
+    }
+
     if (strcmp(long_flag, "help") == 0) options.help = true;
+    else if (strcmp(long_flag, "async-output") == 0) options.async_output = true;
+    else if (strcmp(long_flag, "pipelined") == 0) options.pipelined = true;
+    else if (strcmp(long_flag, "serve") == 0) options.serve = true;
+    else if (strcmp(long_flag, "client") == 0) options.client = true;
     else ERROR_INVALID_ARG("Invalid command-line flag supplied: '--%s'", long_flag);
-    return;
+    return false;
   }
 
   // handle short flag (one beginning with '-')
@@ -49,6 +133,7 @@ static inline void process_flag_arg(char const *flag_arg) {
       default: ERROR_INVALID_ARG("Invalid command-line flag supplied: '%c'", flag_arg[-1]);
     }
   }
+  return false;
 }
 
 // *---------------------------------------------*
@@ -56,20 +141,19 @@ static inline void process_flag_arg(char const *flag_arg) {
 // *---------------------------------------------*
 
 /// Process cli arguments; requires forwarding process's `argc` and `argv`.
-/// @return cli path argument if supplied, NULL otherwise.
-char const *args_process(int const argc, char const *const *const argv) {
+/// @return Processed cli arguments (path arguments are only permitted to be many in batch mode).
+Args args_process(int const argc, char const *const *const argv) {
   assert(argc >= 0);
   assert(argv != NULL);
 
-  char const *source_file_path = NULL;
+  Args args = {.source_file_paths = malloc(sizeof(char const *) * (argc > 0 ? argc : 1))};
+  if (args.source_file_paths == NULL) ERROR_MEMORY_ERRNO();
 
   // process cli arguments
   for (int i = 1; i < argc; i++) {
-    if (*argv[i] == '-') process_flag_arg(argv[i]);
-    else {
-      if (source_file_path != NULL) ERROR_INVALID_ARG("Excessive command-line path supplied: '%s'", argv[i]);
-      source_file_path = argv[i];
-    }
+    if (*argv[i] == '-') {
+      if (process_flag_arg(argv[i], i + 1 < argc ? argv[i + 1] : NULL)) i++;
+    } else args.source_file_paths[args.source_file_path_count++] = argv[i];
   }
 
   // handle options
@@ -77,6 +161,83 @@ char const *args_process(int const argc, char const *const *const argv) {
     manual_print();
     exit(ERROR_CODE_SUCCESS);
   }
+  if (options.async_output) {
+#ifdef _WIN32
+    ERROR_INVALID_ARG("Command-line flag '--async-output' is not supported on this platform");
+#endif
+    g_is_source_program_output_async = true;
+  }
+  if (options.pipelined) {
+    if (options.serve || options.client || option_values.jobs != NULL || args.source_file_path_count == 0) {
+      ERROR_INVALID_ARG("Command-line flag '--pipelined' requires single path argument (and no batch or server mode)");
+    }
+    g_is_interpretation_pipelined = true;
+  }
+  if (option_values.budget != NULL || option_values.timeout != NULL) {
+    // remote interpretation is bound by budget of the server
+    if (options.client) ERROR_INVALID_ARG("Command-line flags '--budget' and '--timeout' conflict with '--client'");
+    if (option_values.budget != NULL) g_execution_bytecode_budget = parse_bytecode_budget(option_values.budget);
+    if (option_values.timeout != NULL) g_execution_timeout = parse_execution_timeout(option_values.timeout);
+  }
+  if (option_values.each != NULL) {
+    if (options.pipelined || options.serve || options.client || option_values.manifest != NULL ||
+        option_values.socket != NULL) {
+      ERROR_INVALID_ARG("Command-line flag '--each' conflicts with other interaction modes");
+    }
+    if (args.source_file_path_count != 1) ERROR_INVALID_ARG("Command-line flag '--each' requires single path argument");
+    if (option_values.jobs != NULL) {
+#ifdef _WIN32
+      ERROR_INVALID_ARG("Command-line flag '--jobs' is not supported on this platform");
+#endif
+      args.job_count = parse_job_count(option_values.jobs);
+    }
+    args.records_path = option_values.each;
+    return args;
+  }
+  if (option_values.socket != NULL && !options.serve && !options.client) {
+    ERROR_INVALID_ARG("Command-line flag '--socket' requires '--serve' or '--client'");
+  }
+  if (options.serve || options.client) {
+#ifdef _WIN32
+    ERROR_INVALID_ARG("Command-line flags '--serve' and '--client' are not supported on this platform");
+#endif
+    if (options.serve && options.client) ERROR_INVALID_ARG("Command-line flags '--serve' and '--client' conflict");
+    if (options.client && option_values.jobs != NULL) {
+      ERROR_INVALID_ARG("Command-line flag '--jobs' conflicts with '--client'");
+    }
+    if (option_values.manifest != NULL) ERROR_INVALID_ARG("Command-line flag '--manifest' requires batch mode");
+
+    int const expected_path_count = options.client ? 1 : 0;
+    if (args.source_file_path_count > expected_path_count) {
+      ERROR_INVALID_ARG("Excessive command-line path supplied: '%s'", args.source_file_paths[expected_path_count]);
+    }
+    if (args.source_file_path_count < expected_path_count) {
+      ERROR_INVALID_ARG("Command-line flag '--client' requires path argument");
+    }
+
+    args.is_serving = options.serve;
+    args.is_client = options.client;
+    args.socket_path = option_values.socket;
+    if (option_values.jobs != NULL) args.job_count = parse_job_count(option_values.jobs);
+  } else if (option_values.jobs != NULL) {
+#ifdef _WIN32
+    ERROR_INVALID_ARG("Command-line flag '--jobs' is not supported on this platform");
+#endif
+    args.job_count = parse_job_count(option_values.jobs);
+    args.manifest_path = option_values.manifest;
+  } else {
+    if (option_values.manifest != NULL) ERROR_INVALID_ARG("Command-line flag '--manifest' requires '--jobs'");
+    if (args.source_file_path_count > 1) {
+      ERROR_INVALID_ARG("Excessive command-line path supplied: '%s'", args.source_file_paths[1]);
+    }
+  }
+
+  return args;
+}
+
+/// Release `args` resources.
+void args_destroy(Args *const args) {
+  assert(args != NULL);
 
-  return source_file_path;
+  free(args->source_file_paths);
 }
@@ -0,0 +1,315 @@
+#ifndef _WIN32
+#define _POSIX_C_SOURCE 200809L
+#endif
+
+#include "cli/batch.h"
+
+#include "backend/chunk.h"
+#include "backend/vm.h"
+#include "common.h"
+#include "frontend/compiler.h"
+#include "global.h"
+#include "utils/error.h"
+#include "utils/io.h"
+#include "utils/memory.h"
+#include "utils/memory_arena.h"
+#include "utils/str.h"
+
+#include <assert.h>
+#include <errno.h>
+#include <stdbool.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+
+#ifndef _WIN32
+#include <pthread.h>
+#endif
+
+#ifndef _WIN32
+// *---------------------------------------------*
+// *              MACRO DEFINITIONS              *
+// *---------------------------------------------*
+
+#define BATCH_OBJECT_ARENA_BLOCK_SIZE (64 * 1024)
+
+// *---------------------------------------------*
+// *              TYPE DEFINITIONS               *
+// *---------------------------------------------*
+
+/// Source file interpreted in batch mode; its output is held until all preceding source files have been emitted.
+typedef struct {
+  char const *path;
+  char *program_output, *error_output; // heap-allocated by memory streams
+  size_t program_output_length, error_output_length;
+  ErrorCode error_code;
+  bool is_interpreted;
+} BatchScript;
+
+/// Batch worker's share of scripts: ones at `worker_index + job_count * stride` for strides in [first_stride,
+/// end_stride). Worker takes its scripts from the front, while idle workers steal them from the back.
+typedef struct {
+  pthread_mutex_t mutex;
+  int first_stride, end_stride;
+} BatchWorkQueue;
+
+/// Batch mode state shared by all workers.
+typedef struct {
+  BatchScript *scripts;
+  int script_count, job_count;
+  BatchWorkQueue *work_queues; // one per worker
+  pthread_mutex_t emission_mutex; // guards script `is_interpreted` flags and `emitted_script_count`
+  int emitted_script_count;
+} Batch;
+
+/// Batch worker thread context.
+typedef struct {
+  Batch *batch;
+  int index;
+} BatchWorker;
+
+// *---------------------------------------------*
+// *         INTERNAL-LINKAGE FUNCTIONS          *
+// *---------------------------------------------*
+
+/// Take script from `batch` work queue at `queue_index`; the front one if `is_owner`, the back one otherwise.
+/// @return Script index, or -1 if work queue is empty.
+static int take_script(Batch *const batch, int const queue_index, bool const is_owner) {
+  BatchWorkQueue *const queue = &batch->work_queues[queue_index];
+  int script_index = -1;
+
+  pthread_mutex_lock(&queue->mutex);
+  if (queue->first_stride < queue->end_stride) {
+    int const stride = is_owner ? queue->first_stride++ : --queue->end_stride;
+    script_index = queue_index + batch->job_count * stride;
+  }
+  pthread_mutex_unlock(&queue->mutex);
+
+  return script_index;
+}
+
+/// Interpret `script` on `vm` (initialized for the duration of interpretation), buffering its output.
+/// @param object_allocator Allocator of `vm` objects, reset once interpretation ends.
+static void interpret_script(VM *const vm, MemoryAllocator const *const object_allocator, BatchScript *const script) {
+  assert(vm != NULL);
+  assert(object_allocator != NULL);
+  assert(script != NULL);
+
+  FILE *const program_output_stream = open_memstream(&script->program_output, &script->program_output_length);
+  if (program_output_stream == NULL) ERROR_IO_ERRNO();
+  FILE *const error_output_stream = open_memstream(&script->error_output, &script->error_output_length);
+  if (error_output_stream == NULL) ERROR_IO_ERRNO();
+
+  VMConfig const vm_config = {
+    .source_file_path = script->path,
+    .static_analysis_error_stream = error_output_stream,
+    .bytecode_execution_error_stream = error_output_stream,
+    .source_program_output_stream = program_output_stream,
+    .memory_manager = memory_manage,
+    .object_allocator = object_allocator,
+    .bytecode_budget = g_execution_bytecode_budget,
+    .execution_timeout = g_execution_timeout,
+  };
+  vm_init(vm, &vm_config);
+  Chunk chunk;
+  chunk_init(&chunk);
+
+  // unreadable script fails on its own, rather than terminating the whole batch
+  char *const source_code = io_try_read_text_file(script->path);
+  if (source_code == NULL) {
+    io_fprintf(
+      error_output_stream, "[ERROR_IO]" COMMON_MS "Failed to read file '%s'" COMMON_MS "%s\n", script->path,
+      strerror(errno)
+    );
+    script->error_code = ERROR_CODE_IO;
+  } else if (compiler_compile(vm, source_code, &chunk) != COMPILER_SUCCESS) {
+    script->error_code = ERROR_CODE_COMPILATION;
+  } else if (!vm_execute(vm, &chunk)) script->error_code = ERROR_CODE_EXECUTION;
+  else script->error_code = ERROR_CODE_SUCCESS;
+  free(source_code);
+
+  chunk_destroy(&chunk);
+  vm_destroy(vm);
+
+  if (fclose(program_output_stream) == EOF) ERROR_IO_ERRNO();
+  if (fclose(error_output_stream) == EOF) ERROR_IO_ERRNO();
+}
+
+/// Mark `batch` script at `script_index` as interpreted, and emit output of every interpreted script that is no
+/// longer preceded by uninterpreted ones; this way output is emitted in script order, regardless of job count.
+static void complete_script(Batch *const batch, int const script_index) {
+  pthread_mutex_lock(&batch->emission_mutex);
+
+  batch->scripts[script_index].is_interpreted = true;
+  while (batch->emitted_script_count < batch->script_count &&
+         batch->scripts[batch->emitted_script_count].is_interpreted) {
+    BatchScript *const script = &batch->scripts[batch->emitted_script_count++];
+
+    if (fwrite(script->program_output, 1, script->program_output_length, stdout) < script->program_output_length) {
+      ERROR_IO_ERRNO();
+    }
+    if (fwrite(script->error_output, 1, script->error_output_length, stderr) < script->error_output_length) {
+      ERROR_IO_ERRNO();
+    }
+
+    free(script->program_output);
+    free(script->error_output);
+    script->program_output = script->error_output = NULL;
+  }
+
+  pthread_mutex_unlock(&batch->emission_mutex);
+}
+
+/// Interpret scripts of `worker_context` worker's batch until there are none left, stealing them from other workers
+/// once worker's own ones run out. Worker reuses single VM, reinitializing it for every script to keep them isolated,
+/// along with single arena its objects are allocated from.
+/// @return NULL (signature conforms to pthread start routine).
+static void *run_batch_worker(void *const worker_context) {
+  BatchWorker const *const worker = worker_context;
+  Batch *const batch = worker->batch;
+  VM vm;
+
+  MemoryArena object_arena;
+  memory_arena_init(&object_arena, BATCH_OBJECT_ARENA_BLOCK_SIZE, memory_manage);
+  MemoryAllocator const object_allocator = memory_arena_make_allocator(&object_arena);
+
+  for (;;) {
+    int script_index = take_script(batch, worker->index, true);
+    for (int i = 1; script_index == -1 && i < batch->job_count; i++) {
+      script_index = take_script(batch, (worker->index + i) % batch->job_count, false);
+    }
+
+    // scripts are never added to work queues, so once all of them are empty, they stay that way
+    if (script_index == -1) break;
+
+    interpret_script(&vm, &object_allocator, &batch->scripts[script_index]);
+    complete_script(batch, script_index);
+  }
+
+  memory_arena_destroy(&object_arena);
+
+  return NULL;
+}
+
+/// Run `batch` scripts on `batch` job count of workers (including calling thread).
+static void run_batch(Batch *const batch) {
+  assert(batch != NULL);
+
+  BatchWorker *const workers = malloc(sizeof(BatchWorker) * batch->job_count);
+  if (workers == NULL) ERROR_MEMORY_ERRNO();
+  pthread_t *const threads = malloc(sizeof(pthread_t) * batch->job_count);
+  if (threads == NULL) ERROR_MEMORY_ERRNO();
+
+  for (int i = 0; i < batch->job_count; i++) workers[i] = (BatchWorker){.batch = batch, .index = i};
+
+  for (int i = 1; i < batch->job_count; i++) {
+    int const error_number = pthread_create(&threads[i], NULL, run_batch_worker, &workers[i]);
+    if (error_number != 0) ERROR_SYSTEM("Failed to start batch worker thread" COMMON_MS "%s\n", strerror(error_number));
+  }
+
+  run_batch_worker(&workers[0]);
+
+  for (int i = 1; i < batch->job_count; i++) {
+    int const error_number = pthread_join(threads[i], NULL);
+    if (error_number != 0) ERROR_SYSTEM("Failed to join batch worker thread" COMMON_MS "%s\n", strerror(error_number));
+  }
+
+  free(threads);
+  free(workers);
+}
+
+/// Get seconds elapsed since some fixed point in time.
+static double get_time_seconds(void) {
+  struct timespec time;
+  if (timespec_get(&time, TIME_UTC) == 0) ERROR_SYSTEM("Failed to get current time");
+  return time.tv_sec + time.tv_nsec / 1e9;
+}
+#endif
+
+// *---------------------------------------------*
+// *         EXTERNAL-LINKAGE FUNCTIONS          *
+// *---------------------------------------------*
+
+/// Interpret source files located at `source_file_paths` of `source_file_path_count`, followed by ones listed in
+/// `manifest_path` file (one path per line, blank lines are skipped; NULL if there's none), using `job_count` worker
+/// threads. Every source file is interpreted by an isolated VM. Source program output and errors are emitted into
+/// stdout and stderr respectively, in source file order; throughput report is written into stderr at the end.
+/// @return Error code of the first source file that failed to be interpreted, ERROR_CODE_SUCCESS if none did.
+ErrorCode batch_interpret(
+  char const *const *const source_file_paths, int const source_file_path_count, char const *const manifest_path,
+  int const job_count
+) {
+  assert(source_file_paths != NULL || source_file_path_count == 0);
+  assert(source_file_path_count >= 0);
+  assert(job_count >= 1 && job_count <= BATCH_MAX_JOB_COUNT);
+
+#ifdef _WIN32
+  ERROR_INVALID_ARG("Batch mode is not supported on this platform");
+#else // POSIX
+  char *const manifest = manifest_path == NULL ? NULL : io_read_text_file(manifest_path);
+  size_t const max_script_count = source_file_path_count + (manifest == NULL ? 0 : str_count_lines(manifest) + 1);
+
+  Batch batch = {.scripts = malloc(sizeof(BatchScript) * (max_script_count > 0 ? max_script_count : 1))};
+  if (batch.scripts == NULL) ERROR_MEMORY_ERRNO();
+
+  // collect script paths
+  for (int i = 0; i < source_file_path_count; i++) {
+    batch.scripts[batch.script_count++] = (BatchScript){.path = source_file_paths[i]};
+  }
+  for (char *line = manifest; line != NULL && *line != '\0';) {
+    char *const line_end = strchr(line, '\n');
+    char *const next_line = line_end == NULL ? NULL : line_end + 1;
+    if (line_end != NULL) *line_end = '\0';
+
+    // accommodate CRLF line endings
+    size_t const line_length = strlen(line);
+    if (line_length > 0 && line[line_length - 1] == '\r') line[line_length - 1] = '\0';
+
+    if (!str_is_all_whitespace(line)) batch.scripts[batch.script_count++] = (BatchScript){.path = line};
+    line = next_line;
+  }
+
+  // stripe scripts across work queues, so that output can be emitted while scripts are still being interpreted
+  batch.job_count = job_count < batch.script_count ? job_count : batch.script_count;
+  batch.work_queues = malloc(sizeof(BatchWorkQueue) * (batch.job_count > 0 ? batch.job_count : 1));
+  if (batch.work_queues == NULL) ERROR_MEMORY_ERRNO();
+  for (int i = 0; i < batch.job_count; i++) {
+    BatchWorkQueue *const queue = &batch.work_queues[i];
+    queue->first_stride = 0;
+    queue->end_stride = (batch.script_count - i + batch.job_count - 1) / batch.job_count;
+
+    int const error_number = pthread_mutex_init(&queue->mutex, NULL);
+    if (error_number != 0) ERROR_SYSTEM("Failed to initialize mutex" COMMON_MS "%s\n", strerror(error_number));
+  }
+  int const error_number = pthread_mutex_init(&batch.emission_mutex, NULL);
+  if (error_number != 0) ERROR_SYSTEM("Failed to initialize mutex" COMMON_MS "%s\n", strerror(error_number));
+
+  double const start_time = get_time_seconds();
+  if (batch.script_count > 0) run_batch(&batch);
+  double const elapsed_time = get_time_seconds() - start_time;
+
+  // aggregate script error codes
+  ErrorCode error_code = ERROR_CODE_SUCCESS;
+  int failed_script_count = 0;
+  for (int i = 0; i < batch.script_count; i++) {
+    if (batch.scripts[i].error_code == ERROR_CODE_SUCCESS) continue;
+    if (failed_script_count++ == 0) error_code = batch.scripts[i].error_code;
+  }
+
+  if (fflush(stdout) == EOF) ERROR_IO_ERRNO();
+  io_fprintf(
+    stderr, "[BATCH]" COMMON_MS "%d scripts (%d failed) interpreted in %.3fs by %d jobs (%.1f scripts/s)\n",
+    batch.script_count, failed_script_count, elapsed_time, batch.job_count,
+    elapsed_time > 0 ? batch.script_count / elapsed_time : 0.0
+  );
+
+  pthread_mutex_destroy(&batch.emission_mutex);
+  for (int i = 0; i < batch.job_count; i++) pthread_mutex_destroy(&batch.work_queues[i].mutex);
+  free(batch.work_queues);
+  free(batch.scripts);
+  free(manifest);
+
+  return error_code;
+#endif
+}
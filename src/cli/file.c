@@ -1,5 +1,6 @@
 #include "cli/file.h"
 
+#include "global.h"
 #include "interpreter.h"
 #include "utils/io.h"
 
@@ -18,7 +19,8 @@ ErrorCode file_interpret(char const *const source_file_path) {
   interpreter_init();
 
   char *const source_code = io_read_text_file(source_file_path);
-  InterpreterStatus const interpreter_status = interpreter_interpret(source_code);
+  InterpreterStatus const interpreter_status =
+    g_is_interpretation_pipelined ? interpreter_interpret_pipelined(source_code) : interpreter_interpret(source_code);
 
   // map interpreter_status to error_code
   static_assert(INTERPRETER_STATUS_COUNT == 4, "Exhaustive InterpreterStatus handling");
@@ -17,13 +17,83 @@ void manual_print(void) {
     "NAME\n"
     "       cla - Custom Lox Abomination interpreter written in C\n"
     "\nSYNOPSIS\n"
-    "       cla [-h|--help] [path]\n"
+    "       cla [-h|--help] [--async-output] [--budget N] [--timeout SECONDS] [path]\n"
+    "       cla [--async-output] --pipelined path\n"
+    "       cla --jobs N [--manifest manifest_path] [path...]\n"
+    "       cla --each records_path [--jobs N] path\n"
+    "       cla --serve [--socket socket_path] [--jobs N]\n"
+    "       cla --client [--socket socket_path] path\n"
     "\nUSAGE\n"
     "       CLA code can be supplied via source file path, or directly through built-in REPL.\n"
     "       REPL is the default interaction mode, entered unless path argument is supplied.\n"
+    "       When stdin isn't a terminal (e.g. it's a pipe), its content is interpreted as it arrives instead; each\n"
+    "       statement gets executed as soon as ';' terminating it is read.\n"
+    "       Many source files can be interpreted at once in batch mode, requested with '--jobs' option.\n"
+    "       Source file can also be executed for every record of CSV or NDJSON file, with '--each' option.\n"
+    "       Long-lived server ('--serve') interprets source files supplied by clients ('--client'), sparing them\n"
+    "       interpreter startup cost.\n"
+  );
+  io_printf(
     "\nOPTIONS\n"
     "       -h, --help\n"
     "           Get help; print out this manual and exit.\n"
+    "\n"
+    "       --async-output\n"
+    "           Write program output on a dedicated thread, so that slow output destinations (e.g. pipes) don't stall\n"
+    "           execution. Output ordering is preserved. POSIX only.\n"
+    "\n"
+    "       --budget N\n"
+    "           Fail execution (with execution error) once it runs more than N bytecode bytes (instructions take 1\n"
+    "           to 3 bytes). Applies to the whole of every interpreted source file (even if it's pipelined or\n"
+    "           streamed), to every REPL line, and to every record of '--each', in every interaction mode but\n"
+    "           '--client' (server enforces its own budget). Checked at statement boundaries.\n"
+    "\n"
+    "       --timeout SECONDS\n"
+    "           Fail execution (with execution error) once it runs longer than SECONDS of wall-clock time. Applies\n"
+    "           like '--budget', and gets checked every few hundred statements.\n"
+    "\n"
+    "       --pipelined\n"
+    "           Compile source file in batches of statements on a dedicated thread, executing (and releasing) each\n"
+    "           batch while subsequent ones are still being compiled. Output of long source files appears sooner, and\n"
+    "           less memory is used. Static analysis error stops interpretation at batch it's found in, hence\n"
+    "           preceding batches get executed.\n"
+    "\n"
+    "       --jobs N\n"
+    "           Interpret every path argument (and every path listed by '--manifest') in batch mode, using N worker\n"
+    "           threads. Every source file is interpreted in isolation, and its output is emitted in path order.\n"
+    "           Throughput report is printed to stderr at the end. Exit code is the one of the first source file that\n"
+    "           failed to be interpreted. POSIX only.\n"
+    "\n"
+    "       --manifest manifest_path\n"
+    "           Read batch mode paths from manifest file, one path per line. Requires '--jobs'.\n"
+    "\n"
+    "       --each records_path\n"
+    "           Compile source file at path once, and execute it for every record of records file, in isolation.\n"
+    "           Records file is NDJSON (one JSON object per line) if it has '.ndjson' or '.jsonl' extension, and CSV\n"
+    "           otherwise. Record fields are exposed as inputs named after CSV header fields (or keys of the first\n"
+    "           NDJSON record), referenced by identifiers. Numeric fields are numbers, empty CSV fields are nil, and\n"
+    "           nested JSON values are strings holding their JSON text; blank lines are skipped. Records file is\n"
+    "           streamed, and '--jobs' shards it across N worker threads at record boundaries, preserving output\n"
+    "           order. Records that fail to be parsed or executed are reported as record errors, and processing\n"
+    "           carries on; exit code is the one of the first failed record (malformed records yield '%d').\n"
+    "\n"
+    "       --serve\n"
+    "           Serve interpretation requests on Unix domain socket until interrupted (SIGINT or SIGTERM), using N\n"
+    "           worker threads when combined with '--jobs' (processor count by default). Every request is interpreted\n"
+    "           in isolation, by a pooled VM. POSIX only.\n"
+    "\n"
+    "       --client\n"
+    "           Interpret source file at path by the server listening on socket. Program output and errors are\n"
+    "           written directly to client's stdout and stderr, and exit code is the one of remote interpretation.\n"
+    "           POSIX only.\n"
+    "\n"
+    "       --socket socket_path\n"
+    "           Unix domain socket path used by '--serve' and '--client' ('$XDG_RUNTIME_DIR/cla.sock' by default,\n"
+    "           or '/tmp/cla-UID/cla.sock' in private directory if XDG_RUNTIME_DIR isn't set, where UID is user ID).\n"
+    "           Socket is accessible to server's user only, and both ends refuse peers run by other users.\n",
+    ERROR_CODE_IO
+  );
+  io_printf(
     "\nEXIT CODES\n"
     "       Exit code indicates whether cla successfully run, or failed for some reason.\n"
     "       Different exit codes indicate different failure causes:\n"
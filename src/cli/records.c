@@ -0,0 +1,1152 @@
+#ifndef _WIN32
+#define _POSIX_C_SOURCE 200809L
+#endif
+
+#include "cli/records.h"
+
+#include "backend/object.h"
+#include "backend/value.h"
+#include "backend/vm.h"
+#include "common.h"
+#include "global.h"
+#include "program.h"
+#include "utils/error.h"
+#include "utils/io.h"
+#include "utils/memory.h"
+#include "utils/memory_arena.h"
+#include "utils/number.h"
+
+#include <assert.h>
+#include <errno.h>
+#include <stdbool.h>
+#include <stdint.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#ifndef _WIN32
+#include <pthread.h>
+#endif
+
+// *---------------------------------------------*
+// *              MACRO DEFINITIONS              *
+// *---------------------------------------------*
+
+/// Minimum size of records file portion read at once; every such portion (cut at record boundary) makes a shard.
+#define RECORDS_SHARD_SIZE (1024 * 1024)
+
+/// Maximum count of shards held in memory per worker (read ahead of, or awaiting emission in record order).
+#define RECORDS_MAX_PENDING_SHARDS_PER_WORKER 2
+
+#define RECORDS_OBJECT_ARENA_BLOCK_SIZE (64 * 1024)
+
+/// Size of buffer used for parsing numeric fields in exponential notation.
+#define RECORDS_NUMBER_BUFFER_SIZE 64
+
+#define RECORDS_UTF8_BOM "\xEF\xBB\xBF"
+
+// *---------------------------------------------*
+// *              TYPE DEFINITIONS               *
+// *---------------------------------------------*
+
+/// Records file format.
+typedef enum {
+  RECORDS_FORMAT_CSV, // RFC 4180; the first record is a header naming fields
+  RECORDS_FORMAT_NDJSON, // one JSON object per line; keys of the first record name fields
+} RecordsFormat;
+
+/// Portion of records file consisting of complete records.
+typedef struct RecordShard RecordShard;
+struct RecordShard {
+  RecordShard *next; // shard that follows in records file (NULL if there's none yet)
+  char *data; // heap-allocated
+  size_t length;
+  int first_line; // line of records file that shard begins at
+  char *program_output, *error_output; // heap-allocated by memory streams (POSIX only)
+  size_t program_output_length, error_output_length;
+  ErrorCode error_code; // error code of the first record that failed to be processed
+  bool is_processed;
+};
+
+/// Sequential records file reader, splitting it into shards.
+typedef struct {
+  FILE *file;
+  RecordsFormat format;
+  char *carry; // incomplete record trailing the most recently read shard (heap-allocated)
+  size_t carry_length, carry_capacity;
+  int next_line;
+  bool is_exhausted;
+} RecordReader;
+
+/// Record field parsed out of shard.
+typedef struct {
+  char const *key; // NDJSON key (not NUL terminated); NULL for CSV fields
+  int key_length;
+  char const *string; // string field content (not NUL terminated); NULL unless field holds a string
+  int string_length;
+  Value value; // value of non-string field
+} RecordField;
+
+/// Shard record parser.
+typedef struct {
+  char const *cursor, *end;
+  int line; // line of records file that cursor is at
+  char *scratch; // receives unescaped string content (capable of holding the whole shard)
+  char *scratch_cursor;
+  char const *error_message; // describes why record parsing failed
+} RecordParser;
+
+/// Script execution state shared (read-only) by all workers.
+typedef struct {
+  char const *records_path, *script_path;
+  RecordsFormat format;
+  Program const *program;
+  char const *const *field_names; // VM input slot names
+  int field_count;
+} RecordProcessor;
+
+/// Record processing worker state.
+typedef struct {
+  RecordProcessor const *processor;
+  VM vm; // recycled for every record, so that records are processed in isolation
+  MemoryArena object_arena;
+  MemoryAllocator object_allocator;
+  char *scratch; // parser scratch buffer (heap-allocated)
+  size_t scratch_capacity;
+} RecordWorker;
+
+#ifndef _WIN32
+/// Shards shared by the reading thread and workers. Shards are queued in records file order, and their output is
+/// emitted in the same order.
+typedef struct {
+  pthread_mutex_t mutex;
+  pthread_cond_t shard_queued; // signaled when shard gets queued, or reader gets exhausted
+  pthread_cond_t shard_emitted;
+  RecordShard *first_pending_shard; // the oldest shard that hasn't been emitted yet (NULL if there's none)
+  RecordShard *last_pending_shard;
+  RecordShard *next_untaken_shard; // the oldest shard that hasn't been taken by worker (NULL if there's none)
+  int pending_shard_count, max_pending_shard_count;
+  bool is_reader_exhausted;
+  ErrorCode error_code;
+} RecordShardQueue;
+
+/// Record processing worker thread context.
+typedef struct {
+  RecordWorker worker;
+  RecordShardQueue *queue;
+  pthread_t thread;
+} RecordWorkerThread;
+#endif
+
+// *---------------------------------------------*
+// *         INTERNAL-LINKAGE FUNCTIONS          *
+// *---------------------------------------------*
+
+/// Determine `records_path` file format from its extension ('.ndjson' and '.jsonl' denote NDJSON, others CSV).
+/// @return Records format.
+static RecordsFormat get_records_format(char const *const records_path) {
+  char const *const extension = strrchr(records_path, '.');
+  if (extension != NULL && (strcmp(extension, ".ndjson") == 0 || strcmp(extension, ".jsonl") == 0)) {
+    return RECORDS_FORMAT_NDJSON;
+  }
+  return RECORDS_FORMAT_CSV;
+}
+
+/// Count line feeds among `length` bytes of `data`.
+/// @return Line feed count.
+static int count_line_feeds(char const *const data, size_t const length) {
+  int line_feed_count = 0;
+  for (size_t i = 0; i < length; i++) line_feed_count += data[i] == '\n';
+  return line_feed_count;
+}
+
+/// Find end of CSV record beginning at `cursor`: position following the first line feed that lies outside of quoted
+/// fields. Like parse_csv_record, only quotes beginning fields open quoted fields (others are part of field content).
+/// @return Record end, or NULL if record isn't terminated before `end`.
+static char const *find_csv_record_end(char const *cursor, char const *const end) {
+  bool is_field_start = true;
+
+  while (cursor < end) {
+    char const character = *cursor++;
+
+    if (character == '"' && is_field_start) {
+      // skip quoted field content up to its closing quote ('""' denotes escaped quote)
+      for (;; cursor++) {
+        if (cursor == end) return NULL;
+        if (*cursor != '"') continue;
+        if (cursor + 1 == end || cursor[1] != '"') break;
+        cursor++;
+      }
+      cursor++;
+      is_field_start = false;
+      continue;
+    }
+
+    if (character == '\n') return cursor;
+    is_field_start = character == ',';
+  }
+
+  return NULL;
+}
+
+/// Find end of the last complete `format` record among `length` bytes of `data` (which begins at record boundary).
+/// @return Offset following the line feed terminating that record, or 0 if there's no complete record.
+static size_t find_last_record_boundary(RecordsFormat const format, char const *const data, size_t const length) {
+  // CSV line feeds terminate records only outside of quoted fields (JSON strings can't contain raw line feeds)
+  if (format == RECORDS_FORMAT_CSV) {
+    size_t boundary = 0;
+    for (char const *record_end = data; (record_end = find_csv_record_end(record_end, data + length)) != NULL;) {
+      boundary = record_end - data;
+    }
+    return boundary;
+  }
+
+  for (size_t i = length; i > 0; i--) {
+    if (data[i - 1] == '\n') return i;
+  }
+  return 0;
+}
+
+/// Initialize `reader` reading `format` records from `records_path` file.
+static void reader_init(RecordReader *const reader, char const *const records_path, RecordsFormat const format) {
+  FILE *const file = fopen(records_path, "rb");
+  if (file == NULL) ERROR_IO("Failed to open file '%s'" COMMON_MS "%s\n", records_path, strerror(errno));
+
+  // shards are large, so stream buffering would merely add a copy
+  if (setvbuf(file, NULL, _IONBF, 0)) ERROR_IO_ERRNO();
+
+  *reader = (RecordReader){.file = file, .format = format, .next_line = 1};
+
+  // skip byte order mark, otherwise carry bytes read in its place over to the first shard
+  size_t const bom_length = sizeof(RECORDS_UTF8_BOM) - 1;
+  char bom[sizeof(RECORDS_UTF8_BOM) - 1];
+  size_t const read_length = fread(bom, 1, bom_length, file);
+  if (ferror(file)) ERROR_IO_ERRNO();
+  if (read_length == bom_length && memcmp(bom, RECORDS_UTF8_BOM, bom_length) == 0) return;
+
+  reader->carry = malloc(bom_length);
+  if (reader->carry == NULL) ERROR_MEMORY_ERRNO();
+  memcpy(reader->carry, bom, read_length);
+  reader->carry_length = read_length;
+  reader->carry_capacity = bom_length;
+}
+
+/// Release `reader` resources.
+static void reader_destroy(RecordReader *const reader) {
+  if (fclose(reader->file)) ERROR_IO_ERRNO();
+  free(reader->carry);
+}
+
+/// Read next shard of about RECORDS_SHARD_SIZE bytes (more if single record exceeds it) out of `reader` file.
+/// Shards end at record boundary; incomplete record that follows is carried over to the next shard.
+/// @return Heap-allocated shard, or NULL if `reader` is exhausted.
+static RecordShard *reader_read_shard(RecordReader *const reader) {
+  if (reader->is_exhausted) return NULL;
+
+  size_t capacity = reader->carry_length > RECORDS_SHARD_SIZE ? reader->carry_length * 2 : RECORDS_SHARD_SIZE;
+  char *data = malloc(capacity);
+  if (data == NULL) ERROR_MEMORY_ERRNO();
+
+  size_t length = reader->carry_length;
+  if (length > 0) memcpy(data, reader->carry, length);
+
+  size_t boundary;
+  for (;;) {
+    length += fread(data + length, 1, capacity - length, reader->file);
+    if (ferror(reader->file)) ERROR_IO_ERRNO();
+
+    // the last record doesn't need to be terminated
+    if (feof(reader->file)) {
+      reader->is_exhausted = true;
+      boundary = length;
+      break;
+    }
+
+    boundary = find_last_record_boundary(reader->format, data, length);
+    if (boundary > 0) break;
+
+    // record is longer than shard
+    capacity *= 2;
+    data = realloc(data, capacity);
+    if (data == NULL) ERROR_MEMORY_ERRNO();
+  }
+
+  reader->carry_length = length - boundary;
+  if (reader->carry_length > reader->carry_capacity) {
+    reader->carry_capacity = reader->carry_length;
+    reader->carry = realloc(reader->carry, reader->carry_capacity);
+    if (reader->carry == NULL) ERROR_MEMORY_ERRNO();
+  }
+  if (reader->carry_length > 0) memcpy(reader->carry, data + boundary, reader->carry_length);
+
+  if (boundary == 0) {
+    free(data);
+    return NULL;
+  }
+
+  RecordShard *const shard = malloc(sizeof(RecordShard));
+  if (shard == NULL) ERROR_MEMORY_ERRNO();
+  *shard = (RecordShard){.data = data, .length = boundary, .first_line = reader->next_line};
+
+  reader->next_line += count_line_feeds(data, boundary);
+
+  return shard;
+}
+
+/// Make `parser` fail to parse current record due to `error_message`.
+/// @return false (meant to be forwarded as a parsing failure indication).
+static bool fail_record(RecordParser *const parser, char const *const error_message) {
+  parser->error_message = error_message;
+  return false;
+}
+
+/// Parse `content` of `length` as a number, in CLA numeric literal notation optionally preceded by '-' sign and
+/// followed by an exponent (as in JSON).
+/// @return true if `content` is such a number (within double range), false otherwise.
+static bool parse_number(char const *const content, int const length, double *const result) {
+  int i = content[0] == '-';
+  int const digits_start = i;
+  while (i < length && content[i] >= '0' && content[i] <= '9') i++;
+  if (i == digits_start) return false;
+
+  if (i < length && content[i] == '.') {
+    int const fraction_start = ++i;
+    while (i < length && content[i] >= '0' && content[i] <= '9') i++;
+    if (i == fraction_start) return false;
+  }
+  int const significand_end = i;
+
+  if (i < length && (content[i] == 'e' || content[i] == 'E')) {
+    i++;
+    if (i < length && (content[i] == '+' || content[i] == '-')) i++;
+    int const exponent_start = i;
+    while (i < length && content[i] >= '0' && content[i] <= '9') i++;
+    if (i == exponent_start) return false;
+  }
+  if (i != length) return false;
+
+  if (significand_end == length) {
+    if (!number_parse(content + digits_start, length - digits_start, result)) return false;
+    if (digits_start > 0) *result = -*result;
+    return true;
+  }
+
+  // exponential notation is rare in records, hence it's left to strtod
+  if (length >= RECORDS_NUMBER_BUFFER_SIZE) return false;
+  char buffer[RECORDS_NUMBER_BUFFER_SIZE];
+  memcpy(buffer, content, length);
+  buffer[length] = '\0';
+
+  errno = 0;
+  *result = strtod(buffer, NULL);
+  return errno != ERANGE;
+}
+
+/// Skip `parser` blank line (one holding nothing but whitespace), unless current record isn't blank.
+/// @return true if blank line got skipped, false otherwise.
+static bool skip_blank_line(RecordParser *const parser) {
+  char const *cursor = parser->cursor;
+  while (cursor < parser->end && (*cursor == ' ' || *cursor == '\t' || *cursor == '\r')) cursor++;
+
+  if (cursor < parser->end && *cursor != '\n') return false;
+
+  parser->cursor = cursor < parser->end ? cursor + 1 : cursor;
+  parser->line++;
+  return true;
+}
+
+/// Skip `parser` record that failed to be parsed (`record_start` denotes its beginning, and `parser` line is still the
+/// one it begins at).
+static void skip_failed_record(RecordParser *const parser, RecordsFormat const format, char const *const record_start) {
+  char const *cursor;
+  if (format == RECORDS_FORMAT_CSV) cursor = find_csv_record_end(record_start, parser->end);
+  else {
+    cursor = memchr(record_start, '\n', parser->end - record_start);
+    if (cursor != NULL) cursor++;
+  }
+  if (cursor == NULL) cursor = parser->end;
+
+  parser->line += count_line_feeds(record_start, cursor - record_start);
+  parser->cursor = cursor;
+}
+
+/// Parse unquoted CSV `field` content of `length` (empty fields are nil, numeric ones are numbers, others strings).
+static void parse_unquoted_csv_field(char const *const content, int const length, RecordField *const field) {
+  double number;
+  if (length == 0) field->value = value_make_nil();
+  else if (parse_number(content, length, &number)) field->value = value_make_number(number);
+  else {
+    field->string = content;
+    field->string_length = length;
+  }
+}
+
+/// Parse `parser` CSV record into `fields`.
+/// @param field_count Receives number of parsed fields.
+/// @return true if record got parsed, false otherwise (`parser` error message describes why).
+static bool parse_csv_record(RecordParser *const parser, RecordField *const fields, int *const field_count) {
+  char const *cursor = parser->cursor;
+  char const *const end = parser->end;
+  int line = parser->line;
+  *field_count = 0;
+
+  for (;;) {
+    if (*field_count == RECORDS_MAX_FIELD_COUNT) return fail_record(parser, "Record exceeds field count limit");
+    RecordField *const field = &fields[(*field_count)++];
+    *field = (RecordField){0};
+
+    if (cursor < end && *cursor == '"') {
+      // quoted fields are always strings; their content is unescaped into scratch buffer
+      char *const content = parser->scratch_cursor;
+      int length = 0;
+
+      for (cursor++;; cursor++) {
+        if (cursor == end) return fail_record(parser, "Unterminated quoted field");
+        if (*cursor == '"') {
+          if (cursor + 1 == end || cursor[1] != '"') break;
+          cursor++;
+        } else if (*cursor == '\n') line++;
+        content[length++] = *cursor;
+      }
+      cursor++;
+
+      parser->scratch_cursor += length;
+      field->string = content;
+      field->string_length = length;
+
+      if (cursor < end && *cursor == '\r' && (cursor + 1 == end || cursor[1] == '\n')) cursor++;
+      if (cursor < end && *cursor != ',' && *cursor != '\n') {
+        return fail_record(parser, "Expected ',' or record end following quoted field");
+      }
+    } else {
+      char const *const content = cursor;
+      while (cursor < end && *cursor != ',' && *cursor != '\n') cursor++;
+
+      // accommodate CRLF line endings
+      int length = cursor - content;
+      if ((cursor == end || *cursor == '\n') && length > 0 && content[length - 1] == '\r') length--;
+
+      parse_unquoted_csv_field(content, length, field);
+    }
+
+    if (cursor < end && *cursor == ',') {
+      cursor++;
+      continue;
+    }
+    break;
+  }
+
+  // consume record terminator
+  if (cursor < end) {
+    cursor++;
+    line++;
+  }
+
+  parser->cursor = cursor;
+  parser->line = line;
+  return true;
+}
+
+/// Skip JSON whitespace at `cursor` (line feeds excluded, as they terminate NDJSON records).
+/// @return Cursor past whitespace.
+static char const *skip_json_whitespace(char const *cursor, char const *const end) {
+  while (cursor < end && (*cursor == ' ' || *cursor == '\t' || *cursor == '\r')) cursor++;
+  return cursor;
+}
+
+/// Parse 4 hexadecimal digits at `cursor`.
+/// @return Parsed code unit, or -1 if there aren't 4 hexadecimal digits.
+static long parse_json_code_unit(char const *const cursor, char const *const end) {
+  if (end - cursor < 4) return -1;
+
+  long code_unit = 0;
+  for (int i = 0; i < 4; i++) {
+    char const digit = cursor[i];
+    code_unit <<= 4;
+    if (digit >= '0' && digit <= '9') code_unit |= digit - '0';
+    else if (digit >= 'a' && digit <= 'f') code_unit |= digit - 'a' + 10;
+    else if (digit >= 'A' && digit <= 'F') code_unit |= digit - 'A' + 10;
+    else return -1;
+  }
+
+  return code_unit;
+}
+
+/// Encode `code_point` as UTF-8 into `buffer`.
+/// @return Number of written bytes.
+static int encode_utf8(long const code_point, char *const buffer) {
+  if (code_point < 0x80) {
+    buffer[0] = code_point;
+    return 1;
+  }
+  if (code_point < 0x800) {
+    buffer[0] = 0xC0 | (code_point >> 6);
+    buffer[1] = 0x80 | (code_point & 0x3F);
+    return 2;
+  }
+  if (code_point < 0x10000) {
+    buffer[0] = 0xE0 | (code_point >> 12);
+    buffer[1] = 0x80 | ((code_point >> 6) & 0x3F);
+    buffer[2] = 0x80 | (code_point & 0x3F);
+    return 3;
+  }
+  buffer[0] = 0xF0 | (code_point >> 18);
+  buffer[1] = 0x80 | ((code_point >> 12) & 0x3F);
+  buffer[2] = 0x80 | ((code_point >> 6) & 0x3F);
+  buffer[3] = 0x80 | (code_point & 0x3F);
+  return 4;
+}
+
+/// Parse JSON string beginning at `parser` cursor (opening quote). Strings without escape sequences point directly
+/// into shard, while others get unescaped into scratch buffer.
+/// @return true if string got parsed, false otherwise.
+static bool parse_json_string(RecordParser *const parser, char const **const content, int *const length) {
+  char const *cursor = parser->cursor + 1;
+  char const *const end = parser->end;
+
+  char const *const raw_content = cursor;
+  while (cursor < end && *cursor != '"' && *cursor != '\\' && (unsigned char)*cursor >= 0x20) cursor++;
+  if (cursor < end && *cursor == '"') {
+    *content = raw_content;
+    *length = cursor - raw_content;
+    parser->cursor = cursor + 1;
+    return true;
+  }
+
+  char *const unescaped_content = parser->scratch_cursor;
+  int unescaped_length = cursor - raw_content;
+  memcpy(unescaped_content, raw_content, unescaped_length);
+
+  for (;;) {
+    if (cursor == end) return fail_record(parser, "Unterminated string");
+    unsigned char const character = *cursor++;
+
+    if (character == '"') break;
+    if (character < 0x20) return fail_record(parser, "Unescaped control character in string");
+    if (character != '\\') {
+      unescaped_content[unescaped_length++] = character;
+      continue;
+    }
+
+    if (cursor == end) return fail_record(parser, "Unterminated string");
+    switch (*cursor++) {
+      case '"': unescaped_content[unescaped_length++] = '"'; break;
+      case '\\': unescaped_content[unescaped_length++] = '\\'; break;
+      case '/': unescaped_content[unescaped_length++] = '/'; break;
+      case 'b': unescaped_content[unescaped_length++] = '\b'; break;
+      case 'f': unescaped_content[unescaped_length++] = '\f'; break;
+      case 'n': unescaped_content[unescaped_length++] = '\n'; break;
+      case 'r': unescaped_content[unescaped_length++] = '\r'; break;
+      case 't': unescaped_content[unescaped_length++] = '\t'; break;
+      case 'u': {
+        long code_point = parse_json_code_unit(cursor, end);
+        if (code_point < 0) return fail_record(parser, "Invalid unicode escape sequence");
+        cursor += 4;
+
+        // code points beyond basic multilingual plane are escaped as surrogate pairs
+        if (code_point >= 0xD800 && code_point <= 0xDBFF) {
+          long const low_surrogate = end - cursor >= 6 && cursor[0] == '\\' && cursor[1] == 'u'
+                                       ? parse_json_code_unit(cursor + 2, end)
+                                       : -1;
+          if (low_surrogate < 0xDC00 || low_surrogate > 0xDFFF) {
+            return fail_record(parser, "Invalid unicode escape sequence");
+          }
+          code_point = 0x10000 + ((code_point - 0xD800) << 10) + (low_surrogate - 0xDC00);
+          cursor += 6;
+        } else if (code_point >= 0xDC00 && code_point <= 0xDFFF) {
+          return fail_record(parser, "Invalid unicode escape sequence");
+        }
+
+        unescaped_length += encode_utf8(code_point, unescaped_content + unescaped_length);
+        break;
+      }
+      default: return fail_record(parser, "Invalid escape sequence");
+    }
+  }
+
+  parser->scratch_cursor += unescaped_length;
+  *content = unescaped_content;
+  *length = unescaped_length;
+  parser->cursor = cursor;
+  return true;
+}
+
+/// Parse JSON value beginning at `parser` cursor into `field`. Nested objects and arrays are exposed as strings
+/// holding their JSON text.
+/// @return true if value got parsed, false otherwise.
+static bool parse_json_value(RecordParser *const parser, RecordField *const field) {
+  char const *cursor = parser->cursor;
+  char const *const end = parser->end;
+  if (cursor == end) return fail_record(parser, "Expected value");
+
+  switch (*cursor) {
+    case '"': return parse_json_string(parser, &field->string, &field->string_length);
+    case '{':
+    case '[': {
+      int depth = 0;
+      do {
+        if (cursor == end || *cursor == '\n') return fail_record(parser, "Unterminated nested value");
+
+        if (*cursor == '"') {
+          parser->cursor = cursor;
+          char const *string_content;
+          int string_length;
+          if (!parse_json_string(parser, &string_content, &string_length)) return false;
+          cursor = parser->cursor;
+          continue;
+        }
+        if (*cursor == '{' || *cursor == '[') depth++;
+        else if (*cursor == '}' || *cursor == ']') depth--;
+        cursor++;
+      } while (depth > 0);
+
+      // nested value text is exposed by caller (once its extent is known)
+      parser->cursor = cursor;
+      return true;
+    }
+    case 't':
+    case 'f':
+    case 'n': {
+      char const *const literals[] = {"true", "false", "null"};
+      Value const literal_values[] = {value_make_bool(true), value_make_bool(false), value_make_nil()};
+
+      for (int i = 0; i < 3; i++) {
+        size_t const literal_length = strlen(literals[i]);
+        if ((size_t)(end - cursor) < literal_length || memcmp(cursor, literals[i], literal_length) != 0) continue;
+
+        field->value = literal_values[i];
+        parser->cursor = cursor + literal_length;
+        return true;
+      }
+      return fail_record(parser, "Expected value");
+    }
+    default: {
+      char const *const number_start = cursor;
+      while (cursor < end && ((*cursor >= '0' && *cursor <= '9') || *cursor == '-' || *cursor == '+' ||
+                              *cursor == '.' || *cursor == 'e' || *cursor == 'E')) {
+        cursor++;
+      }
+
+      double number;
+      if (cursor == number_start) return fail_record(parser, "Expected value");
+      if (!parse_number(number_start, cursor - number_start, &number)) return fail_record(parser, "Invalid number");
+
+      field->value = value_make_number(number);
+      parser->cursor = cursor;
+      return true;
+    }
+  }
+}
+
+/// Parse `parser` NDJSON record (JSON object) into `fields`.
+/// @param field_count Receives number of parsed fields.
+/// @return true if record got parsed, false otherwise (`parser` error message describes why).
+static bool parse_ndjson_record(RecordParser *const parser, RecordField *const fields, int *const field_count) {
+  char const *const end = parser->end;
+  *field_count = 0;
+
+  parser->cursor = skip_json_whitespace(parser->cursor, end);
+  if (parser->cursor == end || *parser->cursor != '{') return fail_record(parser, "Expected record to be an object");
+  parser->cursor = skip_json_whitespace(parser->cursor + 1, end);
+
+  if (parser->cursor < end && *parser->cursor == '}') parser->cursor++;
+  else {
+    for (;;) {
+      if (*field_count == RECORDS_MAX_FIELD_COUNT) return fail_record(parser, "Record exceeds field count limit");
+      RecordField *const field = &fields[(*field_count)++];
+      *field = (RecordField){0};
+
+      if (parser->cursor == end || *parser->cursor != '"') return fail_record(parser, "Expected key");
+      if (!parse_json_string(parser, &field->key, &field->key_length)) return false;
+
+      parser->cursor = skip_json_whitespace(parser->cursor, end);
+      if (parser->cursor == end || *parser->cursor != ':') return fail_record(parser, "Expected ':' following key");
+      parser->cursor = skip_json_whitespace(parser->cursor + 1, end);
+
+      char const *const value_start = parser->cursor;
+      if (!parse_json_value(parser, field)) return false;
+      if (*value_start == '{' || *value_start == '[') {
+        field->string = value_start;
+        field->string_length = parser->cursor - value_start;
+      }
+
+      parser->cursor = skip_json_whitespace(parser->cursor, end);
+      if (parser->cursor < end && *parser->cursor == ',') {
+        parser->cursor = skip_json_whitespace(parser->cursor + 1, end);
+        continue;
+      }
+      if (parser->cursor < end && *parser->cursor == '}') {
+        parser->cursor++;
+        break;
+      }
+      return fail_record(parser, "Expected ',' or '}' following value");
+    }
+  }
+
+  parser->cursor = skip_json_whitespace(parser->cursor, end);
+  if (parser->cursor < end && *parser->cursor != '\n') return fail_record(parser, "Expected record end");
+
+  // consume record terminator
+  if (parser->cursor < end) parser->cursor++;
+  parser->line++;
+  return true;
+}
+
+/// Parse `parser` record of `format` into `fields`.
+/// @param field_count Receives number of parsed fields.
+/// @return true if record got parsed, false otherwise (`parser` error message describes why).
+static bool parse_record(
+  RecordParser *const parser, RecordsFormat const format, RecordField *const fields, int *const field_count
+) {
+  parser->scratch_cursor = parser->scratch;
+  parser->error_message = NULL;
+
+  if (format == RECORDS_FORMAT_CSV) return parse_csv_record(parser, fields, field_count);
+  return parse_ndjson_record(parser, fields, field_count);
+}
+
+/// Read field names out of the first record of `reader` records file, which `first_shard` (NULL if file is empty)
+/// begins with. CSV header is consumed from `first_shard`, while the first NDJSON record is kept (it's a data record).
+/// @param field_count Receives number of field names.
+/// @return Heap-allocated array of heap-allocated, NUL terminated field names (NULL if there are none).
+static char **read_field_names(
+  RecordReader const *const reader, char const *const records_path, RecordShard *const first_shard,
+  int *const field_count
+) {
+  *field_count = 0;
+  if (first_shard == NULL) return NULL;
+
+  char *const scratch = malloc(first_shard->length > 0 ? first_shard->length : 1);
+  if (scratch == NULL) ERROR_MEMORY_ERRNO();
+  RecordParser parser = {
+    .cursor = first_shard->data,
+    .end = first_shard->data + first_shard->length,
+    .line = first_shard->first_line,
+    .scratch = scratch,
+  };
+
+  while (parser.cursor < parser.end && skip_blank_line(&parser));
+
+  RecordField fields[RECORDS_MAX_FIELD_COUNT];
+  int parsed_field_count;
+  if (!parse_record(&parser, reader->format, fields, &parsed_field_count)) {
+    // malformed NDJSON record gets reported during processing (it defines no fields)
+    if (reader->format == RECORDS_FORMAT_NDJSON) {
+      free(scratch);
+      return NULL;
+    }
+    ERROR_IO(
+      "Malformed header of '%s'" COMMON_MS COMMON_FILE_LINE_FORMAT COMMON_MS "%s\n", records_path, records_path,
+      parser.line, parser.error_message
+    );
+  }
+
+  char **const field_names = malloc(sizeof(char *) * (parsed_field_count > 0 ? parsed_field_count : 1));
+  if (field_names == NULL) ERROR_MEMORY_ERRNO();
+  for (int i = 0; i < parsed_field_count; i++) {
+    RecordField const *const field = &fields[i];
+    char const *const name = reader->format == RECORDS_FORMAT_CSV ? field->string : field->key;
+    int const name_length = reader->format == RECORDS_FORMAT_CSV ? field->string_length : field->key_length;
+
+    // non-string CSV header fields (e.g. numeric ones) can't name inputs, hence they're left unnamed
+    field_names[i] = malloc(name_length + 1);
+    if (field_names[i] == NULL) ERROR_MEMORY_ERRNO();
+    if (name != NULL) memcpy(field_names[i], name, name_length);
+    field_names[i][name != NULL ? name_length : 0] = '\0';
+  }
+  *field_count = parsed_field_count;
+
+  if (reader->format == RECORDS_FORMAT_CSV) {
+    size_t const header_length = parser.cursor - first_shard->data;
+    memmove(first_shard->data, parser.cursor, first_shard->length - header_length);
+    first_shard->length -= header_length;
+    first_shard->first_line = parser.line;
+  }
+
+  free(scratch);
+  return field_names;
+}
+
+/// Find VM input slot of `processor` field named `key` of `key_length`; field at `expected_slot` is checked first, as
+/// NDJSON records usually share key order.
+/// @return Input slot, or -1 if there's no such field.
+static int find_field_slot(
+  RecordProcessor const *const processor, char const *const key, int const key_length, int const expected_slot
+) {
+  for (int i = 0; i < processor->field_count; i++) {
+    int const slot = (expected_slot + i) % processor->field_count;
+    char const *const name = processor->field_names[slot];
+    if (strncmp(name, key, key_length) == 0 && name[key_length] == '\0') return slot;
+  }
+  return -1;
+}
+
+/// Initialize `worker` processing records of `processor`.
+static void worker_init(RecordWorker *const worker, RecordProcessor const *const processor) {
+  worker->processor = processor;
+  worker->scratch = NULL;
+  worker->scratch_capacity = 0;
+
+  memory_arena_init(&worker->object_arena, RECORDS_OBJECT_ARENA_BLOCK_SIZE, memory_manage);
+  worker->object_allocator = memory_arena_make_allocator(&worker->object_arena);
+
+  // VM gets configured for every record it executes
+  VMConfig const vm_config = {
+    .static_analysis_error_stream = stderr,
+    .bytecode_execution_error_stream = stderr,
+    .source_program_output_stream = stdout,
+    .memory_manager = memory_manage,
+    .object_allocator = &worker->object_allocator,
+  };
+  vm_init(&worker->vm, &vm_config);
+}
+
+/// Release `worker` resources.
+static void worker_destroy(RecordWorker *const worker) {
+  vm_destroy(&worker->vm);
+  memory_arena_destroy(&worker->object_arena);
+  free(worker->scratch);
+}
+
+/// Execute `worker` processor program for record made of `fields` of `field_count`, by freshly recycled VM.
+/// @return true if execution succeeded, false otherwise.
+static bool execute_record(
+  RecordWorker *const worker, VMConfig const *const vm_config, RecordField const *const fields, int const field_count
+) {
+  RecordProcessor const *const processor = worker->processor;
+  VM *const vm = &worker->vm;
+  vm_recycle(vm, vm_config);
+
+  Value inputs[RECORDS_MAX_FIELD_COUNT];
+  for (int i = 0; i < processor->field_count; i++) inputs[i] = value_make_nil();
+
+  for (int i = 0; i < field_count; i++) {
+    RecordField const *const field = &fields[i];
+
+    int const slot = field->key == NULL ? i : find_field_slot(processor, field->key, field->key_length, i);
+    if (slot == -1) continue;
+
+    inputs[slot] = field->string == NULL
+                     ? field->value
+                     : value_make_object((Object *)object_make_owning_string(vm, field->string, field->string_length));
+  }
+
+  vm->inputs = inputs;
+  return program_execute(processor->program, vm);
+}
+
+/// Process records of `shard` by `worker`, writing output into `program_output_stream` and errors into
+/// `error_output_stream`. Every record is processed in isolation, by VM recycled for it.
+/// @return Error code of the first record that failed to be processed, ERROR_CODE_SUCCESS if none did.
+static ErrorCode process_shard(
+  RecordWorker *const worker, RecordShard const *const shard, FILE *const program_output_stream,
+  FILE *const error_output_stream
+) {
+  RecordProcessor const *const processor = worker->processor;
+
+  // unescaped content is never longer than escaped one
+  if (worker->scratch_capacity < shard->length) {
+    free(worker->scratch);
+    worker->scratch_capacity = shard->length;
+    worker->scratch = malloc(worker->scratch_capacity);
+    if (worker->scratch == NULL) ERROR_MEMORY_ERRNO();
+  }
+
+  VMConfig const vm_config = {
+    .source_file_path = processor->script_path,
+    .static_analysis_error_stream = error_output_stream,
+    .bytecode_execution_error_stream = error_output_stream,
+    .source_program_output_stream = program_output_stream,
+    .memory_manager = memory_manage,
+    .object_allocator = &worker->object_allocator,
+    .input_names = processor->field_names,
+    .input_count = processor->field_count,
+    .bytecode_budget = g_execution_bytecode_budget,
+    .execution_timeout = g_execution_timeout,
+  };
+  RecordParser parser = {
+    .cursor = shard->data,
+    .end = shard->data + shard->length,
+    .line = shard->first_line,
+    .scratch = worker->scratch,
+  };
+  ErrorCode error_code = ERROR_CODE_SUCCESS;
+
+  while (parser.cursor < parser.end) {
+    if (skip_blank_line(&parser)) continue;
+
+    char const *const record_start = parser.cursor;
+    int const record_line = parser.line;
+
+    RecordField fields[RECORDS_MAX_FIELD_COUNT];
+    int field_count;
+    ErrorCode record_error_code = ERROR_CODE_SUCCESS;
+    char const *record_error_message;
+
+    if (!parse_record(&parser, processor->format, fields, &field_count)) {
+      skip_failed_record(&parser, processor->format, record_start);
+      record_error_code = ERROR_CODE_IO;
+      record_error_message = parser.error_message;
+    } else if (processor->format == RECORDS_FORMAT_CSV && field_count != processor->field_count) {
+      record_error_code = ERROR_CODE_IO;
+      record_error_message = "Field count differs from the one of header";
+    } else if (!execute_record(worker, &vm_config, fields, field_count)) {
+      // execution error is reported against the script, hence record that caused it is reported separately
+      record_error_code = ERROR_CODE_EXECUTION;
+      record_error_message = "Script execution failed";
+    }
+
+    if (record_error_code == ERROR_CODE_SUCCESS) continue;
+    io_fprintf(
+      error_output_stream, "[RECORD_ERROR]" COMMON_MS COMMON_FILE_LINE_FORMAT COMMON_MS "%s\n", processor->records_path,
+      record_line, record_error_message
+    );
+    if (error_code == ERROR_CODE_SUCCESS) error_code = record_error_code;
+  }
+
+  return error_code;
+}
+
+#ifndef _WIN32
+/// Process records of `shard` by `worker`, buffering its output and errors in memory (see emit_shard_output).
+static void process_shard_buffered(RecordWorker *const worker, RecordShard *const shard) {
+  FILE *const program_output_stream = open_memstream(&shard->program_output, &shard->program_output_length);
+  if (program_output_stream == NULL) ERROR_IO_ERRNO();
+  FILE *const error_output_stream = open_memstream(&shard->error_output, &shard->error_output_length);
+  if (error_output_stream == NULL) ERROR_IO_ERRNO();
+
+  shard->error_code = process_shard(worker, shard, program_output_stream, error_output_stream);
+
+  if (fclose(program_output_stream) == EOF) ERROR_IO_ERRNO();
+  if (fclose(error_output_stream) == EOF) ERROR_IO_ERRNO();
+}
+
+/// Emit output and errors buffered by processed `shard` into stdout and stderr, and release `shard`.
+static void emit_shard_output(RecordShard *const shard) {
+  if (fwrite(shard->program_output, 1, shard->program_output_length, stdout) < shard->program_output_length) {
+    ERROR_IO_ERRNO();
+  }
+  if (fwrite(shard->error_output, 1, shard->error_output_length, stderr) < shard->error_output_length) {
+    ERROR_IO_ERRNO();
+  }
+
+  free(shard->program_output);
+  free(shard->error_output);
+  free(shard->data);
+  free(shard);
+}
+
+/// Emit output of `queue` shards that have been processed and are no longer preceded by unprocessed ones, releasing
+/// them afterwards; this way output is emitted in records file order, regardless of job count.
+/// @note Requires `queue` mutex to be held.
+static void emit_processed_shards(RecordShardQueue *const queue) {
+  while (queue->first_pending_shard != NULL && queue->first_pending_shard->is_processed) {
+    RecordShard *const shard = queue->first_pending_shard;
+    if (queue->error_code == ERROR_CODE_SUCCESS) queue->error_code = shard->error_code;
+
+    queue->first_pending_shard = shard->next;
+    queue->pending_shard_count--;
+    emit_shard_output(shard);
+  }
+
+  pthread_cond_signal(&queue->shard_emitted);
+}
+
+/// Process shards taken from `thread_context` worker thread's queue until reader gets exhausted and there are none
+/// left, buffering their output until it can be emitted in order.
+/// @return NULL (signature conforms to pthread start routine).
+static void *run_worker_thread(void *const thread_context) {
+  RecordWorkerThread *const worker_thread = thread_context;
+  RecordShardQueue *const queue = worker_thread->queue;
+
+  for (;;) {
+    pthread_mutex_lock(&queue->mutex);
+    while (queue->next_untaken_shard == NULL && !queue->is_reader_exhausted) {
+      pthread_cond_wait(&queue->shard_queued, &queue->mutex);
+    }
+    RecordShard *const shard = queue->next_untaken_shard;
+    if (shard != NULL) queue->next_untaken_shard = shard->next;
+    pthread_mutex_unlock(&queue->mutex);
+
+    if (shard == NULL) break;
+
+    process_shard_buffered(&worker_thread->worker, shard);
+
+    pthread_mutex_lock(&queue->mutex);
+    shard->is_processed = true;
+    emit_processed_shards(queue);
+    pthread_mutex_unlock(&queue->mutex);
+  }
+
+  return NULL;
+}
+
+/// Queue `shard` for processing into `queue`, waiting until the count of pending shards drops below maximum.
+static void queue_shard(RecordShardQueue *const queue, RecordShard *const shard) {
+  pthread_mutex_lock(&queue->mutex);
+
+  while (queue->pending_shard_count >= queue->max_pending_shard_count) {
+    pthread_cond_wait(&queue->shard_emitted, &queue->mutex);
+  }
+
+  if (queue->first_pending_shard == NULL) queue->first_pending_shard = shard;
+  else queue->last_pending_shard->next = shard;
+  queue->last_pending_shard = shard;
+  if (queue->next_untaken_shard == NULL) queue->next_untaken_shard = shard;
+  queue->pending_shard_count++;
+
+  pthread_cond_signal(&queue->shard_queued);
+  pthread_mutex_unlock(&queue->mutex);
+}
+
+/// Process records of `processor` read by `reader` (beginning with `first_shard`) on `job_count` worker threads, while
+/// calling thread keeps reading shards ahead of them.
+/// @return Error code of the first record that failed to be processed, ERROR_CODE_SUCCESS if none did.
+static ErrorCode process_records_concurrently(
+  RecordProcessor const *const processor, RecordReader *const reader, RecordShard *const first_shard,
+  int const job_count
+) {
+  RecordShardQueue queue = {.max_pending_shard_count = job_count * RECORDS_MAX_PENDING_SHARDS_PER_WORKER};
+
+  int error_number = pthread_mutex_init(&queue.mutex, NULL);
+  if (error_number != 0) ERROR_SYSTEM("Failed to initialize mutex" COMMON_MS "%s\n", strerror(error_number));
+  error_number = pthread_cond_init(&queue.shard_queued, NULL);
+  if (error_number != 0) ERROR_SYSTEM("Failed to initialize condition" COMMON_MS "%s\n", strerror(error_number));
+  error_number = pthread_cond_init(&queue.shard_emitted, NULL);
+  if (error_number != 0) ERROR_SYSTEM("Failed to initialize condition" COMMON_MS "%s\n", strerror(error_number));
+
+  RecordWorkerThread *const worker_threads = malloc(sizeof(RecordWorkerThread) * job_count);
+  if (worker_threads == NULL) ERROR_MEMORY_ERRNO();
+
+  for (int i = 0; i < job_count; i++) {
+    worker_init(&worker_threads[i].worker, processor);
+    worker_threads[i].queue = &queue;
+
+    error_number = pthread_create(&worker_threads[i].thread, NULL, run_worker_thread, &worker_threads[i]);
+    if (error_number != 0) {
+      ERROR_SYSTEM("Failed to start record worker thread" COMMON_MS "%s\n", strerror(error_number));
+    }
+  }
+
+  for (RecordShard *shard = first_shard; shard != NULL; shard = reader_read_shard(reader)) queue_shard(&queue, shard);
+
+  pthread_mutex_lock(&queue.mutex);
+  queue.is_reader_exhausted = true;
+  pthread_cond_broadcast(&queue.shard_queued);
+  pthread_mutex_unlock(&queue.mutex);
+
+  for (int i = 0; i < job_count; i++) {
+    error_number = pthread_join(worker_threads[i].thread, NULL);
+    if (error_number != 0) {
+      ERROR_SYSTEM("Failed to join record worker thread" COMMON_MS "%s\n", strerror(error_number));
+    }
+    worker_destroy(&worker_threads[i].worker);
+  }
+  assert(queue.first_pending_shard == NULL && "Expected every shard to be emitted");
+
+  free(worker_threads);
+  pthread_cond_destroy(&queue.shard_emitted);
+  pthread_cond_destroy(&queue.shard_queued);
+  pthread_mutex_destroy(&queue.mutex);
+
+  return queue.error_code;
+}
+#endif
+
+/// Process records of `processor` read by `reader` (beginning with `first_shard`) on calling thread. Output of every
+/// shard is buffered and emitted at once (on POSIX), rather than being written into stdout by every record.
+/// @return Error code of the first record that failed to be processed, ERROR_CODE_SUCCESS if none did.
+static ErrorCode process_records(
+  RecordProcessor const *const processor, RecordReader *const reader, RecordShard *const first_shard
+) {
+  RecordWorker worker;
+  worker_init(&worker, processor);
+  ErrorCode error_code = ERROR_CODE_SUCCESS;
+
+  for (RecordShard *shard = first_shard; shard != NULL; shard = reader_read_shard(reader)) {
+#ifndef _WIN32
+    process_shard_buffered(&worker, shard);
+    if (error_code == ERROR_CODE_SUCCESS) error_code = shard->error_code;
+    emit_shard_output(shard);
+#else
+    ErrorCode const shard_error_code = process_shard(&worker, shard, stdout, stderr);
+    if (error_code == ERROR_CODE_SUCCESS) error_code = shard_error_code;
+
+    free(shard->data);
+    free(shard);
+#endif
+  }
+
+  worker_destroy(&worker);
+
+  return error_code;
+}
+
+// *---------------------------------------------*
+// *         EXTERNAL-LINKAGE FUNCTIONS          *
+// *---------------------------------------------*
+
+/// Compile script located at `script_path` once, and execute it for every record of `records_path` file (CSV, or
+/// NDJSON if it has '.ndjson' or '.jsonl' extension), whose fields are exposed to the script as inputs named after
+/// CSV header fields (or keys of the first NDJSON record). Records file is streamed in shards cut at record
+/// boundaries, processed by `job_count` worker threads (or calling thread if it's 1); source program output and errors
+/// are emitted into stdout and stderr respectively, in record order.
+/// @return Error code of the first record that failed to be processed (or ERROR_CODE_COMPILATION if script failed to
+/// be compiled), ERROR_CODE_SUCCESS if none did.
+ErrorCode records_interpret(char const *const records_path, char const *const script_path, int const job_count) {
+  assert(records_path != NULL);
+  assert(script_path != NULL);
+  assert(job_count >= 1);
+
+  RecordsFormat const format = get_records_format(records_path);
+  RecordReader reader;
+  reader_init(&reader, records_path, format);
+
+  int field_count;
+  RecordShard *const first_shard = reader_read_shard(&reader);
+  char **const field_names = read_field_names(&reader, records_path, first_shard, &field_count);
+
+  ProgramConfig const program_config = {
+    .source_file_path = script_path,
+    .static_analysis_error_stream = stderr,
+    .bytecode_execution_error_stream = stderr,
+    .source_program_output_stream = stdout,
+    .input_names = (char const *const *)field_names,
+    .input_count = field_count,
+  };
+  char *const source_code = io_read_text_file(script_path);
+  Program *program;
+  bool const is_compiled = program_compile(&program_config, source_code, &program);
+  free(source_code);
+
+  ErrorCode error_code = ERROR_CODE_COMPILATION;
+  if (is_compiled) {
+    RecordProcessor const processor = {
+      .records_path = records_path,
+      .script_path = script_path,
+      .format = format,
+      .program = program,
+      .field_names = (char const *const *)field_names,
+      .field_count = field_count,
+    };
+
+#ifndef _WIN32
+    if (job_count > 1) error_code = process_records_concurrently(&processor, &reader, first_shard, job_count);
+    else error_code = process_records(&processor, &reader, first_shard);
+#else
+    error_code = process_records(&processor, &reader, first_shard);
+#endif
+    program_destroy(program);
+  } else if (first_shard != NULL) {
+    free(first_shard->data);
+    free(first_shard);
+  }
+
+  if (fflush(stdout) == EOF) ERROR_IO_ERRNO();
+
+  for (int i = 0; i < field_count; i++) free(field_names[i]);
+  free(field_names);
+  reader_destroy(&reader);
+
+  return error_code;
+}
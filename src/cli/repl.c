@@ -9,14 +9,11 @@
 #include "cli/terminal.h"
 #include "global.h"
 #include "interpreter.h"
-#include "utils/darray.h"
 #include "utils/error.h"
 #include "utils/io.h"
-#include "utils/memory.h"
 
 #include <stdio.h>
 #include <stdlib.h>
-#include <string.h>
 
 // *---------------------------------------------*
 // *              MACRO DEFINITIONS              *
@@ -25,8 +22,6 @@
 #define LOGICAL_LINE_PROMPT "> "
 #define LOGICAL_LINE_CONTINUATION_PROMPT "... "
 
-#define PHYSICAL_LINE_SEPARATOR '\n'
-
 #define INPUT_LINE_INITIAL_GROWTH_CAPACITY 128
 
 #define DISABLE_STREAM_BUFFERING(stream)                          \
@@ -42,16 +37,11 @@
 // *         INTERNAL-LINKAGE FUNCTIONS          *
 // *---------------------------------------------*
 
-/// Interpret stdin stream resource content.
+/// Interpret stdin stream resource content as it arrives (see interpreter_interpret_stream).
 static inline void interpret_stdin_stream_resource_content(void) {
   interpreter_init();
-
-  char *const input_string = io_read_finite_stream_as_str(stdin);
-
-  interpreter_interpret(input_string);
-
+  interpreter_interpret_stream(stdin);
   interpreter_destroy();
-  free(input_string);
 }
 
 // *---------------------------------------------*
@@ -80,10 +70,9 @@ void repl_enter(void) {
   history_init();
   GapBuffer physical_line;
   gap_buffer_init(&physical_line, INPUT_LINE_INITIAL_GROWTH_CAPACITY);
-  DARRAY_DEFINE(char, logical_line, memory_manage);
-  logical_line.initial_growth_capacity = INPUT_LINE_INITIAL_GROWTH_CAPACITY;
   for (bool is_continuing_logical_line = false;;) {
-    // read physical line (one terminated with '\n') from stdin and append it to logical_line (forming it)
+    // read physical line (one terminated with '\n') from stdin; consecutive physical lines form logical line
+    char *physical_line_content;
     for (bool is_physical_line_modified = false;;) {
       { // redraw physical line
         terminal_clear_current_line();
@@ -216,38 +205,20 @@ void repl_enter(void) {
       // keep reading physical line
       continue;
 
-    handle_physical_line_end:;
-      char *const physical_line_content = gap_buffer_get_content(&physical_line);
-      size_t const physical_line_content_length = gap_buffer_get_content_length(&physical_line);
-
-      history_append_entry(physical_line_content, physical_line_content_length);
-
-      size_t const new_logical_line_count =
-        is_continuing_logical_line
-          ? logical_line.count + physical_line_content_length + 1 // account for PHYSICAL_LINE_SEPARATOR
-          : physical_line_content_length + 1; // account for NUL terminator
-
-      // resize logical_line if needed
-      if (logical_line.capacity < new_logical_line_count) DARRAY_RESERVE(&logical_line, new_logical_line_count);
-
-      if (!is_continuing_logical_line) { // form new logical_line
-        strcpy(logical_line.data, physical_line_content);
-      } else { // continue forming logical_line
-        logical_line.data[logical_line.count - 1] = PHYSICAL_LINE_SEPARATOR; // overwrite NUL
-        memcpy(logical_line.data + logical_line.count, physical_line_content, physical_line_content_length);
-        logical_line.data[new_logical_line_count - 1] = '\0';
-      }
-      logical_line.count = new_logical_line_count;
+    handle_physical_line_end:
+      physical_line_content = gap_buffer_get_content(&physical_line);
+      history_append_entry(physical_line_content, gap_buffer_get_content_length(&physical_line));
 
       history_stop_browsing();
       is_physical_line_modified = false;
-      free(physical_line_content);
       gap_buffer_clear_content(&physical_line);
       break;
     }
 
-    // interpret logical_line
-    InterpreterStatus const interpreter_status = interpreter_interpret(logical_line.data);
+    // interpret physical line, continuing logical line formed by the preceding ones (only its cut-off statement gets
+    // compiled again, instead of the whole logical line)
+    InterpreterStatus const interpreter_status = interpreter_interpret_line(physical_line_content);
+    free(physical_line_content);
     if (interpreter_status == INTERPRETER_COMPILER_FAILURE) {
       if (fflush(g_static_analysis_error_stream) == EOF) ERROR_IO_ERRNO();
       char *const static_analysis_errors = io_read_finite_seekable_binary_stream_as_str(g_static_analysis_error_stream);
@@ -266,7 +237,6 @@ void repl_enter(void) {
   }
 
 clean_up:
-  DARRAY_DESTROY(&logical_line);
   gap_buffer_destroy(&physical_line);
   history_destroy();
   interpreter_destroy();
@@ -0,0 +1,571 @@
+#ifndef _WIN32
+#define _POSIX_C_SOURCE 200809L
+#endif
+#if defined(__linux__)
+#define _GNU_SOURCE // SO_PEERCRED
+#elif defined(__APPLE__)
+#define _DARWIN_C_SOURCE // getpeereid
+#endif
+
+#include "cli/server.h"
+
+#include "backend/chunk.h"
+#include "backend/vm.h"
+#include "common.h"
+#include "frontend/compiler.h"
+#include "global.h"
+#include "utils/error.h"
+#include "utils/io.h"
+#include "utils/memory.h"
+#include "utils/memory_arena.h"
+
+#include <assert.h>
+#include <errno.h>
+#include <stdbool.h>
+#include <stdint.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#ifndef _WIN32
+#include <pthread.h>
+#include <signal.h>
+#include <sys/socket.h>
+#include <sys/stat.h>
+#include <sys/time.h>
+#include <sys/un.h>
+#include <unistd.h>
+#endif
+
+// *---------------------------------------------*
+// *              MACRO DEFINITIONS              *
+// *---------------------------------------------*
+
+// Protocol: client connects, sends request header (path and source code lengths, 32-bit big-endian each) along with
+// its stdout and stderr file descriptors, then path and source code themselves. Server interprets request, writing
+// output directly into passed file descriptors, and responds with exit code byte. Both ends only talk to peers run
+// by the same user.
+
+#define SERVER_REQUEST_HEADER_SIZE 8
+#define SERVER_REQUEST_FD_COUNT 2
+
+#define SERVER_MAX_REQUEST_PATH_LENGTH 4096
+#define SERVER_MAX_REQUEST_SOURCE_CODE_LENGTH (256 * 1024 * 1024)
+
+#define SERVER_LISTEN_BACKLOG 128
+
+// max seconds server waits for stalled client to send more of its request (connection gets dropped afterwards)
+#define SERVER_RECEIVE_TIMEOUT_SECONDS 5
+
+#define SERVER_OBJECT_ARENA_BLOCK_SIZE (64 * 1024)
+
+// *---------------------------------------------*
+// *              TYPE DEFINITIONS               *
+// *---------------------------------------------*
+
+#ifndef _WIN32
+/// Request received by server: source code to be interpreted (path is only reported alongside errors).
+typedef struct {
+  char *path, *source_code; // heap-allocated
+  int output_fd, error_fd;  // client's stdout and stderr (-1 unless owned by request)
+} ServerRequest;
+
+// *---------------------------------------------*
+// *          INTERNAL-LINKAGE OBJECTS           *
+// *---------------------------------------------*
+
+static char const *served_socket_path; // socket of serving server (NULL if there's none); removed upon process exit
+
+// *---------------------------------------------*
+// *         INTERNAL-LINKAGE FUNCTIONS          *
+// *---------------------------------------------*
+
+/// Remove socket of serving server, so that it isn't left behind when process exits (e.g. due to fatal error).
+static void remove_served_socket(void) {
+  if (served_socket_path != NULL) unlink(served_socket_path);
+}
+
+/// Encode `value` into 4 `buffer` bytes (big-endian).
+static void encode_uint32(uint8_t *const buffer, uint32_t const value) {
+  for (int i = 0; i < 4; i++) buffer[i] = value >> (24 - 8 * i);
+}
+
+/// Decode 4 `buffer` bytes (big-endian).
+/// @return Decoded value.
+static uint32_t decode_uint32(uint8_t const *const buffer) {
+  return (uint32_t)buffer[0] << 24 | (uint32_t)buffer[1] << 16 | (uint32_t)buffer[2] << 8 | buffer[3];
+}
+
+/// Read `length` bytes from socket `fd` into `buffer`, retrying partial and interrupted reads.
+/// @return true if all of them were read, false otherwise (including premature EOF and receive timeout).
+static bool read_exactly(int const fd, void *const buffer, size_t const length) {
+  for (size_t read_length = 0; read_length < length;) {
+    ssize_t const read_byte_count = recv(fd, (uint8_t *)buffer + read_length, length - read_length, 0);
+    if (read_byte_count < 0 && errno == EINTR) continue;
+    if (read_byte_count <= 0) return false;
+    read_length += read_byte_count;
+  }
+
+  return true;
+}
+
+/// Write `length` bytes of `data` into socket `fd`, retrying partial and interrupted writes.
+/// @return true if all of them were written, false otherwise (e.g. when peer is gone).
+static bool write_exactly(int const fd, void const *const data, size_t const length) {
+  for (size_t written_length = 0; written_length < length;) {
+    ssize_t const written_byte_count =
+      send(fd, (uint8_t const *)data + written_length, length - written_length, MSG_NOSIGNAL);
+    if (written_byte_count < 0 && errno == EINTR) continue;
+    if (written_byte_count < 0) return false;
+    written_length += written_byte_count;
+  }
+
+  return true;
+}
+
+/// Write `length` bytes of `data` into file descriptor `fd` (not necessarily a socket), retrying partial and
+/// interrupted writes.
+/// @return true if all of them were written, false otherwise (e.g. when reader is gone).
+static bool write_fd_exactly(int const fd, void const *const data, size_t const length) {
+  for (size_t written_length = 0; written_length < length;) {
+    ssize_t const written_byte_count = write(fd, (uint8_t const *)data + written_length, length - written_length);
+    if (written_byte_count < 0 && errno == EINTR) continue;
+    if (written_byte_count < 0) return false;
+    written_length += written_byte_count;
+  }
+
+  return true;
+}
+
+/// Determine whether peer connected through Unix domain socket `connection` is run by the same user as calling
+/// process.
+/// @return true if it is, false otherwise (including failure to determine peer's user).
+static bool is_peer_same_user(int const connection) {
+#if defined(__linux__)
+  struct ucred credentials;
+  socklen_t credentials_size = sizeof(credentials);
+  if (getsockopt(connection, SOL_SOCKET, SO_PEERCRED, &credentials, &credentials_size) < 0) return false;
+  uid_t const peer_uid = credentials.uid;
+#else
+  uid_t peer_uid;
+  gid_t peer_gid;
+  if (getpeereid(connection, &peer_uid, &peer_gid) < 0) return false;
+#endif
+
+  return peer_uid == geteuid();
+}
+
+/// Make sure `directory_path` directory is private to calling process's user (owned by it, and inaccessible to
+/// others), so that no one else can place sockets into it.
+static void assert_private_directory(char const *const directory_path) {
+  struct stat directory_stat;
+  if (lstat(directory_path, &directory_stat) < 0) {
+    ERROR_IO("Failed to access directory '%s'" COMMON_MS "%s\n", directory_path, strerror(errno));
+  }
+  if (!S_ISDIR(directory_stat.st_mode) || directory_stat.st_uid != geteuid() || (directory_stat.st_mode & 077) != 0) {
+    ERROR_IO("Directory '%s' is not private to current user", directory_path);
+  }
+}
+
+/// Resolve `socket_path` (NULL denotes default one). Default socket resides in user's runtime directory
+/// ($XDG_RUNTIME_DIR), or in private per-user directory (created by server if `is_serving`) if there's none.
+/// @return Resolved socket path.
+static char const *resolve_socket_path(char const *const socket_path, bool const is_serving) {
+  if (socket_path != NULL) return socket_path;
+
+  static char default_socket_path[sizeof(((struct sockaddr_un *)NULL)->sun_path)];
+  char const *const runtime_directory_path = getenv("XDG_RUNTIME_DIR");
+  if (runtime_directory_path != NULL && runtime_directory_path[0] == '/') {
+    snprintf(
+      default_socket_path, sizeof(default_socket_path), "%s/" SERVER_DEFAULT_SOCKET_NAME, runtime_directory_path
+    );
+    return default_socket_path;
+  }
+
+  char directory_path[64];
+  snprintf(
+    directory_path, sizeof(directory_path), SERVER_FALLBACK_SOCKET_DIRECTORY_FORMAT, (unsigned long)geteuid()
+  );
+  if (is_serving && mkdir(directory_path, 0700) < 0 && errno != EEXIST) {
+    ERROR_IO("Failed to create directory '%s'" COMMON_MS "%s\n", directory_path, strerror(errno));
+  }
+  assert_private_directory(directory_path);
+
+  snprintf(default_socket_path, sizeof(default_socket_path), "%s/" SERVER_DEFAULT_SOCKET_NAME, directory_path);
+  return default_socket_path;
+}
+
+/// Make Unix domain socket address out of `socket_path`.
+static struct sockaddr_un make_socket_address(char const *const socket_path) {
+  assert(socket_path != NULL);
+
+  struct sockaddr_un address = {.sun_family = AF_UNIX};
+  if (strlen(socket_path) >= sizeof(address.sun_path)) ERROR_INVALID_ARG("Socket path '%s' is too long", socket_path);
+  strcpy(address.sun_path, socket_path);
+
+  return address;
+}
+
+/// Receive request header into `header` through `connection`, along with client's stdout and stderr file descriptors
+/// (taken over by `request`).
+/// @return true if request header and both file descriptors were received, false otherwise.
+static bool receive_request_header(int const connection, uint8_t *const header, ServerRequest *const request) {
+  union {
+    struct cmsghdr alignment;
+    char buffer[CMSG_SPACE(sizeof(int) * SERVER_REQUEST_FD_COUNT)];
+  } control;
+  struct iovec iovec = {.iov_base = header, .iov_len = SERVER_REQUEST_HEADER_SIZE};
+  struct msghdr message = {
+    .msg_iov = &iovec, .msg_iovlen = 1, .msg_control = control.buffer, .msg_controllen = sizeof(control.buffer)
+  };
+
+  ssize_t received_byte_count;
+  do received_byte_count = recvmsg(connection, &message, 0);
+  while (received_byte_count < 0 && errno == EINTR);
+  if (received_byte_count <= 0) return false;
+
+  // take over passed file descriptors (excessive ones get closed right away)
+  int passed_fd_count = 0;
+  for (struct cmsghdr *cmsg = CMSG_FIRSTHDR(&message); cmsg != NULL; cmsg = CMSG_NXTHDR(&message, cmsg)) {
+    if (cmsg->cmsg_level != SOL_SOCKET || cmsg->cmsg_type != SCM_RIGHTS) continue;
+
+    size_t const fd_count = (cmsg->cmsg_len - CMSG_LEN(0)) / sizeof(int);
+    for (size_t i = 0; i < fd_count; i++) {
+      int fd;
+      memcpy(&fd, CMSG_DATA(cmsg) + i * sizeof(int), sizeof(int));
+
+      if (passed_fd_count == 0) request->output_fd = fd;
+      else if (passed_fd_count == 1) request->error_fd = fd;
+      else close(fd);
+      passed_fd_count++;
+    }
+  }
+  if (passed_fd_count != SERVER_REQUEST_FD_COUNT || (message.msg_flags & MSG_CTRUNC)) return false;
+
+  return read_exactly(connection, header + received_byte_count, SERVER_REQUEST_HEADER_SIZE - received_byte_count);
+}
+
+/// Receive `request` through `connection`; client stalling for over SERVER_RECEIVE_TIMEOUT_SECONDS fails to send it.
+/// @note `request` has to be destroyed regardless of whether it was received.
+/// @return true if well-formed request was received, false otherwise.
+static bool receive_request(int const connection, ServerRequest *const request) {
+  assert(request != NULL);
+
+  struct timeval const receive_timeout = {.tv_sec = SERVER_RECEIVE_TIMEOUT_SECONDS};
+  if (setsockopt(connection, SOL_SOCKET, SO_RCVTIMEO, &receive_timeout, sizeof(receive_timeout)) < 0) return false;
+
+  uint8_t header[SERVER_REQUEST_HEADER_SIZE];
+  if (!receive_request_header(connection, header, request)) return false;
+
+  uint32_t const path_length = decode_uint32(header);
+  uint32_t const source_code_length = decode_uint32(header + 4);
+  if (path_length > SERVER_MAX_REQUEST_PATH_LENGTH || source_code_length > SERVER_MAX_REQUEST_SOURCE_CODE_LENGTH) {
+    return false;
+  }
+
+  request->path = malloc(path_length + 1);
+  if (request->path == NULL) ERROR_MEMORY_ERRNO();
+  if (!read_exactly(connection, request->path, path_length)) return false;
+  request->path[path_length] = '\0';
+
+  request->source_code = malloc(source_code_length + 1);
+  if (request->source_code == NULL) ERROR_MEMORY_ERRNO();
+  if (!read_exactly(connection, request->source_code, source_code_length)) return false;
+  request->source_code[source_code_length] = '\0';
+
+  return true;
+}
+
+/// Release `request` resources.
+static void destroy_request(ServerRequest *const request) {
+  assert(request != NULL);
+
+  free(request->path);
+  free(request->source_code);
+  if (request->output_fd != -1) close(request->output_fd);
+  if (request->error_fd != -1) close(request->error_fd);
+}
+
+/// Interpret `request` on pre-initialized `vm`, which gets reverted to `idle_vm_config` afterwards.
+/// Failures to write into client file descriptors (e.g. when client's reader is gone) only fail the request itself.
+/// @return Error code of request interpretation.
+static ErrorCode interpret_request(VM *const vm, VMConfig const *const idle_vm_config, ServerRequest *const request) {
+  assert(vm != NULL);
+  assert(idle_vm_config != NULL);
+  assert(request != NULL);
+
+  // errors are gathered in memory and forwarded to client's stderr afterwards (source program output precedes them)
+  char *error_output;
+  size_t error_output_length;
+  FILE *const error_stream = open_memstream(&error_output, &error_output_length);
+  if (error_stream == NULL) ERROR_IO_ERRNO();
+
+  ErrorCode error_code = ERROR_CODE_SUCCESS;
+
+  // output stream takes over client's stdout file descriptor
+  FILE *const output_stream = fdopen(request->output_fd, "w");
+  if (output_stream == NULL) {
+    fprintf(
+      error_stream, "[ERROR_IO]" COMMON_MS "Failed to open client output stream" COMMON_MS "%s\n", strerror(errno)
+    );
+    error_code = ERROR_CODE_IO;
+  } else request->output_fd = -1;
+
+  if (error_code == ERROR_CODE_SUCCESS) {
+    VMConfig const vm_config = {
+      .source_file_path = request->path,
+      .static_analysis_error_stream = error_stream,
+      .bytecode_execution_error_stream = error_stream,
+      .source_program_output_stream = output_stream,
+      .is_source_program_output_failure_tolerant = true,
+      .memory_manager = idle_vm_config->memory_manager,
+      .object_allocator = idle_vm_config->object_allocator,
+      .bytecode_budget = g_execution_bytecode_budget,
+      .execution_timeout = g_execution_timeout,
+    };
+    vm_recycle(vm, &vm_config);
+    Chunk chunk;
+    chunk_init(&chunk);
+
+    if (compiler_compile(vm, request->source_code, &chunk) != COMPILER_SUCCESS) error_code = ERROR_CODE_COMPILATION;
+    else if (!vm_execute(vm, &chunk)) error_code = ERROR_CODE_EXECUTION;
+
+    // output sink gets flushed whenever execution ends
+    int const write_errno = vm->output_sink.write_errno;
+    if (write_errno != 0) {
+      fprintf(error_stream, "[ERROR_IO]" COMMON_MS "%s\n", strerror(write_errno));
+      error_code = ERROR_CODE_IO;
+    }
+
+    chunk_destroy(&chunk);
+    vm_recycle(vm, idle_vm_config); // detaches client streams (and releases request objects by resetting arena)
+  }
+
+  // client might have already closed its end, in which case there's no one left to report errors to
+  if (output_stream != NULL) fclose(output_stream);
+  if (fclose(error_stream) == EOF) ERROR_IO_ERRNO();
+  write_fd_exactly(request->error_fd, error_output, error_output_length);
+  free(error_output);
+
+  return error_code;
+}
+
+/// Serve `server_ptr` server requests one at a time, on VM pre-initialized once and recycled between requests.
+/// VM objects are allocated from worker's own arena, so that objects of every request get released at once.
+/// @return NULL (signature conforms to pthread start routine).
+static void *run_server_worker(void *const server_ptr) {
+  Server const *const server = server_ptr;
+
+  MemoryArena object_arena;
+  memory_arena_init(&object_arena, SERVER_OBJECT_ARENA_BLOCK_SIZE, memory_manage);
+  MemoryAllocator const object_allocator = memory_arena_make_allocator(&object_arena);
+
+  // idle VM is bound to server streams, but it never writes into them
+  VMConfig const idle_vm_config = {
+    .source_file_path = server->socket_path,
+    .static_analysis_error_stream = stderr,
+    .bytecode_execution_error_stream = stderr,
+    .source_program_output_stream = stdout,
+    .memory_manager = memory_manage,
+    .object_allocator = &object_allocator,
+  };
+  VM vm;
+  vm_init(&vm, &idle_vm_config);
+
+  for (;;) {
+    int const connection = accept(server->listening_socket, NULL, NULL);
+    if (connection < 0) {
+      if (errno == EINTR || errno == ECONNABORTED) continue;
+      ERROR_SYSTEM("Failed to accept connection" COMMON_MS "%s\n", strerror(errno));
+    }
+
+    // malformed requests are dropped (connection probing the socket counts as one as well), and so are requests of
+    // other users (they must not make server write into their file descriptors on behalf of server's user)
+    ServerRequest request = {.output_fd = -1, .error_fd = -1};
+    if (is_peer_same_user(connection) && receive_request(connection, &request)) {
+      uint8_t const error_code = interpret_request(&vm, &idle_vm_config, &request);
+      write_exactly(connection, &error_code, 1); // client might be gone already
+    }
+
+    destroy_request(&request);
+    close(connection);
+  }
+}
+
+/// Send request `header` into `connection`, along with calling process's stdout and stderr file descriptors.
+/// @return true if it was sent, false otherwise.
+static bool send_request_header(int const connection, uint8_t const *const header) {
+  int const fds[SERVER_REQUEST_FD_COUNT] = {STDOUT_FILENO, STDERR_FILENO};
+  union {
+    struct cmsghdr alignment;
+    char buffer[CMSG_SPACE(sizeof(fds))];
+  } control;
+  memset(&control, 0, sizeof(control));
+
+  struct iovec iovec = {.iov_base = (void *)header, .iov_len = SERVER_REQUEST_HEADER_SIZE};
+  struct msghdr message = {
+    .msg_iov = &iovec, .msg_iovlen = 1, .msg_control = control.buffer, .msg_controllen = sizeof(control.buffer)
+  };
+  struct cmsghdr *const cmsg = CMSG_FIRSTHDR(&message);
+  cmsg->cmsg_level = SOL_SOCKET;
+  cmsg->cmsg_type = SCM_RIGHTS;
+  cmsg->cmsg_len = CMSG_LEN(sizeof(fds));
+  memcpy(CMSG_DATA(cmsg), fds, sizeof(fds));
+
+  ssize_t sent_byte_count;
+  do sent_byte_count = sendmsg(connection, &message, MSG_NOSIGNAL);
+  while (sent_byte_count < 0 && errno == EINTR);
+  if (sent_byte_count <= 0) return false;
+
+  return write_exactly(connection, header + sent_byte_count, SERVER_REQUEST_HEADER_SIZE - sent_byte_count);
+}
+#endif
+
+// *---------------------------------------------*
+// *         EXTERNAL-LINKAGE FUNCTIONS          *
+// *---------------------------------------------*
+
+/// Make `server` listen on Unix domain socket located at `socket_path` (NULL denotes default one).
+/// Socket left behind by server that terminated abnormally gets replaced (files other than sockets never do).
+void server_listen(Server *const server, char const *socket_path) {
+  assert(server != NULL);
+
+#ifdef _WIN32
+  ERROR_INVALID_ARG("Server mode is not supported on this platform");
+#else // POSIX
+  socket_path = resolve_socket_path(socket_path, true);
+  struct sockaddr_un const address = make_socket_address(socket_path);
+
+  int const listening_socket = socket(AF_UNIX, SOCK_STREAM, 0);
+  if (listening_socket < 0) ERROR_SYSTEM_ERRNO();
+
+  // socket is made accessible to server's user only (umask applies to socket file created by bind)
+  mode_t const original_umask = umask(077);
+  if (bind(listening_socket, (struct sockaddr const *)&address, sizeof(address)) < 0) {
+    if (errno != EADDRINUSE) ERROR_SYSTEM("Failed to bind socket '%s'" COMMON_MS "%s\n", socket_path, strerror(errno));
+
+    // socket is either in use by a running server, or left behind by one that terminated abnormally
+    int const probing_socket = socket(AF_UNIX, SOCK_STREAM, 0);
+    if (probing_socket < 0) ERROR_SYSTEM_ERRNO();
+    bool const is_socket_in_use = connect(probing_socket, (struct sockaddr const *)&address, sizeof(address)) == 0;
+    close(probing_socket);
+    if (is_socket_in_use) ERROR_IO("Server is already listening on '%s'", socket_path);
+
+    // only sockets get replaced, other files (e.g. mistyped socket path) are left intact
+    struct stat socket_stat;
+    if (lstat(socket_path, &socket_stat) < 0) {
+      ERROR_SYSTEM("Failed to bind socket '%s'" COMMON_MS "%s\n", socket_path, strerror(errno));
+    }
+    if (!S_ISSOCK(socket_stat.st_mode)) ERROR_IO("File '%s' exists and is not a socket", socket_path);
+
+    if (unlink(socket_path) < 0 || bind(listening_socket, (struct sockaddr const *)&address, sizeof(address)) < 0) {
+      ERROR_SYSTEM("Failed to bind socket '%s'" COMMON_MS "%s\n", socket_path, strerror(errno));
+    }
+  }
+  umask(original_umask);
+  if (listen(listening_socket, SERVER_LISTEN_BACKLOG) < 0) ERROR_SYSTEM_ERRNO();
+
+  *server = (Server){.socket_path = socket_path, .listening_socket = listening_socket};
+#endif
+}
+
+/// Serve requests of listening `server` by `worker_count` worker threads (0 denotes available processor count), each
+/// running its own pre-initialized VM, until SIGINT or SIGTERM is received. Server socket gets removed afterwards.
+/// @return Server error code.
+ErrorCode server_serve(Server *const server, int const worker_count) {
+  assert(server != NULL);
+  assert(worker_count >= 0);
+
+#ifdef _WIN32
+  ERROR_INVALID_ARG("Server mode is not supported on this platform");
+#else // POSIX
+  // termination signals are awaited by calling thread (workers inherit blocked signal mask)
+  sigset_t termination_signals;
+  sigemptyset(&termination_signals);
+  sigaddset(&termination_signals, SIGINT);
+  sigaddset(&termination_signals, SIGTERM);
+  int error_number = pthread_sigmask(SIG_BLOCK, &termination_signals, NULL);
+  if (error_number != 0) ERROR_SYSTEM("Failed to block termination signals" COMMON_MS "%s\n", strerror(error_number));
+
+  // writing into client file descriptors whose reader is gone fails the request, instead of killing the server
+  if (signal(SIGPIPE, SIG_IGN) == SIG_ERR) ERROR_SYSTEM_ERRNO();
+
+  served_socket_path = server->socket_path;
+  if (atexit(remove_served_socket) != 0) ERROR_SYSTEM("Failed to register server socket removal");
+
+  long const processor_count = sysconf(_SC_NPROCESSORS_ONLN);
+  int const thread_count = worker_count > 0 ? worker_count : processor_count < 1 ? 1 : processor_count;
+
+  for (int i = 0; i < thread_count; i++) {
+    pthread_t thread;
+    error_number = pthread_create(&thread, NULL, run_server_worker, server);
+    if (error_number == 0) error_number = pthread_detach(thread);
+    if (error_number != 0) {
+      ERROR_SYSTEM("Failed to start server worker thread" COMMON_MS "%s\n", strerror(error_number));
+    }
+  }
+  io_fprintf(stderr, "[SERVER]" COMMON_MS "Listening on '%s' with %d workers\n", server->socket_path, thread_count);
+
+  int signal_number;
+  error_number = sigwait(&termination_signals, &signal_number);
+  if (error_number != 0) ERROR_SYSTEM("Failed to await termination signal" COMMON_MS "%s\n", strerror(error_number));
+
+  close(server->listening_socket);
+  served_socket_path = NULL;
+  if (unlink(server->socket_path) < 0) {
+    ERROR_IO("Failed to remove socket '%s'" COMMON_MS "%s\n", server->socket_path, strerror(errno));
+  }
+
+  return ERROR_CODE_SUCCESS;
+#endif
+}
+
+/// Interpret file located at `source_file_path` by server listening on `socket_path` (NULL denotes default one).
+/// Source file is read by calling process, while its output is written by server directly into calling process's
+/// stdout and stderr; this way remote interpretation is indistinguishable from a regular one.
+/// @return Interpretation error code.
+ErrorCode server_interpret_remotely(char const *socket_path, char const *const source_file_path) {
+  assert(source_file_path != NULL);
+
+#ifdef _WIN32
+  ERROR_INVALID_ARG("Client mode is not supported on this platform");
+#else // POSIX
+  socket_path = resolve_socket_path(socket_path, false);
+  struct sockaddr_un const address = make_socket_address(socket_path);
+
+  char *const source_code = io_read_text_file(source_file_path);
+  size_t const path_length = strlen(source_file_path);
+  size_t const source_code_length = strlen(source_code);
+  if (path_length > SERVER_MAX_REQUEST_PATH_LENGTH) ERROR_INVALID_ARG("Path '%s' is too long", source_file_path);
+  if (source_code_length > SERVER_MAX_REQUEST_SOURCE_CODE_LENGTH) {
+    ERROR_IO("File '%s' is too large to be interpreted remotely", source_file_path);
+  }
+
+  int const connection = socket(AF_UNIX, SOCK_STREAM, 0);
+  if (connection < 0) ERROR_SYSTEM_ERRNO();
+  if (connect(connection, (struct sockaddr const *)&address, sizeof(address)) < 0) {
+    ERROR_IO("Failed to connect to server at '%s'" COMMON_MS "%s\n", socket_path, strerror(errno));
+  }
+
+  // source code and file descriptors are only handed over to server run by the same user
+  if (!is_peer_same_user(connection)) ERROR_IO("Server at '%s' is run by another user", socket_path);
+
+  uint8_t header[SERVER_REQUEST_HEADER_SIZE];
+  encode_uint32(header, path_length);
+  encode_uint32(header + 4, source_code_length);
+  if (!send_request_header(connection, header) || !write_exactly(connection, source_file_path, path_length) ||
+      !write_exactly(connection, source_code, source_code_length)) {
+    ERROR_IO("Failed to send request to server at '%s'" COMMON_MS "%s\n", socket_path, strerror(errno));
+  }
+
+  uint8_t error_code;
+  if (!read_exactly(connection, &error_code, 1) || error_code >= ERROR_CODE_COUNT) {
+    ERROR_IO("Server at '%s' failed to report exit code", socket_path);
+  }
+
+  close(connection);
+  free(source_code);
+
+  return error_code;
+#endif
+}
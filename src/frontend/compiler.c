@@ -1,15 +1,43 @@
+#ifndef _WIN32
+#define _POSIX_C_SOURCE 200809L
+#endif
+
 #include "frontend/compiler.h"
 
+#include "backend/gc.h"
 #include "backend/object.h"
+#include "backend/vm.h"
 #include "frontend/lexer.h"
-#include "global.h"
+#include "utils/character.h"
 #include "utils/debug.h"
 #include "utils/error.h"
 #include "utils/io.h"
+#include "utils/memory.h"
+#include "utils/number.h"
 
-#include <errno.h>
+#include <stdint.h>
 #include <stdio.h>
 #include <stdlib.h>
+#include <string.h>
+
+#ifndef _WIN32
+#include <pthread.h>
+#include <stdatomic.h>
+#include <unistd.h>
+#endif
+
+// *---------------------------------------------*
+// *              MACRO DEFINITIONS              *
+// *---------------------------------------------*
+
+/// Source code length compiled by a single thread; longer source code gets split into segments compiled in parallel.
+#define COMPILER_SEGMENT_LENGTH (1024 * 1024)
+
+/// Minimum source code length of a pipelined batch (batch extends up to the nearest statement boundary past it).
+#define COMPILER_BATCH_LENGTH (64 * 1024)
+
+/// Maximum number of compiled batches awaiting execution; bounds how far compilation can get ahead of execution.
+#define COMPILER_PIPELINE_CAPACITY 4
 
 // *---------------------------------------------*
 // *              TYPE DEFINITIONS               *
@@ -35,8 +63,61 @@ typedef enum {
   PRECEDENCE_PRIMARY
 } Precedence;
 
-/// Function handling (compiling) specified TokenType.
-typedef void(TokenHandlerFn)(void);
+/// Source code segment compiled into its own chunk (possibly in parallel with other segments).
+typedef struct {
+  char const *source_code; // not NUL terminated
+  size_t length;
+  int32_t first_line, last_line;
+  Chunk chunk;
+  CompilerStatus status;
+  char *static_analysis_errors; // reported static analysis errors
+  size_t static_analysis_errors_length;
+} CompilerSegment;
+
+/// Segments shared by compiling threads; each thread takes next uncompiled segment until none is left.
+typedef struct {
+  VM *vm; // virtual machine that segments are compiled for
+  CompilerSegment *segments;
+  int segment_count;
+#ifndef _WIN32
+  atomic_int next_segment_index;
+  pthread_mutex_t object_creation_mutex; // serializes creation of vm objects across compiling threads
+#endif
+} CompilerSegmentQueue;
+
+/// Source code compiled in batches of whole statements, possibly concurrently with their execution.
+/// Batch string constants are neither interned nor tracked until batch gets taken (see compiler_pipeline_take_batch).
+struct CompilerPipeline {
+  VM *vm; // virtual machine that batches are compiled for
+  char const *source_code; // uncompiled source code remainder
+  size_t remaining_length;
+  int32_t line; // line uncompiled source code remainder begins at
+  CompilerSegment batches[COMPILER_PIPELINE_CAPACITY]; // compiled batches awaiting execution (ring buffer)
+  int first_batch_index, batch_count;
+  bool is_compiled; // whether the last batch has been compiled
+  bool is_concurrent; // whether batches are compiled on a dedicated thread (otherwise by thread taking them)
+#ifndef _WIN32
+  bool is_stopping;
+  pthread_mutex_t mutex; // guards batch ring and flags
+  pthread_cond_t condition; // signaled whenever batch ring or flags change
+  pthread_t thread;
+#endif
+};
+
+typedef struct ExprFrame ExprFrame;
+
+/// Function handling (compiling) specified TokenType subexpression described by `frame`.
+/// Handler gets invoked upon `frame` creation, and then again after each operand it requested has been compiled.
+/// @return Precedence of the next operand to compile, or PRECEDENCE_NONE if subexpression is complete.
+typedef Precedence(TokenHandlerFn)(ExprFrame *frame);
+
+/// Subexpression being compiled by its token handler (kept on explicit stack instead of C call stack).
+struct ExprFrame {
+  TokenHandlerFn *handler;
+  int32_t token_index; // handled token
+  Precedence precedence; // precedence of expression subexpression belongs to
+  int operand_count; // compiled operands
+};
 
 typedef struct {
   TokenHandlerFn *nud; // null-denotation (requires no-context)
@@ -49,12 +130,13 @@ typedef struct {
 // *---------------------------------------------*
 
 static TokenHandlerFn compile_left_associative_binary_expr;
-static TokenHandlerFn compile_right_associative_binary_expr;
+static TokenHandlerFn compile_concatenation_expr;
 static TokenHandlerFn compile_unary_expr;
 static TokenHandlerFn compile_grouping_expr;
 static TokenHandlerFn compile_numeric_literal;
 static TokenHandlerFn compile_string_literal;
 static TokenHandlerFn compile_invariable_literal;
+static TokenHandlerFn compile_input;
 
 // *---------------------------------------------*
 // *          INTERNAL-LINKAGE OBJECTS           *
@@ -68,7 +150,7 @@ static ParseRule const parse_rules[] = {
   [LEXER_TOKEN_FALSE] = {compile_invariable_literal, NULL, PRECEDENCE_NONE},
   [LEXER_TOKEN_NUMBER] = {compile_numeric_literal, NULL, PRECEDENCE_NONE},
   [LEXER_TOKEN_STRING] = {compile_string_literal, NULL, PRECEDENCE_NONE},
-  [LEXER_TOKEN_IDENTIFIER] = {NULL, NULL, PRECEDENCE_NONE},
+  [LEXER_TOKEN_IDENTIFIER] = {compile_input, NULL, PRECEDENCE_NONE},
 
   // single-character tokens
   [LEXER_TOKEN_PLUS] = {NULL, compile_left_associative_binary_expr, PRECEDENCE_TERM},
@@ -91,7 +173,7 @@ static ParseRule const parse_rules[] = {
   [LEXER_TOKEN_CLOSE_CURLY_BRACE] = {NULL, NULL, PRECEDENCE_NONE},
 
   // multi-character tokens
-  [LEXER_TOKEN_DOT_DOT] = {NULL, compile_right_associative_binary_expr, PRECEDENCE_CONCATENATION},
+  [LEXER_TOKEN_DOT_DOT] = {NULL, compile_concatenation_expr, PRECEDENCE_CONCATENATION},
   [LEXER_TOKEN_EQUAL_EQUAL] = {NULL, compile_left_associative_binary_expr, PRECEDENCE_EQUALITY},
   [LEXER_TOKEN_BANG_EQUAL] = {NULL, compile_left_associative_binary_expr, PRECEDENCE_EQUALITY},
   [LEXER_TOKEN_LESS_EQUAL] = {NULL, compile_left_associative_binary_expr, PRECEDENCE_COMPARISON},
@@ -113,12 +195,23 @@ static ParseRule const parse_rules[] = {
   [LEXER_TOKEN_PRINT] = {NULL, NULL, PRECEDENCE_NONE},
 };
 
-static Chunk *current_chunk; // TEMP
+// compiler state is per-thread, so that separate threads can compile concurrently
+static _Thread_local Chunk *current_chunk; // TEMP
 
-static struct {
-  LexerToken previous, current;
+static _Thread_local struct {
+  VM *vm; // virtual machine that source code is compiled for
+  LexerTokenBuffer tokens;
+  int32_t previous, current; // token indices
   ParserState state;
   bool had_error;
+  FILE *error_stream; // static analysis error stream
+  DARRAY_TYPE(ExprFrame) expr_frames; // subexpressions awaiting operands
+  int32_t statement_start; // index of token beginning last compiled statement
+  ChunkCheckpoint statement_checkpoint; // current_chunk state preceding last compiled statement
+  bool is_interning_deferred; // whether string literals are left uninterned (and untracked) for pipelined execution
+#ifndef _WIN32
+  pthread_mutex_t *object_creation_mutex; // non-NULL while parser.vm is shared by several compiling threads
+#endif
 } parser;
 
 // *---------------------------------------------*
@@ -130,103 +223,167 @@ static inline Chunk *get_current_chunk(void) {
   return current_chunk;
 }
 
-/// Handle `error_type` error at `token` with `message`.
-static void compiler_error_at(ErrorType const error_type, LexerToken const *const token, char const *const message) {
-  assert(token != NULL);
+/// Get type of token at `token_index`.
+static inline LexerTokenType get_token_type(int32_t const token_index) {
+  return lexer_token_buffer_get_type(&parser.tokens, token_index);
+}
+
+/// Get lexeme of token at `token_index`.
+static inline char const *get_token_lexeme(int32_t const token_index) {
+  return lexer_token_buffer_get_lexeme(&parser.tokens, token_index);
+}
+
+/// Get lexeme length of token at `token_index`.
+static inline int get_token_lexeme_length(int32_t const token_index) {
+  return lexer_token_buffer_get_lexeme_length(&parser.tokens, token_index);
+}
+
+/// Get line of token at `token_index`.
+static inline int32_t get_token_line(int32_t const token_index) {
+  return lexer_token_buffer_get_line(&parser.tokens, token_index);
+}
+
+/// Handle `error_type` error at `token_index` token with `message`.
+static void compiler_error_at(ErrorType const error_type, int32_t const token_index, char const *const message) {
   assert(message != NULL);
 
   if (parser.state != PARSER_OK) return;
 
   // record error
-  parser.state = token->type == LEXER_TOKEN_EOF ? PARSER_UNEXPECTED_EOF : PARSER_PANIC;
+  LexerToken const token = lexer_token_buffer_get_token(&parser.tokens, token_index);
+  parser.state = token.type == LEXER_TOKEN_EOF ? PARSER_UNEXPECTED_EOF : PARSER_PANIC;
   parser.had_error = true;
+  if (parser.error_stream == NULL) return; // error is merely recorded
 
   // print error
   static_assert(ERROR_TYPE_COUNT == 3, "Exhaustive ErrorType handling");
   switch (error_type) {
     case ERROR_LEXICAL: {
-      io_fprintf(g_static_analysis_error_stream, "[LEXICAL_ERROR]");
+      io_fprintf(parser.error_stream, "[LEXICAL_ERROR]");
       break;
     }
     case ERROR_SYNTAX: {
-      io_fprintf(g_static_analysis_error_stream, "[SYNTAX_ERROR]");
+      io_fprintf(parser.error_stream, "[SYNTAX_ERROR]");
       break;
     }
     case ERROR_SEMANTIC: {
-      io_fprintf(g_static_analysis_error_stream, "[SEMANTIC_ERROR]");
+      io_fprintf(parser.error_stream, "[SEMANTIC_ERROR]");
       break;
     }
     default: ERROR_INTERNAL("Unknown error_type '%d'", error_type);
   }
   io_fprintf(
-    g_static_analysis_error_stream, COMMON_MS COMMON_FILE_LINE_COLUMN_FORMAT COMMON_MS "%s", g_source_file_path,
-    token->line, token->column, message
+    parser.error_stream, COMMON_MS COMMON_FILE_LINE_COLUMN_FORMAT COMMON_MS "%s",
+    parser.vm->config.source_file_path, token.line, token.column, message
   );
-  if (token->type == LEXER_TOKEN_ERROR || token->type == LEXER_TOKEN_EOF) {
-    io_fprintf(g_static_analysis_error_stream, "\n");
-  } else io_fprintf(g_static_analysis_error_stream, " at '%.*s'\n", token->lexeme_length, token->lexeme);
+  if (token.type == LEXER_TOKEN_ERROR || token.type == LEXER_TOKEN_EOF) {
+    io_fprintf(parser.error_stream, "\n");
+  } else io_fprintf(parser.error_stream, " at '%.*s'\n", token.lexeme_length, token.lexeme);
 }
 
 /// Handle `error_type` error at parser.previous token with `message`.
 static inline void compiler_error_at_previous(ErrorType const error_type, char const *const message) {
-  compiler_error_at(error_type, &parser.previous, message);
+  compiler_error_at(error_type, parser.previous, message);
 }
 
 /// Handle `error_type` error at parser.current token with `message`.
 static inline void compiler_error_at_current(ErrorType const error_type, char const *const message) {
-  compiler_error_at(error_type, &parser.current, message);
+  compiler_error_at(error_type, parser.current, message);
 }
 
-/// Update parser.previous, advance parser.current, and handle any error tokens.
+/// Update parser.previous, advance parser.current (up to EOF token), and handle any error tokens.
 static void compiler_advance(void) {
   parser.previous = parser.current;
 
   for (;;) {
-    parser.current = lexer_scan();
-    if (parser.current.type != LEXER_TOKEN_ERROR) break;
-    compiler_error_at_current(ERROR_LEXICAL, parser.current.lexeme);
+    if (parser.current + 1 < lexer_token_buffer_get_count(&parser.tokens)) parser.current++;
+    if (get_token_type(parser.current) != LEXER_TOKEN_ERROR) break;
+
+    LexerToken const error_token = lexer_token_buffer_get_token(&parser.tokens, parser.current);
+    compiler_error_at_current(ERROR_LEXICAL, error_token.lexeme);
   }
 }
 
-/// Advance compiler if parser.current.type matches `type`, report error with `message` otherwise.
+/// Advance compiler if parser.current token type matches `type`, report error with `message` otherwise.
 static inline void compiler_consume(LexerTokenType const type, char const *const message) {
-  if (parser.current.type != type) compiler_error_at_current(ERROR_SYNTAX, message);
+  if (get_token_type(parser.current) != type) compiler_error_at_current(ERROR_SYNTAX, message);
   compiler_advance();
 }
 
-/// Advance compiler if parser.current.type matches `type`.
+/// Advance compiler if parser.current token type matches `type`.
 /// @return true if it does, false otherwise.
 static inline bool compiler_match(LexerTokenType const type) {
-  if (parser.current.type != type) return false;
+  if (get_token_type(parser.current) != type) return false;
   compiler_advance();
   return true;
 }
 
 /// Generate `opcode` bytecode instruction and append it to current_chunk.
 static inline void emit_instruction(ChunkOpCode const opcode) {
-  chunk_append_instruction(get_current_chunk(), opcode, parser.previous.line);
+  chunk_append_instruction(get_current_chunk(), opcode, get_token_line(parser.previous));
+}
+
+/// Generate bytecode instruction `operand` and append it to current_chunk.
+static inline void emit_operand(uint8_t const operand) {
+  chunk_append_operand(get_current_chunk(), operand);
 }
 
 /// Generate bytecode constant instruction and append it to current_chunk.
 static inline void emit_constant_instruction(Value const value) {
-  chunk_append_constant_instruction(get_current_chunk(), value, parser.previous.line);
+  if (!chunk_append_constant_instruction(get_current_chunk(), value, get_token_line(parser.previous))) {
+    compiler_error_at_previous(ERROR_SEMANTIC, "Exceeded chunk constant pool limit");
+  }
 }
 
 /// Compile `precedence` level expression.
+/// @note Compilation is iterative; subexpressions awaiting operands are kept on parser.expr_frames stack, so that
+/// nesting depth is limited only by available memory (not by C call stack).
 static void compile_precedence_expr(Precedence const precedence) {
-  compiler_advance();
-
-  // compile head token subexpression
-  if (parse_rules[parser.previous.type].nud == NULL) {
-    compiler_error_at_previous(ERROR_SYNTAX, "Expected expression");
-    return;
-  }
-  parse_rules[parser.previous.type].nud();
+  size_t const stack_base = parser.expr_frames.count;
+  Precedence operand_precedence = precedence;
 
-  // compile tail tokens subexpression
-  while (parse_rules[parser.current.type].precedence >= precedence) {
+  for (;;) {
+    // compile head token subexpression
     compiler_advance();
-    parse_rules[parser.previous.type].led();
+    LexerTokenType const head_type = get_token_type(parser.previous);
+    ExprFrame frame = {
+      .handler = parse_rules[head_type].nud,
+      .token_index = parser.previous,
+      .precedence = operand_precedence,
+    };
+    // identifiers are expressions only if VM declares input slots they could refer to
+    if (head_type == LEXER_TOKEN_IDENTIFIER && parser.vm->config.input_count == 0) frame.handler = NULL;
+    if (frame.handler == NULL) {
+      compiler_error_at_previous(ERROR_SYNTAX, "Expected expression");
+
+      // expression without head has no tail either; resume subexpression awaiting it
+      if (parser.expr_frames.count == stack_base) return;
+      frame = parser.expr_frames.data[--parser.expr_frames.count];
+      frame.operand_count++;
+    }
+
+    for (;;) {
+      operand_precedence = frame.handler(&frame);
+      if (operand_precedence != PRECEDENCE_NONE) break;
+
+      // compile tail tokens subexpression
+      if (parse_rules[get_token_type(parser.current)].precedence >= frame.precedence) {
+        compiler_advance();
+        frame = (ExprFrame){
+          .handler = parse_rules[get_token_type(parser.previous)].led,
+          .token_index = parser.previous,
+          .precedence = frame.precedence,
+        };
+        continue;
+      }
+
+      // expression is complete; resume subexpression awaiting it
+      if (parser.expr_frames.count == stack_base) return;
+      frame = parser.expr_frames.data[--parser.expr_frames.count];
+      frame.operand_count++;
+    }
+
+    DARRAY_PUSH(&parser.expr_frames, frame);
   }
 }
 
@@ -236,9 +393,9 @@ static void compile_expr(void) {
 }
 
 /// Compile left-associaive binary expression.
-static void compile_left_associative_binary_expr(void) {
-  LexerTokenType const operator_type = parser.previous.type;
-  compile_precedence_expr(parse_rules[operator_type].precedence + 1);
+static Precedence compile_left_associative_binary_expr(ExprFrame *const frame) {
+  LexerTokenType const operator_type = get_token_type(frame->token_index);
+  if (frame->operand_count == 0) return parse_rules[operator_type].precedence + 1; // right operand
 
   switch (operator_type) {
     case LEXER_TOKEN_PLUS: {
@@ -287,26 +444,37 @@ static void compile_left_associative_binary_expr(void) {
     }
     default: ERROR_INTERNAL("Unknown binary operator type '%d'", operator_type);
   }
+
+  return PRECEDENCE_NONE;
 }
 
-/// Compile right-associative binary expression.
-static void compile_right_associative_binary_expr(void) {
-  LexerTokenType const operator_type = parser.previous.type;
-  compile_precedence_expr(parse_rules[operator_type].precedence);
+/// Compile (right-associative) string-concatenation expression.
+/// Whole '..' chain gets compiled at once, so that it can be evaluated by a single N-ary concatenation instruction
+/// (instead of one binary instruction per operator, each yielding an intermediate string).
+static Precedence compile_concatenation_expr(ExprFrame *const frame) {
+  if (frame->operand_count == 0 || compiler_match(LEXER_TOKEN_DOT_DOT)) return PRECEDENCE_CONCATENATION + 1;
+  int operand_count = frame->operand_count + 1; // left operand has been compiled before chain
 
-  switch (operator_type) {
-    case LEXER_TOKEN_DOT_DOT: {
-      emit_instruction(CHUNK_OP_CONCATENATE);
-      break;
+  // chains exceeding instruction operand limit are split into several instructions (starting from the right)
+  while (operand_count > 1) {
+    int const instruction_operand_count = operand_count < UINT8_MAX ? operand_count : UINT8_MAX;
+
+    if (instruction_operand_count == 2) emit_instruction(CHUNK_OP_CONCATENATE);
+    else {
+      emit_instruction(CHUNK_OP_CONCATENATE_N);
+      emit_operand(instruction_operand_count);
     }
-    default: ERROR_INTERNAL("Unknown binary operator type '%d'", operator_type);
+
+    operand_count -= instruction_operand_count - 1;
   }
+
+  return PRECEDENCE_NONE;
 }
 
 /// Compile unary expression.
-static void compile_unary_expr(void) {
-  LexerTokenType const operator_type = parser.previous.type;
-  compile_precedence_expr(PRECEDENCE_UNARY);
+static Precedence compile_unary_expr(ExprFrame *const frame) {
+  LexerTokenType const operator_type = get_token_type(frame->token_index);
+  if (frame->operand_count == 0) return PRECEDENCE_UNARY;
 
   switch (operator_type) {
     case LEXER_TOKEN_MINUS: {
@@ -319,39 +487,59 @@ static void compile_unary_expr(void) {
     }
     default: ERROR_INTERNAL("Unknown unary operator type '%d'", operator_type);
   }
+
+  return PRECEDENCE_NONE;
 }
 
 /// Compile '(...)' grouping expression.
-static void compile_grouping_expr(void) {
-  compile_expr();
+static Precedence compile_grouping_expr(ExprFrame *const frame) {
+  if (frame->operand_count == 0) return PRECEDENCE_ASSIGNMENT; // grouped expression
+
   compiler_consume(LEXER_TOKEN_CLOSE_PAREN, "Expected ')' closing grouping expression");
+  return PRECEDENCE_NONE;
 }
 
 /// Compile numeric literal.
-static void compile_numeric_literal(void) {
-  errno = 0;
-  double const value = strtod(parser.previous.lexeme, NULL);
-  if (errno != 0) {
-    ERROR_MEMORY(
-      COMMON_FILE_LINE_COLUMN_FORMAT COMMON_MS "Out-of-range numeric literal '%.*s'", g_source_file_path,
-      parser.previous.line, parser.previous.column, parser.previous.lexeme_length, parser.previous.lexeme
-    );
+static Precedence compile_numeric_literal(ExprFrame *const frame) {
+  double value;
+  if (!number_parse(get_token_lexeme(frame->token_index), get_token_lexeme_length(frame->token_index), &value)) {
+    compiler_error_at(ERROR_SEMANTIC, frame->token_index, "Out-of-range numeric literal");
+    return PRECEDENCE_NONE;
   }
   emit_constant_instruction(value_make_number(value));
+
+  return PRECEDENCE_NONE;
 }
 
 /// Compile string literal.
-static void compile_string_literal(void) {
-  char const *const content = parser.previous.lexeme + 1; // account for beginning '"'
-  int const content_length = parser.previous.lexeme_length - 2; // account for surrounding '"'
-  ObjectString *const string_object = object_make_non_owning_string(content, content_length);
+static Precedence compile_string_literal(ExprFrame *const frame) {
+  char const *const content = get_token_lexeme(frame->token_index) + 1; // account for beginning '"'
+  int const content_length = get_token_lexeme_length(frame->token_index) - 2; // account for surrounding '"'
+
+  // VM executing pipelined batches interns their strings itself, as it can't share them with compiling thread
+  if (parser.is_interning_deferred) {
+    ObjectString *const string_object = object_make_uninitialized_owning_string(parser.vm, content_length);
+    memcpy(string_object->inline_content, content, content_length);
+    emit_constant_instruction(value_make_object((Object *)string_object));
+    return PRECEDENCE_NONE;
+  }
+
+#ifndef _WIN32
+  if (parser.object_creation_mutex != NULL) pthread_mutex_lock(parser.object_creation_mutex);
+#endif
+  ObjectString *const string_object = object_make_owning_string(parser.vm, content, content_length);
+#ifndef _WIN32
+  if (parser.object_creation_mutex != NULL) pthread_mutex_unlock(parser.object_creation_mutex);
+#endif
 
   emit_constant_instruction(value_make_object((Object *)string_object));
+
+  return PRECEDENCE_NONE;
 }
 
 /// Compile invariable literal (one with fixed lexeme).
-static void compile_invariable_literal(void) {
-  LexerTokenType const literal_type = parser.previous.type;
+static Precedence compile_invariable_literal(ExprFrame *const frame) {
+  LexerTokenType const literal_type = get_token_type(frame->token_index);
 
   switch (literal_type) {
     case LEXER_TOKEN_NIL: {
@@ -368,6 +556,27 @@ static void compile_invariable_literal(void) {
     }
     default: ERROR_INTERNAL("Unknown invariable literal type '%d'", literal_type);
   }
+
+  return PRECEDENCE_NONE;
+}
+
+/// Compile identifier referring to VM input slot (declared by VM configuration).
+static Precedence compile_input(ExprFrame *const frame) {
+  char const *const name = get_token_lexeme(frame->token_index);
+  int const name_length = get_token_lexeme_length(frame->token_index);
+  VMConfig const *const config = &parser.vm->config;
+
+  for (int input_slot = 0; input_slot < config->input_count; input_slot++) {
+    char const *const input_name = config->input_names[input_slot];
+    if (strncmp(input_name, name, name_length) != 0 || input_name[name_length] != '\0') continue;
+
+    emit_instruction(CHUNK_OP_INPUT);
+    emit_operand(input_slot);
+    return PRECEDENCE_NONE;
+  }
+
+  compiler_error_at(ERROR_SEMANTIC, frame->token_index, "Undeclared input");
+  return PRECEDENCE_NONE;
 }
 
 /// Compile expression statement.
@@ -390,33 +599,885 @@ static void compile_stmt(void) {
   else compile_expr_stmt();
 }
 
+/// Begin compiling `source_code` for `vm`, beginning at `first_line` and `first_column`, into `chunk`, reporting static
+/// analysis errors into `error_stream`; tokenizes `source_code` and resets compiler state.
+static void begin_compilation(
+  VM *const vm, char const *const source_code, int32_t const first_line, int const first_column, Chunk *const chunk,
+  FILE *const error_stream
+) {
+  parser.vm = vm;
+  parser.state = PARSER_OK;
+  parser.had_error = false;
+  parser.error_stream = error_stream;
+  current_chunk = chunk; // TEMP
+  DARRAY_INIT(&parser.expr_frames, sizeof(ExprFrame), memory_manage);
+  lexer_tokenize(source_code, vm->config.source_file_path, first_line, first_column, &parser.tokens);
+  parser.current = -1;
+  compiler_advance();
+}
+
+/// End compilation begun by begin_compilation.
+/// @note Neither terminating instruction is emitted, nor parser.tokens (ending with EOF token) are destroyed.
+/// @return Compiler status indicating compilation result.
+static CompilerStatus end_compilation(void) {
+  DARRAY_DESTROY(&parser.expr_frames);
+
+  if (!parser.had_error) return COMPILER_SUCCESS;
+  if (parser.state == PARSER_UNEXPECTED_EOF) return COMPILER_UNEXPECTED_EOF;
+  return COMPILER_FAILURE;
+}
+
+/// Compile `source_code` for `vm`, beginning at `first_line` and `first_column`, appending bytecode instructions to
+/// `chunk` and reporting static analysis errors into `error_stream`.
+/// @note Neither terminating instruction is emitted, nor parser.tokens (ending with EOF token) are destroyed.
+/// @return Compiler status indicating compilation result.
+static CompilerStatus compile_source_code(
+  VM *const vm, char const *const source_code, int32_t const first_line, int const first_column, Chunk *const chunk,
+  FILE *const error_stream
+) {
+  begin_compilation(vm, source_code, first_line, first_column, chunk, error_stream);
+
+  while (!compiler_match(LEXER_TOKEN_EOF)) {
+    parser.statement_start = parser.current;
+    parser.statement_checkpoint = chunk_make_checkpoint(chunk);
+    compile_stmt();
+  }
+
+  return end_compilation();
+}
+
+/// Find segment boundary in `source_code` of `length` (which has to begin outside of string literals, comments and
+/// groupings): beginning of the first line that follows statement-terminating ';' and lies at least `min_length` into
+/// `source_code`. Candidate lines are validated against string literal, comment and grouping state tracked from the
+/// beginning of `source_code`; ones residing within string literals, comments or groupings are skipped.
+/// @param line Line that `source_code` begins at; gets advanced to the line that found boundary begins at.
+/// @return Boundary offset, or 0 if there's none.
+static size_t find_segment_boundary(
+  char const *const source_code, size_t const length, size_t const min_length, int32_t *const line
+) {
+  assert(source_code != NULL);
+  assert(line != NULL);
+
+  bool is_in_string_literal = false, is_in_comment = false;
+  int grouping_depth = 0; // parentheses and curly braces
+  char last_significant_char = '\0'; // last character that's neither whitespace nor part of comment
+
+  for (size_t offset = 0; offset < length; offset++) {
+    char const character = source_code[offset];
+    if (character == '\n') (*line)++;
+
+    if (is_in_string_literal) {
+      if (character == '"') is_in_string_literal = false;
+      continue;
+    }
+    if (is_in_comment) {
+      if (character == '\n') is_in_comment = false;
+      else continue;
+    }
+
+    switch (character) {
+      case '"': {
+        is_in_string_literal = true;
+        break;
+      }
+      case '#': {
+        is_in_comment = true;
+        continue;
+      }
+      case '(':
+      case '{': {
+        grouping_depth++;
+        break;
+      }
+      case ')':
+      case '}': {
+        grouping_depth--;
+        break;
+      }
+      case '\n': {
+        // validate candidate boundary (next line beginning)
+        if (offset + 1 < min_length || last_significant_char != ';' || grouping_depth != 0) continue;
+        return offset + 1;
+      }
+    }
+
+    if (!character_is_whitespace(character)) last_significant_char = character;
+  }
+
+  return 0;
+}
+
+/// Split `source_code` of `length` into at most `max_segment_count` segments of similar length.
+/// Segments begin at the first line following statement-terminating ';' past each even split point. Such lines are
+/// found by a single serial scan over `source_code`, tracking string literal, comment and grouping state (see
+/// find_segment_boundary).
+/// @return Number of segments `source_code` was split into.
+static int split_source_code(
+  char const *const source_code, size_t const length, CompilerSegment *const segments, int const max_segment_count
+) {
+  assert(max_segment_count >= 1);
+
+  int segment_count = 1;
+  segments[0] = (CompilerSegment){.source_code = source_code, .first_line = 1};
+
+  size_t segment_offset = 0;
+  int32_t line = 1;
+  while (segment_count < max_segment_count) {
+    size_t const split_offset = length / max_segment_count * segment_count;
+    size_t const min_length = split_offset > segment_offset ? split_offset - segment_offset : 0;
+    size_t const boundary =
+      find_segment_boundary(source_code + segment_offset, length - segment_offset, min_length, &line);
+    if (boundary == 0 || segment_offset + boundary == length) break;
+    segment_offset += boundary;
+
+    segments[segment_count] = (CompilerSegment){.source_code = source_code + segment_offset, .first_line = line};
+    segment_count++;
+  }
+
+  // determine segment lengths
+  for (int i = 0; i < segment_count - 1; i++) segments[i].length = segments[i + 1].source_code - segments[i].source_code;
+  segments[segment_count - 1].length = source_code + length - segments[segment_count - 1].source_code;
+
+  return segment_count;
+}
+
+/// Compile `segment` for `vm` into its own chunk, buffering its static analysis errors.
+static void compile_segment(VM *const vm, CompilerSegment *const segment) {
+  assert(vm != NULL);
+  assert(segment != NULL);
+
+  // lexer requires NUL terminated source code
+  char *const source_code = malloc(segment->length + 1);
+  if (source_code == NULL) ERROR_MEMORY_ERRNO();
+  memcpy(source_code, segment->source_code, segment->length);
+  source_code[segment->length] = '\0';
+
+#ifdef _WIN32
+  FILE *const error_stream = tmpfile();
+#else // POSIX
+  FILE *const error_stream = open_memstream(&segment->static_analysis_errors, &segment->static_analysis_errors_length);
+#endif
+  if (error_stream == NULL) ERROR_IO_ERRNO();
+
+  chunk_init(&segment->chunk);
+  segment->status = compile_source_code(vm, source_code, segment->first_line, 1, &segment->chunk, error_stream);
+  segment->last_line = get_token_line(parser.previous);
+  lexer_token_buffer_destroy(&parser.tokens);
+
+#ifdef _WIN32
+  // read buffered errors back
+  long const errors_length = ftell(error_stream);
+  if (errors_length == -1) ERROR_IO_ERRNO();
+  segment->static_analysis_errors = malloc(errors_length + 1);
+  if (segment->static_analysis_errors == NULL) ERROR_MEMORY_ERRNO();
+  rewind(error_stream);
+  segment->static_analysis_errors_length = fread(segment->static_analysis_errors, 1, errors_length, error_stream);
+#endif
+  if (fclose(error_stream) == EOF) ERROR_IO_ERRNO();
+
+  free(source_code);
+}
+
+/// Scan characters of `stream` pending source code that haven't been scanned yet for statement boundaries: positions
+/// following statement-terminating ';' that resides outside of string literals, comments and groupings. Scan state
+/// carries over between calls, so that every pending character is scanned only once, regardless of block count.
+/// The last found boundary is kept in `stream`, along with whether token following it is known.
+static void scan_stream_statement_boundary(CompilerStream *const stream) {
+  assert(stream != NULL);
+
+  char const *const source_code = stream->pending_source_code.data;
+  for (size_t offset = stream->scanned_length; offset < stream->pending_source_code.count; offset++) {
+    char const character = source_code[offset];
+    if (character == '\n') {
+      stream->scanned_line++;
+      stream->scanned_column = 1;
+    } else stream->scanned_column++;
+
+    if (stream->is_scanning_string_literal) {
+      if (character == '"') {
+        stream->is_scanning_string_literal = false;
+        stream->is_lookahead_known = true;
+      }
+      continue;
+    }
+    if (stream->is_scanning_comment) {
+      if (character == '\n') stream->is_scanning_comment = false;
+      continue;
+    }
+    // token following boundary is known once it begins, unless it's string literal (then it's known once it ends)
+    if (character != '"' && character != '#' && !character_is_whitespace(character)) stream->is_lookahead_known = true;
+
+    switch (character) {
+      case '"': {
+        stream->is_scanning_string_literal = true;
+        break;
+      }
+      case '#': {
+        stream->is_scanning_comment = true;
+        break;
+      }
+      case '(':
+      case '{': {
+        stream->scanned_grouping_depth++;
+        break;
+      }
+      case ')':
+      case '}': {
+        stream->scanned_grouping_depth--;
+        break;
+      }
+      case ';': {
+        if (stream->scanned_grouping_depth != 0) break;
+        stream->boundary_length = offset + 1;
+        stream->boundary_line = stream->scanned_line;
+        stream->boundary_column = stream->scanned_column;
+        stream->is_lookahead_known = false;
+        break;
+      }
+    }
+  }
+  stream->scanned_length = stream->pending_source_code.count;
+}
+
+/// Compile statements beginning within first `length` characters of `stream` pending source code (which end at
+/// statement boundary, or pending source code end) into stream chunk, terminating it with RETURN. Pending source code
+/// following them is visible to the parser, as token following the last compiled statement is read ahead (the same way
+/// as by whole source code compilation).
+/// @param error_stream Stream static analysis errors are reported into (NULL if they're merely recorded).
+/// @return Compiler status indicating compilation result.
+static CompilerStatus compile_pending_stream_source_code(
+  CompilerStream *const stream, size_t const length, FILE *const error_stream
+) {
+  assert(stream != NULL);
+  assert(length <= stream->pending_source_code.count);
+
+  // lexer requires NUL terminated source code
+  if (stream->pending_source_code.capacity < stream->pending_source_code.count + 1) {
+    DARRAY_RESERVE(&stream->pending_source_code, stream->pending_source_code.count + 1);
+  }
+  char *const source_code = stream->pending_source_code.data;
+  source_code[stream->pending_source_code.count] = '\0';
+
+  begin_compilation(
+    stream->vm, source_code, stream->pending_first_line, stream->pending_first_column, stream->chunk, error_stream
+  );
+  while (!compiler_match(LEXER_TOKEN_EOF) && get_token_lexeme(parser.current) < source_code + length) {
+    parser.statement_start = parser.current;
+    parser.statement_checkpoint = chunk_make_checkpoint(stream->chunk);
+    compile_stmt();
+  }
+  CompilerStatus const status = end_compilation();
+  emit_instruction(CHUNK_OP_RETURN); // TEMP
+  lexer_token_buffer_destroy(&parser.tokens);
+
+#ifdef DEBUG_COMPILER
+  if (status == COMPILER_SUCCESS && error_stream != NULL) {
+    debug_disassemble_chunk(stream->chunk, stream->vm->config.source_file_path, "DEBUG_COMPILER");
+  }
+#endif
+
+  return status;
+}
+
+/// Drop first `length` characters of `stream` pending source code (once they got compiled).
+/// @param next_line Line that pending source code following dropped characters begins at.
+/// @param next_column Column that pending source code following dropped characters begins at.
+static void drop_pending_stream_source_code(
+  CompilerStream *const stream, size_t const length, int32_t const next_line, int const next_column
+) {
+  assert(stream != NULL);
+  assert(length <= stream->pending_source_code.count);
+
+  char *const source_code = stream->pending_source_code.data;
+  memmove(source_code, source_code + length, stream->pending_source_code.count - length);
+  stream->pending_source_code.count -= length;
+  stream->scanned_length -= length;
+  stream->pending_first_line = next_line;
+  stream->pending_first_column = next_column;
+
+  // the last scanned boundary lies within dropped characters
+  stream->boundary_length = 0;
+}
+
+/// Compile `segment` for `vm` once more on calling thread, appending its bytecode instructions directly to `chunk`
+/// (which holds preceding segments) and reporting static analysis errors right away.
+/// @return Compiler status indicating compilation result.
+static CompilerStatus recompile_segment(VM *const vm, CompilerSegment const *const segment, Chunk *const chunk) {
+  assert(vm != NULL);
+  assert(segment != NULL);
+  assert(chunk != NULL);
+
+  // lexer requires NUL terminated source code
+  char *const source_code = malloc(segment->length + 1);
+  if (source_code == NULL) ERROR_MEMORY_ERRNO();
+  memcpy(source_code, segment->source_code, segment->length);
+  source_code[segment->length] = '\0';
+
+  CompilerStatus const status =
+    compile_source_code(vm, source_code, segment->first_line, 1, chunk, vm->config.static_analysis_error_stream);
+  lexer_token_buffer_destroy(&parser.tokens);
+
+  free(source_code);
+
+  return status;
+}
+
+#ifndef _WIN32
+/// Compile `queue` segments until there are none left.
+/// @return NULL (signature conforms to pthread start routine).
+static void *compile_queued_segments(void *const queue_ptr) {
+  CompilerSegmentQueue *const queue = queue_ptr;
+
+  parser.object_creation_mutex = &queue->object_creation_mutex;
+  for (;;) {
+    int const segment_index = atomic_fetch_add(&queue->next_segment_index, 1);
+    if (segment_index >= queue->segment_count) break;
+
+    compile_segment(queue->vm, &queue->segments[segment_index]);
+  }
+  parser.object_creation_mutex = NULL;
+
+  return NULL;
+}
+#endif
+
+/// Compile `queue` segments using `thread_count` threads (including calling one).
+static void compile_segments_in_parallel(CompilerSegmentQueue *const queue, int const thread_count) {
+  assert(queue != NULL);
+  assert(thread_count >= 1);
+
+#ifdef _WIN32
+  // segments are compiled by calling thread alone
+  for (int i = 0; i < queue->segment_count; i++) compile_segment(queue->vm, &queue->segments[i]);
+#else // POSIX
+  pthread_t *const threads = malloc(sizeof(pthread_t) * thread_count);
+  if (threads == NULL) ERROR_MEMORY_ERRNO();
+
+  for (int i = 1; i < thread_count; i++) {
+    int const error_number = pthread_create(&threads[i], NULL, compile_queued_segments, queue);
+    if (error_number != 0) ERROR_SYSTEM("Failed to start compiler thread" COMMON_MS "%s\n", strerror(error_number));
+  }
+
+  compile_queued_segments(queue);
+
+  for (int i = 1; i < thread_count; i++) {
+    int const error_number = pthread_join(threads[i], NULL);
+    if (error_number != 0) ERROR_SYSTEM("Failed to join compiler thread" COMMON_MS "%s\n", strerror(error_number));
+  }
+
+  free(threads);
+#endif
+}
+
+/// Get number of processors available for compilation.
+/// @return Available processor count.
+static int get_available_processor_count(void) {
+#ifdef _WIN32
+  return 1;
+#else // POSIX
+  long const processor_count = sysconf(_SC_NPROCESSORS_ONLN);
+  return processor_count < 1 ? 1 : processor_count;
+#endif
+}
+
+/// Compile next batch of `pipeline` source code into `batch` (batch strings are left uninterned and untracked).
+/// @return Whether it's the last batch (source code got exhausted, or batch failed to compile).
+static bool compile_next_batch(CompilerPipeline *const pipeline, CompilerSegment *const batch) {
+  assert(pipeline != NULL);
+  assert(batch != NULL);
+
+  int32_t next_line = pipeline->line;
+  size_t batch_length =
+    find_segment_boundary(pipeline->source_code, pipeline->remaining_length, COMPILER_BATCH_LENGTH, &next_line);
+  if (batch_length == 0) batch_length = pipeline->remaining_length;
+  *batch = (CompilerSegment){
+    .source_code = pipeline->source_code,
+    .length = batch_length,
+    .first_line = pipeline->line,
+  };
+
+  parser.is_interning_deferred = true;
+  compile_segment(pipeline->vm, batch);
+  parser.is_interning_deferred = false;
+  chunk_append_instruction(&batch->chunk, CHUNK_OP_RETURN, batch->last_line); // TEMP
+
+  pipeline->source_code += batch_length;
+  pipeline->remaining_length -= batch_length;
+  pipeline->line = next_line;
+
+  return pipeline->remaining_length == 0 || batch->status != COMPILER_SUCCESS;
+}
+
+/// Release `batch` compiled by `pipeline` without executing it.
+static void discard_batch(CompilerPipeline *const pipeline, CompilerSegment *const batch) {
+  assert(pipeline != NULL);
+  assert(batch != NULL);
+
+  // batch strings are untracked, hence they have to be deallocated here
+  for (size_t i = 0; i < batch->chunk.constants.count; i++) {
+    Value const constant = batch->chunk.constants.data[i];
+    if (!value_is_string(constant)) continue;
+
+    ObjectString *const string = (ObjectString *)constant.as.object;
+    gc_deallocate(pipeline->vm, string, sizeof(*string) + string->length);
+  }
+
+  chunk_destroy(&batch->chunk);
+  free(batch->static_analysis_errors);
+}
+
+#ifndef _WIN32
+/// Compile `pipeline_ptr` pipeline source code batch by batch, until it's exhausted, batch fails to compile, or
+/// pipeline gets stopped. Compiling thread blocks whenever pipeline holds COMPILER_PIPELINE_CAPACITY batches.
+/// @return NULL (signature conforms to pthread start routine).
+static void *run_compiler_pipeline(void *const pipeline_ptr) {
+  CompilerPipeline *const pipeline = pipeline_ptr;
+
+  for (bool is_compiled = false; !is_compiled;) {
+    CompilerSegment batch;
+    bool const is_last_batch = compile_next_batch(pipeline, &batch);
+
+    pthread_mutex_lock(&pipeline->mutex);
+    while (pipeline->batch_count == COMPILER_PIPELINE_CAPACITY && !pipeline->is_stopping) {
+      pthread_cond_wait(&pipeline->condition, &pipeline->mutex);
+    }
+    bool const is_stopping = pipeline->is_stopping;
+    if (!is_stopping) {
+      int const batch_index = (pipeline->first_batch_index + pipeline->batch_count) % COMPILER_PIPELINE_CAPACITY;
+      pipeline->batches[batch_index] = batch;
+      pipeline->batch_count++;
+      pipeline->is_compiled = is_last_batch;
+      pthread_cond_broadcast(&pipeline->condition);
+    }
+    is_compiled = is_last_batch || is_stopping;
+    pthread_mutex_unlock(&pipeline->mutex);
+
+    if (is_stopping) discard_batch(pipeline, &batch);
+  }
+
+  return NULL;
+}
+
+/// Take next batch compiled by `pipeline` dedicated thread into `batch`, waiting for it to be compiled.
+/// @return true if batch got taken, false if there are none left.
+static bool take_compiled_batch(CompilerPipeline *const pipeline, CompilerSegment *const batch) {
+  assert(pipeline != NULL);
+  assert(batch != NULL);
+
+  pthread_mutex_lock(&pipeline->mutex);
+  while (pipeline->batch_count == 0 && !pipeline->is_compiled) {
+    pthread_cond_wait(&pipeline->condition, &pipeline->mutex);
+  }
+
+  bool const is_batch_available = pipeline->batch_count > 0;
+  if (is_batch_available) {
+    *batch = pipeline->batches[pipeline->first_batch_index];
+    pipeline->first_batch_index = (pipeline->first_batch_index + 1) % COMPILER_PIPELINE_CAPACITY;
+    pipeline->batch_count--;
+    pthread_cond_broadcast(&pipeline->condition);
+  }
+  pthread_mutex_unlock(&pipeline->mutex);
+
+  return is_batch_available;
+}
+#endif
+
 // *---------------------------------------------*
 // *         EXTERNAL-LINKAGE FUNCTIONS          *
 // *---------------------------------------------*
 
-/// Compile `source_code` into bytecode instructions and append them to `chunk`.
+/// Compile `source_code` for `vm` into bytecode instructions and append them to `chunk`.
+/// @note Long `source_code` is compiled in parallel (see compiler_compile_parallel).
 /// @return Compiler status indicating compilation result.
-CompilerStatus compiler_compile(char const *const source_code, Chunk *const chunk) {
+CompilerStatus compiler_compile(VM *const vm, char const *const source_code, Chunk *const chunk) {
+  assert(vm != NULL);
   assert(source_code != NULL);
   assert(chunk != NULL);
 
-  // reset compiler
-  parser.state = PARSER_OK;
-  parser.had_error = false;
-  current_chunk = chunk; // TEMP
-  lexer_init(source_code);
-  compiler_advance();
-
-  // compile source_code
-  while (!compiler_match(LEXER_TOKEN_EOF)) compile_stmt();
+  size_t const segment_count = strlen(source_code) / COMPILER_SEGMENT_LENGTH;
+  if (segment_count > 1 && get_available_processor_count() > 1) {
+    return compiler_compile_parallel(vm, source_code, chunk, segment_count < INT32_MAX ? segment_count : INT32_MAX);
+  }
 
+  CompilerStatus const status =
+    compile_source_code(vm, source_code, 1, 1, chunk, vm->config.static_analysis_error_stream);
   emit_instruction(CHUNK_OP_RETURN); // TEMP
+  lexer_token_buffer_destroy(&parser.tokens);
 
 #ifdef DEBUG_COMPILER
-  if (!parser.had_error) debug_disassemble_chunk(chunk, "DEBUG_COMPILER");
+  if (status == COMPILER_SUCCESS) debug_disassemble_chunk(chunk, vm->config.source_file_path, "DEBUG_COMPILER");
 #endif
 
-  if (!parser.had_error) return COMPILER_SUCCESS;
-  if (parser.state == PARSER_UNEXPECTED_EOF) return COMPILER_UNEXPECTED_EOF;
-  return COMPILER_FAILURE;
+  return status;
+}
+
+/// Compile `source_code` consisting of a single expression (without terminating ';') for `vm` into bytecode
+/// instructions leaving its value on top of `vm` stack, and append them to `chunk` (terminated with RETURN).
+/// Meant for embedding hosts evaluating expressions over their inputs (see VMConfig input slots).
+/// @return Compiler status indicating compilation result.
+CompilerStatus compiler_compile_expression(VM *const vm, char const *const source_code, Chunk *const chunk) {
+  assert(vm != NULL);
+  assert(source_code != NULL);
+  assert(chunk != NULL);
+
+  begin_compilation(vm, source_code, 1, 1, chunk, vm->config.static_analysis_error_stream);
+  compile_expr();
+  compiler_consume(LEXER_TOKEN_EOF, "Expected end of expression");
+  CompilerStatus const status = end_compilation();
+  emit_instruction(CHUNK_OP_RETURN);
+  lexer_token_buffer_destroy(&parser.tokens);
+
+#ifdef DEBUG_COMPILER
+  if (status == COMPILER_SUCCESS) debug_disassemble_chunk(chunk, vm->config.source_file_path, "DEBUG_COMPILER");
+#endif
+
+  return status;
+}
+
+/// Split `source_code` into up to `max_segment_count` segments at statement boundaries, compile them for `vm` into
+/// separate chunks on a pool of threads, and link resulting chunks (along with their constants and lines) into `chunk`.
+/// @note Outcome (including reported static analysis errors) is identical to that of compiler_compile.
+/// @return Compiler status indicating compilation result.
+CompilerStatus compiler_compile_parallel(
+  VM *const vm, char const *const source_code, Chunk *const chunk, int const max_segment_count
+) {
+  assert(vm != NULL);
+  assert(source_code != NULL);
+  assert(chunk != NULL);
+  assert(max_segment_count >= 1);
+
+  CompilerSegment *const segments = malloc(sizeof(CompilerSegment) * max_segment_count);
+  if (segments == NULL) ERROR_MEMORY_ERRNO();
+
+  CompilerSegmentQueue queue = {.vm = vm, .segments = segments};
+  queue.segment_count = split_source_code(source_code, strlen(source_code), segments, max_segment_count);
+#ifndef _WIN32
+  atomic_init(&queue.next_segment_index, 0);
+  int const error_number = pthread_mutex_init(&queue.object_creation_mutex, NULL);
+  if (error_number != 0) ERROR_SYSTEM("Failed to initialize compiler mutex" COMMON_MS "%s\n", strerror(error_number));
+#endif
+
+  int const processor_count = get_available_processor_count();
+  compile_segments_in_parallel(&queue, queue.segment_count < processor_count ? queue.segment_count : processor_count);
+#ifndef _WIN32
+  pthread_mutex_destroy(&queue.object_creation_mutex);
+#endif
+
+  // link segments; static analysis stops being reported past first error, hence only first failed segment reports
+  CompilerStatus status = COMPILER_SUCCESS;
+  int segment_index = 0;
+  for (; segment_index < queue.segment_count; segment_index++) {
+    CompilerSegment *const segment = &segments[segment_index];
+
+    // segment whose constants don't fit into chunk is compiled into it once more, so that constant pool overflow gets
+    // reported exactly where compiler_compile reports it
+    if (chunk->constants.count + segment->chunk.constants.count > CHUNK_MAX_CONSTANT_COUNT) {
+      if (status == COMPILER_SUCCESS) status = recompile_segment(vm, segment, chunk);
+      break;
+    }
+
+    if (status == COMPILER_SUCCESS && segment->status != COMPILER_SUCCESS) {
+      status = segment->status;
+      FILE *const error_stream = vm->config.static_analysis_error_stream;
+      fwrite(segment->static_analysis_errors, 1, segment->static_analysis_errors_length, error_stream);
+      if (ferror(error_stream)) ERROR_IO_ERRNO();
+    }
+    if (chunk_append_chunk(chunk, &segment->chunk) != 0) ERROR_INTERNAL("Expected segment constants to fit into chunk");
+
+    chunk_destroy(&segment->chunk);
+    free(segment->static_analysis_errors);
+  }
+
+  // segments following constant pool overflow don't get linked
+  for (; segment_index < queue.segment_count; segment_index++) {
+    chunk_destroy(&segments[segment_index].chunk);
+    free(segments[segment_index].static_analysis_errors);
+  }
+  chunk_append_instruction(chunk, CHUNK_OP_RETURN, segments[queue.segment_count - 1].last_line); // TEMP
+
+  free(segments);
+
+#ifdef DEBUG_COMPILER
+  if (status == COMPILER_SUCCESS) debug_disassemble_chunk(chunk, vm->config.source_file_path, "DEBUG_COMPILER");
+#endif
+
+  return status;
+}
+
+/// Initialize `session` compiling for `vm` into `chunk`.
+void compiler_session_init(CompilerSession *const session, VM *const vm, Chunk *const chunk) {
+  assert(session != NULL);
+  assert(vm != NULL);
+  assert(chunk != NULL);
+
+  session->vm = vm;
+  session->chunk = chunk;
+  DARRAY_INIT(&session->pending_source_code, sizeof(char), memory_manage);
+  session->pending_first_line = 1;
+  session->pending_first_column = 1;
+}
+
+/// Release `session` resources and set it to uninitialized state.
+/// @note Session chunk isn't destroyed.
+void compiler_session_destroy(CompilerSession *const session) {
+  assert(session != NULL);
+
+  DARRAY_DESTROY(&session->pending_source_code);
+  *session = (CompilerSession){0};
+}
+
+/// Compile source code `line`, continuing statement cut off by the end of line previously compiled by `session`.
+/// Statements completed by previous lines have already been compiled into session chunk; only the cut-off statement
+/// gets compiled again (along with `line`), so that compiling multiline source code line by line takes linear time.
+/// @note On COMPILER_UNEXPECTED_EOF session chunk holds statements completed so far, and session awaits next line.
+/// Otherwise, it holds the whole compiled source code (terminated with RETURN), and next line begins new source code.
+/// @return Compiler status indicating compilation result.
+CompilerStatus compiler_session_compile_line(CompilerSession *const session, char const *const line) {
+  assert(session != NULL);
+  assert(line != NULL);
+
+  { // append line to pending source code (separating it from the cut-off statement with a newline)
+    size_t const line_length = strlen(line);
+    bool const is_continuing = session->pending_source_code.count > 0;
+    size_t const pending_length = is_continuing ? session->pending_source_code.count - 1 : 0; // exclude NUL
+    size_t const new_count = pending_length + is_continuing + line_length + 1; // account for NUL terminator
+
+    if (session->pending_source_code.capacity < new_count) DARRAY_RESERVE(&session->pending_source_code, new_count);
+    if (is_continuing) session->pending_source_code.data[pending_length] = '\n';
+    memcpy(session->pending_source_code.data + pending_length + is_continuing, line, line_length + 1);
+    session->pending_source_code.count = new_count;
+  }
+
+  CompilerStatus const status = compile_source_code(
+    session->vm, session->pending_source_code.data, session->pending_first_line, session->pending_first_column,
+    session->chunk, session->vm->config.static_analysis_error_stream
+  );
+
+  if (status == COMPILER_UNEXPECTED_EOF) {
+    // discard bytecode partially emitted by the cut-off statement, and keep its source code pending
+    chunk_rollback(session->chunk, &parser.statement_checkpoint);
+
+    char const *const statement_source_code = get_token_lexeme(parser.statement_start);
+    uint32_t const statement_offset = statement_source_code - session->pending_source_code.data;
+    session->pending_first_line = lexer_token_buffer_move_line_cursor(&parser.tokens, statement_offset);
+    session->pending_first_column = lexer_token_buffer_get_column(&parser.tokens, parser.statement_start);
+
+    size_t const statement_count = session->pending_source_code.count - statement_offset; // includes NUL terminator
+    memmove(session->pending_source_code.data, statement_source_code, statement_count);
+    session->pending_source_code.count = statement_count;
+  } else {
+    emit_instruction(CHUNK_OP_RETURN); // TEMP
+
+    // next line begins new source code
+    session->pending_source_code.count = 0;
+    session->pending_first_line = 1;
+    session->pending_first_column = 1;
+  }
+
+  lexer_token_buffer_destroy(&parser.tokens);
+
+#ifdef DEBUG_COMPILER
+  if (status == COMPILER_SUCCESS) {
+    debug_disassemble_chunk(session->chunk, session->vm->config.source_file_path, "DEBUG_COMPILER");
+  }
+#endif
+
+  return status;
+}
+
+/// Initialize `stream` compiling for `vm` into `chunk`.
+void compiler_stream_init(CompilerStream *const stream, VM *const vm, Chunk *const chunk) {
+  assert(stream != NULL);
+  assert(vm != NULL);
+  assert(chunk != NULL);
+
+  stream->vm = vm;
+  stream->chunk = chunk;
+  DARRAY_INIT(&stream->pending_source_code, sizeof(char), memory_manage);
+  stream->pending_first_line = 1;
+  stream->pending_first_column = 1;
+  stream->scanned_length = 0;
+  stream->scanned_line = 1;
+  stream->scanned_column = 1;
+  stream->is_scanning_string_literal = false;
+  stream->is_scanning_comment = false;
+  stream->scanned_grouping_depth = 0;
+  stream->boundary_length = 0;
+  stream->boundary_line = 1;
+  stream->boundary_column = 1;
+  stream->is_lookahead_known = false;
+}
+
+/// Release `stream` resources and set it to uninitialized state.
+/// @note Stream chunk isn't destroyed.
+void compiler_stream_destroy(CompilerStream *const stream) {
+  assert(stream != NULL);
+
+  DARRAY_DESTROY(&stream->pending_source_code);
+  *stream = (CompilerStream){0};
+}
+
+/// Feed `source_code` block of `length` (which may end anywhere, even mid-token) into `stream`, and compile pending
+/// statements up to the last statement boundary (see scan_stream_statement_boundary) into stream chunk. Source code
+/// following that boundary is kept pending, until subsequent blocks complete it, or the stream gets finished.
+/// Static analysis errors are reported exactly as by whole source code compilation, which reads token following the
+/// last compiled statement ahead (reporting it if it's a lexical error); statements failing to compile are therefore
+/// kept pending until that token is known (see CompilerStream).
+/// @note Stream chunk is left intact if there's no complete statement to compile. Otherwise, compiled statements are
+/// appended to it (terminated with RETURN); caller is expected to execute and reset it before feeding next block.
+/// @return Compiler status indicating compilation result.
+CompilerStatus compiler_stream_feed(CompilerStream *const stream, char const *const source_code, size_t const length) {
+  assert(stream != NULL);
+  assert(source_code != NULL || length == 0);
+
+  size_t const pending_length = stream->pending_source_code.count;
+  if (stream->pending_source_code.capacity < pending_length + length) {
+    DARRAY_RESERVE(&stream->pending_source_code, pending_length + length);
+  }
+  if (length > 0) memcpy(stream->pending_source_code.data + pending_length, source_code, length);
+  stream->pending_source_code.count += length;
+
+  scan_stream_statement_boundary(stream);
+  if (stream->boundary_length == 0) return COMPILER_SUCCESS;
+
+  bool const is_lookahead_known = stream->is_lookahead_known;
+  ChunkCheckpoint const checkpoint = chunk_make_checkpoint(stream->chunk);
+  CompilerStatus const status = compile_pending_stream_source_code(
+    stream, stream->boundary_length, is_lookahead_known ? stream->vm->config.static_analysis_error_stream : NULL
+  );
+  if (status != COMPILER_SUCCESS && !is_lookahead_known) {
+    chunk_rollback(stream->chunk, &checkpoint);
+    return COMPILER_SUCCESS;
+  }
+
+  drop_pending_stream_source_code(stream, stream->boundary_length, stream->boundary_line, stream->boundary_column);
+  return status;
+}
+
+/// Compile source code remaining pending in `stream` (once there's nothing more to feed) into stream chunk.
+/// @note Stream chunk is left intact if no source code is pending.
+/// @return Compiler status indicating compilation result.
+CompilerStatus compiler_stream_finish(CompilerStream *const stream) {
+  assert(stream != NULL);
+
+  size_t const pending_length = stream->pending_source_code.count;
+  if (pending_length == 0) return COMPILER_SUCCESS;
+
+  CompilerStatus const status =
+    compile_pending_stream_source_code(stream, pending_length, stream->vm->config.static_analysis_error_stream);
+  drop_pending_stream_source_code(stream, pending_length, stream->scanned_line, stream->scanned_column);
+  return status;
+}
+
+/// Start compiling `source_code` for `vm` in batches of whole statements on a dedicated thread, so that batches can
+/// be executed (and released) while subsequent ones are still being compiled. Compilation gets ahead of execution by
+/// at most COMPILER_PIPELINE_CAPACITY batches.
+/// @note Compiled batches are executed in order; batch failing to compile ends the pipeline. Batches are compiled on
+/// demand, by thread taking them, on Windows and for VMs with object allocator (which isn't required to be
+/// thread-safe).
+/// @return Heap-allocated pipeline, released by compiler_pipeline_stop.
+CompilerPipeline *compiler_pipeline_start(VM *const vm, char const *const source_code) {
+  assert(vm != NULL);
+  assert(source_code != NULL);
+
+  CompilerPipeline *const pipeline = malloc(sizeof(*pipeline));
+  if (pipeline == NULL) ERROR_MEMORY_ERRNO();
+
+  pipeline->vm = vm;
+  pipeline->source_code = source_code;
+  pipeline->remaining_length = strlen(source_code);
+  pipeline->line = 1;
+  pipeline->first_batch_index = 0;
+  pipeline->batch_count = 0;
+  pipeline->is_compiled = false;
+
+#ifdef _WIN32
+  pipeline->is_concurrent = false;
+#else // POSIX
+  pipeline->is_concurrent = vm->config.object_allocator == NULL;
+  if (pipeline->is_concurrent) {
+    pipeline->is_stopping = false;
+    int error_number = pthread_mutex_init(&pipeline->mutex, NULL);
+    if (error_number == 0) error_number = pthread_cond_init(&pipeline->condition, NULL);
+    if (error_number == 0) error_number = pthread_create(&pipeline->thread, NULL, run_compiler_pipeline, pipeline);
+    if (error_number != 0) ERROR_SYSTEM("Failed to start compiler thread" COMMON_MS "%s\n", strerror(error_number));
+  }
+#endif
+
+  return pipeline;
+}
+
+/// Take next batch compiled by `pipeline` (waiting for it to be compiled), interning its strings within pipeline VM.
+/// Static analysis errors of batch that failed to compile get reported once it's taken, hence they're ordered after
+/// output of preceding batches.
+/// @param chunk Uninitialized chunk receiving batch bytecode (terminated with RETURN); caller has to destroy it.
+/// @param status Receives batch compiler status; batch has to be executed only if it's COMPILER_SUCCESS.
+/// @return true if batch got taken, false if there are none left.
+bool compiler_pipeline_take_batch(CompilerPipeline *const pipeline, Chunk *const chunk, CompilerStatus *const status) {
+  assert(pipeline != NULL);
+  assert(chunk != NULL);
+  assert(status != NULL);
+
+  CompilerSegment batch;
+#ifndef _WIN32
+  if (pipeline->is_concurrent) {
+    if (!take_compiled_batch(pipeline, &batch)) return false;
+  } else
+#endif
+  {
+    if (pipeline->is_compiled) return false;
+    pipeline->is_compiled = compile_next_batch(pipeline, &batch);
+  }
+
+  // intern batch strings (their duplicates get deallocated)
+  for (size_t i = 0; i < batch.chunk.constants.count; i++) {
+    Value *const constant = &batch.chunk.constants.data[i];
+    if (!value_is_string(*constant)) continue;
+
+    ObjectString *const string = object_intern_owning_string(pipeline->vm, (ObjectString *)constant->as.object);
+    *constant = value_make_object((Object *)string);
+  }
+
+  if (batch.status != COMPILER_SUCCESS) {
+    FILE *const error_stream = pipeline->vm->config.static_analysis_error_stream;
+    fwrite(batch.static_analysis_errors, 1, batch.static_analysis_errors_length, error_stream);
+    if (ferror(error_stream)) ERROR_IO_ERRNO();
+  }
+  free(batch.static_analysis_errors);
+
+#ifdef DEBUG_COMPILER
+  if (batch.status == COMPILER_SUCCESS) {
+    debug_disassemble_chunk(&batch.chunk, pipeline->vm->config.source_file_path, "DEBUG_COMPILER");
+  }
+#endif
+
+  *chunk = batch.chunk;
+  *status = batch.status;
+  return true;
+}
+
+/// Stop `pipeline` compilation (discarding batches that haven't been taken), and release `pipeline` resources.
+void compiler_pipeline_stop(CompilerPipeline *const pipeline) {
+  assert(pipeline != NULL);
+
+#ifndef _WIN32
+  if (pipeline->is_concurrent) {
+    pthread_mutex_lock(&pipeline->mutex);
+    pipeline->is_stopping = true;
+    pthread_cond_broadcast(&pipeline->condition);
+    pthread_mutex_unlock(&pipeline->mutex);
+
+    int const error_number = pthread_join(pipeline->thread, NULL);
+    if (error_number != 0) ERROR_SYSTEM("Failed to join compiler thread" COMMON_MS "%s\n", strerror(error_number));
+
+    pthread_cond_destroy(&pipeline->condition);
+    pthread_mutex_destroy(&pipeline->mutex);
+  }
+#endif
+
+  for (int i = 0; i < pipeline->batch_count; i++) {
+    discard_batch(pipeline, &pipeline->batches[(pipeline->first_batch_index + i) % COMPILER_PIPELINE_CAPACITY]);
+  }
+
+  free(pipeline);
 }
@@ -3,26 +3,160 @@
 #include "utils/character.h"
 #include "utils/debug.h"
 #include "utils/io.h"
+#include "utils/memory.h"
 
+#include <inttypes.h>
 #include <stdbool.h>
+#include <stdint.h>
 #include <stdio.h>
 #include <string.h>
 
+#if defined(__AVX2__) || defined(__SSE2__)
+#include <immintrin.h>
+#endif
+
+// *---------------------------------------------*
+// *              MACRO DEFINITIONS              *
+// *---------------------------------------------*
+
+// vectorized scanning processes LEXER_VECTOR_SIZE source characters at a time (scalar fallback is used otherwise)
+#if defined(__AVX2__)
+#define LEXER_VECTOR_SIZE 32
+#elif defined(__SSE2__)
+#define LEXER_VECTOR_SIZE 16
+#endif
+
+#ifdef LEXER_VECTOR_SIZE
+/// Mask with `length` lowest bits set (`length` <= 32).
+#define LEXER_LOW_BITS_MASK(length) ((uint32_t)((UINT64_C(1) << (length)) - 1))
+
+#define LEXER_COUNT_TRAILING_ZEROS(mask) __builtin_ctz(mask)
+#define LEXER_COUNT_LEADING_ZEROS(mask) __builtin_clz(mask)
+#define LEXER_COUNT_SET_BITS(mask) __builtin_popcount(mask)
+
+#endif
+
+#define LEXER_KEYWORD_HASH_TABLE_SIZE 32 // power of 2
+
+/// Hash keyword of `length` by its `first` and `last` characters.
+/// @note Hash is perfect (collision-free) over keyword set; colliding keyword table entries fail to compile.
+#define LEXER_KEYWORD_HASH(length, first, last)                                                                    \
+  (((unsigned)(unsigned char)(first) + 5u * (unsigned char)(last) + (unsigned)(length)) &                           \
+   (LEXER_KEYWORD_HASH_TABLE_SIZE - 1))
+
+/// Make keyword table entry (designated initializer) for `keyword` string literal.
+#define LEXER_KEYWORD_ENTRY(keyword, first, last, keyword_type)                                                    \
+  [LEXER_KEYWORD_HASH(sizeof(keyword) - 1, first, last)] = {                                                        \
+    .lexeme = keyword, .lexeme_length = sizeof(keyword) - 1, .type = keyword_type                                   \
+  }
+
+// *---------------------------------------------*
+// *              TYPE DEFINITIONS               *
+// *---------------------------------------------*
+
+/// Keyword table entry; empty entries have zero lexeme_length.
+typedef struct {
+  char const *lexeme;
+  int lexeme_length;
+  LexerTokenType type;
+} LexerKeyword;
+
+#if defined(__AVX2__)
+typedef __m256i LexerVector;
+#elif defined(__SSE2__)
+typedef __m128i LexerVector;
+#endif
+
+// *---------------------------------------------*
+// *             FUNCTION PROTOTYPES             *
+// *---------------------------------------------*
+
+int32_t lexer_token_buffer_get_count(LexerTokenBuffer const *buffer);
+LexerTokenType lexer_token_buffer_get_type(LexerTokenBuffer const *buffer, int32_t token_index);
+char const *lexer_token_buffer_get_lexeme(LexerTokenBuffer const *buffer, int32_t token_index);
+int lexer_token_buffer_get_lexeme_length(LexerTokenBuffer const *buffer, int32_t token_index);
+int32_t lexer_token_buffer_get_line(LexerTokenBuffer *buffer, int32_t token_index);
+
 // *---------------------------------------------*
 // *          INTERNAL-LINKAGE OBJECTS           *
 // *---------------------------------------------*
 
-static struct {
+// lexer state is per-thread, so that separate threads can lex concurrently
+static _Thread_local struct {
   char const *char_cursor;
+  char const *source_end; // NUL terminator position (vectorized scanning never reads past it)
   char const *lexeme;
   int32_t line;
   int column, lexeme_start_column;
+  char const *source_file_path; // reported by debug output (NULL unless tokenizing whole source file)
 } lexer;
 
+/// Keyword perfect hash table indexed by LEXER_KEYWORD_HASH.
+static LexerKeyword const lexer_keywords[LEXER_KEYWORD_HASH_TABLE_SIZE] = {
+  LEXER_KEYWORD_ENTRY("true", 't', 'e', LEXER_TOKEN_TRUE),
+  LEXER_KEYWORD_ENTRY("false", 'f', 'e', LEXER_TOKEN_FALSE),
+  LEXER_KEYWORD_ENTRY("var", 'v', 'r', LEXER_TOKEN_VAR),
+  LEXER_KEYWORD_ENTRY("nil", 'n', 'l', LEXER_TOKEN_NIL),
+  LEXER_KEYWORD_ENTRY("and", 'a', 'd', LEXER_TOKEN_AND),
+  LEXER_KEYWORD_ENTRY("or", 'o', 'r', LEXER_TOKEN_OR),
+  LEXER_KEYWORD_ENTRY("fun", 'f', 'n', LEXER_TOKEN_FUN),
+  LEXER_KEYWORD_ENTRY("return", 'r', 'n', LEXER_TOKEN_RETURN),
+  LEXER_KEYWORD_ENTRY("if", 'i', 'f', LEXER_TOKEN_IF),
+  LEXER_KEYWORD_ENTRY("else", 'e', 'e', LEXER_TOKEN_ELSE),
+  LEXER_KEYWORD_ENTRY("while", 'w', 'e', LEXER_TOKEN_WHILE),
+  LEXER_KEYWORD_ENTRY("for", 'f', 'r', LEXER_TOKEN_FOR),
+  LEXER_KEYWORD_ENTRY("class", 'c', 's', LEXER_TOKEN_CLASS),
+  LEXER_KEYWORD_ENTRY("super", 's', 'r', LEXER_TOKEN_SUPER),
+  LEXER_KEYWORD_ENTRY("this", 't', 's', LEXER_TOKEN_THIS),
+  LEXER_KEYWORD_ENTRY("print", 'p', 't', LEXER_TOKEN_PRINT),
+};
+static_assert(LEXER_TOKEN_KEYWORD_COUNT == 16, "Exhaustive keyword token handling");
+
 // *---------------------------------------------*
 // *         INTERNAL-LINKAGE FUNCTIONS          *
 // *---------------------------------------------*
 
+#ifdef LEXER_VECTOR_SIZE
+/// Load LEXER_VECTOR_SIZE characters starting at `characters`.
+/// @return Loaded vector.
+static inline LexerVector lexer_vector_load(char const *const characters) {
+#if defined(__AVX2__)
+  return _mm256_loadu_si256((__m256i const *)characters);
+#else
+  return _mm_loadu_si128((__m128i const *)characters);
+#endif
+}
+
+/// Match `characters` vector against `character`.
+/// @return Mask with bits set for matching vector elements.
+static inline uint32_t lexer_vector_match(LexerVector const characters, char const character) {
+#if defined(__AVX2__)
+  return (uint32_t)_mm256_movemask_epi8(_mm256_cmpeq_epi8(characters, _mm256_set1_epi8(character)));
+#else
+  return (uint32_t)_mm_movemask_epi8(_mm_cmpeq_epi8(characters, _mm_set1_epi8(character)));
+#endif
+}
+
+/// Match `characters` vector against whitespace characters (' ', '\t', '\n', '\v', '\f' and '\r').
+/// @return Mask with bits set for whitespace vector elements.
+static inline uint32_t lexer_vector_match_whitespace(LexerVector const characters) {
+  // '\t', '\n', '\v', '\f' and '\r' form contiguous range (bytes above 0x7F are negative, hence excluded)
+#if defined(__AVX2__)
+  __m256i const is_control_whitespace = _mm256_and_si256(
+    _mm256_cmpgt_epi8(characters, _mm256_set1_epi8('\t' - 1)), _mm256_cmpgt_epi8(_mm256_set1_epi8('\r' + 1), characters)
+  );
+  __m256i const is_space = _mm256_cmpeq_epi8(characters, _mm256_set1_epi8(' '));
+  return (uint32_t)_mm256_movemask_epi8(_mm256_or_si256(is_control_whitespace, is_space));
+#else
+  __m128i const is_control_whitespace = _mm_and_si128(
+    _mm_cmpgt_epi8(characters, _mm_set1_epi8('\t' - 1)), _mm_cmpgt_epi8(_mm_set1_epi8('\r' + 1), characters)
+  );
+  __m128i const is_space = _mm_cmpeq_epi8(characters, _mm_set1_epi8(' '));
+  return (uint32_t)_mm_movemask_epi8(_mm_or_si128(is_control_whitespace, is_space));
+#endif
+}
+#endif
+
 /// Determine whether `character` can be a part of identifier literal.
 /// @return true if it can, false otherwise.
 static inline bool can_constitute_identifier_literal(char const character) {
@@ -81,7 +215,7 @@ static LexerToken lexer_make_token(LexerTokenType const token_type) {
   };
 
 #ifdef DEBUG_LEXER
-  debug_token(&token);
+  debug_token(&token, lexer.source_file_path);
 #endif
 
   return token;
@@ -101,7 +235,7 @@ static LexerToken lexer_make_error_token(char const *const message) {
   };
 
 #ifdef DEBUG_LEXER
-  debug_token(&error_token);
+  debug_token(&error_token, lexer.source_file_path);
 #endif
 
   return error_token;
@@ -119,20 +253,41 @@ static LexerToken lexer_make_eof_token(void) {
   };
 
 #ifdef DEBUG_LEXER
-  debug_token(&eof_token);
+  debug_token(&eof_token, lexer.source_file_path);
 #endif
 
   return eof_token;
 }
 
+/// Advance lexer.char_cursor to the first `terminator` character (or source end), tracking lines along the way.
+/// @note Advancing past '\n' doesn't reset lexer.column.
+static void lexer_advance_until(char const terminator) {
+#ifdef LEXER_VECTOR_SIZE
+  while (lexer.source_end - lexer.char_cursor >= LEXER_VECTOR_SIZE) {
+    LexerVector const characters = lexer_vector_load(lexer.char_cursor);
+    uint32_t const terminator_mask = lexer_vector_match(characters, terminator);
+    int const advance_length = terminator_mask == 0 ? LEXER_VECTOR_SIZE : LEXER_COUNT_TRAILING_ZEROS(terminator_mask);
+    uint32_t const newline_mask = lexer_vector_match(characters, '\n') & LEXER_LOW_BITS_MASK(advance_length);
+
+    lexer.char_cursor += advance_length;
+    lexer.column += advance_length;
+    lexer.line += LEXER_COUNT_SET_BITS(newline_mask);
+
+    if (terminator_mask != 0) return;
+  }
+#endif
+
+  while (lexer_peek() != terminator && !lexer_reached_end()) {
+    if (lexer_advance() == '\n') lexer.line++;
+  }
+}
+
 /// Tokenize string literal.
 /// @return String literal token.
 static LexerToken lexer_tokenize_string_literal(void) {
   // advance until closing quote
-  while (lexer_peek() != '"') {
-    if (lexer_reached_end()) return lexer_make_error_token("Unterminated string literal");
-    if (lexer_advance() == '\n') lexer.line++;
-  }
+  lexer_advance_until('"');
+  if (lexer_reached_end()) return lexer_make_error_token("Unterminated string literal");
 
   lexer_advance(); // advance past closing quote
 
@@ -155,71 +310,56 @@ static LexerToken lexer_tokenize_numeric_literal(void) {
   return lexer_make_token(LEXER_TOKEN_NUMBER);
 }
 
-/// Make either identifier or `keyword_type` (reserved identifier) token.
-/// @return `keyword_type` token if lexer.lexeme offsetted by `keyword_beginning_length` matches `keyword_rest`,
-/// identifier token otherwise.
-static LexerToken lexer_make_identifier_token(
-  int const keyword_beginning_length, int const keyword_rest_length, const char *const keyword_rest,
-  LexerTokenType const keyword_type
-) {
-  assert(keyword_rest != NULL);
-  assert(keyword_beginning_length > 0);
-  assert(keyword_rest_length > 0);
-
-  if (lexer.char_cursor - lexer.lexeme != keyword_beginning_length + keyword_rest_length) goto handle_identifier;
-  if (memcmp(lexer.lexeme + keyword_beginning_length, keyword_rest, keyword_rest_length)) goto handle_identifier;
-
-  // keyword
-  return lexer_make_token(keyword_type);
-
-handle_identifier:
-  return lexer_make_token(LEXER_TOKEN_IDENTIFIER);
-}
-
 /// Tokenize identifier literal; handles both regular and reserved identifiers (keywords).
 /// @return Regular or reserved identifier token.
 static LexerToken lexer_tokenize_identifier_literal(void) {
   // advance past identifier literal
   while (can_constitute_identifier_literal(lexer_peek())) lexer_advance();
 
-  // determine if it's a regular or reserved identifier (algorithm mimics trie data structure)
-  static_assert(LEXER_TOKEN_KEYWORD_COUNT == 16, "Exhaustive keyword token handling");
-  switch (*lexer.lexeme) {
-    case 'a': return lexer_make_identifier_token(1, 2, "nd", LEXER_TOKEN_AND);
-    case 'c': return lexer_make_identifier_token(1, 4, "lass", LEXER_TOKEN_CLASS);
-    case 'e': return lexer_make_identifier_token(1, 3, "lse", LEXER_TOKEN_ELSE);
-    case 'f': {
-      if (lexer.char_cursor - lexer.lexeme <= 1) break;
-      switch (lexer.lexeme[1]) {
-        case 'a': return lexer_make_identifier_token(2, 3, "lse", LEXER_TOKEN_FALSE);
-        case 'o': return lexer_make_identifier_token(2, 1, "r", LEXER_TOKEN_FOR);
-        case 'u': return lexer_make_identifier_token(2, 1, "n", LEXER_TOKEN_FUN);
-      }
-      break;
-    }
-    case 'i': return lexer_make_identifier_token(1, 1, "f", LEXER_TOKEN_IF);
-    case 'n': return lexer_make_identifier_token(1, 2, "il", LEXER_TOKEN_NIL);
-    case 'o': return lexer_make_identifier_token(1, 1, "r", LEXER_TOKEN_OR);
-    case 'p': return lexer_make_identifier_token(1, 4, "rint", LEXER_TOKEN_PRINT);
-    case 'r': return lexer_make_identifier_token(1, 5, "eturn", LEXER_TOKEN_RETURN);
-    case 's': return lexer_make_identifier_token(1, 4, "uper", LEXER_TOKEN_SUPER);
-    case 't': {
-      if (lexer.char_cursor - lexer.lexeme <= 1) break;
-      switch (lexer.lexeme[1]) {
-        case 'h': return lexer_make_identifier_token(2, 2, "is", LEXER_TOKEN_THIS);
-        case 'r': return lexer_make_identifier_token(2, 2, "ue", LEXER_TOKEN_TRUE);
-      }
-      break;
-    }
-    case 'v': return lexer_make_identifier_token(1, 2, "ar", LEXER_TOKEN_VAR);
-    case 'w': return lexer_make_identifier_token(1, 4, "hile", LEXER_TOKEN_WHILE);
+  // determine if it's a regular or reserved identifier (single comparison against keyword sharing its hash)
+  int const lexeme_length = lexer.char_cursor - lexer.lexeme;
+  LexerKeyword const *const keyword =
+    &lexer_keywords[LEXER_KEYWORD_HASH(lexeme_length, lexer.lexeme[0], lexer.lexeme[lexeme_length - 1])];
+  if (keyword->lexeme_length == lexeme_length && memcmp(keyword->lexeme, lexer.lexeme, lexeme_length) == 0) {
+    return lexer_make_token(keyword->type);
   }
 
   // regular identifier
   return lexer_make_token(LEXER_TOKEN_IDENTIFIER);
 }
 
-/// Advance past all whitespace characters.
+/// Advance past run of whitespace characters (comments excluded).
+static void lexer_skip_whitespace_run(void) {
+#ifdef LEXER_VECTOR_SIZE
+  while (lexer.source_end - lexer.char_cursor >= LEXER_VECTOR_SIZE) {
+    LexerVector const characters = lexer_vector_load(lexer.char_cursor);
+    uint32_t const non_whitespace_mask =
+      ~lexer_vector_match_whitespace(characters) & LEXER_LOW_BITS_MASK(LEXER_VECTOR_SIZE);
+    int const run_length =
+      non_whitespace_mask == 0 ? LEXER_VECTOR_SIZE : LEXER_COUNT_TRAILING_ZEROS(non_whitespace_mask);
+    uint32_t const newline_mask = lexer_vector_match(characters, '\n') & LEXER_LOW_BITS_MASK(run_length);
+
+    lexer.char_cursor += run_length;
+    if (newline_mask == 0) lexer.column += run_length;
+    else {
+      int const last_newline_index = 31 - LEXER_COUNT_LEADING_ZEROS(newline_mask);
+      lexer.column = run_length - last_newline_index; // 1 + characters following last newline
+      lexer.line += LEXER_COUNT_SET_BITS(newline_mask);
+    }
+
+    if (non_whitespace_mask != 0) return;
+  }
+#endif
+
+  while (character_is_whitespace(lexer_peek())) {
+    if (lexer_advance() == '\n') {
+      lexer.column = 1;
+      lexer.line++;
+    }
+  }
+}
+
+/// Advance past all whitespace characters and comments.
 static void lexer_skip_whitespace(void) {
   for (;;) {
     switch (lexer_peek()) {
@@ -228,18 +368,23 @@ static void lexer_skip_whitespace(void) {
       case '\t':
       case '\v':
       case '\r': {
-        lexer_advance();
+        // most whitespace (e.g. separating tokens) is a single character, too short to benefit from scanning runs
+        if (character_is_whitespace(lexer_peek_next())) lexer_skip_whitespace_run();
+        else lexer_advance();
         break;
       }
       case '\n': {
-        lexer_advance();
-        lexer.column = 1;
-        lexer.line++;
+        if (character_is_whitespace(lexer_peek_next())) lexer_skip_whitespace_run();
+        else {
+          lexer_advance();
+          lexer.column = 1;
+          lexer.line++;
+        }
         break;
       }
       case '#': {
-        do lexer_advance();
-        while (lexer_peek() != '\n' && !lexer_reached_end());
+        lexer_advance();
+        lexer_advance_until('\n');
         break;
       }
       default: return;
@@ -247,6 +392,33 @@ static void lexer_skip_whitespace(void) {
   }
 }
 
+/// Count '\n' characters in [`begin`, `end`) range.
+/// @return Newline count.
+static int32_t count_newlines(char const *begin, char const *const end) {
+  int32_t newline_count = 0;
+  for (; begin < end; begin++) newline_count += *begin == '\n';
+  return newline_count;
+}
+
+/// Find message of `buffer` error token at `token_index`.
+/// @return Error message.
+static char const *lexer_token_buffer_find_error_message(
+  LexerTokenBuffer const *const buffer, int32_t const token_index
+) {
+  assert(lexer_token_buffer_get_type(buffer, token_index) == LEXER_TOKEN_ERROR);
+
+  // binary search (errors are sorted by token_index)
+  size_t low = 0, high = buffer->errors.count;
+  while (low < high) {
+    size_t const middle = low + (high - low) / 2;
+    if (buffer->errors.data[middle].token_index < token_index) low = middle + 1;
+    else high = middle;
+  }
+
+  assert(low < buffer->errors.count && buffer->errors.data[low].token_index == token_index);
+  return buffer->errors.data[low].message;
+}
+
 // *---------------------------------------------*
 // *         EXTERNAL-LINKAGE FUNCTIONS          *
 // *---------------------------------------------*
@@ -261,8 +433,10 @@ void lexer_init(char const *const source_code) {
 
   lexer.lexeme = source_code;
   lexer.char_cursor = source_code;
+  lexer.source_end = source_code + strlen(source_code);
   lexer.line = 1;
   lexer.column = 1;
+  lexer.source_file_path = NULL;
 }
 
 /// Scan lexer source code for next lexeme, bundle it up with metadata, and produce new token.
@@ -311,3 +485,147 @@ LexerToken lexer_scan(void) {
     default: return lexer_make_error_token("Unexpected character");
   }
 }
+
+/// Tokenize whole `source_code` of `source_file_path` (up to and including EOF token), beginning at `first_line` and
+/// `first_column`, into `buffer`.
+/// @note `buffer` gets initialized; it references `source_code`, which therefore has to outlive it.
+void lexer_tokenize(
+  char const *const source_code, char const *const source_file_path, int32_t const first_line, int const first_column,
+  LexerTokenBuffer *const buffer
+) {
+  assert(source_code != NULL);
+  assert(first_line >= 1);
+  assert(first_column >= 1);
+  assert(buffer != NULL);
+
+  lexer_init(source_code);
+  lexer.source_file_path = source_file_path;
+  lexer.line = first_line;
+  lexer.column = first_column;
+  size_t const source_code_length = lexer.source_end - source_code;
+  if (source_code_length > UINT32_MAX) ERROR_MEMORY("Source code exceeds %" PRIu32 " bytes\n", UINT32_MAX);
+
+  buffer->source_code = source_code;
+  buffer->line_cursor_offset = 0;
+  buffer->line_cursor_line = first_line;
+  buffer->first_column = first_column;
+  DARRAY_INIT(&buffer->lexeme_offsets, sizeof(uint32_t), memory_manage);
+  DARRAY_INIT(&buffer->lexeme_lengths, sizeof(uint32_t), memory_manage);
+  DARRAY_INIT(&buffer->types, sizeof(uint8_t), memory_manage);
+  DARRAY_INIT(&buffer->errors, sizeof(LexerTokenBufferError), memory_manage);
+
+  // source code averages several characters per token; reserving upfront avoids most reallocations
+  size_t const estimated_token_count = source_code_length / 4 + 1;
+  DARRAY_RESERVE(&buffer->lexeme_offsets, estimated_token_count);
+  DARRAY_RESERVE(&buffer->lexeme_lengths, estimated_token_count);
+  DARRAY_RESERVE(&buffer->types, estimated_token_count);
+
+  for (;;) {
+    LexerToken const token = lexer_scan();
+    uint32_t const lexeme_offset = lexer.lexeme - source_code;
+    uint32_t lexeme_length = token.lexeme_length;
+
+    if (token.type == LEXER_TOKEN_ERROR) {
+      LexerTokenBufferError const error = {.token_index = buffer->types.count, .message = token.lexeme};
+      DARRAY_PUSH(&buffer->errors, error);
+      lexeme_length = lexer.char_cursor - lexer.lexeme;
+    } else if (token.type == LEXER_TOKEN_EOF) lexeme_length = 0;
+
+    // token arrays share count, and thus grow together (single capacity check suffices)
+    if (buffer->types.count == buffer->types.capacity) {
+      DARRAY_GROW(&buffer->lexeme_offsets);
+      DARRAY_GROW(&buffer->lexeme_lengths);
+      DARRAY_GROW(&buffer->types);
+    }
+    size_t const token_index = buffer->types.count;
+    buffer->lexeme_offsets.data[token_index] = lexeme_offset;
+    buffer->lexeme_lengths.data[token_index] = lexeme_length;
+    buffer->types.data[token_index] = token.type;
+    buffer->lexeme_offsets.count = buffer->lexeme_lengths.count = buffer->types.count = token_index + 1;
+
+    if (token.type == LEXER_TOKEN_EOF) break;
+  }
+}
+
+/// Release `buffer` resources.
+void lexer_token_buffer_destroy(LexerTokenBuffer *const buffer) {
+  assert(buffer != NULL);
+
+  DARRAY_DESTROY(&buffer->lexeme_offsets);
+  DARRAY_DESTROY(&buffer->lexeme_lengths);
+  DARRAY_DESTROY(&buffer->types);
+  DARRAY_DESTROY(&buffer->errors);
+}
+
+/// Move `buffer` line cursor to `offset`, counting newlines along the way.
+/// @return Line at `offset` (including newline residing there).
+int32_t lexer_token_buffer_move_line_cursor(LexerTokenBuffer *const buffer, uint32_t const offset) {
+  assert(buffer != NULL);
+
+  char const *const source_code = buffer->source_code;
+  if (offset >= buffer->line_cursor_offset) {
+    buffer->line_cursor_line += count_newlines(source_code + buffer->line_cursor_offset, source_code + offset);
+  } else buffer->line_cursor_line -= count_newlines(source_code + offset, source_code + buffer->line_cursor_offset);
+  buffer->line_cursor_offset = offset;
+
+  return buffer->line_cursor_line;
+}
+
+/// Compute `buffer` token column at `token_index`; matches LexerToken.column.
+/// @note Computation scans source code backwards, it's therefore meant for diagnostics.
+/// @return Token column.
+int lexer_token_buffer_get_column(LexerTokenBuffer const *const buffer, int32_t const token_index) {
+  assert(buffer != NULL);
+  assert(token_index >= 0 && (size_t)token_index < buffer->types.count);
+
+  char const *const source_code = buffer->source_code;
+  uint32_t const lexeme_offset = buffer->lexeme_offsets.data[token_index];
+
+  // find beginning of line; newlines within lexemes (e.g. multiline string literals) don't begin new lines
+  uint32_t line_start_offset = lexeme_offset;
+  int32_t preceding_token_index = token_index - 1;
+  for (;;) {
+    while (line_start_offset > 0 && source_code[line_start_offset - 1] != '\n') line_start_offset--;
+    if (line_start_offset == 0) break;
+
+    uint32_t const newline_offset = line_start_offset - 1;
+    while (preceding_token_index >= 0 && buffer->lexeme_offsets.data[preceding_token_index] > newline_offset) {
+      preceding_token_index--;
+    }
+    if (preceding_token_index < 0) break;
+
+    uint32_t const preceding_lexeme_offset = buffer->lexeme_offsets.data[preceding_token_index];
+    if (newline_offset >= preceding_lexeme_offset + buffer->lexeme_lengths.data[preceding_token_index]) break;
+    line_start_offset = preceding_lexeme_offset;
+  }
+
+  // source code might begin mid-line
+  int const line_start_column = line_start_offset == 0 ? buffer->first_column : 1;
+
+  return lexeme_offset - line_start_offset + line_start_column;
+}
+
+/// Materialize `buffer` token at `token_index`.
+/// @return Token identical to the one produced by lexer_scan.
+LexerToken lexer_token_buffer_get_token(LexerTokenBuffer *const buffer, int32_t const token_index) {
+  assert(buffer != NULL);
+  assert(token_index >= 0 && (size_t)token_index < buffer->types.count);
+
+  LexerToken token = {
+    .type = lexer_token_buffer_get_type(buffer, token_index),
+    .line = lexer_token_buffer_get_line(buffer, token_index),
+    .column = lexer_token_buffer_get_column(buffer, token_index),
+    .lexeme = lexer_token_buffer_get_lexeme(buffer, token_index),
+    .lexeme_length = lexer_token_buffer_get_lexeme_length(buffer, token_index),
+  };
+
+  if (token.type == LEXER_TOKEN_ERROR) {
+    token.lexeme = lexer_token_buffer_find_error_message(buffer, token_index);
+    token.lexeme_length = strlen(token.lexeme);
+  } else if (token.type == LEXER_TOKEN_EOF) {
+    token.lexeme = "EOF";
+    token.lexeme_length = 3;
+  }
+
+  return token;
+}
@@ -14,3 +14,15 @@ FILE *g_bytecode_execution_error_stream;
 
 /// Stream for source program's (one being interpreted) output.
 FILE *g_source_program_output_stream;
+
+/// Whether source program output gets written by a dedicated writer thread.
+bool g_is_source_program_output_async;
+
+/// Whether source file compilation is pipelined with its execution.
+bool g_is_interpretation_pipelined;
+
+/// Max count of bytecode bytes executed per execution (0 means unlimited); see VMConfig.
+size_t g_execution_bytecode_budget;
+
+/// Max wall-clock seconds spent per execution (0 means unlimited); see VMConfig.
+double g_execution_timeout;
@@ -3,19 +3,83 @@
 #include "backend/vm.h"
 #include "frontend/compiler.h"
 #include "global.h"
+#include "utils/error.h"
+#include "utils/io.h"
+#include "utils/memory.h"
+
+#include <stdio.h>
+#include <stdlib.h>
+
+// *---------------------------------------------*
+// *              MACRO DEFINITIONS              *
+// *---------------------------------------------*
+
+/// Maximum length of source code block read at once from interpreted stream.
+#define INTERPRETER_STREAM_BLOCK_LENGTH (64 * 1024)
+
+// *---------------------------------------------*
+// *          INTERNAL-LINKAGE OBJECTS           *
+// *---------------------------------------------*
+
+static VM interpreter_vm;
+
+// source code interpreted line by line
+static Chunk line_chunk;
+static CompilerSession line_compiler_session;
+
+// *---------------------------------------------*
+// *         INTERNAL-LINKAGE FUNCTIONS          *
+// *---------------------------------------------*
+
+/// Execute `chunk` if its compilation (yielding `compiler_status`) succeeded.
+/// @return Interpreter status indicating interpretation result.
+static InterpreterStatus interpret_compiled_chunk(CompilerStatus const compiler_status, Chunk *const chunk) {
+  // map compiler_status to interpreter_status
+  static_assert(COMPILER_STATUS_COUNT == 3, "Exhaustive CompilerStatus handling");
+  switch (compiler_status) {
+    case COMPILER_SUCCESS: {
+      break;
+    }
+    case COMPILER_FAILURE: {
+      return INTERPRETER_COMPILER_FAILURE;
+    }
+    case COMPILER_UNEXPECTED_EOF: {
+      return INTERPRETER_COMPILER_UNEXPECTED_EOF;
+    }
+    default: ERROR_INTERNAL("Unknown CompilerStatus '%d'", compiler_status);
+  }
+
+  if (!vm_execute(&interpreter_vm, chunk)) return INTERPRETER_VM_FAILURE;
+
+  return INTERPRETER_SUCCESS;
+}
 
 // *---------------------------------------------*
 // *         EXTERNAL-LINKAGE FUNCTIONS          *
 // *---------------------------------------------*
 
-/// Initialize interpreter.
+/// Initialize interpreter according to global configuration (see global.h).
 void interpreter_init(void) {
-  vm_init();
+  VMConfig const vm_config = {
+    .source_file_path = g_source_file_path,
+    .static_analysis_error_stream = g_static_analysis_error_stream,
+    .bytecode_execution_error_stream = g_bytecode_execution_error_stream,
+    .source_program_output_stream = g_source_program_output_stream,
+    .is_source_program_output_async = g_is_source_program_output_async,
+    .memory_manager = memory_manage,
+    .bytecode_budget = g_execution_bytecode_budget,
+    .execution_timeout = g_execution_timeout,
+  };
+  vm_init(&interpreter_vm, &vm_config);
+  chunk_init(&line_chunk);
+  compiler_session_init(&line_compiler_session, &interpreter_vm, &line_chunk);
 }
 
 /// Release interpreter resources and set it to uninitialized state.
 void interpreter_destroy(void) {
-  vm_destroy();
+  compiler_session_destroy(&line_compiler_session);
+  chunk_destroy(&line_chunk);
+  vm_destroy(&interpreter_vm);
 }
 
 /// Interpret `source_code`; interpreter state persists across `source_code` interpretations.
@@ -23,33 +87,97 @@ void interpreter_destroy(void) {
 InterpreterStatus interpreter_interpret(char const *const source_code) {
   assert(source_code != NULL);
 
-  InterpreterStatus interpreter_status = INTERPRETER_SUCCESS;
   Chunk chunk;
   chunk_init(&chunk);
 
-  CompilerStatus const compiler_status = compiler_compile(source_code, &chunk);
+  CompilerStatus const compiler_status = compiler_compile(&interpreter_vm, source_code, &chunk);
+  InterpreterStatus const interpreter_status = interpret_compiled_chunk(compiler_status, &chunk);
 
-  // map compiler_status to interpreter_status
-  static_assert(COMPILER_STATUS_COUNT == 3, "Exhaustive CompilerStatus handling");
-  switch (compiler_status) {
-    case COMPILER_SUCCESS: {
-      break;
-    }
-    case COMPILER_FAILURE: {
-      interpreter_status = INTERPRETER_COMPILER_FAILURE;
-      goto clean_up;
-    }
-    case COMPILER_UNEXPECTED_EOF: {
-      interpreter_status = INTERPRETER_COMPILER_UNEXPECTED_EOF;
-      goto clean_up;
-    }
-    default: ERROR_INTERNAL("Unknown CompilerStatus '%d'", compiler_status);
+  chunk_destroy(&chunk);
+
+  return interpreter_status;
+}
+
+/// Interpret `source_code` like interpreter_interpret, but pipelined: `source_code` is compiled in batches of whole
+/// statements on a dedicated thread, while already compiled batches get executed (and released). This way output
+/// appears before the whole `source_code` is compiled, and bytecode of only a few batches is held at once.
+/// @note Static analysis error ends interpretation at batch it's found in, thus preceding batches get executed.
+/// @return Interpreter status indicating interpretation result.
+InterpreterStatus interpreter_interpret_pipelined(char const *const source_code) {
+  assert(source_code != NULL);
+
+  CompilerPipeline *const pipeline = compiler_pipeline_start(&interpreter_vm, source_code);
+  InterpreterStatus interpreter_status = INTERPRETER_SUCCESS;
+
+  Chunk chunk;
+  CompilerStatus compiler_status;
+  while (interpreter_status == INTERPRETER_SUCCESS &&
+         compiler_pipeline_take_batch(pipeline, &chunk, &compiler_status)) {
+    interpreter_status = interpret_compiled_chunk(compiler_status, &chunk);
+    chunk_destroy(&chunk);
   }
 
-  if (!vm_execute(&chunk)) interpreter_status = INTERPRETER_VM_FAILURE;
+  compiler_pipeline_stop(pipeline);
+
+  return interpreter_status;
+}
+
+/// Interpret source code read from `stream` until EOF, as it arrives: stream is read in blocks (as soon as any of its
+/// content is available), and statements completed by each block get compiled and executed right away; only source
+/// code of the statement cut off by block end is held (see compiler_stream_feed). This way interpretation of unbounded
+/// streams (e.g. pipes) proceeds without reading them whole first, and its output isn't delayed until they end.
+/// @note Interpretation ends at the first statement failing to compile or execute; preceding ones have been executed.
+/// @return Interpreter status indicating interpretation result.
+InterpreterStatus interpreter_interpret_stream(FILE *const stream) {
+  assert(stream != NULL);
+
+  char *const block = malloc(INTERPRETER_STREAM_BLOCK_LENGTH);
+  if (block == NULL) ERROR_MEMORY_ERRNO();
+
+  Chunk chunk;
+  chunk_init(&chunk);
+  CompilerStream compiler_stream;
+  compiler_stream_init(&compiler_stream, &interpreter_vm, &chunk);
 
-clean_up:
+  InterpreterStatus interpreter_status = INTERPRETER_SUCCESS;
+  for (bool is_exhausted = false; !is_exhausted && interpreter_status == INTERPRETER_SUCCESS;) {
+    size_t const block_length = io_read_available(stream, block, INTERPRETER_STREAM_BLOCK_LENGTH);
+    is_exhausted = block_length == 0;
+
+    CompilerStatus const compiler_status = is_exhausted ? compiler_stream_finish(&compiler_stream)
+                                                        : compiler_stream_feed(&compiler_stream, block, block_length);
+    if (compiler_status == COMPILER_SUCCESS && chunk.code.count == 0) continue; // no statement got completed
+
+    interpreter_status = interpret_compiled_chunk(compiler_status, &chunk);
+    chunk_reset(&chunk);
+
+    // deliver output of executed statements right away, even if it's fully buffered (e.g. written into a pipe)
+    FILE *const output_stream = interpreter_vm.config.source_program_output_stream;
+    if (fflush(output_stream) == EOF) ERROR_IO_ERRNO();
+  }
+
+  compiler_stream_destroy(&compiler_stream);
   chunk_destroy(&chunk);
+  free(block);
+
+  return interpreter_status;
+}
+
+/// Interpret source code `line`, continuing previously interpreted line if its interpretation yielded
+/// INTERPRETER_COMPILER_UNEXPECTED_EOF; source code spanning several lines gets executed once it's complete.
+/// @note Only statements cut off by previous line end get compiled again (see compiler_session_compile_line).
+/// @return Interpreter status indicating interpretation result.
+InterpreterStatus interpreter_interpret_line(char const *const line) {
+  assert(line != NULL);
+
+  // every line is bound by its own execution budget (waiting for the user doesn't consume it)
+  vm_reset_execution_budget(&interpreter_vm);
+
+  CompilerStatus const compiler_status = compiler_session_compile_line(&line_compiler_session, line);
+  InterpreterStatus const interpreter_status = interpret_compiled_chunk(compiler_status, &line_chunk);
+
+  // keep statements completed by incomplete source code, so that it can be continued by the next line
+  if (compiler_status != COMPILER_UNEXPECTED_EOF) chunk_reset(&line_chunk);
 
   return interpreter_status;
 }
@@ -1,6 +1,9 @@
 #include "cli/args.h"
+#include "cli/batch.h"
 #include "cli/file.h"
+#include "cli/records.h"
 #include "cli/repl.h"
+#include "cli/server.h"
 #include "global.h"
 
 // *---------------------------------------------*
@@ -13,7 +16,40 @@ int main(int const argc, char const *const *const argv) {
   g_source_program_output_stream = stdout;
 
   // process cli arguments
-  g_source_file_path = args_process(argc, argv);
+  Args args = args_process(argc, argv);
+
+  // run interpreter as a server, or delegate interpretation to one
+  if (args.is_serving) {
+    Server server;
+    server_listen(&server, args.socket_path);
+    ErrorCode const error_code = server_serve(&server, args.job_count);
+    args_destroy(&args);
+    return error_code;
+  }
+  if (args.is_client) {
+    ErrorCode const error_code = server_interpret_remotely(args.socket_path, args.source_file_paths[0]);
+    args_destroy(&args);
+    return error_code;
+  }
+
+  // run source file for every record of records file
+  if (args.records_path != NULL) {
+    ErrorCode const error_code =
+      records_interpret(args.records_path, args.source_file_paths[0], args.job_count > 0 ? args.job_count : 1);
+    args_destroy(&args);
+    return error_code;
+  }
+
+  // run many source files in batch mode
+  if (args.job_count != 0) {
+    ErrorCode const error_code =
+      batch_interpret(args.source_file_paths, args.source_file_path_count, args.manifest_path, args.job_count);
+    args_destroy(&args);
+    return error_code;
+  }
+
+  g_source_file_path = args.source_file_path_count == 0 ? NULL : args.source_file_paths[0];
+  args_destroy(&args);
 
   // run interpreter in the specified interaction mode
   if (g_source_file_path == NULL) repl_enter();
@@ -0,0 +1,210 @@
+#include "program.h"
+
+#include "backend/chunk.h"
+#include "backend/object.h"
+#include "backend/string_table.h"
+#include "backend/value.h"
+#include "backend/vm.h"
+#include "frontend/compiler.h"
+#include "utils/error.h"
+#include "utils/memory.h"
+
+#include <assert.h>
+#include <stdlib.h>
+
+// *---------------------------------------------*
+// *              TYPE DEFINITIONS               *
+// *---------------------------------------------*
+
+struct Program {
+  VM vm; // owns program constants (program strings are interned within it); never executes any bytecode
+  Chunk chunk;
+};
+
+// *---------------------------------------------*
+// *         INTERNAL-LINKAGE FUNCTIONS          *
+// *---------------------------------------------*
+
+/// Make VM configuration corresponding to program `config`.
+/// @note Object allocator isn't applied; program VM owns program strings, which have to outlive its resets.
+/// @return VM configuration managing memory with memory_manage, and producing output synchronously.
+static VMConfig make_vm_config(ProgramConfig const *const config) {
+  assert(config != NULL);
+
+  return (VMConfig){
+    .source_file_path = config->source_file_path,
+    .static_analysis_error_stream = config->static_analysis_error_stream,
+    .bytecode_execution_error_stream = config->bytecode_execution_error_stream,
+    .source_program_output_stream = config->source_program_output_stream,
+    .memory_manager = memory_manage,
+    .input_names = config->input_names,
+    .input_count = config->input_count,
+    .bytecode_budget = config->bytecode_budget,
+    .execution_timeout = config->execution_timeout,
+  };
+}
+
+/// Bind `program` strings to `vm`, by interning them within `vm` (unless strings with the same content already are).
+/// @return true if every program string is interned within `vm` (program chunk can be executed as is), false if some of
+/// them got preceded by their `vm` counterparts.
+static bool bind_program_strings(Program const *const program, VM *const vm) {
+  assert(program != NULL);
+  assert(vm != NULL);
+
+  bool is_bound = true;
+  for (size_t i = 0; i < program->chunk.constants.count; i++) {
+    Value const constant = program->chunk.constants.data[i];
+    if (!value_is_string(constant)) continue;
+
+    ObjectString *const string = (ObjectString *)constant.as.object;
+    ObjectString const *const interned_string =
+      string_table_find(&vm->strings, string->content, string->length, string->hash);
+
+    if (interned_string == NULL) string_table_insert(&vm->strings, string);
+    else if (interned_string != string) is_bound = false;
+  }
+
+  return is_bound;
+}
+
+/// Execute `program` by `vm` whose strings precede some of `program` ones (see bind_program_strings): program chunk
+/// gets executed along with a copy of its constants, where such strings are substituted with their `vm` counterparts.
+/// @return true if execution succeeded, false otherwise.
+static bool execute_rebound_program(Program const *const program, VM *const vm) {
+  assert(program != NULL);
+  assert(vm != NULL);
+
+  size_t const constant_count = program->chunk.constants.count;
+  Value *const constants = malloc(sizeof(Value) * constant_count);
+  if (constants == NULL) ERROR_MEMORY_ERRNO();
+
+  for (size_t i = 0; i < constant_count; i++) {
+    Value const constant = program->chunk.constants.data[i];
+    if (!value_is_string(constant)) {
+      constants[i] = constant;
+      continue;
+    }
+
+    ObjectString const *const string = (ObjectString *)constant.as.object;
+    ObjectString *const interned_string =
+      string_table_find(&vm->strings, string->content, string->length, string->hash);
+    assert(interned_string != NULL && "Expected program strings to be bound");
+    constants[i] = value_make_object((Object *)interned_string);
+  }
+
+  // code and lines are shared with program chunk
+  Chunk rebound_chunk = program->chunk;
+  rebound_chunk.constants.data = constants;
+  bool const is_successful = vm_execute(vm, &rebound_chunk);
+
+  free(constants);
+
+  return is_successful;
+}
+
+// *---------------------------------------------*
+// *         EXTERNAL-LINKAGE FUNCTIONS          *
+// *---------------------------------------------*
+
+/// Compile `source_code` into program, so that it can be executed repeatedly without being compiled again.
+/// Static analysis errors (including exceeded compiler limits) are reported according to `config`.
+/// @param out_program Receives heap-allocated program (released by program_destroy) if compilation succeeds, NULL
+/// otherwise.
+/// @return true if compilation succeeded, false otherwise.
+bool program_compile(ProgramConfig const *const config, char const *const source_code, Program **const out_program) {
+  assert(config != NULL);
+  assert(source_code != NULL);
+  assert(out_program != NULL);
+
+  Program *const program = malloc(sizeof(*program));
+  if (program == NULL) ERROR_MEMORY_ERRNO();
+
+  // program VM never produces output, nor executes any bytecode
+  VMConfig const program_vm_config = make_vm_config(config);
+  vm_init(&program->vm, &program_vm_config);
+  chunk_init(&program->chunk);
+
+  if (compiler_compile(&program->vm, source_code, &program->chunk) != COMPILER_SUCCESS) {
+    program_destroy(program);
+    *out_program = NULL;
+    return false;
+  }
+
+  *out_program = program;
+  return true;
+}
+
+/// Release `program` resources.
+/// @note VMs that executed `program` reference its strings (see program_execute), hence they have to be destroyed,
+/// reset or recycled beforehand.
+void program_destroy(Program *const program) {
+  assert(program != NULL);
+
+  chunk_destroy(&program->chunk);
+  vm_destroy(&program->vm);
+  free(program);
+}
+
+/// Execute `program` by `vm`; `vm` state persists across executions (reset or recycle `vm` for fresh state).
+/// Program strings get interned within `vm` on first execution, so subsequent executions merely verify them. If `vm`
+/// has already interned strings with the same content (e.g. made by other programs), program is executed with them
+/// substituted, which makes such executions slower.
+/// @note Program is never modified, thus it can be executed by VMs running on separate threads concurrently.
+/// @return true if execution succeeded, false otherwise.
+bool program_execute(Program const *const program, VM *const vm) {
+  assert(program != NULL);
+  assert(vm != NULL);
+  assert(vm != &program->vm && "Expected program to be executed by foreign VM");
+
+  if (!bind_program_strings(program, vm)) return execute_rebound_program(program, vm);
+  return vm_execute(vm, &program->chunk);
+}
+
+/// Execute `program` by `vm` (see program_execute), with values of `vm` input slots set to `inputs` (as many as input
+/// slots configured for `vm`).
+/// @return true if execution succeeded, false otherwise.
+bool program_execute_with_inputs(Program const *const program, VM *const vm, double const *const inputs) {
+  assert(program != NULL);
+  assert(vm != NULL);
+  assert(inputs != NULL || vm->config.input_count == 0);
+
+  Value input_values[VM_MAX_INPUT_COUNT];
+  for (int i = 0; i < vm->config.input_count; i++) input_values[i] = value_make_number(inputs[i]);
+
+  vm->inputs = input_values;
+  bool const is_successful = program_execute(program, vm);
+  vm->inputs = NULL;
+
+  return is_successful;
+}
+
+/// Make VM configured according to `config`, for executing programs (see program_execute). If `config` sets object
+/// allocator, objects made by VM are allocated by it, and released at once by resetting it on VM reset or destruction.
+/// @return Heap-allocated VM (released by program_vm_destroy).
+VM *program_vm_create(ProgramConfig const *const config) {
+  assert(config != NULL);
+
+  VM *const vm = malloc(sizeof(*vm));
+  if (vm == NULL) ERROR_MEMORY_ERRNO();
+
+  VMConfig vm_config = make_vm_config(config);
+  vm_config.object_allocator = config->object_allocator;
+  vm_init(vm, &vm_config);
+
+  return vm;
+}
+
+/// Reset `vm` back to freshly created state (releasing every object it made, and program strings it references).
+void program_vm_reset(VM *const vm) {
+  assert(vm != NULL);
+
+  vm_reset(vm);
+}
+
+/// Release `vm` resources.
+void program_vm_destroy(VM *const vm) {
+  assert(vm != NULL);
+
+  vm_destroy(vm);
+  free(vm);
+}
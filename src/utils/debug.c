@@ -81,17 +81,38 @@ static int32_t debug_constant_instruction(Chunk const *const chunk, uint8_t cons
   ERROR_INTERNAL("Unknown chunk constant instruction opcode '%d'", opcode);
 }
 
+/// Print `chunk` N-ary concatenation instruction located at `offset`.
+/// @return Offset to next instruction.
+static int32_t debug_concatenate_n_instruction(Chunk const *const chunk, int32_t const offset) {
+  assert(chunk != NULL);
+
+  io_printf("OP_CONCATENATE_N %d\n", chunk->code.data[offset + 1]);
+
+  return offset + 2;
+}
+
+/// Print `chunk` input instruction located at `offset`.
+/// @return Offset to next instruction.
+static int32_t debug_input_instruction(Chunk const *const chunk, int32_t const offset) {
+  assert(chunk != NULL);
+
+  io_printf("OP_INPUT %d\n", chunk->code.data[offset + 1]);
+
+  return offset + 2;
+}
+
 // *---------------------------------------------*
 // *         EXTERNAL-LINKAGE FUNCTIONS          *
 // *---------------------------------------------*
 
-/// Print lexical `token`.
-void debug_token(LexerToken const *const token) {
+/// Print lexical `token` of `source_file_path` (NULL if token doesn't belong to any).
+void debug_token(LexerToken const *const token, char const *const source_file_path) {
 #define PRINTF_BREAK(...) \
   io_printf(__VA_ARGS__); \
   break
 
-  io_printf(COMMON_FILE_LINE_COLUMN_FORMAT " ", g_source_file_path, token->line, token->column);
+  if (source_file_path != NULL) io_printf(COMMON_FILE_FORMAT COMMON_PS, source_file_path);
+  io_printf(COMMON_LINE_COLUMN_FORMAT " ", token->line, token->column);
 
   static_assert(LEXER_TOKEN_TYPE_COUNT == 44, "Exhaustive LexerTokenType handling");
   switch (token->type) {
@@ -157,26 +178,30 @@ void debug_token(LexerToken const *const token) {
 #undef PRINTF_BREAK
 }
 
-/// Disassemble and print `chunk` annotated with `name`.
-void debug_disassemble_chunk(Chunk const *const chunk, char const *const name) {
+/// Disassemble and print `chunk` of `source_file_path` annotated with `name`.
+void debug_disassemble_chunk(Chunk const *const chunk, char const *const source_file_path, char const *const name) {
   assert(chunk != NULL);
   assert(name != NULL);
 
   io_printf("\n== %s ==\n", name);
-  for (size_t offset = 0; offset < chunk->code.count;) offset = debug_disassemble_instruction(chunk, offset);
+  for (size_t offset = 0; offset < chunk->code.count;) {
+    offset = debug_disassemble_instruction(chunk, source_file_path, offset);
+  }
 }
 
-/// Disassemble and print `chunk` instruction located at `offset`.
+/// Disassemble and print `chunk` (of `source_file_path`) instruction located at `offset`.
 /// @return Offset to next instruction.
-int32_t debug_disassemble_instruction(Chunk const *const chunk, int32_t const offset) {
+int32_t debug_disassemble_instruction(
+  Chunk const *const chunk, char const *const source_file_path, int32_t const offset
+) {
   assert(chunk != NULL);
   assert(offset >= 0 && "Expected offset to be nonnegative");
 
-  io_printf(COMMON_FILE_LINE_FORMAT " ", g_source_file_path, chunk_get_instruction_line(chunk, offset));
+  io_printf(COMMON_FILE_LINE_FORMAT " ", source_file_path, chunk_get_instruction_line(chunk, offset));
 
   uint8_t const opcode = chunk->code.data[offset];
 
-  static_assert(CHUNK_OP_OPCODE_COUNT == 22, "Exhaustive chunk opcode handling");
+  static_assert(CHUNK_OP_OPCODE_COUNT == 24, "Exhaustive chunk opcode handling");
   switch (opcode) {
     case CHUNK_OP_RETURN:
     case CHUNK_OP_PRINT:
@@ -204,6 +229,12 @@ int32_t debug_disassemble_instruction(Chunk const *const chunk, int32_t const of
     case CHUNK_OP_CONSTANT_2B: {
       return debug_constant_instruction(chunk, opcode, offset);
     }
+    case CHUNK_OP_CONCATENATE_N: {
+      return debug_concatenate_n_instruction(chunk, offset);
+    }
+    case CHUNK_OP_INPUT: {
+      return debug_input_instruction(chunk, offset);
+    }
     default: ERROR_INTERNAL("Unknown chunk opcode '%d'", opcode);
   }
 }
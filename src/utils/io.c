@@ -8,6 +8,7 @@
 
 #include <assert.h>
 #include <errno.h>
+#include <limits.h>
 #include <stdlib.h>
 #include <string.h>
 
@@ -152,6 +153,45 @@ char *io_read_text_file(char const *const filepath) {
   return content_string;
 }
 
+/// Read textual file at `filepath` into heap-allocated string, without terminating the process if file can't be read
+/// (meant for interpreting many files, where a single unreadable one shouldn't affect the others).
+/// @note Caller takes ownership of returned string.
+/// @return String with `filepath` file content, or NULL if file couldn't be read (errno indicates why).
+char *io_try_read_text_file(char const *const filepath) {
+  assert(filepath != NULL);
+
+  FILE *const file_stream = fopen(filepath, "rb");
+  if (file_stream == NULL) return NULL;
+
+  // read until EOF rather than seeking, as files that can't be read (e.g. directories) might still be seekable
+  size_t capacity = 4096;
+  char *content_string = malloc(capacity + 1); // account for NUL terminator
+  if (content_string == NULL) ERROR_MEMORY_ERRNO();
+
+  size_t content_length = 0;
+  for (;;) {
+    size_t const requested_length = capacity - content_length;
+    size_t const bytes_read = fread(content_string + content_length, 1, requested_length, file_stream);
+    content_length += bytes_read;
+    if (bytes_read < requested_length) break;
+
+    capacity *= 2;
+    content_string = realloc(content_string, capacity + 1);
+    if (content_string == NULL) ERROR_MEMORY_ERRNO();
+  }
+
+  int const read_errno = ferror(file_stream) ? errno : 0;
+  fclose(file_stream);
+  if (read_errno != 0) {
+    free(content_string);
+    errno = read_errno;
+    return NULL;
+  }
+
+  content_string[content_length] = '\0';
+  return content_string;
+}
+
 /// Clear content of file connected to `file_stream`.
 void io_clear_file(FILE *const file_stream) {
   assert(file_stream != NULL);
@@ -173,3 +213,31 @@ void io_clear_file(FILE *const file_stream) {
 
   if (fseek(file_stream, 0, SEEK_SET)) ERROR_IO_ERRNO();
 }
+
+/// Read up to `capacity` bytes of `stream` resource content into `buffer`, blocking only until some content is
+/// available (instead of until `buffer` gets filled), so that content is consumed as soon as it arrives.
+/// @note `stream` is read through its file descriptor, hence it must not have been read through `stream` before.
+/// @return Number of read bytes, 0 on EOF.
+size_t io_read_available(FILE *const stream, void *const buffer, size_t const capacity) {
+  assert(stream != NULL);
+  assert(buffer != NULL);
+  assert(capacity > 0);
+
+#ifdef _WIN32
+  int const stream_fd = _fileno(stream);
+  if (stream_fd < 0) ERROR_IO_ERRNO();
+
+  int const bytes_read = _read(stream_fd, buffer, capacity < INT_MAX ? (unsigned)capacity : INT_MAX);
+  if (bytes_read == -1) ERROR_IO_ERRNO();
+#else // POSIX
+  int const stream_fd = fileno(stream);
+  if (stream_fd == -1) ERROR_IO_ERRNO();
+
+  ssize_t bytes_read;
+  do bytes_read = read(stream_fd, buffer, capacity);
+  while (bytes_read == -1 && errno == EINTR);
+  if (bytes_read == -1) ERROR_IO_ERRNO();
+#endif
+
+  return bytes_read;
+}
@@ -0,0 +1,141 @@
+#include "utils/memory_arena.h"
+
+#include "utils/error.h"
+
+#include <stdbool.h>
+#include <stdint.h>
+#include <string.h>
+
+// *---------------------------------------------*
+// *              TYPE DEFINITIONS               *
+// *---------------------------------------------*
+
+struct MemoryArenaBlock {
+  MemoryArenaBlock *next;
+  size_t capacity; // data size
+  max_align_t data[];
+};
+
+// *---------------------------------------------*
+// *             FUNCTION PROTOTYPES             *
+// *---------------------------------------------*
+
+MemoryAllocator memory_arena_make_allocator(MemoryArena *arena);
+
+// *---------------------------------------------*
+// *         INTERNAL-LINKAGE FUNCTIONS          *
+// *---------------------------------------------*
+
+/// Round `size` up to multiple of MEMORY_ARENA_ALIGNMENT.
+/// @return Aligned size.
+static size_t align_size(size_t const size) {
+  if (size > SIZE_MAX - (MEMORY_ARENA_ALIGNMENT - 1)) ERROR_MEMORY("Arena object size overflow\n");
+
+  return (size + MEMORY_ARENA_ALIGNMENT - 1) / MEMORY_ARENA_ALIGNMENT * MEMORY_ARENA_ALIGNMENT;
+}
+
+/// Make `arena` allocate objects from `block`.
+static void use_block(MemoryArena *const arena, MemoryArenaBlock *const block) {
+  arena->current_block = block;
+  arena->cursor = (unsigned char *)block->data;
+  arena->end = arena->cursor + block->capacity;
+}
+
+/// Move `arena` on to block capable of holding `size` bytes; either the retained block following current one, or
+/// newly allocated block inserted after it.
+static void advance_block(MemoryArena *const arena, size_t const size) {
+  MemoryArenaBlock **const next_block = arena->current_block == NULL ? &arena->first_block
+                                                                     : &arena->current_block->next;
+
+  if (*next_block == NULL || (*next_block)->capacity < size) {
+    size_t const capacity = size > arena->block_size ? size : arena->block_size;
+    if (capacity > SIZE_MAX - sizeof(MemoryArenaBlock)) ERROR_MEMORY("Arena block size overflow\n");
+
+    MemoryArenaBlock *const block = memory_allocate(arena->memory_manager, sizeof(MemoryArenaBlock) + capacity);
+    block->next = *next_block;
+    block->capacity = capacity;
+    *next_block = block;
+  }
+
+  use_block(arena, *next_block);
+}
+
+/// Allocate object of `size` from `arena`.
+/// @return Allocated object.
+static void *allocate(MemoryArena *const arena, size_t const size) {
+  size_t const aligned_size = align_size(size);
+  if (aligned_size > (size_t)(arena->end - arena->cursor)) advance_block(arena, aligned_size);
+
+  void *const object = arena->cursor;
+  arena->cursor += aligned_size;
+
+  return object;
+}
+
+// *---------------------------------------------*
+// *         EXTERNAL-LINKAGE FUNCTIONS          *
+// *---------------------------------------------*
+
+/// Initialize `arena` allocating blocks of at least `block_size` by `memory_manager` (blocks are allocated lazily).
+void memory_arena_init(MemoryArena *const arena, size_t const block_size, MemoryManagerFn *const memory_manager) {
+  assert(arena != NULL);
+  assert(block_size > 0);
+  assert(memory_manager != NULL);
+
+  *arena = (MemoryArena){.memory_manager = memory_manager, .block_size = block_size};
+}
+
+/// Release `arena` resources (including every object allocated from it) and set it to uninitialized state.
+void memory_arena_destroy(MemoryArena *const arena) {
+  assert(arena != NULL);
+
+  for (MemoryArenaBlock *block = arena->first_block; block != NULL;) {
+    MemoryArenaBlock *const next_block = block->next;
+    memory_deallocate(arena->memory_manager, block, sizeof(MemoryArenaBlock) + block->capacity);
+    block = next_block;
+  }
+
+  *arena = (MemoryArena){0};
+}
+
+/// MemoryAllocatorFn implementation allocating from `arena_ptr` arena.
+/// The most recently allocated object is resized (and deallocated) in place; resizing other objects allocates them
+/// anew (unless they're shrunk), while deallocating them is a no-op (their memory is reclaimed by memory_arena_reset).
+/// @see MemoryManagerFn for further documentation.
+void *memory_arena_manage(void *const arena_ptr, void *const object, size_t const old_size, size_t const new_size) {
+  assert(arena_ptr != NULL);
+  assert(!(object == NULL && old_size > 0 && new_size != 0) && "Invalid operation; can't allocate object with size");
+
+  MemoryArena *const arena = arena_ptr;
+  if (object == NULL) return new_size == 0 ? NULL : allocate(arena, new_size);
+
+  size_t const aligned_old_size = align_size(old_size);
+  bool const is_last_object = (unsigned char *)object + aligned_old_size == arena->cursor;
+
+  if (new_size == 0) {
+    if (is_last_object) arena->cursor = object;
+    return NULL;
+  }
+
+  if (is_last_object) {
+    size_t const aligned_new_size = align_size(new_size);
+    if (aligned_new_size <= (size_t)(arena->end - (unsigned char *)object)) {
+      arena->cursor = (unsigned char *)object + aligned_new_size;
+      return object;
+    }
+  } else if (new_size <= old_size) return object;
+
+  void *const reallocated_object = allocate(arena, new_size);
+  memcpy(reallocated_object, object, old_size < new_size ? old_size : new_size);
+
+  return reallocated_object;
+}
+
+/// MemoryResetFn implementation releasing every object allocated from `arena_ptr` arena in O(1), by rewinding it to
+/// its first block (retained blocks get reused by subsequent allocations).
+void memory_arena_reset(void *const arena_ptr) {
+  assert(arena_ptr != NULL);
+
+  MemoryArena *const arena = arena_ptr;
+  if (arena->first_block != NULL) use_block(arena, arena->first_block);
+}
@@ -0,0 +1,383 @@
+#ifndef _WIN32
+#define _POSIX_C_SOURCE 200809L
+#endif
+
+#include "utils/output_sink.h"
+
+#include "utils/error.h"
+
+#include <assert.h>
+#include <errno.h>
+#include <stdlib.h>
+
+#ifndef _WIN32
+#include <pthread.h>
+#include <stdatomic.h>
+#include <sys/uio.h>
+#endif
+
+// *---------------------------------------------*
+// *              MACRO DEFINITIONS              *
+// *---------------------------------------------*
+
+/// Size of ring buffer shared with asynchronous writer thread (has to be a power of 2).
+#define OUTPUT_SINK_RING_SIZE (4 * 1024 * 1024)
+
+// *---------------------------------------------*
+// *              TYPE DEFINITIONS               *
+// *---------------------------------------------*
+
+#ifndef _WIN32
+/// Writer thread draining single-producer/single-consumer ring buffer into sink stream.
+/// Ring positions grow monotonically; they get wrapped only when indexing ring.
+/// Mutex and condition variable are used solely for putting a thread to sleep, never for accessing ring.
+/// @note Sequentially consistent atomics guarantee that either sleeping party sees published progress, or the other
+/// party sees it sleeping (and wakes it up).
+struct OutputSinkAsyncWriter {
+  char *ring;
+  int stream_fd;
+  atomic_size_t read_position;  // advanced by writer thread only
+  atomic_size_t write_position; // advanced by sink owner only
+  atomic_bool is_writer_waiting;
+  atomic_bool is_owner_waiting;
+  atomic_bool is_closing;
+  atomic_int write_errno; // errno of failed write (subsequent output gets discarded), 0 otherwise
+  pthread_mutex_t mutex;
+  pthread_cond_t condition;
+  pthread_t thread;
+};
+#endif
+
+// *---------------------------------------------*
+// *             FUNCTION PROTOTYPES             *
+// *---------------------------------------------*
+
+void output_sink_write(OutputSink *sink, char const *data, size_t length);
+void output_sink_write_char(OutputSink *sink, char character);
+
+// *---------------------------------------------*
+// *         INTERNAL-LINKAGE FUNCTIONS          *
+// *---------------------------------------------*
+
+#ifndef _WIN32
+/// Write `iovecs` of `iovec_count` into `fd`, retrying partial and interrupted writes.
+/// @note `iovecs` get modified in the process.
+/// @return 0 if write succeeded, errno otherwise.
+static int output_sink_write_iovecs(int const fd, struct iovec *iovecs, int iovec_count) {
+  assert(iovecs != NULL);
+
+  while (iovec_count > 0) {
+    ssize_t written_byte_count = writev(fd, iovecs, iovec_count);
+    if (written_byte_count < 0) {
+      if (errno == EINTR) continue;
+      return errno;
+    }
+
+    // skip fully written iovecs and advance past partially written one
+    while (iovec_count > 0 && (size_t)written_byte_count >= iovecs->iov_len) {
+      written_byte_count -= iovecs->iov_len;
+      iovecs++;
+      iovec_count--;
+    }
+    if (iovec_count > 0) {
+      iovecs->iov_base = (char *)iovecs->iov_base + written_byte_count;
+      iovecs->iov_len -= written_byte_count;
+    }
+  }
+
+  return 0;
+}
+
+/// Wake the other `writer` party up if it's waiting (`is_other_party_waiting`).
+static void output_sink_wake_async_party(
+  OutputSinkAsyncWriter *const writer, atomic_bool const *const is_other_party_waiting
+) {
+  assert(writer != NULL);
+  assert(is_other_party_waiting != NULL);
+
+  if (!atomic_load(is_other_party_waiting)) return;
+
+  pthread_mutex_lock(&writer->mutex);
+  pthread_cond_broadcast(&writer->condition);
+  pthread_mutex_unlock(&writer->mutex);
+}
+
+/// Asynchronous writer thread entry point; drains `writer_arg` ring until it's closed and empty.
+static void *output_sink_run_async_writer(void *const writer_arg) {
+  OutputSinkAsyncWriter *const writer = writer_arg;
+  size_t read_position = atomic_load(&writer->read_position);
+
+  for (;;) {
+    size_t const write_position = atomic_load(&writer->write_position);
+
+    if (write_position == read_position) {
+      if (atomic_load(&writer->is_closing) && atomic_load(&writer->write_position) == read_position) return NULL;
+
+      // sleep until more output gets published (flag is rechecked by owner after publishing)
+      pthread_mutex_lock(&writer->mutex);
+      atomic_store(&writer->is_writer_waiting, true);
+      if (atomic_load(&writer->write_position) == read_position && !atomic_load(&writer->is_closing))
+        pthread_cond_wait(&writer->condition, &writer->mutex);
+      atomic_store(&writer->is_writer_waiting, false);
+      pthread_mutex_unlock(&writer->mutex);
+      continue;
+    }
+
+    size_t const start_index = read_position & (OUTPUT_SINK_RING_SIZE - 1);
+    size_t const pending_length = write_position - read_position;
+    size_t const first_piece_length =
+      pending_length < OUTPUT_SINK_RING_SIZE - start_index ? pending_length : OUTPUT_SINK_RING_SIZE - start_index;
+
+    if (atomic_load(&writer->write_errno) == 0) {
+      struct iovec iovecs[] = {
+        {.iov_base = writer->ring + start_index, .iov_len = first_piece_length},
+        {.iov_base = writer->ring, .iov_len = pending_length - first_piece_length},
+      };
+      int const write_errno = output_sink_write_iovecs(writer->stream_fd, iovecs, sizeof(iovecs) / sizeof(iovecs[0]));
+      if (write_errno != 0) atomic_store(&writer->write_errno, write_errno);
+    }
+
+    read_position = write_position;
+    atomic_store(&writer->read_position, read_position);
+    output_sink_wake_async_party(writer, &writer->is_owner_waiting);
+  }
+}
+
+/// Wait until `writer` ring has at least `required_free_space` bytes of free space.
+/// @note Waiting for OUTPUT_SINK_RING_SIZE free space waits for the ring to be fully drained.
+static void output_sink_wait_for_async_writer(OutputSinkAsyncWriter *const writer, size_t const required_free_space) {
+  assert(writer != NULL);
+  assert(required_free_space <= OUTPUT_SINK_RING_SIZE);
+
+  size_t const write_position = atomic_load(&writer->write_position);
+
+#define HAS_REQUIRED_FREE_SPACE() \
+  (OUTPUT_SINK_RING_SIZE - (write_position - atomic_load(&writer->read_position)) >= required_free_space)
+
+  while (!HAS_REQUIRED_FREE_SPACE()) {
+    // sleep until writer thread drains some output (flag is rechecked by writer thread after draining)
+    pthread_mutex_lock(&writer->mutex);
+    atomic_store(&writer->is_owner_waiting, true);
+    if (!HAS_REQUIRED_FREE_SPACE()) pthread_cond_wait(&writer->condition, &writer->mutex);
+    atomic_store(&writer->is_owner_waiting, false);
+    pthread_mutex_unlock(&writer->mutex);
+  }
+
+#undef HAS_REQUIRED_FREE_SPACE
+
+  int const write_errno = atomic_load(&writer->write_errno);
+  if (write_errno != 0) ERROR_IO("%s\n", strerror(write_errno));
+}
+
+/// Publish `data` of `remaining_length` into `writer` ring, blocking whenever the ring is full.
+static void output_sink_publish_to_async_writer(
+  OutputSinkAsyncWriter *const writer, char const *data, size_t remaining_length
+) {
+  assert(writer != NULL);
+  assert(data != NULL || remaining_length == 0);
+
+  while (remaining_length > 0) {
+    output_sink_wait_for_async_writer(writer, 1);
+
+    size_t const write_position = atomic_load(&writer->write_position);
+    size_t const free_space = OUTPUT_SINK_RING_SIZE - (write_position - atomic_load(&writer->read_position));
+    size_t const start_index = write_position & (OUTPUT_SINK_RING_SIZE - 1);
+
+    size_t piece_length = remaining_length < free_space ? remaining_length : free_space;
+    if (piece_length > OUTPUT_SINK_RING_SIZE - start_index) piece_length = OUTPUT_SINK_RING_SIZE - start_index;
+
+    memcpy(writer->ring + start_index, data, piece_length);
+    atomic_store(&writer->write_position, write_position + piece_length);
+    output_sink_wake_async_party(writer, &writer->is_writer_waiting);
+
+    data += piece_length;
+    remaining_length -= piece_length;
+  }
+}
+
+/// Make asynchronous writer draining its ring into `stream_fd`.
+/// @return Heap-allocated asynchronous writer with running writer thread.
+static OutputSinkAsyncWriter *output_sink_make_async_writer(int const stream_fd) {
+  OutputSinkAsyncWriter *const writer = malloc(sizeof(*writer));
+  if (writer == NULL) ERROR_MEMORY_ERRNO();
+
+  writer->ring = malloc(OUTPUT_SINK_RING_SIZE);
+  if (writer->ring == NULL) ERROR_MEMORY_ERRNO();
+
+  writer->stream_fd = stream_fd;
+  atomic_init(&writer->read_position, 0);
+  atomic_init(&writer->write_position, 0);
+  atomic_init(&writer->is_writer_waiting, false);
+  atomic_init(&writer->is_owner_waiting, false);
+  atomic_init(&writer->is_closing, false);
+  atomic_init(&writer->write_errno, 0);
+
+  int error_number = pthread_mutex_init(&writer->mutex, NULL);
+  if (error_number == 0) error_number = pthread_cond_init(&writer->condition, NULL);
+  if (error_number == 0) error_number = pthread_create(&writer->thread, NULL, output_sink_run_async_writer, writer);
+  if (error_number != 0) ERROR_SYSTEM("Failed to start output writer thread" COMMON_MS "%s\n", strerror(error_number));
+
+  return writer;
+}
+
+/// Stop `writer` thread once it drains its ring, and release `writer` resources.
+static void output_sink_free_async_writer(OutputSinkAsyncWriter *const writer) {
+  assert(writer != NULL);
+
+  atomic_store(&writer->is_closing, true);
+  pthread_mutex_lock(&writer->mutex);
+  pthread_cond_broadcast(&writer->condition);
+  pthread_mutex_unlock(&writer->mutex);
+
+  int const error_number = pthread_join(writer->thread, NULL);
+  if (error_number != 0) ERROR_SYSTEM("Failed to stop output writer thread" COMMON_MS "%s\n", strerror(error_number));
+
+  pthread_cond_destroy(&writer->condition);
+  pthread_mutex_destroy(&writer->mutex);
+  free(writer->ring);
+  free(writer);
+}
+#endif
+
+/// Handle failed `sink` write with `write_errno`; failure tolerant sinks record it, others terminate the process.
+static void output_sink_handle_write_failure(OutputSink *const sink, int const write_errno) {
+  assert(sink != NULL);
+  assert(write_errno != 0);
+
+  if (!sink->is_failure_tolerant) ERROR_IO("%s\n", strerror(write_errno));
+  if (sink->write_errno == 0) sink->write_errno = write_errno;
+}
+
+/// Write buffered `sink` content followed by `data` of `length` into `sink` stream through stdio.
+static void output_sink_write_through_stdio(OutputSink *const sink, char const *const data, size_t const length) {
+  if (fwrite(sink->buffer, 1, sink->count, sink->stream) < sink->count ||
+      (length > 0 && fwrite(data, 1, length, sink->stream) < length) || fflush(sink->stream) == EOF) {
+    output_sink_handle_write_failure(sink, errno);
+  }
+}
+
+/// Write buffered `sink` content followed by `data` of `length` directly into `sink` stream (or hand it over to
+/// asynchronous writer), emptying `sink`.
+static void output_sink_write_through(OutputSink *const sink, char const *const data, size_t const length) {
+  assert(sink != NULL);
+  assert(data != NULL || length == 0);
+
+  if (sink->write_errno != 0) {
+    sink->count = 0;
+    return;
+  }
+
+  // anything written through stream itself has to precede sink content
+  if (fflush(sink->stream) == EOF) {
+    output_sink_handle_write_failure(sink, errno);
+    sink->count = 0;
+    return;
+  }
+
+#ifdef _WIN32
+  output_sink_write_through_stdio(sink, data, length);
+#else // POSIX
+  if (sink->stream_fd == -1) output_sink_write_through_stdio(sink, data, length);
+  else if (sink->async_writer != NULL) {
+    output_sink_publish_to_async_writer(sink->async_writer, sink->buffer, sink->count);
+    output_sink_publish_to_async_writer(sink->async_writer, data, length);
+  } else {
+    struct iovec iovecs[] = {
+      {.iov_base = sink->buffer, .iov_len = sink->count},
+      {.iov_base = (void *)data, .iov_len = length},
+    };
+    int const write_errno = output_sink_write_iovecs(sink->stream_fd, iovecs, sizeof(iovecs) / sizeof(iovecs[0]));
+    if (write_errno != 0) output_sink_handle_write_failure(sink, write_errno);
+  }
+#endif
+
+  sink->count = 0;
+}
+
+// *---------------------------------------------*
+// *         EXTERNAL-LINKAGE FUNCTIONS          *
+// *---------------------------------------------*
+
+/// Initialize `sink` writing into `stream`.
+/// @note Streams lacking file descriptor (e.g. memory streams) are written into through stdio.
+/// @param is_async Whether writes should be performed by a dedicated writer thread (POSIX only; requires `stream` to
+/// have file descriptor).
+void output_sink_init(OutputSink *const sink, FILE *const stream, bool const is_async) {
+  assert(sink != NULL);
+  assert(stream != NULL);
+
+#ifdef _WIN32
+  int const stream_fd = _fileno(stream);
+  if (stream_fd == -1) ERROR_IO_ERRNO();
+#else // POSIX
+  int const stream_fd = fileno(stream);
+  if (stream_fd == -1 && is_async) ERROR_IO("Asynchronous output requires stream with file descriptor");
+#endif
+
+  char *const buffer = malloc(OUTPUT_SINK_BUFFER_SIZE);
+  if (buffer == NULL) ERROR_MEMORY_ERRNO();
+
+  OutputSinkAsyncWriter *async_writer = NULL;
+  if (is_async) {
+#ifdef _WIN32
+    ERROR_SYSTEM("Asynchronous output is not supported on this platform");
+#else // POSIX
+    async_writer = output_sink_make_async_writer(stream_fd);
+#endif
+  }
+
+  *sink = (OutputSink){
+    .stream = stream, .stream_fd = stream_fd, .buffer = buffer, .count = 0, .async_writer = async_writer
+  };
+}
+
+/// Make synchronous `sink` tolerate failed writes (e.g. into pipe whose reader is gone): the first failure gets
+/// recorded into sink->write_errno, and any subsequent output gets discarded.
+void output_sink_tolerate_write_failures(OutputSink *const sink) {
+  assert(sink != NULL);
+  assert(sink->async_writer == NULL && "Expected synchronous sink");
+
+  sink->is_failure_tolerant = true;
+}
+
+/// Flush `sink`, release its resources and set it to uninitialized state.
+void output_sink_destroy(OutputSink *const sink) {
+  assert(sink != NULL);
+
+  output_sink_flush(sink);
+#ifndef _WIN32
+  if (sink->async_writer != NULL) output_sink_free_async_writer(sink->async_writer);
+#endif
+  free(sink->buffer);
+
+  *sink = (OutputSink){0};
+}
+
+/// Write buffered `sink` content into its stream.
+/// @note Asynchronous sinks wait for their writer thread to write all of the previously written output.
+void output_sink_flush(OutputSink *const sink) {
+  assert(sink != NULL);
+
+  if (sink->count > 0) output_sink_write_through(sink, NULL, 0);
+
+#ifndef _WIN32
+  if (sink->async_writer != NULL) output_sink_wait_for_async_writer(sink->async_writer, OUTPUT_SINK_RING_SIZE);
+#endif
+}
+
+/// Write `data` of `length` (not fitting into remaining `sink` buffer space) into `sink`.
+/// Data that would fill at least half of the buffer gets written through along with buffered content (single system
+/// call), instead of being copied.
+void output_sink_write_overflowing(OutputSink *const sink, char const *const data, size_t const length) {
+  assert(sink != NULL);
+  assert(data != NULL);
+
+  if (length >= OUTPUT_SINK_BUFFER_SIZE / 2) {
+    output_sink_write_through(sink, data, length);
+    return;
+  }
+
+  output_sink_write_through(sink, NULL, 0);
+  memcpy(sink->buffer, data, length);
+  sink->count = length;
+}
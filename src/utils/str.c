@@ -6,3 +6,4 @@
 
 bool str_is_all_whitespace(char const *string);
 size_t str_count_lines(char const *string);
+uint32_t str_hash(char const *string, size_t length);
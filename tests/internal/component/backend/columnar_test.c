@@ -0,0 +1,195 @@
+#include "backend/columnar.h"
+
+#include "backend/chunk.h"
+#include "backend/value.h"
+#include "backend/vm.h"
+#include "component/component_test.h"
+#include "frontend/compiler.h"
+#include "utils/error.h"
+#include "utils/io.h"
+#include "utils/memory.h"
+
+#include <math.h>
+#include <stdio.h>
+#include <stdlib.h>
+
+// *---------------------------------------------*
+// *              MACRO DEFINITIONS              *
+// *---------------------------------------------*
+
+#define INPUT_COUNT 2
+
+// spans several blocks, the last of which is partial
+#define ROW_COUNT (COLUMNAR_BLOCK_ROW_COUNT * 3 + 7)
+
+// x input is zero every 17th row (beginning with the 8th one)
+#define ZERO_X_ROW_COUNT (ROW_COUNT / 17 + (ROW_COUNT % 17 > 8))
+
+#define EXECUTION_ERROR(error_message) "[EXECUTION_ERROR]" COMMON_MS __FILE__ COMMON_PS "1" COMMON_MS error_message "\n"
+
+// *---------------------------------------------*
+// *          INTERNAL-LINKAGE OBJECTS           *
+// *---------------------------------------------*
+
+static char const *const input_names[INPUT_COUNT] = {"x", "y"};
+static double x_column[ROW_COUNT];
+static double y_column[ROW_COUNT];
+static double const *const input_columns[INPUT_COUNT] = {x_column, y_column};
+static Value result_column[ROW_COUNT];
+static bool failure_column[ROW_COUNT];
+
+static VMConfig vm_config;
+static VM vm;
+static Chunk chunk;
+
+// *---------------------------------------------*
+// *         INTERNAL-LINKAGE FUNCTIONS          *
+// *---------------------------------------------*
+
+/// Compile `expression` and evaluate it over every row.
+/// @return Number of rows whose evaluation failed.
+static size_t evaluate(char const *const expression) {
+  chunk_reset(&chunk);
+  io_clear_file(vm_config.static_analysis_error_stream);
+  io_clear_file(vm_config.bytecode_execution_error_stream);
+
+  if (compiler_compile_expression(&vm, expression, &chunk) != COMPILER_SUCCESS) {
+    ERROR_INTERNAL("Failed to compile '%s'", expression);
+  }
+
+  ColumnarBatch const batch = {
+    .input_columns = input_columns,
+    .row_count = ROW_COUNT,
+    .result_column = result_column,
+    .failure_column = failure_column,
+  };
+  return columnar_evaluate(&vm, &chunk, &batch);
+}
+
+/// Assert that every `result_column` value equals the one yielded by executing compiled chunk for that row.
+static void assert_row_by_row_execution_equivalence(void) {
+  for (int row = 0; row < ROW_COUNT; row++) {
+    Value const row_inputs[INPUT_COUNT] = {value_make_number(x_column[row]), value_make_number(y_column[row])};
+    vm.inputs = row_inputs;
+
+    assert_true(vm_execute(&vm, &chunk));
+    component_test_assert_value_equality(&vm, result_column[row], vm_stack_pop(&vm));
+  }
+
+  vm.inputs = NULL;
+}
+
+// *---------------------------------------------*
+// *                  FIXTURES                   *
+// *---------------------------------------------*
+
+static int setup_test_group_env(void **const _) {
+  vm_config.source_file_path = __FILE__;
+  vm_config.memory_manager = memory_manage;
+  vm_config.input_names = input_names;
+  vm_config.input_count = INPUT_COUNT;
+  vm_config.source_program_output_stream = stdout;
+
+  vm_config.static_analysis_error_stream = tmpfile();
+  if (vm_config.static_analysis_error_stream == NULL) ERROR_IO_ERRNO();
+
+  vm_config.bytecode_execution_error_stream = tmpfile();
+  if (vm_config.bytecode_execution_error_stream == NULL) ERROR_IO_ERRNO();
+
+  for (int row = 0; row < ROW_COUNT; row++) {
+    x_column[row] = row % 17 - 8;
+    y_column[row] = row * 0.5;
+  }
+
+  vm_init(&vm, &vm_config);
+  chunk_init(&chunk);
+
+  return 0;
+}
+
+static int teardown_test_group_env(void **const _) {
+  vm_destroy(&vm);
+  chunk_destroy(&chunk);
+
+  if (fclose(vm_config.static_analysis_error_stream)) ERROR_IO_ERRNO();
+  if (fclose(vm_config.bytecode_execution_error_stream)) ERROR_IO_ERRNO();
+
+  return 0;
+}
+
+// *---------------------------------------------*
+// *                 TEST CASES                  *
+// *---------------------------------------------*
+
+static void test_vectorized_evaluation(void **const _) {
+  char const *const expressions[] = {
+    "x", "-x * 2.5 + y", "(x - y) / (y + 1) % 3", "x < y", "x >= -2 == (y <= 10)", "!(x > 0)", "!!nil != false",
+    "x == nil", "true", "nil",
+  };
+
+  for (size_t i = 0; i < sizeof(expressions) / sizeof(expressions[0]); i++) {
+    assert_int_equal(evaluate(expressions[i]), 0);
+    assert_row_by_row_execution_equivalence();
+  }
+}
+
+static void test_row_failure_reporting(void **const _) {
+  assert_int_equal(evaluate("1 % x + y / x"), ZERO_X_ROW_COUNT);
+
+  for (int row = 0; row < ROW_COUNT; row++) {
+    double const x = x_column[row];
+    Value const expected_value = x == 0 ? value_make_nil() : value_make_number(fmod(1, x) + y_column[row] / x);
+    component_test_assert_value_equality(&vm, result_column[row], expected_value);
+    assert_int_equal(failure_column[row], x == 0);
+  }
+
+  // failing rows fail at modulo (the first failing instruction), and each failure gets reported individually
+  FILE *const error_stream = vm_config.bytecode_execution_error_stream;
+  rewind(error_stream);
+  char actual_error[256];
+  for (int i = 0; i < ZERO_X_ROW_COUNT; i++) {
+    assert_non_null(fgets(actual_error, sizeof(actual_error), error_stream));
+    assert_string_equal(actual_error, EXECUTION_ERROR("Illegal modulo by zero"));
+  }
+  assert_null(fgets(actual_error, sizeof(actual_error), error_stream));
+}
+
+static void test_type_error_reporting(void **const _) {
+  assert_int_equal(evaluate("x + (y < 1)"), ROW_COUNT);
+
+  for (int row = 0; row < ROW_COUNT; row++) {
+    component_test_assert_value_equality(&vm, result_column[row], value_make_nil());
+  }
+
+  FILE *const error_stream = vm_config.bytecode_execution_error_stream;
+  rewind(error_stream);
+  char actual_error[256];
+  assert_non_null(fgets(actual_error, sizeof(actual_error), error_stream));
+  assert_string_equal(
+    actual_error, EXECUTION_ERROR("Expected addition operands to be numbers (got 'number' and 'bool')")
+  );
+}
+
+static void test_row_by_row_fallback(void **const _) {
+  // string concatenation can't be vectorized
+  assert_int_equal(evaluate("\"x=\" .. x == \"x=-8\""), 0);
+  assert_row_by_row_execution_equivalence();
+  component_test_assert_value_equality(&vm, result_column[0], value_make_bool(true));
+  component_test_assert_value_equality(&vm, result_column[1], value_make_bool(false));
+
+  assert_int_equal(evaluate("\"a\" .. 1 / x"), ZERO_X_ROW_COUNT);
+  component_test_assert_value_equality(&vm, result_column[8], value_make_nil());
+  for (int row = 0; row < ROW_COUNT; row++) assert_int_equal(failure_column[row], x_column[row] == 0);
+  assert_int_equal(vm.stack.count, 0);
+}
+
+int main(void) {
+  struct CMUnitTest const tests[] = {
+    cmocka_unit_test(test_vectorized_evaluation),
+    cmocka_unit_test(test_row_failure_reporting),
+    cmocka_unit_test(test_type_error_reporting),
+    cmocka_unit_test(test_row_by_row_fallback),
+  };
+
+  return cmocka_run_group_tests(tests, setup_test_group_env, teardown_test_group_env);
+}
@@ -0,0 +1,157 @@
+#include "backend/string_table.h"
+
+#include "backend/object.h"
+#include "backend/vm.h"
+#include "component/component_test.h"
+#include "utils/memory.h"
+#include "utils/str.h"
+
+#include <stdio.h>
+#include <string.h>
+
+// *---------------------------------------------*
+// *              MACRO DEFINITIONS              *
+// *---------------------------------------------*
+
+#define MANY_STRINGS_COUNT 1000
+
+#define FIND(string_c) \
+  string_table_find(&table, string_c, STR_ARRAY_LENGTH(string_c), str_hash(string_c, STR_ARRAY_LENGTH(string_c)))
+
+// *---------------------------------------------*
+// *          INTERNAL-LINKAGE OBJECTS           *
+// *---------------------------------------------*
+
+static VM vm;
+static StringTable table;
+
+// *---------------------------------------------*
+// *                  FIXTURES                   *
+// *---------------------------------------------*
+
+static int setup_test_case_env(void **const _) {
+  VMConfig const vm_config = {.source_program_output_stream = stdout, .memory_manager = memory_manage};
+  vm_init(&vm, &vm_config);
+  string_table_init(&table, memory_manage);
+
+  return 0;
+}
+
+static int teardown_test_case_env(void **const _) {
+  string_table_destroy(&table);
+  vm_destroy(&vm);
+
+  return 0;
+}
+
+// *---------------------------------------------*
+// *                 TEST CASES                  *
+// *---------------------------------------------*
+
+static void test_find_in_empty_table(void **const _) {
+  assert_null(FIND(""));
+  assert_null(FIND("a"));
+}
+
+static void test_insert_and_find(void **const _) {
+  ObjectString *const string_a = object_make_owning_string(&vm, "a", 1);
+  ObjectString *const string_ab = object_make_owning_string(&vm, "ab", 2);
+
+  string_table_insert(&table, string_a);
+  string_table_insert(&table, string_ab);
+
+  assert_ptr_equal(FIND("a"), string_a);
+  assert_ptr_equal(FIND("ab"), string_ab);
+  assert_null(FIND("b"));
+  assert_null(FIND("abc"));
+}
+
+static void test_remove(void **const _) {
+  ObjectString *const string_a = object_make_owning_string(&vm, "a", 1);
+  ObjectString *const string_b = object_make_owning_string(&vm, "b", 1);
+
+  string_table_insert(&table, string_a);
+  string_table_insert(&table, string_b);
+
+  assert_true(string_table_remove(&table, string_a));
+  assert_false(string_table_remove(&table, string_a));
+  assert_null(FIND("a"));
+  assert_ptr_equal(FIND("b"), string_b);
+
+  string_table_insert(&table, string_a);
+  assert_ptr_equal(FIND("a"), string_a);
+}
+
+static void test_growth(void **const _) {
+  ObjectString *strings[MANY_STRINGS_COUNT];
+
+  for (int i = 0; i < MANY_STRINGS_COUNT; i++) {
+    char content[8];
+    int const content_length = sprintf(content, "%d", i);
+
+    strings[i] = object_make_owning_string(&vm, content, content_length);
+    string_table_insert(&table, strings[i]);
+  }
+
+  for (int i = 0; i < MANY_STRINGS_COUNT; i++) {
+    ObjectString const *const string = strings[i];
+    assert_ptr_equal(string_table_find(&table, string->content, string->length, string->hash), string);
+  }
+
+  // remove every other string
+  for (int i = 0; i < MANY_STRINGS_COUNT; i += 2) assert_true(string_table_remove(&table, strings[i]));
+
+  for (int i = 0; i < MANY_STRINGS_COUNT; i++) {
+    ObjectString const *const string = strings[i];
+    ObjectString const *const expected_string = i % 2 == 0 ? NULL : string;
+    assert_ptr_equal(string_table_find(&table, string->content, string->length, string->hash), expected_string);
+  }
+}
+
+static void test_string_interning(void **const _) {
+  ObjectString *const owning_string = object_make_owning_string(&vm, "abc", 3);
+  ObjectString *const non_owning_string = object_make_non_owning_string(&vm, "abc", 3);
+
+  ObjectString *const uninitialized_string = object_make_uninitialized_owning_string(&vm, 3);
+  memcpy(uninitialized_string->inline_content, "abc", 3);
+  ObjectString *const interned_string = object_intern_owning_string(&vm, uninitialized_string);
+
+  assert_ptr_equal(owning_string, non_owning_string);
+  assert_ptr_equal(owning_string, interned_string);
+  assert_ptr_not_equal(owning_string, object_make_owning_string(&vm, "abd", 3));
+  assert_ptr_equal(string_table_find(&vm.strings, "abc", 3, str_hash("abc", 3)), owning_string);
+
+  assert_true(object_equals(&vm, (Object *)owning_string, (Object *)object_make_owning_string(&vm, "abc", 3)));
+  assert_false(object_equals(&vm, (Object *)owning_string, (Object *)object_make_owning_string(&vm, "ab", 2)));
+}
+
+static void test_clear(void **const _) {
+  ObjectString *const string_a = object_make_owning_string(&vm, "a", 1);
+  ObjectString *const string_b = object_make_owning_string(&vm, "b", 1);
+
+  string_table_insert(&table, string_a);
+  string_table_insert(&table, string_b);
+  size_t const capacity = table.capacity;
+
+  string_table_clear(&table);
+  assert_int_equal(table.count, 0);
+  assert_int_equal(table.capacity, capacity);
+  assert_null(FIND("a"));
+  assert_null(FIND("b"));
+
+  string_table_insert(&table, string_a);
+  assert_ptr_equal(FIND("a"), string_a);
+}
+
+int main(void) {
+  struct CMUnitTest const tests[] = {
+    cmocka_unit_test_setup_teardown(test_find_in_empty_table, setup_test_case_env, teardown_test_case_env),
+    cmocka_unit_test_setup_teardown(test_insert_and_find, setup_test_case_env, teardown_test_case_env),
+    cmocka_unit_test_setup_teardown(test_remove, setup_test_case_env, teardown_test_case_env),
+    cmocka_unit_test_setup_teardown(test_growth, setup_test_case_env, teardown_test_case_env),
+    cmocka_unit_test_setup_teardown(test_clear, setup_test_case_env, teardown_test_case_env),
+    cmocka_unit_test_setup_teardown(test_string_interning, setup_test_case_env, teardown_test_case_env),
+  };
+
+  return cmocka_run_group_tests(tests, NULL, NULL);
+}
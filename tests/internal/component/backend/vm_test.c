@@ -4,12 +4,16 @@
 #include "backend/object.h"
 #include "backend/value.h"
 #include "component/component_test.h"
-#include "global.h"
 #include "utils/error.h"
 #include "utils/io.h"
+#include "utils/memory.h"
+#include "utils/memory_arena.h"
 #include "utils/str.h"
 
 #include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
 
 // *---------------------------------------------*
 // *              MACRO DEFINITIONS              *
@@ -20,7 +24,7 @@
 
 #define ASSERT_EMPTY_STACK() assert_int_equal(vm.stack.count, 0)
 
-#define STACK_POP_ASSERT(expected_value) component_test_assert_value_equality(vm_stack_pop(), expected_value)
+#define STACK_POP_ASSERT(expected_value) component_test_assert_value_equality(&vm, vm_stack_pop(&vm), expected_value)
 #define STACK_POP_ASSERT_MANY(...) COMPONENT_TEST_APPLY_TO_EACH_ARG(STACK_POP_ASSERT, Value, __VA_ARGS__)
 
 #define APPEND_CONSTANT_INSTRUCTION(constant) chunk_append_constant_instruction(&chunk, constant, 1)
@@ -32,12 +36,12 @@
 
 #define ASSERT_EXECUTION_ERROR(expected_error_message)                                         \
   component_test_assert_file_content(                                                          \
-    g_bytecode_execution_error_stream,                                                         \
+    vm_config.bytecode_execution_error_stream,                                                 \
     "[EXECUTION_ERROR]" COMMON_MS __FILE__ COMMON_PS "1" COMMON_MS expected_error_message "\n" \
   )
 
 #define ASSERT_SOURCE_PROGRAM_OUTPUT(expected_output) \
-  component_test_assert_file_content(g_source_program_output_stream, expected_output "\n")
+  component_test_assert_file_content(vm_config.source_program_output_stream, expected_output "\n")
 
 #define ASSERT_INVALID_BINARY_NUMERIC_OPERATOR_OPERAND_TYPES(operator_instruction, operator_descriptor)            \
   do {                                                                                                             \
@@ -82,8 +86,8 @@
     /* string */                                                                                                   \
     reset_test_case_env();                                                                                         \
     APPEND_CONSTANT_INSTRUCTIONS(                                                                                  \
-      value_make_object((Object *)object_make_owning_string("a", 1)),                                              \
-      value_make_object((Object *)object_make_owning_string("b", 1))                                               \
+      value_make_object((Object *)object_make_owning_string(&vm, "a", 1)),                                         \
+      value_make_object((Object *)object_make_owning_string(&vm, "b", 1))                                          \
     );                                                                                                             \
     APPEND_INSTRUCTIONS(operator_instruction, CHUNK_OP_RETURN);                                                    \
     EXECUTE_ASSERT_FAILURE();                                                                                      \
@@ -91,7 +95,7 @@
                                                                                                                    \
     reset_test_case_env();                                                                                         \
     APPEND_CONSTANT_INSTRUCTIONS(                                                                                  \
-      value_make_object((Object *)object_make_owning_string("a", 1)), value_make_number(2),                        \
+      value_make_object((Object *)object_make_owning_string(&vm, "a", 1)), value_make_number(2),                   \
     );                                                                                                             \
     APPEND_INSTRUCTIONS(operator_instruction, CHUNK_OP_RETURN);                                                    \
     EXECUTE_ASSERT_FAILURE();                                                                                      \
@@ -99,7 +103,7 @@
                                                                                                                    \
     reset_test_case_env();                                                                                         \
     APPEND_CONSTANT_INSTRUCTIONS(                                                                                  \
-      value_make_number(1), value_make_object((Object *)object_make_owning_string("b", 1)),                        \
+      value_make_number(1), value_make_object((Object *)object_make_owning_string(&vm, "b", 1)),                   \
     );                                                                                                             \
     APPEND_INSTRUCTIONS(operator_instruction, CHUNK_OP_RETURN);                                                    \
     EXECUTE_ASSERT_FAILURE();                                                                                      \
@@ -118,26 +122,26 @@
                                                                                                                    \
     reset_test_case_env();                                                                                         \
     APPEND_INSTRUCTION(CHUNK_OP_NIL);                                                                              \
-    APPEND_CONSTANT_INSTRUCTION(value_make_object((Object *)object_make_owning_string("b", 1)));                   \
+    APPEND_CONSTANT_INSTRUCTION(value_make_object((Object *)object_make_owning_string(&vm, "b", 1)));              \
     APPEND_INSTRUCTIONS(operator_instruction, CHUNK_OP_RETURN);                                                    \
     EXECUTE_ASSERT_FAILURE();                                                                                      \
     ASSERT_EXECUTION_ERROR("Expected " operator_descriptor " operands to be numbers (got 'nil' and 'string')");    \
                                                                                                                    \
     reset_test_case_env();                                                                                         \
-    APPEND_CONSTANT_INSTRUCTION(value_make_object((Object *)object_make_owning_string("a", 1)));                   \
+    APPEND_CONSTANT_INSTRUCTION(value_make_object((Object *)object_make_owning_string(&vm, "a", 1)));              \
     APPEND_INSTRUCTIONS(CHUNK_OP_NIL, operator_instruction, CHUNK_OP_RETURN);                                      \
     EXECUTE_ASSERT_FAILURE();                                                                                      \
     ASSERT_EXECUTION_ERROR("Expected " operator_descriptor " operands to be numbers (got 'string' and 'nil')");    \
                                                                                                                    \
     reset_test_case_env();                                                                                         \
     APPEND_INSTRUCTION(CHUNK_OP_TRUE);                                                                             \
-    APPEND_CONSTANT_INSTRUCTION(value_make_object((Object *)object_make_owning_string("b", 1)));                   \
+    APPEND_CONSTANT_INSTRUCTION(value_make_object((Object *)object_make_owning_string(&vm, "b", 1)));              \
     APPEND_INSTRUCTIONS(operator_instruction, CHUNK_OP_RETURN);                                                    \
     EXECUTE_ASSERT_FAILURE();                                                                                      \
     ASSERT_EXECUTION_ERROR("Expected " operator_descriptor " operands to be numbers (got 'bool' and 'string')");   \
                                                                                                                    \
     reset_test_case_env();                                                                                         \
-    APPEND_CONSTANT_INSTRUCTION(value_make_object((Object *)object_make_owning_string("a", 1)));                   \
+    APPEND_CONSTANT_INSTRUCTION(value_make_object((Object *)object_make_owning_string(&vm, "a", 1)));              \
     APPEND_INSTRUCTIONS(CHUNK_OP_FALSE, operator_instruction, CHUNK_OP_RETURN);                                    \
     EXECUTE_ASSERT_FAILURE();                                                                                      \
     ASSERT_EXECUTION_ERROR("Expected " operator_descriptor " operands to be numbers (got 'string' and 'bool')");   \
@@ -157,6 +161,8 @@
 // *          INTERNAL-LINKAGE OBJECTS           *
 // *---------------------------------------------*
 
+static VMConfig vm_config;
+static VM vm;
 static Chunk chunk;
 
 // *---------------------------------------------*
@@ -164,14 +170,24 @@ static Chunk chunk;
 // *---------------------------------------------*
 
 static bool execute(void) {
-  io_clear_file(g_bytecode_execution_error_stream);
-  io_clear_file(g_source_program_output_stream);
+  io_clear_file(vm_config.bytecode_execution_error_stream);
+  io_clear_file(vm_config.source_program_output_stream);
 
-  return vm_execute(&chunk);
+  return vm_execute(&vm, &chunk);
+}
+
+/// Wait (busily) for `seconds` of wall-clock time to pass.
+static void wait_seconds(double const seconds) {
+  struct timespec start, now;
+  if (timespec_get(&start, TIME_UTC) != TIME_UTC) ERROR_SYSTEM("Failed to get current time");
+
+  do {
+    if (timespec_get(&now, TIME_UTC) != TIME_UTC) ERROR_SYSTEM("Failed to get current time");
+  } while ((now.tv_sec - start.tv_sec) + (now.tv_nsec - start.tv_nsec) / 1e9 <= seconds);
 }
 
 static void reset_test_case_env(void) {
-  vm_reset();
+  vm_reset(&vm);
   chunk_reset(&chunk);
 }
 
@@ -180,33 +196,34 @@ static void reset_test_case_env(void) {
 // *---------------------------------------------*
 
 static int setup_test_group_env(void **const _) {
-  g_source_file_path = __FILE__;
+  vm_config.source_file_path = __FILE__;
+  vm_config.memory_manager = memory_manage;
 
-  g_bytecode_execution_error_stream = tmpfile();
-  if (g_bytecode_execution_error_stream == NULL) ERROR_IO_ERRNO();
+  vm_config.bytecode_execution_error_stream = tmpfile();
+  if (vm_config.bytecode_execution_error_stream == NULL) ERROR_IO_ERRNO();
 
-  g_source_program_output_stream = tmpfile();
-  if (g_source_program_output_stream == NULL) ERROR_IO_ERRNO();
+  vm_config.source_program_output_stream = tmpfile();
+  if (vm_config.source_program_output_stream == NULL) ERROR_IO_ERRNO();
 
   return 0;
 }
 
 static int teardown_test_group_env(void **const _) {
-  if (fclose(g_bytecode_execution_error_stream)) ERROR_IO_ERRNO();
-  if (fclose(g_source_program_output_stream)) ERROR_IO_ERRNO();
+  if (fclose(vm_config.bytecode_execution_error_stream)) ERROR_IO_ERRNO();
+  if (fclose(vm_config.source_program_output_stream)) ERROR_IO_ERRNO();
 
   return 0;
 }
 
 static int setup_test_case_env(void **const _) {
-  vm_init();
+  vm_init(&vm, &vm_config);
   chunk_init(&chunk);
 
   return 0;
 }
 
 static int teardown_test_case_env(void **const _) {
-  vm_destroy();
+  vm_destroy(&vm);
   chunk_destroy(&chunk);
 
   return 0;
@@ -215,7 +232,7 @@ static int teardown_test_case_env(void **const _) {
 // *---------------------------------------------*
 // *                 TEST CASES                  *
 // *---------------------------------------------*
-static_assert(CHUNK_OP_OPCODE_COUNT == 22, "Exhaustive ChunkOpCode handling");
+static_assert(CHUNK_OP_OPCODE_COUNT == 24, "Exhaustive ChunkOpCode handling");
 
 static void test_CHUNK_OP_CONSTANT(void **const _) {
   APPEND_CONSTANT_INSTRUCTIONS(value_make_number(1), value_make_number(2), value_make_number(3));
@@ -322,7 +339,7 @@ static void test_CHUNK_OP_NEGATE(void **const _) {
   ASSERT_EXECUTION_ERROR("Expected negation operand to be a number (got 'bool')");
 
   reset_test_case_env();
-  APPEND_CONSTANT_INSTRUCTION(value_make_object((Object *)object_make_owning_string("a", 1)));
+  APPEND_CONSTANT_INSTRUCTION(value_make_object((Object *)object_make_owning_string(&vm, "a", 1)));
   APPEND_INSTRUCTIONS(CHUNK_OP_NEGATE, CHUNK_OP_RETURN);
   EXECUTE_ASSERT_FAILURE();
   ASSERT_EXECUTION_ERROR("Expected negation operand to be a number (got 'string')");
@@ -535,7 +552,7 @@ static void test_CHUNK_OP_NOT(void **const _) {
   ASSERT_CHUNK_OP_NOT(value_make_number(-1), false);
   ASSERT_CHUNK_OP_NOT(value_make_number(0), false);
   ASSERT_CHUNK_OP_NOT(value_make_bool(true), false);
-  ASSERT_CHUNK_OP_NOT(value_make_object((Object *)object_make_owning_string("a", 1)), false);
+  ASSERT_CHUNK_OP_NOT(value_make_object((Object *)object_make_owning_string(&vm, "a", 1)), false);
 
   // falsy values
   ASSERT_CHUNK_OP_NOT(value_make_bool(false), true);
@@ -568,19 +585,23 @@ static void test_CHUNK_OP_EQUAL(void **const _) {
   ASSERT_CHUNK_OP_EQUAL(value_make_bool(true), value_make_bool(true), true);
   ASSERT_CHUNK_OP_EQUAL(value_make_nil(), value_make_nil(), true);
   ASSERT_CHUNK_OP_EQUAL(
-    value_make_object((Object *)object_make_owning_string("a", 1)),
-    value_make_object((Object *)object_make_owning_string("a", 1)), true
+    value_make_object((Object *)object_make_owning_string(&vm, "a", 1)),
+    value_make_object((Object *)object_make_owning_string(&vm, "a", 1)), true
   );
 
   // unequal values
   ASSERT_CHUNK_OP_EQUAL(value_make_number(0), value_make_number(1), false);
   ASSERT_CHUNK_OP_EQUAL(value_make_number(0), value_make_bool(true), false);
   ASSERT_CHUNK_OP_EQUAL(value_make_number(0), value_make_nil(), false);
-  ASSERT_CHUNK_OP_EQUAL(value_make_number(0), value_make_object((Object *)object_make_owning_string("b", 1)), false);
+  ASSERT_CHUNK_OP_EQUAL(
+    value_make_number(0), value_make_object((Object *)object_make_owning_string(&vm, "b", 1)), false
+  );
   ASSERT_CHUNK_OP_EQUAL(value_make_bool(true), value_make_bool(false), false);
   ASSERT_CHUNK_OP_EQUAL(value_make_bool(true), value_make_nil(), false);
-  ASSERT_CHUNK_OP_EQUAL(value_make_bool(true), value_make_object((Object *)object_make_owning_string("b", 1)), false);
-  ASSERT_CHUNK_OP_EQUAL(value_make_nil(), value_make_object((Object *)object_make_owning_string("b", 1)), false);
+  ASSERT_CHUNK_OP_EQUAL(
+    value_make_bool(true), value_make_object((Object *)object_make_owning_string(&vm, "b", 1)), false
+  );
+  ASSERT_CHUNK_OP_EQUAL(value_make_nil(), value_make_object((Object *)object_make_owning_string(&vm, "b", 1)), false);
 
 #undef ASSERT_CHUNK_OP_EQUAL
 }
@@ -596,21 +617,25 @@ static void test_CHUNK_OP_NOT_EQUAL(void **const _) {
   ASSERT_CHUNK_OP_NOT_EQUAL(value_make_bool(true), value_make_bool(true), false);
   ASSERT_CHUNK_OP_NOT_EQUAL(value_make_nil(), value_make_nil(), false);
   ASSERT_CHUNK_OP_NOT_EQUAL(
-    value_make_object((Object *)object_make_owning_string("a", 1)),
-    value_make_object((Object *)object_make_owning_string("a", 1)), false
+    value_make_object((Object *)object_make_owning_string(&vm, "a", 1)),
+    value_make_object((Object *)object_make_owning_string(&vm, "a", 1)), false
   );
 
   // unequal values
   ASSERT_CHUNK_OP_NOT_EQUAL(value_make_number(0), value_make_number(1), true);
   ASSERT_CHUNK_OP_NOT_EQUAL(value_make_number(0), value_make_bool(true), true);
   ASSERT_CHUNK_OP_NOT_EQUAL(value_make_number(0), value_make_nil(), true);
-  ASSERT_CHUNK_OP_NOT_EQUAL(value_make_number(0), value_make_object((Object *)object_make_owning_string("b", 1)), true);
+  ASSERT_CHUNK_OP_NOT_EQUAL(
+    value_make_number(0), value_make_object((Object *)object_make_owning_string(&vm, "b", 1)), true
+  );
   ASSERT_CHUNK_OP_NOT_EQUAL(value_make_bool(true), value_make_bool(false), true);
   ASSERT_CHUNK_OP_NOT_EQUAL(value_make_bool(true), value_make_nil(), true);
   ASSERT_CHUNK_OP_NOT_EQUAL(
-    value_make_bool(true), value_make_object((Object *)object_make_owning_string("b", 1)), true
+    value_make_bool(true), value_make_object((Object *)object_make_owning_string(&vm, "b", 1)), true
+  );
+  ASSERT_CHUNK_OP_NOT_EQUAL(
+    value_make_nil(), value_make_object((Object *)object_make_owning_string(&vm, "b", 1)), true
   );
-  ASSERT_CHUNK_OP_NOT_EQUAL(value_make_nil(), value_make_object((Object *)object_make_owning_string("b", 1)), true);
 
 #undef ASSERT_CHUNK_OP_NOT_EQUAL
 }
@@ -724,12 +749,12 @@ static void test_CHUNK_OP_GREATER_EQUAL(void **const _) {
 }
 
 static void test_CHUNK_OP_CONCATENATE(void **const _) {
-#define ASSERT_CHUNK_OP_CONCATENATE(value_a, value_b, expected_string_c)                              \
-  ASSERT_VALUE_IS_RESULT_OF_INSTRUCTION_ON_VALUES(                                                    \
-    value_make_object(                                                                                \
-      (Object *)object_make_non_owning_string(expected_string_c, STR_ARRAY_LENGTH(expected_string_c)) \
-    ),                                                                                                \
-    CHUNK_OP_CONCATENATE, value_a, value_b                                                            \
+#define ASSERT_CHUNK_OP_CONCATENATE(value_a, value_b, expected_string_c)                               \
+  ASSERT_VALUE_IS_RESULT_OF_INSTRUCTION_ON_VALUES(                                                     \
+    value_make_object(                                                                                 \
+      (Object *)object_make_owning_string(&vm, expected_string_c, STR_ARRAY_LENGTH(expected_string_c)) \
+    ),                                                                                                 \
+    CHUNK_OP_CONCATENATE, value_a, value_b                                                             \
   )
 
 #define ASSERT_OPERAND_TYPE_ERROR(operand_a_type, operand_b_type)                               \
@@ -742,8 +767,8 @@ static void test_CHUNK_OP_CONCATENATE(void **const _) {
     reset_test_case_env();                                                                      \
   } while (0)
 
-#define STRING_A value_make_object((Object *)object_make_non_owning_string("a", 1))
-#define STRING_B value_make_object((Object *)object_make_non_owning_string("b", 1))
+#define STRING_A value_make_object((Object *)object_make_non_owning_string(&vm, "a", 1))
+#define STRING_B value_make_object((Object *)object_make_non_owning_string(&vm, "b", 1))
 
   // valid operand types
   ASSERT_CHUNK_OP_CONCATENATE(STRING_A, STRING_B, "ab");
@@ -801,6 +826,320 @@ static void test_CHUNK_OP_CONCATENATE(void **const _) {
 #undef STRING_B
 }
 
+static void test_CHUNK_OP_CONCATENATE_rope(void **const _) {
+#define LONG_STRING_LENGTH OBJECT_ROPE_MIN_LENGTH
+#define SHORT_STRING "ab"
+#define SHORT_STRING_COUNT 1000
+
+  char long_string_content[LONG_STRING_LENGTH];
+  memset(long_string_content, 'x', LONG_STRING_LENGTH);
+  Value const long_string =
+    value_make_object((Object *)object_make_owning_string(&vm, long_string_content, LONG_STRING_LENGTH));
+  Value const short_string = value_make_object((Object *)object_make_non_owning_string(&vm, SHORT_STRING, 2));
+
+  size_t const expected_content_length =
+    LONG_STRING_LENGTH * 2 + STR_ARRAY_LENGTH(SHORT_STRING) * SHORT_STRING_COUNT * 2;
+  char *const expected_content = malloc(expected_content_length);
+  if (expected_content == NULL) ERROR_MEMORY_ERRNO();
+
+  // append short strings to long one
+  APPEND_CONSTANT_INSTRUCTION(long_string);
+  for (int i = 0; i < SHORT_STRING_COUNT; i++) {
+    APPEND_CONSTANT_INSTRUCTION(short_string);
+    APPEND_INSTRUCTIONS(CHUNK_OP_CONCATENATE);
+  }
+
+  // prepend short strings to long one (right-associative concatenation chain)
+  for (int i = 0; i < SHORT_STRING_COUNT; i++) APPEND_CONSTANT_INSTRUCTION(short_string);
+  APPEND_CONSTANT_INSTRUCTION(long_string);
+  for (int i = 0; i < SHORT_STRING_COUNT; i++) APPEND_INSTRUCTION(CHUNK_OP_CONCATENATE);
+  APPEND_INSTRUCTION(CHUNK_OP_CONCATENATE);
+
+  APPEND_INSTRUCTION(CHUNK_OP_RETURN);
+  EXECUTE_ASSERT_SUCCESS();
+
+  Value const result = vm_stack_pop(&vm);
+  ASSERT_EMPTY_STACK();
+  assert_true(value_is_string(result));
+  assert_int_equal(result.as.object->type, OBJECT_ROPE);
+  assert_string_equal(value_get_type_string(result), "string");
+
+  size_t offset = 0;
+  memcpy(expected_content + offset, long_string_content, LONG_STRING_LENGTH);
+  offset += LONG_STRING_LENGTH;
+  for (int i = 0; i < SHORT_STRING_COUNT * 2; i++, offset += STR_ARRAY_LENGTH(SHORT_STRING))
+    memcpy(expected_content + offset, SHORT_STRING, STR_ARRAY_LENGTH(SHORT_STRING));
+  memcpy(expected_content + offset, long_string_content, LONG_STRING_LENGTH);
+
+  Value const expected_string =
+    value_make_object((Object *)object_make_owning_string(&vm, expected_content, expected_content_length));
+  assert_true(value_equals(&vm, result, expected_string));
+  assert_ptr_equal(value_to_string_object(&vm, result), expected_string.as.object);
+
+  free(expected_content);
+
+#undef LONG_STRING_LENGTH
+#undef SHORT_STRING
+#undef SHORT_STRING_COUNT
+}
+
+static void test_CHUNK_OP_CONCATENATE_mixed_operand_allocation(void **const _) {
+  Value const string = value_make_object((Object *)object_make_non_owning_string(&vm, "a", 1));
+
+  APPEND_CONSTANT_INSTRUCTIONS(string, value_make_number(1));
+  APPEND_INSTRUCTIONS(CHUNK_OP_NIL, CHUNK_OP_TRUE, CHUNK_OP_FALSE);
+  APPEND_CONSTANT_INSTRUCTION(string);
+  APPEND_INSTRUCTION(CHUNK_OP_CONCATENATE_N);
+  chunk_append_operand(&chunk, 6);
+  APPEND_INSTRUCTION(CHUNK_OP_RETURN);
+
+  Object const *const last_object_before_execution = vm.gc_objects;
+  EXECUTE_ASSERT_SUCCESS();
+
+  // the only object made during execution is the concatenation result itself
+  Value const result = vm_stack_pop(&vm);
+  assert_ptr_equal(vm.gc_objects, result.as.object);
+  assert_ptr_equal(vm.gc_objects->next, last_object_before_execution);
+  assert_ptr_equal(result.as.object, object_make_owning_string(&vm, "a1niltruefalsea", 15));
+
+  // nil and bool string representations are immortal (interned, yet not tracked)
+  ObjectString const *const nil_string = value_to_string_object(&vm, value_make_nil());
+  assert_ptr_equal(nil_string, object_make_non_owning_string(&vm, "nil", 3));
+  assert_ptr_equal(value_to_string_object(&vm, value_make_bool(true)), object_make_owning_string(&vm, "true", 4));
+  assert_ptr_equal(value_to_string_object(&vm, value_make_bool(false)), object_make_owning_string(&vm, "false", 5));
+  assert_ptr_equal(vm.gc_objects, result.as.object);
+}
+
+static void test_CHUNK_OP_CONCATENATE_N(void **const _) {
+#define STRING_A value_make_object((Object *)object_make_non_owning_string(&vm, "a", 1))
+#define STRING_B value_make_object((Object *)object_make_non_owning_string(&vm, "b", 1))
+
+  // flat operands
+  APPEND_CONSTANT_INSTRUCTIONS(STRING_A, value_make_number(1));
+  APPEND_INSTRUCTION(CHUNK_OP_NIL);
+  APPEND_CONSTANT_INSTRUCTION(STRING_B);
+  APPEND_INSTRUCTION(CHUNK_OP_CONCATENATE_N);
+  chunk_append_operand(&chunk, 4);
+  APPEND_INSTRUCTION(CHUNK_OP_RETURN);
+  EXECUTE_ASSERT_SUCCESS();
+
+  Value const result = vm_stack_pop(&vm);
+  ASSERT_EMPTY_STACK();
+  assert_int_equal(result.as.object->type, OBJECT_STRING);
+  assert_ptr_equal(result.as.object, object_make_owning_string(&vm, "a1nilb", 6));
+
+  // rope operand
+  reset_test_case_env();
+
+  char long_string_content[OBJECT_ROPE_MIN_LENGTH];
+  memset(long_string_content, 'x', OBJECT_ROPE_MIN_LENGTH);
+  Object *const long_string = (Object *)object_make_owning_string(&vm, long_string_content, OBJECT_ROPE_MIN_LENGTH);
+  Value const rope = value_make_object(object_concatenate(&vm, long_string, long_string));
+
+  APPEND_CONSTANT_INSTRUCTIONS(STRING_A, rope, STRING_B);
+  APPEND_INSTRUCTION(CHUNK_OP_CONCATENATE_N);
+  chunk_append_operand(&chunk, 3);
+  APPEND_INSTRUCTION(CHUNK_OP_RETURN);
+  EXECUTE_ASSERT_SUCCESS();
+
+  Value const rope_result = vm_stack_pop(&vm);
+  ASSERT_EMPTY_STACK();
+  assert_int_equal(rope_result.as.object->type, OBJECT_ROPE);
+  assert_int_equal(object_get_string_length(rope_result.as.object), OBJECT_ROPE_MIN_LENGTH * 2 + 2);
+
+  ObjectString const *const flattened = value_to_string_object(&vm, rope_result);
+  assert_int_equal(flattened->content[0], 'a');
+  assert_memory_equal(flattened->content + 1, long_string_content, OBJECT_ROPE_MIN_LENGTH);
+  assert_int_equal(flattened->content[flattened->length - 1], 'b');
+
+  // invalid operand types (only the last two operands are checked, as '..' is right-associative)
+  reset_test_case_env();
+
+  APPEND_CONSTANT_INSTRUCTIONS(STRING_A, value_make_number(1), value_make_number(2));
+  APPEND_INSTRUCTION(CHUNK_OP_CONCATENATE_N);
+  chunk_append_operand(&chunk, 3);
+  APPEND_INSTRUCTION(CHUNK_OP_RETURN);
+  EXECUTE_ASSERT_FAILURE();
+  ASSERT_EXECUTION_ERROR(
+    "Expected at least one string-concatenation operand to be a string (got 'number' and 'number')"
+  );
+
+#undef STRING_A
+#undef STRING_B
+}
+
+static void test_CHUNK_OP_INPUT(void **const _) {
+  char const *const input_names[] = {"a", "b"};
+  VMConfig input_vm_config = vm_config;
+  input_vm_config.input_names = input_names;
+  input_vm_config.input_count = 2;
+  vm_recycle(&vm, &input_vm_config);
+
+  Value const inputs[] = {value_make_number(1), value_make_bool(true)};
+  vm.inputs = inputs;
+
+  APPEND_INSTRUCTION(CHUNK_OP_INPUT);
+  chunk_append_operand(&chunk, 1);
+  APPEND_INSTRUCTION(CHUNK_OP_INPUT);
+  chunk_append_operand(&chunk, 0);
+  APPEND_INSTRUCTION(CHUNK_OP_RETURN);
+  EXECUTE_ASSERT_SUCCESS();
+  STACK_POP_ASSERT_MANY(value_make_number(1), value_make_bool(true));
+  ASSERT_EMPTY_STACK();
+
+  // inputs are supplied anew prior to each execution
+  Value const next_inputs[] = {value_make_number(2), value_make_nil()};
+  vm.inputs = next_inputs;
+
+  EXECUTE_ASSERT_SUCCESS();
+  STACK_POP_ASSERT_MANY(value_make_number(2), value_make_nil());
+  ASSERT_EMPTY_STACK();
+
+  vm_recycle(&vm, &vm_config);
+  assert_null(vm.inputs);
+}
+
+static void test_vm_recycle(void **const _) {
+  // leave behind stack value and heap-allocated string
+  APPEND_CONSTANT_INSTRUCTIONS(
+    value_make_object((Object *)object_make_non_owning_string(&vm, "a", 1)), value_make_number(1)
+  );
+  APPEND_INSTRUCTIONS(CHUNK_OP_CONCATENATE, CHUNK_OP_RETURN);
+  EXECUTE_ASSERT_SUCCESS();
+
+  VM fresh_vm;
+  vm_init(&fresh_vm, &vm_config);
+  size_t const fresh_string_count = fresh_vm.strings.count;
+  vm_destroy(&fresh_vm);
+
+  VMConfig recycled_vm_config = vm_config;
+  recycled_vm_config.source_program_output_stream = tmpfile();
+  if (recycled_vm_config.source_program_output_stream == NULL) ERROR_IO_ERRNO();
+
+  vm_recycle(&vm, &recycled_vm_config);
+  ASSERT_EMPTY_STACK();
+  assert_null(vm.gc_objects);
+  assert_int_equal(vm.strings.count, fresh_string_count);
+
+  // recycled VM writes into newly configured stream
+  chunk_reset(&chunk);
+  APPEND_CONSTANT_INSTRUCTION(value_make_object((Object *)object_make_non_owning_string(&vm, "b", 1)));
+  APPEND_INSTRUCTIONS(CHUNK_OP_PRINT, CHUNK_OP_RETURN);
+  EXECUTE_ASSERT_SUCCESS();
+  component_test_assert_file_content(recycled_vm_config.source_program_output_stream, "b\n");
+
+  vm_recycle(&vm, &vm_config);
+  if (fclose(recycled_vm_config.source_program_output_stream)) ERROR_IO_ERRNO();
+}
+
+static void test_vm_recycle_with_object_allocator(void **const _) {
+  MemoryArena object_arena;
+  memory_arena_init(&object_arena, 64, memory_manage);
+  MemoryAllocator const object_allocator = memory_arena_make_allocator(&object_arena);
+
+  VMConfig arena_vm_config = vm_config;
+  arena_vm_config.object_allocator = &object_allocator;
+  vm_recycle(&vm, &arena_vm_config);
+
+  // allocate strings spanning several arena blocks
+  Object const *const first_object = (Object *)object_make_owning_string(&vm, "a", 1);
+  for (int i = 0; i < 8; i++) {
+    APPEND_CONSTANT_INSTRUCTIONS(
+      value_make_object((Object *)object_make_owning_string(&vm, "abcdefghijklmnopqrstuvwxyz", 26)),
+      value_make_number(i)
+    );
+    APPEND_INSTRUCTIONS(CHUNK_OP_CONCATENATE, CHUNK_OP_PRINT);
+  }
+  APPEND_INSTRUCTION(CHUNK_OP_RETURN);
+  EXECUTE_ASSERT_SUCCESS();
+  assert_ptr_not_equal(object_arena.current_block, object_arena.first_block);
+
+  // objects are released by resetting arena, so their memory gets reused from the beginning
+  vm_recycle(&vm, &arena_vm_config);
+  assert_null(vm.gc_objects);
+  assert_ptr_equal(object_arena.current_block, object_arena.first_block);
+
+  Object *const reallocated_object = (Object *)object_make_owning_string(&vm, "a", 1);
+  assert_ptr_equal(reallocated_object, first_object);
+
+  chunk_reset(&chunk);
+  APPEND_CONSTANT_INSTRUCTION(value_make_object(reallocated_object));
+  APPEND_INSTRUCTIONS(CHUNK_OP_PRINT, CHUNK_OP_RETURN);
+  EXECUTE_ASSERT_SUCCESS();
+  component_test_assert_file_content(vm_config.source_program_output_stream, "a\n");
+
+  vm_destroy(&vm); // resets arena as well
+  vm_init(&vm, &vm_config);
+  memory_arena_destroy(&object_arena);
+}
+
+static void test_execution_bytecode_budget(void **const _) {
+  VMConfig budget_vm_config = vm_config;
+  budget_vm_config.bytecode_budget = 6;
+  vm_recycle(&vm, &budget_vm_config);
+
+  // every print statement takes 3 bytecode bytes, so the third one exceeds budget (after being executed)
+  for (int i = 1; i <= 4; i++) {
+    APPEND_CONSTANT_INSTRUCTION(value_make_number(i));
+    APPEND_INSTRUCTION(CHUNK_OP_PRINT);
+  }
+  APPEND_INSTRUCTION(CHUNK_OP_RETURN);
+  EXECUTE_ASSERT_FAILURE();
+  ASSERT_SOURCE_PROGRAM_OUTPUT("1\n2\n3");
+  ASSERT_EXECUTION_ERROR("Execution budget of 6 bytecode bytes exceeded");
+
+  // budget spans subsequent executions (e.g. pipelined batches), so the second one exceeds what's left of it (7 bytes)
+  budget_vm_config.bytecode_budget = 20;
+  vm_recycle(&vm, &budget_vm_config);
+  EXECUTE_ASSERT_SUCCESS();
+  ASSERT_SOURCE_PROGRAM_OUTPUT("1\n2\n3\n4");
+  EXECUTE_ASSERT_FAILURE();
+  ASSERT_SOURCE_PROGRAM_OUTPUT("1\n2\n3");
+  ASSERT_EXECUTION_ERROR("Execution budget of 20 bytecode bytes exceeded");
+
+  // budget gets restored by its reset, as well as by VM recycling
+  vm_reset_execution_budget(&vm);
+  EXECUTE_ASSERT_SUCCESS();
+  vm_recycle(&vm, &budget_vm_config);
+  EXECUTE_ASSERT_SUCCESS();
+
+  vm_recycle(&vm, &vm_config);
+}
+
+static void test_execution_timeout(void **const _) {
+  for (int i = 0; i < 1000; i++) APPEND_INSTRUCTIONS(CHUNK_OP_NIL, CHUNK_OP_POP);
+  APPEND_INSTRUCTION(CHUNK_OP_RETURN);
+
+  VMConfig timeout_vm_config = vm_config;
+  timeout_vm_config.execution_timeout = 60;
+  vm_recycle(&vm, &timeout_vm_config);
+  EXECUTE_ASSERT_SUCCESS();
+  ASSERT_EMPTY_STACK();
+
+  // timeout is checked periodically (rather than after every statement), but well before 1000 statements execute
+  timeout_vm_config.execution_timeout = 1e-9;
+  vm_recycle(&vm, &timeout_vm_config);
+  EXECUTE_ASSERT_FAILURE();
+  ASSERT_EXECUTION_ERROR("Execution timeout of 1e-09 seconds exceeded");
+
+  // timeout spans subsequent executions, excluding time spent between them
+  timeout_vm_config.execution_timeout = 0.05;
+  vm_recycle(&vm, &timeout_vm_config);
+  EXECUTE_ASSERT_SUCCESS();
+  wait_seconds(2 * timeout_vm_config.execution_timeout);
+  EXECUTE_ASSERT_SUCCESS();
+
+  int execution_count = 2;
+  while (execute()) execution_count++;
+  assert_true(execution_count > 2);
+  ASSERT_EXECUTION_ERROR("Execution timeout of 0.05 seconds exceeded");
+
+  vm_reset_execution_budget(&vm);
+  EXECUTE_ASSERT_SUCCESS();
+
+  vm_recycle(&vm, &vm_config);
+}
+
 int main(void) {
   // CHUNK_OP_RETURN test is missing as it's not yet properly implemented
 
@@ -826,6 +1165,18 @@ int main(void) {
     cmocka_unit_test_setup_teardown(test_CHUNK_OP_GREATER, setup_test_case_env, teardown_test_case_env),
     cmocka_unit_test_setup_teardown(test_CHUNK_OP_GREATER_EQUAL, setup_test_case_env, teardown_test_case_env),
     cmocka_unit_test_setup_teardown(test_CHUNK_OP_CONCATENATE, setup_test_case_env, teardown_test_case_env),
+    cmocka_unit_test_setup_teardown(test_CHUNK_OP_CONCATENATE_rope, setup_test_case_env, teardown_test_case_env),
+    cmocka_unit_test_setup_teardown(test_CHUNK_OP_CONCATENATE_N, setup_test_case_env, teardown_test_case_env),
+    cmocka_unit_test_setup_teardown(test_CHUNK_OP_INPUT, setup_test_case_env, teardown_test_case_env),
+    cmocka_unit_test_setup_teardown(
+      test_CHUNK_OP_CONCATENATE_mixed_operand_allocation, setup_test_case_env, teardown_test_case_env
+    ),
+    cmocka_unit_test_setup_teardown(test_vm_recycle, setup_test_case_env, teardown_test_case_env),
+    cmocka_unit_test_setup_teardown(
+      test_vm_recycle_with_object_allocator, setup_test_case_env, teardown_test_case_env
+    ),
+    cmocka_unit_test_setup_teardown(test_execution_bytecode_budget, setup_test_case_env, teardown_test_case_env),
+    cmocka_unit_test_setup_teardown(test_execution_timeout, setup_test_case_env, teardown_test_case_env),
   };
 
   return cmocka_run_group_tests(tests, setup_test_group_env, teardown_test_group_env);
@@ -0,0 +1,257 @@
+#ifndef _WIN32
+#define _POSIX_C_SOURCE 200809L
+#endif
+
+#include "cli/batch.h"
+
+#include "common.h"
+#include "component/component_test.h"
+#include "utils/error.h"
+#include "utils/io.h"
+
+#include <errno.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#ifndef _WIN32
+#include <unistd.h>
+#endif
+
+// *---------------------------------------------*
+// *              MACRO DEFINITIONS              *
+// *---------------------------------------------*
+
+#define BATCH_PATH_PREFIX "/tmp/cla-batch-test"
+
+#define MAX_SCRIPT_COUNT 32
+
+// statements executed by scripts that take a while to interpret
+#define HEAVY_SCRIPT_STATEMENT_COUNT 20000
+
+// *---------------------------------------------*
+// *          INTERNAL-LINKAGE OBJECTS           *
+// *---------------------------------------------*
+
+static char script_paths[MAX_SCRIPT_COUNT][64];
+static char const *script_path_ptrs[MAX_SCRIPT_COUNT];
+static char missing_script_path[64];
+static char manifest_path[64];
+
+static FILE *program_output_stream;
+static FILE *error_output_stream;
+
+// *---------------------------------------------*
+// *         INTERNAL-LINKAGE FUNCTIONS          *
+// *---------------------------------------------*
+
+/// Write `content` into file at `path`.
+static void write_file(char const *const path, char const *const content) {
+  size_t const length = strlen(content);
+
+  FILE *const file = fopen(path, "wb");
+  if (file == NULL) ERROR_IO_ERRNO();
+  if (fwrite(content, 1, length, file) < length) ERROR_IO_ERRNO();
+  if (fclose(file) == EOF) ERROR_IO_ERRNO();
+}
+
+#ifndef _WIN32
+/// Interpret first `script_count` scripts, followed by ones listed in `manifest_path` file (NULL if there's none), in
+/// batch mode by `job_count` jobs. Stdout and stderr get redirected into program and error output streams respectively
+/// for the duration of interpretation.
+/// @return Interpretation error code.
+static ErrorCode interpret(int const script_count, char const *const manifest_path, int const job_count) {
+  if (fflush(stdout) == EOF || fflush(stderr) == EOF) ERROR_IO_ERRNO();
+  int const stdout_fd = dup(STDOUT_FILENO);
+  int const stderr_fd = dup(STDERR_FILENO);
+  if (stdout_fd < 0 || stderr_fd < 0) ERROR_IO_ERRNO();
+  if (dup2(fileno(program_output_stream), STDOUT_FILENO) < 0) ERROR_IO_ERRNO();
+  if (dup2(fileno(error_output_stream), STDERR_FILENO) < 0) ERROR_IO_ERRNO();
+
+  ErrorCode const error_code = batch_interpret(script_path_ptrs, script_count, manifest_path, job_count);
+
+  if (fflush(stdout) == EOF || fflush(stderr) == EOF) ERROR_IO_ERRNO();
+  if (dup2(stdout_fd, STDOUT_FILENO) < 0 || dup2(stderr_fd, STDERR_FILENO) < 0) ERROR_IO_ERRNO();
+  if (close(stdout_fd) || close(stderr_fd)) ERROR_IO_ERRNO();
+
+  return error_code;
+}
+
+/// Discard content of program and error output streams.
+static void clear_output_streams(void) {
+  io_clear_file(program_output_stream);
+  io_clear_file(error_output_stream);
+}
+
+/// Assert that error output stream holds `expected_errors`, followed by throughput report of `script_count` scripts
+/// (`failed_script_count` of which failed).
+static void assert_error_output(
+  char const *const expected_errors, int const script_count, int const failed_script_count
+) {
+  char expected_report_prefix[128];
+  snprintf(
+    expected_report_prefix, sizeof(expected_report_prefix),
+    "[BATCH]" COMMON_MS "%d scripts (%d failed) interpreted in ", script_count, failed_script_count
+  );
+
+  // report holds elapsed time, thus only its prefix is compared
+  char *const error_output = io_read_finite_seekable_binary_stream_as_str(error_output_stream);
+  char *const report = strstr(error_output, "[BATCH]");
+  assert_non_null(report);
+  *report = '\0';
+  assert_string_equal(error_output, expected_errors);
+  *report = '[';
+  assert_memory_equal(report, expected_report_prefix, strlen(expected_report_prefix));
+
+  free(error_output);
+}
+#endif
+
+// *---------------------------------------------*
+// *                  FIXTURES                   *
+// *---------------------------------------------*
+
+static int setup_test_group_env(void **const _) {
+#ifndef _WIN32
+  for (int i = 0; i < MAX_SCRIPT_COUNT; i++) {
+    snprintf(script_paths[i], sizeof(script_paths[i]), BATCH_PATH_PREFIX "-%ld-%d.cla", (long)getpid(), i);
+    script_path_ptrs[i] = script_paths[i];
+  }
+  snprintf(missing_script_path, sizeof(missing_script_path), BATCH_PATH_PREFIX "-%ld-missing.cla", (long)getpid());
+  snprintf(manifest_path, sizeof(manifest_path), BATCH_PATH_PREFIX "-%ld.manifest", (long)getpid());
+#endif
+
+  return 0;
+}
+
+static int teardown_test_group_env(void **const _) {
+#ifndef _WIN32
+  for (int i = 0; i < MAX_SCRIPT_COUNT; i++) remove(script_paths[i]);
+  remove(manifest_path);
+#endif
+
+  return 0;
+}
+
+static int setup_test_case_env(void **const _) {
+  program_output_stream = tmpfile();
+  if (program_output_stream == NULL) ERROR_IO_ERRNO();
+  error_output_stream = tmpfile();
+  if (error_output_stream == NULL) ERROR_IO_ERRNO();
+
+  return 0;
+}
+
+static int teardown_test_case_env(void **const _) {
+  if (fclose(program_output_stream)) ERROR_IO_ERRNO();
+  if (fclose(error_output_stream)) ERROR_IO_ERRNO();
+
+  return 0;
+}
+
+// *---------------------------------------------*
+// *                 TEST CASES                  *
+// *---------------------------------------------*
+
+static void test_output_order(void **const _) {
+#ifndef _WIN32
+  // every 8th script is heavy; such scripts are striped onto the first worker, so that idle workers steal them
+  char *const script = malloc(HEAVY_SCRIPT_STATEMENT_COUNT * 7 + 32);
+  if (script == NULL) ERROR_MEMORY_ERRNO();
+  char expected_output[MAX_SCRIPT_COUNT * 4] = "";
+
+  for (int i = 0; i < MAX_SCRIPT_COUNT; i++) {
+    size_t script_length = 0;
+    for (int j = 0; i % 8 == 0 && j < HEAVY_SCRIPT_STATEMENT_COUNT; j++) {
+      script_length += sprintf(script + script_length, "1 + 1;\n");
+    }
+    sprintf(script + script_length, "print %d;\n", i);
+    write_file(script_paths[i], script);
+    sprintf(expected_output + strlen(expected_output), "%d\n", i);
+  }
+  free(script);
+
+  for (int job_count = 1; job_count <= 8; job_count *= 2) {
+    clear_output_streams();
+
+    assert_int_equal(interpret(MAX_SCRIPT_COUNT, NULL, job_count), ERROR_CODE_SUCCESS);
+    component_test_assert_file_content(program_output_stream, expected_output);
+    assert_error_output("", MAX_SCRIPT_COUNT, 0);
+  }
+#endif
+}
+
+static void test_first_failing_exit_code(void **const _) {
+#ifndef _WIN32
+  write_file(script_paths[0], "print 1;\n");
+  write_file(script_paths[1], "print -\"a\";\n");
+  write_file(script_paths[2], "print ;\n");
+  write_file(script_paths[3], "print 2;\n");
+
+  // script failing to execute precedes the one failing to compile, hence its error code is the batch one
+  assert_int_equal(interpret(4, NULL, 2), ERROR_CODE_EXECUTION);
+  component_test_assert_file_content(program_output_stream, "1\n2\n");
+
+  char expected_errors[512];
+  snprintf(
+    expected_errors, sizeof(expected_errors),
+    "[EXECUTION_ERROR]" COMMON_MS "%s" COMMON_PS "1" COMMON_MS
+    "Expected negation operand to be a number (got 'string')\n"
+    "[SYNTAX_ERROR]" COMMON_MS "%s" COMMON_PS "1" COMMON_PS "7" COMMON_MS "Expected expression at ';'\n",
+    script_paths[1], script_paths[2]
+  );
+  assert_error_output(expected_errors, 4, 2);
+#endif
+}
+
+static void test_unreadable_script(void **const _) {
+#ifndef _WIN32
+  // unreadable script fails on its own, without affecting the other ones
+  write_file(script_paths[0], "print 1;\n");
+  script_path_ptrs[1] = missing_script_path;
+  write_file(script_paths[2], "print 2;\n");
+
+  ErrorCode const error_code = interpret(3, NULL, 2);
+  script_path_ptrs[1] = script_paths[1];
+
+  assert_int_equal(error_code, ERROR_CODE_IO);
+  component_test_assert_file_content(program_output_stream, "1\n2\n");
+
+  char expected_errors[512];
+  snprintf(
+    expected_errors, sizeof(expected_errors), "[ERROR_IO]" COMMON_MS "Failed to read file '%s'" COMMON_MS "%s\n",
+    missing_script_path, strerror(ENOENT)
+  );
+  assert_error_output(expected_errors, 3, 1);
+#endif
+}
+
+static void test_manifest(void **const _) {
+#ifndef _WIN32
+  for (int i = 0; i < 4; i++) {
+    char script[32];
+    sprintf(script, "print %d;\n", i);
+    write_file(script_paths[i], script);
+  }
+
+  // manifest scripts follow path arguments; CRLF line endings are accommodated, and blank lines are skipped
+  char manifest[512];
+  snprintf(manifest, sizeof(manifest), "%s\r\n\r\n  \n%s\n\n%s", script_paths[1], script_paths[2], script_paths[3]);
+  write_file(manifest_path, manifest);
+
+  assert_int_equal(interpret(1, manifest_path, 2), ERROR_CODE_SUCCESS);
+  component_test_assert_file_content(program_output_stream, "0\n1\n2\n3\n");
+  assert_error_output("", 4, 0);
+#endif
+}
+
+int main(void) {
+  struct CMUnitTest const tests[] = {
+    cmocka_unit_test_setup_teardown(test_output_order, setup_test_case_env, teardown_test_case_env),
+    cmocka_unit_test_setup_teardown(test_first_failing_exit_code, setup_test_case_env, teardown_test_case_env),
+    cmocka_unit_test_setup_teardown(test_unreadable_script, setup_test_case_env, teardown_test_case_env),
+    cmocka_unit_test_setup_teardown(test_manifest, setup_test_case_env, teardown_test_case_env),
+  };
+
+  return cmocka_run_group_tests(tests, setup_test_group_env, teardown_test_group_env);
+}
@@ -0,0 +1,270 @@
+#ifndef _WIN32
+#define _POSIX_C_SOURCE 200809L
+#endif
+
+#include "cli/records.h"
+
+#include "common.h"
+#include "component/component_test.h"
+#include "utils/error.h"
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#ifndef _WIN32
+#include <unistd.h>
+#endif
+
+// *---------------------------------------------*
+// *              MACRO DEFINITIONS              *
+// *---------------------------------------------*
+
+#define RECORDS_PATH_PREFIX "/tmp/cla-records-test"
+
+/// Script printing fields 'a' and 'b' of every record.
+#define FIELD_PRINTING_SCRIPT "print a .. \"|\" .. b;\n"
+
+// records spanning multiple shards (so that multiple jobs process them concurrently)
+#define MULTI_SHARD_RECORD_COUNT 300000
+
+// *---------------------------------------------*
+// *          INTERNAL-LINKAGE OBJECTS           *
+// *---------------------------------------------*
+
+static char csv_records_path[64];
+static char ndjson_records_path[64];
+static char script_path[64];
+
+static FILE *program_output_stream;
+static FILE *error_output_stream;
+
+// *---------------------------------------------*
+// *         INTERNAL-LINKAGE FUNCTIONS          *
+// *---------------------------------------------*
+
+/// Write `length` bytes of `content` into file at `path`.
+static void write_file(char const *const path, char const *const content, size_t const length) {
+  FILE *const file = fopen(path, "wb");
+  if (file == NULL) ERROR_IO_ERRNO();
+  if (fwrite(content, 1, length, file) < length) ERROR_IO_ERRNO();
+  if (fclose(file) == EOF) ERROR_IO_ERRNO();
+}
+
+#ifndef _WIN32
+/// Interpret `script` for every record of `records_path` file holding `records`, by `job_count` jobs. Stdout and
+/// stderr get redirected into program and error output streams respectively for the duration of interpretation.
+/// @return Interpretation error code.
+static ErrorCode interpret(
+  char const *const records_path, char const *const records, char const *const script, int const job_count
+) {
+  write_file(records_path, records, strlen(records));
+  write_file(script_path, script, strlen(script));
+
+  if (fflush(stdout) == EOF || fflush(stderr) == EOF) ERROR_IO_ERRNO();
+  int const stdout_fd = dup(STDOUT_FILENO);
+  int const stderr_fd = dup(STDERR_FILENO);
+  if (stdout_fd < 0 || stderr_fd < 0) ERROR_IO_ERRNO();
+  if (dup2(fileno(program_output_stream), STDOUT_FILENO) < 0) ERROR_IO_ERRNO();
+  if (dup2(fileno(error_output_stream), STDERR_FILENO) < 0) ERROR_IO_ERRNO();
+
+  ErrorCode const error_code = records_interpret(records_path, script_path, job_count);
+
+  if (fflush(stdout) == EOF || fflush(stderr) == EOF) ERROR_IO_ERRNO();
+  if (dup2(stdout_fd, STDOUT_FILENO) < 0 || dup2(stderr_fd, STDERR_FILENO) < 0) ERROR_IO_ERRNO();
+  if (close(stdout_fd) || close(stderr_fd)) ERROR_IO_ERRNO();
+
+  return error_code;
+}
+#endif
+
+// *---------------------------------------------*
+// *                  FIXTURES                   *
+// *---------------------------------------------*
+
+static int setup_test_group_env(void **const _) {
+#ifndef _WIN32
+  snprintf(csv_records_path, sizeof(csv_records_path), RECORDS_PATH_PREFIX "-%ld.csv", (long)getpid());
+  snprintf(ndjson_records_path, sizeof(ndjson_records_path), RECORDS_PATH_PREFIX "-%ld.ndjson", (long)getpid());
+  snprintf(script_path, sizeof(script_path), RECORDS_PATH_PREFIX "-%ld.cla", (long)getpid());
+#endif
+
+  return 0;
+}
+
+static int teardown_test_group_env(void **const _) {
+#ifndef _WIN32
+  remove(csv_records_path);
+  remove(ndjson_records_path);
+  remove(script_path);
+#endif
+
+  return 0;
+}
+
+static int setup_test_case_env(void **const _) {
+  program_output_stream = tmpfile();
+  if (program_output_stream == NULL) ERROR_IO_ERRNO();
+  error_output_stream = tmpfile();
+  if (error_output_stream == NULL) ERROR_IO_ERRNO();
+
+  return 0;
+}
+
+static int teardown_test_case_env(void **const _) {
+  if (fclose(program_output_stream)) ERROR_IO_ERRNO();
+  if (fclose(error_output_stream)) ERROR_IO_ERRNO();
+
+  return 0;
+}
+
+// *---------------------------------------------*
+// *                 TEST CASES                  *
+// *---------------------------------------------*
+
+static void test_csv_quoted_fields(void **const _) {
+#ifndef _WIN32
+  ErrorCode const error_code = interpret(
+    csv_records_path, "\"a\",b\n\"x,\"\"y\"\"\nz\",1\n\"\",\"2\"\n", FIELD_PRINTING_SCRIPT, 1
+  );
+
+  assert_int_equal(error_code, ERROR_CODE_SUCCESS);
+  component_test_assert_file_content(program_output_stream, "x,\"y\"\nz|1\n|2\n");
+  component_test_assert_file_content(error_output_stream, "");
+#endif
+}
+
+static void test_csv_crlf_line_endings_and_bom(void **const _) {
+#ifndef _WIN32
+  ErrorCode const error_code = interpret(
+    csv_records_path, "\xEF\xBB\xBF\"a\",b\r\n1,x\r\n\"2\",\r\n\r\n3,\"y\r\nz\"\r\n", FIELD_PRINTING_SCRIPT, 1
+  );
+
+  assert_int_equal(error_code, ERROR_CODE_SUCCESS);
+  component_test_assert_file_content(program_output_stream, "1|x\n2|nil\n3|y\r\nz\n");
+  component_test_assert_file_content(error_output_stream, "");
+#endif
+}
+
+static void test_csv_malformed_records(void **const _) {
+#ifndef _WIN32
+  // quote following field start is part of field content, hence it doesn't open quoted field spanning next records
+  ErrorCode const error_code = interpret(
+    csv_records_path, "a,b\n1\n\"p\"q,5\"in\n2,5\"in\n3,4,5\n4,\"unterminated\n", FIELD_PRINTING_SCRIPT, 1
+  );
+
+  assert_int_equal(error_code, ERROR_CODE_IO);
+  component_test_assert_file_content(program_output_stream, "2|5\"in\n");
+
+  char expected_errors[512];
+  snprintf(
+    expected_errors, sizeof(expected_errors),
+    "[RECORD_ERROR]" COMMON_MS "%s" COMMON_PS "2" COMMON_MS "Field count differs from the one of header\n"
+    "[RECORD_ERROR]" COMMON_MS "%s" COMMON_PS "3" COMMON_MS "Expected ',' or record end following quoted field\n"
+    "[RECORD_ERROR]" COMMON_MS "%s" COMMON_PS "5" COMMON_MS "Field count differs from the one of header\n"
+    "[RECORD_ERROR]" COMMON_MS "%s" COMMON_PS "6" COMMON_MS "Unterminated quoted field\n",
+    csv_records_path, csv_records_path, csv_records_path, csv_records_path
+  );
+  component_test_assert_file_content(error_output_stream, expected_errors);
+#endif
+}
+
+static void test_ndjson_records(void **const _) {
+#ifndef _WIN32
+  ErrorCode const error_code = interpret(
+    ndjson_records_path,
+    "{\"a\": \"\\u00e9\\ud83d\\ude00\\n\\\"\", \"b\": {\"c\": [1, \"}\"]}}\n"
+    "{\"b\": true, \"a\": null}\n"
+    "{\"a\": -1.5e2}\n",
+    FIELD_PRINTING_SCRIPT, 1
+  );
+
+  assert_int_equal(error_code, ERROR_CODE_SUCCESS);
+  component_test_assert_file_content(
+    program_output_stream, "\xC3\xA9\xF0\x9F\x98\x80\n\"|{\"c\": [1, \"}\"]}\nnil|true\n-150|nil\n"
+  );
+  component_test_assert_file_content(error_output_stream, "");
+#endif
+}
+
+static void test_ndjson_malformed_records(void **const _) {
+#ifndef _WIN32
+  ErrorCode const error_code =
+    interpret(ndjson_records_path, "{\"a\": 1, \"b\": 2}\n{\"a\": 1,\n[]\n{\"a\": \"\\ud83d\"}\n", "print a;\n", 1);
+
+  assert_int_equal(error_code, ERROR_CODE_IO);
+  component_test_assert_file_content(program_output_stream, "1\n");
+
+  char expected_errors[512];
+  snprintf(
+    expected_errors, sizeof(expected_errors),
+    "[RECORD_ERROR]" COMMON_MS "%s" COMMON_PS "2" COMMON_MS "Expected key\n"
+    "[RECORD_ERROR]" COMMON_MS "%s" COMMON_PS "3" COMMON_MS "Expected record to be an object\n"
+    "[RECORD_ERROR]" COMMON_MS "%s" COMMON_PS "4" COMMON_MS "Invalid unicode escape sequence\n",
+    ndjson_records_path, ndjson_records_path, ndjson_records_path
+  );
+  component_test_assert_file_content(error_output_stream, expected_errors);
+#endif
+}
+
+static void test_execution_failure(void **const _) {
+#ifndef _WIN32
+  ErrorCode const error_code = interpret(csv_records_path, "a\n1\nx\n2\n", "print -a;\n", 1);
+
+  assert_int_equal(error_code, ERROR_CODE_EXECUTION);
+  component_test_assert_file_content(program_output_stream, "-1\n-2\n");
+
+  char expected_errors[512];
+  snprintf(
+    expected_errors, sizeof(expected_errors),
+    "[EXECUTION_ERROR]" COMMON_MS "%s" COMMON_PS "1" COMMON_MS
+    "Expected negation operand to be a number (got 'string')\n"
+    "[RECORD_ERROR]" COMMON_MS "%s" COMMON_PS "3" COMMON_MS "Script execution failed\n",
+    script_path, csv_records_path
+  );
+  component_test_assert_file_content(error_output_stream, expected_errors);
+#endif
+}
+
+static void test_concurrent_output_order(void **const _) {
+#ifndef _WIN32
+  // every shard holds failed record, so that errors are interleaved with output of multiple shards
+  size_t const records_capacity = MULTI_SHARD_RECORD_COUNT * 16;
+  char *const records = malloc(records_capacity);
+  char *const expected_output = malloc(records_capacity);
+  if (records == NULL || expected_output == NULL) ERROR_MEMORY_ERRNO();
+
+  size_t records_length = sprintf(records, "a\n");
+  size_t expected_output_length = 0;
+  for (int i = 0; i < MULTI_SHARD_RECORD_COUNT; i++) {
+    records_length += sprintf(records + records_length, "%d\n", i);
+    expected_output_length += sprintf(expected_output + expected_output_length, "%d\n", i);
+  }
+
+  for (int job_count = 1; job_count <= 4; job_count *= 2) {
+    if (fflush(program_output_stream) == EOF || ftruncate(fileno(program_output_stream), 0)) ERROR_IO_ERRNO();
+    rewind(program_output_stream);
+
+    assert_int_equal(interpret(csv_records_path, records, "print a;\n", job_count), ERROR_CODE_SUCCESS);
+    component_test_assert_file_content(program_output_stream, expected_output);
+  }
+  component_test_assert_file_content(error_output_stream, "");
+
+  free(records);
+  free(expected_output);
+#endif
+}
+
+int main(void) {
+  struct CMUnitTest const tests[] = {
+    cmocka_unit_test_setup_teardown(test_csv_quoted_fields, setup_test_case_env, teardown_test_case_env),
+    cmocka_unit_test_setup_teardown(test_csv_crlf_line_endings_and_bom, setup_test_case_env, teardown_test_case_env),
+    cmocka_unit_test_setup_teardown(test_csv_malformed_records, setup_test_case_env, teardown_test_case_env),
+    cmocka_unit_test_setup_teardown(test_ndjson_records, setup_test_case_env, teardown_test_case_env),
+    cmocka_unit_test_setup_teardown(test_ndjson_malformed_records, setup_test_case_env, teardown_test_case_env),
+    cmocka_unit_test_setup_teardown(test_execution_failure, setup_test_case_env, teardown_test_case_env),
+    cmocka_unit_test_setup_teardown(test_concurrent_output_order, setup_test_case_env, teardown_test_case_env),
+  };
+
+  return cmocka_run_group_tests(tests, setup_test_group_env, teardown_test_group_env);
+}
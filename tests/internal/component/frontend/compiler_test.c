@@ -3,18 +3,23 @@
 #include "backend/chunk.h"
 #include "backend/object.h"
 #include "backend/value.h"
+#include "backend/vm.h"
 #include "common.h"
 #include "component/component_test.h"
-#include "global.h"
 #include "utils/error.h"
 #include "utils/io.h"
 #include "utils/memory.h"
+#include "utils/memory_arena.h"
 
 #include <math.h>
 #include <stdio.h>
 #include <stdlib.h>
 #include <string.h>
 
+#ifndef _WIN32
+#include <pthread.h>
+#endif
+
 // *---------------------------------------------*
 // *              MACRO DEFINITIONS              *
 // *---------------------------------------------*
@@ -61,14 +66,6 @@
     ASSERT_OPCODES(operator_opcode, CHUNK_OP_POP, CHUNK_OP_RETURN);                  \
   } while (0)
 
-#define ASSERT_BINARY_OPERATOR_IS_RIGHT_ASSOCIATIVE(operator)                                       \
-  do {                                                                                              \
-    ChunkOpCode const operator_opcode = map_binary_operator_to_its_opcode(operator);                \
-    COMPILE_ASSERT_SUCCESS("1 " operator" 2 " operator" 3;");                                       \
-    ASSERT_CONSTANT_INSTRUCTIONS(value_make_number(1), value_make_number(2), value_make_number(3)); \
-    ASSERT_OPCODES(operator_opcode, operator_opcode, CHUNK_OP_POP, CHUNK_OP_RETURN);                \
-  } while (0)
-
 #define ASSERT_BINARY_OPERATORS_HAVE_THE_SAME_PRECEDENCE(operator_a, operator_b)         \
   do {                                                                                   \
     ChunkOpCode const operator_a_opcode = map_binary_operator_to_its_opcode(operator_a); \
@@ -97,10 +94,29 @@
     ASSERT_OPCODES(operator_a_opcode, operator_b_opcode, CHUNK_OP_POP, CHUNK_OP_RETURN);            \
   } while (0)
 
+#define CONCURRENT_VM_COUNT 64
+
+/// Statement repeated by pipelined compilation test; it spans 5 lines, and interns the same strings in every batch.
+#define PIPELINED_STATEMENT "print \"a;\nb\" .. \"c\" == \"a;\nbc\";\nprint (1 +\n2);\n"
+#define PIPELINED_STATEMENT_OUTPUT "true\n3\n"
+#define PIPELINED_STATEMENT_COUNT 8192
+
+// *---------------------------------------------*
+// *              TYPE DEFINITIONS               *
+// *---------------------------------------------*
+
+/// Source program compiled and executed by its own VM, concurrently with other such runs.
+typedef struct {
+  int index; // embedded in source program, so that each run yields distinct output
+  bool is_successful;
+  char *source_program_output;
+} ConcurrentVMRun;
+
 // *---------------------------------------------*
 // *          INTERNAL-LINKAGE OBJECTS           *
 // *---------------------------------------------*
 
+static VM vm;
 static Chunk chunk;
 static int chunk_code_offset;
 static int chunk_constant_instruction_index;
@@ -123,9 +139,9 @@ static CompilerStatus compile(char const *const source_code) {
   chunk_reset(&chunk);
   chunk_code_offset = 0;
   chunk_constant_instruction_index = 0;
-  io_clear_file(g_static_analysis_error_stream);
+  io_clear_file(vm.config.static_analysis_error_stream);
 
-  return compiler_compile(source_code, &chunk);
+  return compiler_compile(&vm, source_code, &chunk);
 }
 
 static void assert_static_analysis_error(
@@ -157,14 +173,14 @@ static void assert_static_analysis_error(
       ) < 0)
     ERROR_IO_ERRNO();
 
-  component_test_assert_file_content(g_static_analysis_error_stream, expected_static_analysis_error);
+  component_test_assert_file_content(vm.config.static_analysis_error_stream, expected_static_analysis_error);
 
   free(expected_static_analysis_error);
 }
 
 static void assert_chunk_constant(int32_t const constant_index, Value const expected_constant) {
   assert_int_equal(chunk_constant_instruction_index, constant_index);
-  component_test_assert_value_equality(chunk.constants.data[constant_index], expected_constant);
+  component_test_assert_value_equality(&vm, chunk.constants.data[constant_index], expected_constant);
   chunk_constant_instruction_index++;
 }
 
@@ -189,6 +205,165 @@ static void assert_constant_instruction(Value const expected_constant) {
 #define ASSERT_CONSTANT_INSTRUCTIONS(...) \
   COMPONENT_TEST_APPLY_TO_EACH_ARG(assert_constant_instruction, Value, __VA_ARGS__)
 
+/// Assert that compiling `source_code` in up to `max_segment_count` parallel segments yields the same chunk, status,
+/// and static analysis errors as compiling it sequentially.
+static void assert_parallel_compilation_equivalence(char const *const source_code, int const max_segment_count) {
+  assert(source_code != NULL);
+
+  CompilerStatus const expected_status = compile(source_code);
+  char *const expected_static_analysis_errors =
+    io_read_finite_seekable_binary_stream_as_str(vm.config.static_analysis_error_stream);
+
+  Chunk parallel_chunk;
+  chunk_init(&parallel_chunk);
+  io_clear_file(vm.config.static_analysis_error_stream);
+  assert_int_equal(compiler_compile_parallel(&vm, source_code, &parallel_chunk, max_segment_count), expected_status);
+  component_test_assert_file_content(vm.config.static_analysis_error_stream, expected_static_analysis_errors);
+
+  if (expected_status == COMPILER_SUCCESS) {
+    assert_int_equal(parallel_chunk.code.count, chunk.code.count);
+    assert_memory_equal(parallel_chunk.code.data, chunk.code.data, chunk.code.count);
+
+    assert_int_equal(parallel_chunk.lines.count, chunk.lines.count);
+    for (size_t i = 0; i < chunk.lines.count; i++) {
+      assert_int_equal(parallel_chunk.lines.data[i].line, chunk.lines.data[i].line);
+      assert_int_equal(parallel_chunk.lines.data[i].count, chunk.lines.data[i].count);
+    }
+
+    assert_int_equal(parallel_chunk.constants.count, chunk.constants.count);
+    for (size_t i = 0; i < chunk.constants.count; i++) {
+      component_test_assert_value_equality(&vm, parallel_chunk.constants.data[i], chunk.constants.data[i]);
+    }
+  }
+
+  chunk_destroy(&parallel_chunk);
+  free(expected_static_analysis_errors);
+}
+
+/// Assert that compiling `lines` (NULL terminated) one by one within compiler session yields the same chunk, status,
+/// and static analysis errors as compiling them joined together; every line but the last one is expected to be cut off.
+static void assert_compiler_session_equivalence(char const *const *const lines) {
+  assert(lines != NULL);
+
+  char source_code[1024] = "";
+  for (int i = 0; lines[i] != NULL; i++) {
+    if (i > 0) strcat(source_code, "\n");
+    strcat(source_code, lines[i]);
+  }
+  CompilerStatus const expected_status = compile(source_code);
+  char *const expected_static_analysis_errors =
+    io_read_finite_seekable_binary_stream_as_str(vm.config.static_analysis_error_stream);
+
+  Chunk session_chunk;
+  chunk_init(&session_chunk);
+  CompilerSession session;
+  compiler_session_init(&session, &vm, &session_chunk);
+
+  for (int i = 0; lines[i] != NULL; i++) {
+    io_clear_file(vm.config.static_analysis_error_stream);
+    CompilerStatus const status = compiler_session_compile_line(&session, lines[i]);
+    if (lines[i + 1] != NULL) assert_int_equal(status, COMPILER_UNEXPECTED_EOF);
+    else assert_int_equal(status, expected_status);
+  }
+  component_test_assert_file_content(vm.config.static_analysis_error_stream, expected_static_analysis_errors);
+
+  if (expected_status == COMPILER_SUCCESS) {
+    assert_int_equal(session_chunk.code.count, chunk.code.count);
+    assert_memory_equal(session_chunk.code.data, chunk.code.data, chunk.code.count);
+
+    assert_int_equal(session_chunk.lines.count, chunk.lines.count);
+    for (size_t i = 0; i < chunk.lines.count; i++) {
+      assert_int_equal(session_chunk.lines.data[i].line, chunk.lines.data[i].line);
+      assert_int_equal(session_chunk.lines.data[i].count, chunk.lines.data[i].count);
+    }
+
+    assert_int_equal(session_chunk.constants.count, chunk.constants.count);
+    for (size_t i = 0; i < chunk.constants.count; i++) {
+      component_test_assert_value_equality(&vm, session_chunk.constants.data[i], chunk.constants.data[i]);
+    }
+  }
+
+  compiler_session_destroy(&session);
+  chunk_destroy(&session_chunk);
+  free(expected_static_analysis_errors);
+}
+#define ASSERT_COMPILER_SESSION_EQUIVALENCE(...) \
+  assert_compiler_session_equivalence((char const *const[]){__VA_ARGS__, NULL})
+
+/// Assert that feeding `source_code` into compiler stream in blocks of `block_length`, and executing chunks it yields
+/// right away, results in the same status, static analysis errors, and execution errors as compiling and executing
+/// `source_code` at once; so does source program output, unless `source_code` fails to compile (streamed statements
+/// preceding the failing one get executed).
+static void assert_compiler_stream_equivalence(char const *const source_code, size_t const block_length) {
+  assert(source_code != NULL);
+  assert(block_length > 0);
+
+  VMConfig const stream_vm_config = {
+    .source_file_path = __FILE__,
+    .static_analysis_error_stream = tmpfile(),
+    .bytecode_execution_error_stream = tmpfile(),
+    .source_program_output_stream = tmpfile(),
+    .memory_manager = memory_manage,
+  };
+  if (stream_vm_config.static_analysis_error_stream == NULL) ERROR_IO_ERRNO();
+  if (stream_vm_config.bytecode_execution_error_stream == NULL) ERROR_IO_ERRNO();
+  if (stream_vm_config.source_program_output_stream == NULL) ERROR_IO_ERRNO();
+
+  VM stream_vm;
+  vm_init(&stream_vm, &stream_vm_config);
+  Chunk stream_chunk;
+  chunk_init(&stream_chunk);
+
+  CompilerStatus const expected_status = compiler_compile(&stream_vm, source_code, &stream_chunk);
+  if (expected_status == COMPILER_SUCCESS) vm_execute(&stream_vm, &stream_chunk);
+  char *const expected_static_analysis_errors =
+    io_read_finite_seekable_binary_stream_as_str(stream_vm_config.static_analysis_error_stream);
+  char *const expected_execution_errors =
+    io_read_finite_seekable_binary_stream_as_str(stream_vm_config.bytecode_execution_error_stream);
+  char *const expected_output =
+    io_read_finite_seekable_binary_stream_as_str(stream_vm_config.source_program_output_stream);
+  io_clear_file(stream_vm_config.static_analysis_error_stream);
+  io_clear_file(stream_vm_config.bytecode_execution_error_stream);
+  io_clear_file(stream_vm_config.source_program_output_stream);
+  chunk_reset(&stream_chunk);
+
+  CompilerStream stream;
+  compiler_stream_init(&stream, &stream_vm, &stream_chunk);
+
+  size_t const length = strlen(source_code);
+  CompilerStatus status = COMPILER_SUCCESS;
+  bool is_executed = true;
+  for (size_t offset = 0; status == COMPILER_SUCCESS && is_executed; offset += block_length) {
+    bool const is_exhausted = offset >= length;
+    size_t const fed_length = length - offset < block_length ? length - offset : block_length;
+
+    status = is_exhausted ? compiler_stream_finish(&stream)
+                          : compiler_stream_feed(&stream, source_code + offset, fed_length);
+    if (status == COMPILER_SUCCESS && stream_chunk.code.count > 0) is_executed = vm_execute(&stream_vm, &stream_chunk);
+    chunk_reset(&stream_chunk);
+
+    if (is_exhausted) break;
+  }
+
+  assert_int_equal(status, expected_status);
+  component_test_assert_file_content(stream_vm_config.static_analysis_error_stream, expected_static_analysis_errors);
+  component_test_assert_file_content(stream_vm_config.bytecode_execution_error_stream, expected_execution_errors);
+  if (expected_status == COMPILER_SUCCESS) {
+    component_test_assert_file_content(stream_vm_config.source_program_output_stream, expected_output);
+  }
+
+  compiler_stream_destroy(&stream);
+  chunk_destroy(&stream_chunk);
+  vm_destroy(&stream_vm);
+  free(expected_output);
+  free(expected_execution_errors);
+  free(expected_static_analysis_errors);
+
+  if (fclose(stream_vm_config.static_analysis_error_stream)) ERROR_IO_ERRNO();
+  if (fclose(stream_vm_config.bytecode_execution_error_stream)) ERROR_IO_ERRNO();
+  if (fclose(stream_vm_config.source_program_output_stream)) ERROR_IO_ERRNO();
+}
+
 static ChunkOpCode map_binary_operator_to_its_opcode(char const *const operator) {
   assert(operator!= NULL);
 
@@ -208,23 +383,156 @@ static ChunkOpCode map_binary_operator_to_its_opcode(char const *const operator)
   ERROR_INTERNAL("Unknown binary operator '%s'", operator);
 }
 
+#ifndef _WIN32
+/// Compile and execute source program of `run_context` run on a dedicated VM, recording the outcome.
+/// @note Doesn't assert anything, as assertions are not thread-safe.
+static void *perform_concurrent_vm_run(void *const run_context) {
+  ConcurrentVMRun *const run = run_context;
+
+  VMConfig const vm_config = {
+    .source_file_path = __FILE__,
+    .static_analysis_error_stream = tmpfile(),
+    .bytecode_execution_error_stream = tmpfile(),
+    .source_program_output_stream = tmpfile(),
+    .memory_manager = memory_manage,
+  };
+  if (vm_config.static_analysis_error_stream == NULL) ERROR_IO_ERRNO();
+  if (vm_config.bytecode_execution_error_stream == NULL) ERROR_IO_ERRNO();
+  if (vm_config.source_program_output_stream == NULL) ERROR_IO_ERRNO();
+
+  // interns identical strings, as well as builds and flattens ropes, in every VM
+  char source_code[256];
+  snprintf(
+    source_code, sizeof(source_code),
+    "print \"vm \" .. %d .. \": \" .. true;\n"
+    "print (\"vm \" .. %d) .. (\"-\" .. \"-\") .. (\"a\" .. 1 .. \"b\" .. 2 .. \"c\" .. 3) == \"vm %d--a1b2c3\";\n",
+    run->index, run->index, run->index
+  );
+
+  VM run_vm;
+  vm_init(&run_vm, &vm_config);
+  Chunk run_chunk;
+  chunk_init(&run_chunk);
+
+  run->is_successful =
+    compiler_compile(&run_vm, source_code, &run_chunk) == COMPILER_SUCCESS && vm_execute(&run_vm, &run_chunk);
+
+  chunk_destroy(&run_chunk);
+  vm_destroy(&run_vm);
+
+  if (fflush(vm_config.source_program_output_stream)) ERROR_IO_ERRNO();
+  run->source_program_output = io_read_finite_seekable_binary_stream_as_str(vm_config.source_program_output_stream);
+
+  if (fclose(vm_config.static_analysis_error_stream)) ERROR_IO_ERRNO();
+  if (fclose(vm_config.bytecode_execution_error_stream)) ERROR_IO_ERRNO();
+  if (fclose(vm_config.source_program_output_stream)) ERROR_IO_ERRNO();
+
+  return NULL;
+}
+#endif
+
+/// Assert pipelined compilation behavior for VM whose objects are allocated by `object_allocator` (may be NULL).
+static void assert_pipelined_compilation(MemoryAllocator const *const object_allocator) {
+  VMConfig const pipeline_vm_config = {
+    .source_file_path = __FILE__,
+    .static_analysis_error_stream = tmpfile(),
+    .bytecode_execution_error_stream = tmpfile(),
+    .source_program_output_stream = tmpfile(),
+    .memory_manager = memory_manage,
+    .object_allocator = object_allocator,
+  };
+  if (pipeline_vm_config.static_analysis_error_stream == NULL) ERROR_IO_ERRNO();
+  if (pipeline_vm_config.bytecode_execution_error_stream == NULL) ERROR_IO_ERRNO();
+  if (pipeline_vm_config.source_program_output_stream == NULL) ERROR_IO_ERRNO();
+
+  VM pipeline_vm;
+  vm_init(&pipeline_vm, &pipeline_vm_config);
+
+  // source code spanning several batches, followed by static analysis error
+  size_t const statement_length = strlen(PIPELINED_STATEMENT);
+  size_t const output_length = strlen(PIPELINED_STATEMENT_OUTPUT);
+  char *const source_code = malloc(statement_length * (PIPELINED_STATEMENT_COUNT + 1) + 16);
+  char *const expected_output = malloc(output_length * PIPELINED_STATEMENT_COUNT + 1);
+  if (source_code == NULL || expected_output == NULL) ERROR_MEMORY_ERRNO();
+  for (int i = 0; i < PIPELINED_STATEMENT_COUNT; i++) {
+    memcpy(source_code + statement_length * i, PIPELINED_STATEMENT, statement_length);
+    memcpy(expected_output + output_length * i, PIPELINED_STATEMENT_OUTPUT, output_length);
+  }
+  source_code[statement_length * PIPELINED_STATEMENT_COUNT] = '\0';
+  expected_output[output_length * PIPELINED_STATEMENT_COUNT] = '\0';
+
+  // batches are executed in order, and strings they share are interned only once
+  CompilerPipeline *pipeline = compiler_pipeline_start(&pipeline_vm, source_code);
+  Chunk batch_chunk;
+  CompilerStatus batch_status;
+  int batch_count = 0;
+  while (compiler_pipeline_take_batch(pipeline, &batch_chunk, &batch_status)) {
+    batch_count++;
+    assert_int_equal(batch_status, COMPILER_SUCCESS);
+    assert_true(vm_execute(&pipeline_vm, &batch_chunk));
+    chunk_destroy(&batch_chunk);
+  }
+  compiler_pipeline_stop(pipeline);
+  assert_true(batch_count > 1);
+  component_test_assert_file_content(pipeline_vm_config.source_program_output_stream, expected_output);
+
+  // batch failing to compile reports its errors once taken, and ends the pipeline
+  strcat(source_code, "print ;\n" PIPELINED_STATEMENT);
+  pipeline = compiler_pipeline_start(&pipeline_vm, source_code);
+  while (compiler_pipeline_take_batch(pipeline, &batch_chunk, &batch_status) && batch_status == COMPILER_SUCCESS) {
+    chunk_destroy(&batch_chunk);
+  }
+  assert_int_equal(batch_status, COMPILER_FAILURE);
+  chunk_destroy(&batch_chunk);
+  assert_false(compiler_pipeline_take_batch(pipeline, &batch_chunk, &batch_status));
+  compiler_pipeline_stop(pipeline);
+
+  char expected_error[256];
+  snprintf(
+    expected_error, sizeof(expected_error),
+    "[SYNTAX_ERROR]" COMMON_MS COMMON_FILE_LINE_COLUMN_FORMAT COMMON_MS "Expected expression at ';'\n", __FILE__,
+    PIPELINED_STATEMENT_COUNT * 5 + 1, 7
+  );
+  component_test_assert_file_content(pipeline_vm_config.static_analysis_error_stream, expected_error);
+
+  // stopping pipeline discards batches that haven't been taken
+  pipeline = compiler_pipeline_start(&pipeline_vm, source_code);
+  assert_true(compiler_pipeline_take_batch(pipeline, &batch_chunk, &batch_status));
+  chunk_destroy(&batch_chunk);
+  compiler_pipeline_stop(pipeline);
+
+  free(expected_output);
+  free(source_code);
+  vm_destroy(&pipeline_vm);
+
+  if (fclose(pipeline_vm_config.static_analysis_error_stream)) ERROR_IO_ERRNO();
+  if (fclose(pipeline_vm_config.bytecode_execution_error_stream)) ERROR_IO_ERRNO();
+  if (fclose(pipeline_vm_config.source_program_output_stream)) ERROR_IO_ERRNO();
+}
+
 // *---------------------------------------------*
 // *                  FIXTURES                   *
 // *---------------------------------------------*
 
 static int setup_test_group_env(void **const _) {
-  g_source_file_path = __FILE__;
-  g_static_analysis_error_stream = tmpfile();
-  if (g_static_analysis_error_stream == NULL) ERROR_IO_ERRNO();
+  VMConfig const vm_config = {
+    .source_file_path = __FILE__,
+    .static_analysis_error_stream = tmpfile(),
+    .source_program_output_stream = stdout,
+    .memory_manager = memory_manage,
+  };
+  if (vm_config.static_analysis_error_stream == NULL) ERROR_IO_ERRNO();
 
+  vm_init(&vm, &vm_config);
   chunk_init(&chunk);
 
   return 0;
 }
 
 static int teardown_test_group_env(void **const _) {
-  if (fclose(g_static_analysis_error_stream)) ERROR_IO_ERRNO();
+  if (fclose(vm.config.static_analysis_error_stream)) ERROR_IO_ERRNO();
 
+  vm_destroy(&vm);
   chunk_destroy(&chunk);
 
   return 0;
@@ -233,7 +541,7 @@ static int teardown_test_group_env(void **const _) {
 // *---------------------------------------------*
 // *                 TEST CASES                  *
 // *---------------------------------------------*
-static_assert(CHUNK_OP_OPCODE_COUNT == 22, "Exhaustive OpCode handling");
+static_assert(CHUNK_OP_OPCODE_COUNT == 24, "Exhaustive OpCode handling");
 
 static void test_lexical_error_reporting(void **const _) {
   COMPILE_ASSERT_FAILURE("\"abc");
@@ -295,7 +603,7 @@ static void test_string_literal(void **const _) {
   char const *const input_string_content = input_source + 1; // account for beginning '"'
   size_t const input_string_content_length = strlen(input_source) - 3; // account for surrounding '"' and ';'
   Value const expected_value =
-    value_make_object((Object *)object_make_non_owning_string(input_string_content, input_string_content_length));
+    value_make_object((Object *)object_make_owning_string(&vm, input_string_content, input_string_content_length));
 
   COMPILE_ASSERT_SUCCESS(input_source);
   assert_constant_instruction(expected_value);
@@ -321,6 +629,31 @@ static void test_OP_CONSTANT_2B_being_generated(void **const _) {
   ASSERT_OPCODES(CHUNK_OP_POP, CHUNK_OP_RETURN);
 }
 
+static void test_constant_pool_overflow(void **const _) {
+  // one numeric literal statement per line; the last ones don't fit into chunk constant pool
+  size_t const statement_count = CHUNK_MAX_CONSTANT_COUNT + 16;
+  char *const source_code = malloc(statement_count * 3 + 1);
+  if (source_code == NULL) ERROR_MEMORY_ERRNO();
+  for (size_t i = 0; i < statement_count; i++) memcpy(source_code + i * 3, "1;\n", 3);
+  source_code[statement_count * 3] = '\0';
+
+  COMPILE_ASSERT_FAILURE(source_code);
+  ASSERT_SEMANTIC_ERROR(CHUNK_MAX_CONSTANT_COUNT + 1, 1, "Exceeded chunk constant pool limit at '1'");
+
+  // segments compiled in parallel fit into their own constant pools, but not into the linked one
+  for (int max_segment_count = 2; max_segment_count <= 64; max_segment_count *= 2) {
+    assert_parallel_compilation_equivalence(source_code, max_segment_count);
+  }
+
+  // static analysis error preceding constant pool overflow gets reported instead of it
+  memcpy(source_code + CHUNK_MAX_CONSTANT_COUNT / 2 * 3, "@;\n", 3);
+  assert_parallel_compilation_equivalence(source_code, 16);
+  memcpy(source_code + (CHUNK_MAX_CONSTANT_COUNT - 2) * 3, "@;\n", 3);
+  assert_parallel_compilation_equivalence(source_code, 16);
+
+  free(source_code);
+}
+
 static void test_arithmetic_operators(void **const _) {
   ASSERT_BINARY_OPERATOR_SYNTAX("+");
   ASSERT_BINARY_OPERATOR_SYNTAX("*");
@@ -423,12 +756,44 @@ static void test_relational_operator_precedence(void **const _) {
 static void test_string_concatenation_operator(void **const _) {
   ASSERT_BINARY_OPERATOR_SYNTAX("..");
 
-  ASSERT_BINARY_OPERATOR_IS_RIGHT_ASSOCIATIVE("..");
-
   ASSERT_BINARY_OPERATOR_A_HAS_HIGHER_PRECEDENCE("+", "..");
   ASSERT_BINARY_OPERATOR_A_HAS_HIGHER_PRECEDENCE("..", "==");
 }
 
+static void test_string_concatenation_chain(void **const _) {
+  COMPILE_ASSERT_SUCCESS("1 .. 2 .. 3;");
+  ASSERT_CONSTANT_INSTRUCTIONS(value_make_number(1), value_make_number(2), value_make_number(3));
+  ASSERT_OPCODES(CHUNK_OP_CONCATENATE_N, 3, CHUNK_OP_POP, CHUNK_OP_RETURN);
+
+  COMPILE_ASSERT_SUCCESS("1 .. 2 + 3 .. 4;");
+  ASSERT_CONSTANT_INSTRUCTIONS(value_make_number(1), value_make_number(2), value_make_number(3));
+  ASSERT_OPCODE(CHUNK_OP_ADD);
+  assert_constant_instruction(value_make_number(4));
+  ASSERT_OPCODES(CHUNK_OP_CONCATENATE_N, 3, CHUNK_OP_POP, CHUNK_OP_RETURN);
+
+  // grouping breaks the chain
+  COMPILE_ASSERT_SUCCESS("(1 .. 2) .. 3;");
+  ASSERT_CONSTANT_INSTRUCTIONS(value_make_number(1), value_make_number(2));
+  ASSERT_OPCODE(CHUNK_OP_CONCATENATE);
+  assert_constant_instruction(value_make_number(3));
+  ASSERT_OPCODES(CHUNK_OP_CONCATENATE, CHUNK_OP_POP, CHUNK_OP_RETURN);
+
+  COMPILE_ASSERT_SUCCESS("1 .. (2 .. 3);");
+  ASSERT_CONSTANT_INSTRUCTIONS(value_make_number(1), value_make_number(2), value_make_number(3));
+  ASSERT_OPCODES(CHUNK_OP_CONCATENATE, CHUNK_OP_CONCATENATE, CHUNK_OP_POP, CHUNK_OP_RETURN);
+}
+
+static void test_string_concatenation_chain_exceeding_operand_limit(void **const _) {
+  // UINT8_MAX + 1 operands; chain is split into N-ary concatenation of the last UINT8_MAX operands, and binary one
+  char source_code[(UINT8_MAX + 1) * 5];
+  for (int i = 0; i < UINT8_MAX; i++) memcpy(source_code + i * 5, "1 .. ", 5);
+  memcpy(source_code + UINT8_MAX * 5, "1;", 3);
+
+  COMPILE_ASSERT_SUCCESS(source_code);
+  for (int i = 0; i <= UINT8_MAX; i++) assert_constant_instruction(value_make_number(1));
+  ASSERT_OPCODES(CHUNK_OP_CONCATENATE_N, UINT8_MAX, CHUNK_OP_CONCATENATE, CHUNK_OP_POP, CHUNK_OP_RETURN);
+}
+
 static void test_print_stmt(void **const _) {
   COMPILE_ASSERT_UNEXPECTED_EOF("print");
   ASSERT_SYNTAX_ERROR(1, 6, "Expected expression");
@@ -441,6 +806,224 @@ static void test_print_stmt(void **const _) {
   ASSERT_OPCODES(CHUNK_OP_PRINT, CHUNK_OP_RETURN);
 }
 
+static void test_input_identifier(void **const _) {
+  // identifiers aren't expressions unless input slots are declared
+  COMPILE_ASSERT_FAILURE("a;");
+  ASSERT_SYNTAX_ERROR(1, 1, "Expected expression at 'a'");
+
+  char const *const input_names[] = {"a", "ab"};
+  VMConfig input_vm_config = vm.config;
+  input_vm_config.input_names = input_names;
+  input_vm_config.input_count = 2;
+  vm_recycle(&vm, &input_vm_config);
+
+  COMPILE_ASSERT_SUCCESS("print ab + a;");
+  ASSERT_OPCODES(CHUNK_OP_INPUT, 1, CHUNK_OP_INPUT, 0, CHUNK_OP_ADD, CHUNK_OP_PRINT, CHUNK_OP_RETURN);
+
+  COMPILE_ASSERT_FAILURE("b;");
+  ASSERT_SEMANTIC_ERROR(1, 1, "Undeclared input at 'b'");
+
+  input_vm_config.input_count = 0;
+  vm_recycle(&vm, &input_vm_config);
+}
+
+static void test_expression_compilation(void **const _) {
+  char const *const input_names[] = {"x"};
+  VMConfig input_vm_config = vm.config;
+  input_vm_config.input_names = input_names;
+  input_vm_config.input_count = 1;
+  vm_recycle(&vm, &input_vm_config);
+
+  chunk_reset(&chunk);
+  chunk_code_offset = 0;
+  chunk_constant_instruction_index = 0;
+  io_clear_file(vm.config.static_analysis_error_stream);
+  assert_int_equal(compiler_compile_expression(&vm, "-x * 2 > 1", &chunk), COMPILER_SUCCESS);
+  ASSERT_OPCODES(CHUNK_OP_INPUT, 0, CHUNK_OP_NEGATE);
+  assert_constant_instruction(value_make_number(2));
+  ASSERT_OPCODE(CHUNK_OP_MULTIPLY);
+  assert_constant_instruction(value_make_number(1));
+  ASSERT_OPCODES(CHUNK_OP_GREATER, CHUNK_OP_RETURN);
+
+  chunk_reset(&chunk);
+  assert_int_equal(compiler_compile_expression(&vm, "x;", &chunk), COMPILER_FAILURE);
+  ASSERT_SYNTAX_ERROR(1, 2, "Expected end of expression at ';'");
+
+  input_vm_config.input_count = 0;
+  vm_recycle(&vm, &input_vm_config);
+}
+
+static void test_deeply_nested_expr(void **const _) {
+  // nesting depth is limited only by available memory (it would overflow C call stack if compiled recursively)
+  int const nesting_depth = 1000000;
+  char *const source_code = malloc(nesting_depth * sizeof("nil .. (") + sizeof("nil;"));
+  if (source_code == NULL) ERROR_MEMORY_ERRNO();
+
+  memset(source_code, '(', nesting_depth);
+  memcpy(source_code + nesting_depth, "1", 1);
+  memset(source_code + nesting_depth + 1, ')', nesting_depth);
+  memcpy(source_code + nesting_depth * 2 + 1, ";", 2);
+  COMPILE_ASSERT_SUCCESS(source_code);
+  assert_constant_instruction(value_make_number(1));
+  ASSERT_OPCODES(CHUNK_OP_POP, CHUNK_OP_RETURN);
+
+  memset(source_code, '-', nesting_depth);
+  memcpy(source_code + nesting_depth, "1;", 3);
+  COMPILE_ASSERT_SUCCESS(source_code);
+  assert_constant_instruction(value_make_number(1));
+  for (int i = 0; i < nesting_depth; i++) ASSERT_OPCODE(CHUNK_OP_NEGATE);
+  ASSERT_OPCODES(CHUNK_OP_POP, CHUNK_OP_RETURN);
+
+  for (int i = 0; i < nesting_depth; i++) memcpy(source_code + i * 8, "nil .. (", 8);
+  memcpy(source_code + nesting_depth * 8, "nil", 3);
+  memset(source_code + nesting_depth * 8 + 3, ')', nesting_depth);
+  memcpy(source_code + nesting_depth * 9 + 3, ";", 2);
+  COMPILE_ASSERT_SUCCESS(source_code);
+  for (int i = 0; i < nesting_depth; i++) ASSERT_OPCODE(CHUNK_OP_NIL);
+  ASSERT_OPCODE(CHUNK_OP_NIL);
+  for (int i = 0; i < nesting_depth; i++) ASSERT_OPCODE(CHUNK_OP_CONCATENATE);
+  ASSERT_OPCODES(CHUNK_OP_POP, CHUNK_OP_RETURN);
+
+  // errors are reported at the same tokens as in shallow expressions
+  memset(source_code, '(', nesting_depth);
+  memcpy(source_code + nesting_depth, "1 +);", 6);
+  COMPILE_ASSERT_FAILURE(source_code);
+  ASSERT_SYNTAX_ERROR(1, nesting_depth + 4, "Expected expression at ')'");
+
+  free(source_code);
+}
+
+static void test_compiler_session(void **const _) {
+  ASSERT_COMPILER_SESSION_EQUIVALENCE("print 1;");
+  ASSERT_COMPILER_SESSION_EQUIVALENCE("print 1 +", "2;");
+  ASSERT_COMPILER_SESSION_EQUIVALENCE("1; print \"a\" .. 2; print (3", "", "+ 4", ");");
+  ASSERT_COMPILER_SESSION_EQUIVALENCE("print 1; print 2 +", "3 * 4; print", "5;");
+  ASSERT_COMPILER_SESSION_EQUIVALENCE("print 1; print 2 # comment;", "+ 3 # comment", ";");
+
+  // errors are reported at the same lines and columns, even within cut-off statements beginning mid-line
+  ASSERT_COMPILER_SESSION_EQUIVALENCE("print 1; print 2 +", "3 +;");
+  ASSERT_COMPILER_SESSION_EQUIVALENCE("print 1; print (2", "+ 3", ";");
+  ASSERT_COMPILER_SESSION_EQUIVALENCE("print 1; print", "@;");
+  ASSERT_COMPILER_SESSION_EQUIVALENCE("print 1; 2 +", "3", "+ 4 5;");
+}
+
+static void test_compiler_stream(void **const _) {
+  // blocks may end anywhere, e.g. within tokens, string literals, comments, and groupings
+  char const *const tricky_statements[] = {
+    "print \"a;\nb\" .. \"c\";\n", "# comment;\n", "print (1 +\n2);\n", "print 3; # trailing comment;\n",
+    "1 == 2;\n", "print 4;",
+  };
+  size_t const tricky_statement_count = sizeof(tricky_statements) / sizeof(tricky_statements[0]);
+
+  char source_code[1024] = "";
+  for (size_t i = 0; strlen(source_code) + 32 < sizeof(source_code); i++) {
+    strcat(source_code, tricky_statements[i % tricky_statement_count]);
+  }
+
+  for (size_t block_length = 1; block_length <= sizeof(source_code); block_length *= 3) {
+    assert_compiler_stream_equivalence(source_code, block_length);
+  }
+
+  // errors are reported at the same lines and columns
+  size_t const source_code_length = strlen(source_code);
+  strcpy(source_code + source_code_length / 2, "\nprint 1;\nprint -\"a\";\nprint 2;\n");
+  assert_compiler_stream_equivalence(source_code, 7);
+  strcpy(source_code + source_code_length / 2, "\nprint 1;\nprint ;\n1 +;\n");
+  assert_compiler_stream_equivalence(source_code, 7);
+  strcpy(source_code + source_code_length / 2, "\nprint 1;\nprint \"unterminated;\n1;\n");
+  assert_compiler_stream_equivalence(source_code, 7);
+  strcpy(source_code + source_code_length / 2, "\nprint 1;\nprint (2 +\n");
+  assert_compiler_stream_equivalence(source_code, 7);
+
+  // token following failing statement is read ahead (reporting it if it's a lexical error), even if it arrives later
+  for (size_t block_length = 1; block_length <= 8; block_length++) {
+    assert_compiler_stream_equivalence("print 1;\nprint ;@\n", block_length);
+    assert_compiler_stream_equivalence("print 1;\nprint ; # comment\n\"unterminated\n", block_length);
+  }
+}
+
+static void test_compiler_stream_compiling_statements_mid_line(void **const _) {
+  // statements get compiled as soon as ';' terminating them arrives, even if their line goes on (e.g. minified code)
+  chunk_reset(&chunk);
+  chunk_code_offset = 0;
+  chunk_constant_instruction_index = 0;
+  io_clear_file(vm.config.static_analysis_error_stream);
+
+  CompilerStream stream;
+  compiler_stream_init(&stream, &vm, &chunk);
+
+  assert_int_equal(compiler_stream_feed(&stream, "print 1; print (2;", 18), COMPILER_SUCCESS);
+  ASSERT_CONSTANT_INSTRUCTIONS(value_make_number(1));
+  ASSERT_OPCODES(CHUNK_OP_PRINT, CHUNK_OP_RETURN);
+
+  // statement cut off within grouping is compiled once grouping closes (reporting errors at their original columns)
+  chunk_reset(&chunk);
+  chunk_code_offset = 0;
+  assert_int_equal(compiler_stream_feed(&stream, "); print \"", 10), COMPILER_FAILURE);
+  ASSERT_SYNTAX_ERROR(1, 18, "Expected ')' closing grouping expression at ';'");
+
+  compiler_stream_destroy(&stream);
+}
+
+static void test_parallel_compilation(void **const _) {
+  // statement boundaries have to be found outside of string literals, comments, and groupings
+  char const *const tricky_statements[] = {
+    "print \"a;\nb\" .. \"c\";\n", "# comment;\n", "print (1 +\n2);\n", "print 3; # trailing comment;\n",
+    "1 == 2;\n",
+  };
+  size_t const tricky_statement_count = sizeof(tricky_statements) / sizeof(tricky_statements[0]);
+
+  char source_code[4096] = "";
+  for (size_t i = 0; strlen(source_code) + 32 < sizeof(source_code); i++) {
+    strcat(source_code, tricky_statements[i % tricky_statement_count]);
+  }
+
+  for (int max_segment_count = 1; max_segment_count <= 64; max_segment_count *= 4) {
+    assert_parallel_compilation_equivalence(source_code, max_segment_count);
+  }
+
+  // only the first static analysis error is reported, regardless of segment it resides in
+  size_t const source_code_length = strlen(source_code);
+  strcpy(source_code + source_code_length / 2, "print ;\n1 +;\n");
+  assert_parallel_compilation_equivalence(source_code, 16);
+  strcpy(source_code + source_code_length / 2, "print 1;\nprint \"unterminated;\n1;\n");
+  assert_parallel_compilation_equivalence(source_code, 16);
+}
+
+static void test_concurrent_vms(void **const _) {
+#ifndef _WIN32
+  ConcurrentVMRun runs[CONCURRENT_VM_COUNT];
+  pthread_t threads[CONCURRENT_VM_COUNT];
+
+  for (int i = 0; i < CONCURRENT_VM_COUNT; i++) {
+    runs[i] = (ConcurrentVMRun){.index = i};
+    assert_int_equal(pthread_create(&threads[i], NULL, perform_concurrent_vm_run, &runs[i]), 0);
+  }
+  for (int i = 0; i < CONCURRENT_VM_COUNT; i++) assert_int_equal(pthread_join(threads[i], NULL), 0);
+
+  for (int i = 0; i < CONCURRENT_VM_COUNT; i++) {
+    char expected_output[64];
+    snprintf(expected_output, sizeof(expected_output), "vm %d: true\ntrue\n", i);
+
+    assert_true(runs[i].is_successful);
+    assert_string_equal(runs[i].source_program_output, expected_output);
+
+    free(runs[i].source_program_output);
+  }
+#endif
+}
+
+static void test_pipelined_compilation(void **const _) {
+  assert_pipelined_compilation(NULL);
+
+  // object allocator isn't thread-safe, hence batches get compiled by thread taking them
+  MemoryArena object_arena;
+  memory_arena_init(&object_arena, 4096, memory_manage);
+  MemoryAllocator const object_allocator = memory_arena_make_allocator(&object_arena);
+  assert_pipelined_compilation(&object_allocator);
+  memory_arena_destroy(&object_arena);
+}
+
 int main(void) {
   struct CMUnitTest const tests[] = {
     cmocka_unit_test(test_lexical_error_reporting),
@@ -451,6 +1034,7 @@ int main(void) {
     cmocka_unit_test(test_numeric_literal),
     cmocka_unit_test(test_string_literal),
     cmocka_unit_test(test_OP_CONSTANT_2B_being_generated),
+    cmocka_unit_test(test_constant_pool_overflow),
     cmocka_unit_test(test_arithmetic_operators),
     cmocka_unit_test(test_arithmetic_operator_associativity),
     cmocka_unit_test(test_arithmetic_operator_precedence),
@@ -460,7 +1044,18 @@ int main(void) {
     cmocka_unit_test(test_relational_operator_associativity),
     cmocka_unit_test(test_relational_operator_precedence),
     cmocka_unit_test(test_string_concatenation_operator),
+    cmocka_unit_test(test_string_concatenation_chain),
+    cmocka_unit_test(test_string_concatenation_chain_exceeding_operand_limit),
     cmocka_unit_test(test_print_stmt),
+    cmocka_unit_test(test_input_identifier),
+    cmocka_unit_test(test_expression_compilation),
+    cmocka_unit_test(test_deeply_nested_expr),
+    cmocka_unit_test(test_compiler_session),
+    cmocka_unit_test(test_compiler_stream),
+    cmocka_unit_test(test_compiler_stream_compiling_statements_mid_line),
+    cmocka_unit_test(test_parallel_compilation),
+    cmocka_unit_test(test_concurrent_vms),
+    cmocka_unit_test(test_pipelined_compilation),
   };
 
   return cmocka_run_group_tests(tests, setup_test_group_env, teardown_test_group_env);
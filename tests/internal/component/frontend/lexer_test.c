@@ -51,6 +51,30 @@ static inline void init_SCAN_ASSERT_EOF(char const *const lexeme) {
   SCAN_ASSERT_EOF();
 }
 
+/// Assert that tokenizing `source_code` into token buffer yields the same tokens as scanning it one by one.
+static void tokenize_assert_scan_equivalence(char const *const source_code) {
+  LexerTokenBuffer buffer;
+  lexer_tokenize(source_code, __FILE__, 1, 1, &buffer);
+
+  // retrieve tokens backwards first (line computation handles moving back and forth)
+  for (int32_t i = lexer_token_buffer_get_count(&buffer) - 1; i >= 0; i--) lexer_token_buffer_get_token(&buffer, i);
+
+  lexer_init(source_code);
+  for (int32_t i = 0; i < lexer_token_buffer_get_count(&buffer); i++) {
+    LexerToken const expected_token = lexer_scan();
+    LexerToken const token = lexer_token_buffer_get_token(&buffer, i);
+
+    assert_int_equal(token.type, expected_token.type);
+    assert_int_equal(lexer_token_buffer_get_type(&buffer, i), expected_token.type);
+    assert_position(token, expected_token.line, expected_token.column);
+    assert_int_equal(token.lexeme_length, expected_token.lexeme_length);
+    assert_memory_equal(token.lexeme, expected_token.lexeme, expected_token.lexeme_length);
+  }
+  assert_int_equal(lexer_token_buffer_get_type(&buffer, lexer_token_buffer_get_count(&buffer) - 1), LEXER_TOKEN_EOF);
+
+  lexer_token_buffer_destroy(&buffer);
+}
+
 static inline void init_scan_assert_error(char const *const source_code, char const *const error_lexeme) {
   lexer_init(source_code);
   scan_assert(LEXER_TOKEN_ERROR, error_lexeme);
@@ -111,6 +135,32 @@ static void test_position_tracking(void **const _) {
   lexer_init("1 \n 2"), assert_position(lexer_scan(), 1, 1), assert_position(lexer_scan(), 2, 2);
 }
 
+static void test_position_tracking_across_long_runs(void **const _) {
+  // runs exceeding vectorized scanning width
+  lexer_init("                                        +"), assert_position(lexer_scan(), 1, 41);
+  lexer_init("\n \t\r\n                    \n\n                 \n     +"), assert_position(lexer_scan(), 6, 6);
+  lexer_init("  \n                                    \n                                     +"),
+    assert_position(lexer_scan(), 3, 38);
+  lexer_init("# comment exceeding vectorized scanning width...\n     +"), assert_position(lexer_scan(), 2, 6);
+  lexer_init("# \"comment\" exceeding vectorized scanning width...                                +"),
+    SCAN_ASSERT_ALL_EOF(1, 84);
+
+  // string literal tracks lines without resetting column
+  lexer_init("\"string literal\nexceeding\nvectorized\nscanning width...\" +");
+  scan_assert_all(LEXER_TOKEN_STRING, "\"string literal\nexceeding\nvectorized\nscanning width...\"", 4, 1);
+  scan_assert_all(LEXER_TOKEN_PLUS, "+", 4, 57);
+  lexer_init("  \"unterminated string literal exceeding\n\nvectorized scanning width");
+  scan_assert_all(LEXER_TOKEN_ERROR, "Unterminated string literal", 3, 3);
+}
+
+static void test_token_buffer(void **const _) {
+  tokenize_assert_scan_equivalence("");
+  tokenize_assert_scan_equivalence("  \n\t # comment");
+  tokenize_assert_scan_equivalence("print 1 + 2;\nprint \"multi\nline\" .. \"string\";\n  -3.5 >= 2 # comment\n");
+  tokenize_assert_scan_equivalence("\"one\ntwo\" + \"three\nfour\"\n\n  @ \"five\nsix\n\" $ +");
+  tokenize_assert_scan_equivalence("\n  ^ (1 + &) ~\n \"unterminated string literal\nspanning lines");
+}
+
 static void test_string_literal(void **const _) {
   init_scan_assert("\"abc\"", LEXER_TOKEN_STRING);
   init_scan_assert_error("\"abc", "Unterminated string literal");
@@ -151,6 +201,15 @@ static void test_identifier_literal(void **const _) {
   init_scan_assert("name_123", LEXER_TOKEN_IDENTIFIER);
   init_scan_assert("name123", LEXER_TOKEN_IDENTIFIER);
   init_scan_assert("abcdefghijklmnopqrstuvwxyzABCDEFGHIJKLMNOPQRSTUVWXYZ1234567890_", LEXER_TOKEN_IDENTIFIER);
+
+  // identifiers resembling keywords (sharing their length, first and last characters)
+  init_scan_assert("aid", LEXER_TOKEN_IDENTIFIER);
+  init_scan_assert("thus", LEXER_TOKEN_IDENTIFIER);
+  init_scan_assert("fir", LEXER_TOKEN_IDENTIFIER);
+  init_scan_assert("pivot", LEXER_TOKEN_IDENTIFIER);
+  init_scan_assert("f", LEXER_TOKEN_IDENTIFIER);
+  init_scan_assert("printer", LEXER_TOKEN_IDENTIFIER);
+  init_scan_assert("True", LEXER_TOKEN_IDENTIFIER);
 }
 
 static void test_single_char_tokens(void **const _) {
@@ -291,6 +350,8 @@ int main(void) {
     cmocka_unit_test(test_whitespace),
     cmocka_unit_test(test_unexpected_char),
     cmocka_unit_test(test_position_tracking),
+    cmocka_unit_test(test_position_tracking_across_long_runs),
+    cmocka_unit_test(test_token_buffer),
     cmocka_unit_test(test_string_literal),
     cmocka_unit_test(test_numeric_literal),
     cmocka_unit_test(test_identifier_literal),
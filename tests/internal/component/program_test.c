@@ -0,0 +1,308 @@
+#include "program.h"
+
+#include "backend/object.h"
+#include "backend/vm.h"
+#include "common.h"
+#include "component/component_test.h"
+#include "utils/error.h"
+#include "utils/memory.h"
+#include "utils/memory_arena.h"
+
+#include <stdbool.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#ifndef _WIN32
+#include <pthread.h>
+#endif
+
+// *---------------------------------------------*
+// *              MACRO DEFINITIONS              *
+// *---------------------------------------------*
+
+/// Program exercising string interning; concatenation result has to be identical to the equal string constant.
+#define STRING_PROGRAM "print \"a\" .. \"b\" == \"ab\";\nprint \"ab\";\n"
+#define STRING_PROGRAM_OUTPUT "true\nab\n"
+
+#define CONCURRENT_EXECUTION_THREAD_COUNT 8
+#define CONCURRENT_EXECUTION_COUNT 1000
+
+// *---------------------------------------------*
+// *              TYPE DEFINITIONS               *
+// *---------------------------------------------*
+
+/// Repeated program execution by its own VM, concurrent with other such executions.
+typedef struct {
+  Program const *program;
+  bool is_successful;
+} ConcurrentProgramExecution;
+
+// *---------------------------------------------*
+// *          INTERNAL-LINKAGE OBJECTS           *
+// *---------------------------------------------*
+
+static ProgramConfig program_config;
+static VMConfig vm_config;
+static VM vm;
+
+// *---------------------------------------------*
+// *         INTERNAL-LINKAGE FUNCTIONS          *
+// *---------------------------------------------*
+
+/// Compile `source_code` into program, asserting compilation success.
+/// @return Compiled program.
+static Program *compile(char const *const source_code) {
+  Program *program;
+  assert_true(program_compile(&program_config, source_code, &program));
+  assert_non_null(program);
+
+  return program;
+}
+
+#ifndef _WIN32
+/// Execute `execution_ptr` program CONCURRENT_EXECUTION_COUNT times by dedicated VM (discarding its output).
+/// @return NULL (signature conforms to pthread start routine).
+static void *perform_concurrent_program_execution(void *const execution_ptr) {
+  ConcurrentProgramExecution *const execution = execution_ptr;
+
+  VMConfig execution_vm_config = vm_config;
+  execution_vm_config.source_program_output_stream = tmpfile();
+  if (execution_vm_config.source_program_output_stream == NULL) ERROR_IO_ERRNO();
+
+  VM execution_vm;
+  vm_init(&execution_vm, &execution_vm_config);
+
+  execution->is_successful = true;
+  for (int i = 0; i < CONCURRENT_EXECUTION_COUNT; i++) {
+    execution->is_successful &= program_execute(execution->program, &execution_vm);
+  }
+
+  vm_destroy(&execution_vm);
+  if (fclose(execution_vm_config.source_program_output_stream)) ERROR_IO_ERRNO();
+
+  return NULL;
+}
+#endif
+
+// *---------------------------------------------*
+// *                  FIXTURES                   *
+// *---------------------------------------------*
+
+static int setup_test_case_env(void **const _) {
+  vm_config = (VMConfig){
+    .source_file_path = __FILE__,
+    .static_analysis_error_stream = tmpfile(),
+    .bytecode_execution_error_stream = tmpfile(),
+    .source_program_output_stream = tmpfile(),
+    .memory_manager = memory_manage,
+  };
+  if (vm_config.static_analysis_error_stream == NULL) ERROR_IO_ERRNO();
+  if (vm_config.bytecode_execution_error_stream == NULL) ERROR_IO_ERRNO();
+  if (vm_config.source_program_output_stream == NULL) ERROR_IO_ERRNO();
+
+  vm_init(&vm, &vm_config);
+
+  program_config = (ProgramConfig){
+    .source_file_path = vm_config.source_file_path,
+    .static_analysis_error_stream = vm_config.static_analysis_error_stream,
+    .bytecode_execution_error_stream = vm_config.bytecode_execution_error_stream,
+    .source_program_output_stream = vm_config.source_program_output_stream,
+  };
+
+  return 0;
+}
+
+static int teardown_test_case_env(void **const _) {
+  vm_destroy(&vm);
+
+  if (fclose(vm_config.static_analysis_error_stream)) ERROR_IO_ERRNO();
+  if (fclose(vm_config.bytecode_execution_error_stream)) ERROR_IO_ERRNO();
+  if (fclose(vm_config.source_program_output_stream)) ERROR_IO_ERRNO();
+
+  return 0;
+}
+
+// *---------------------------------------------*
+// *                 TEST CASES                  *
+// *---------------------------------------------*
+
+static void test_repeated_execution(void **const _) {
+  Program *const program = compile(STRING_PROGRAM);
+
+  for (int i = 0; i < 3; i++) assert_true(program_execute(program, &vm));
+  component_test_assert_file_content(
+    vm_config.source_program_output_stream, STRING_PROGRAM_OUTPUT STRING_PROGRAM_OUTPUT STRING_PROGRAM_OUTPUT
+  );
+
+  // reset VM doesn't retain program strings, so they get interned again
+  vm_reset(&vm);
+  assert_true(program_execute(program, &vm));
+
+  vm_reset(&vm);
+  program_destroy(program);
+}
+
+static void test_execution_by_vm_with_interned_strings(void **const _) {
+  // strings made by VM precede equal program strings
+  object_make_owning_string(&vm, "ab", 2);
+  object_make_owning_string(&vm, "b", 1);
+
+  Program *const program = compile(STRING_PROGRAM);
+  assert_true(program_execute(program, &vm));
+  assert_true(program_execute(program, &vm));
+  component_test_assert_file_content(
+    vm_config.source_program_output_stream, STRING_PROGRAM_OUTPUT STRING_PROGRAM_OUTPUT
+  );
+
+  vm_reset(&vm);
+  program_destroy(program);
+}
+
+static void test_compilation_failure(void **const _) {
+  Program *program;
+  assert_false(program_compile(&program_config, "print 1;\nprint ;", &program));
+  assert_null(program);
+  component_test_assert_file_content(
+    vm_config.static_analysis_error_stream,
+    "[SYNTAX_ERROR]" COMMON_MS __FILE__ COMMON_PS "2" COMMON_PS "7" COMMON_MS "Expected expression at ';'\n"
+  );
+}
+
+static void test_compiler_limit_failure(void **const _) {
+  // exceeded compiler limits are reported as static analysis errors, rather than terminating host process
+  char out_of_range_literal[402] = "1";
+  memset(out_of_range_literal + 1, '0', 400);
+
+  char source_code[sizeof(out_of_range_literal) + 16];
+  sprintf(source_code, "print %s;", out_of_range_literal);
+
+  char expected_error[sizeof(out_of_range_literal) + sizeof(__FILE__) + 64];
+  sprintf(
+    expected_error,
+    "[SEMANTIC_ERROR]" COMMON_MS __FILE__ COMMON_PS "1" COMMON_PS "7" COMMON_MS
+    "Out-of-range numeric literal at '%s'\n",
+    out_of_range_literal
+  );
+
+  Program *program;
+  assert_false(program_compile(&program_config, source_code, &program));
+  assert_null(program);
+  component_test_assert_file_content(vm_config.static_analysis_error_stream, expected_error);
+}
+
+static void test_vm_lifecycle(void **const _) {
+  Program *const program = compile(STRING_PROGRAM);
+  VM *const program_vm = program_vm_create(&program_config);
+
+  assert_true(program_execute(program, program_vm));
+  program_vm_reset(program_vm);
+  assert_true(program_execute(program, program_vm));
+  component_test_assert_file_content(
+    vm_config.source_program_output_stream, STRING_PROGRAM_OUTPUT STRING_PROGRAM_OUTPUT
+  );
+
+  program_vm_destroy(program_vm);
+  program_destroy(program);
+}
+
+static void test_vm_with_object_allocator(void **const _) {
+  MemoryArena object_arena;
+  memory_arena_init(&object_arena, 64, memory_manage);
+  MemoryAllocator const object_allocator = memory_arena_make_allocator(&object_arena);
+  program_config.object_allocator = &object_allocator;
+
+  Program *const program = compile("print \"a\" .. 1;\n");
+  assert_null(object_arena.first_block);
+
+  // objects made by program VM are allocated from arena
+  VM *const program_vm = program_vm_create(&program_config);
+  assert_true(program_execute(program, program_vm));
+  assert_non_null(object_arena.first_block);
+  unsigned char const *const allocated_cursor = object_arena.cursor;
+
+  // reset releases them by resetting arena, while program strings (owned by program) remain intact
+  program_vm_reset(program_vm);
+  assert_ptr_not_equal(object_arena.cursor, allocated_cursor);
+  assert_true(program_execute(program, program_vm));
+  assert_ptr_equal(object_arena.cursor, allocated_cursor);
+  component_test_assert_file_content(vm_config.source_program_output_stream, "a1\na1\n");
+
+  program_vm_destroy(program_vm);
+  program_destroy(program);
+  memory_arena_destroy(&object_arena);
+}
+
+static void test_execution_failure(void **const _) {
+  Program *const program = compile("print 1;\nprint -\"a\";\n");
+
+  assert_false(program_execute(program, &vm));
+  component_test_assert_file_content(vm_config.source_program_output_stream, "1\n");
+  component_test_assert_file_content(
+    vm_config.bytecode_execution_error_stream,
+    "[EXECUTION_ERROR]" COMMON_MS __FILE__ COMMON_PS "2" COMMON_MS
+    "Expected negation operand to be a number (got 'string')\n"
+  );
+
+  vm_reset(&vm);
+  program_destroy(program);
+}
+
+static void test_execution_with_inputs(void **const _) {
+  char const *const input_names[] = {"x", "y"};
+  program_config.input_names = input_names;
+  program_config.input_count = 2;
+  Program *const program = compile("print x;\nprint x + y;\n");
+  VM *const program_vm = program_vm_create(&program_config);
+
+  assert_true(program_execute_with_inputs(program, program_vm, (double const[]){1, 2}));
+  assert_true(program_execute_with_inputs(program, program_vm, (double const[]){3, 4}));
+  component_test_assert_file_content(vm_config.source_program_output_stream, "1\n3\n3\n7\n");
+
+  // inputs that aren't supplied are nil
+  assert_false(program_execute(program, program_vm));
+  component_test_assert_file_content(vm_config.source_program_output_stream, "1\n3\n3\n7\nnil\n");
+  component_test_assert_file_content(
+    vm_config.bytecode_execution_error_stream,
+    "[EXECUTION_ERROR]" COMMON_MS __FILE__ COMMON_PS "2" COMMON_MS
+    "Expected addition operands to be numbers (got 'nil' and 'nil')\n"
+  );
+
+  program_vm_destroy(program_vm);
+  program_destroy(program);
+}
+
+static void test_concurrent_execution(void **const _) {
+#ifndef _WIN32
+  Program *const program = compile(STRING_PROGRAM);
+  ConcurrentProgramExecution executions[CONCURRENT_EXECUTION_THREAD_COUNT];
+  pthread_t threads[CONCURRENT_EXECUTION_THREAD_COUNT];
+
+  for (int i = 0; i < CONCURRENT_EXECUTION_THREAD_COUNT; i++) {
+    executions[i] = (ConcurrentProgramExecution){.program = program};
+    assert_int_equal(pthread_create(&threads[i], NULL, perform_concurrent_program_execution, &executions[i]), 0);
+  }
+  for (int i = 0; i < CONCURRENT_EXECUTION_THREAD_COUNT; i++) assert_int_equal(pthread_join(threads[i], NULL), 0);
+  for (int i = 0; i < CONCURRENT_EXECUTION_THREAD_COUNT; i++) assert_true(executions[i].is_successful);
+
+  program_destroy(program);
+#endif
+}
+
+int main(void) {
+  struct CMUnitTest const tests[] = {
+    cmocka_unit_test_setup_teardown(test_repeated_execution, setup_test_case_env, teardown_test_case_env),
+    cmocka_unit_test_setup_teardown(
+      test_execution_by_vm_with_interned_strings, setup_test_case_env, teardown_test_case_env
+    ),
+    cmocka_unit_test_setup_teardown(test_compilation_failure, setup_test_case_env, teardown_test_case_env),
+    cmocka_unit_test_setup_teardown(test_compiler_limit_failure, setup_test_case_env, teardown_test_case_env),
+    cmocka_unit_test_setup_teardown(test_vm_lifecycle, setup_test_case_env, teardown_test_case_env),
+    cmocka_unit_test_setup_teardown(test_vm_with_object_allocator, setup_test_case_env, teardown_test_case_env),
+    cmocka_unit_test_setup_teardown(test_execution_failure, setup_test_case_env, teardown_test_case_env),
+    cmocka_unit_test_setup_teardown(test_execution_with_inputs, setup_test_case_env, teardown_test_case_env),
+    cmocka_unit_test_setup_teardown(test_concurrent_execution, setup_test_case_env, teardown_test_case_env),
+  };
+
+  return cmocka_run_group_tests(tests, NULL, NULL);
+}
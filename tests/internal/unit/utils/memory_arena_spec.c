@@ -0,0 +1,130 @@
+#include "unit/unit_test.h"
+#include "utils/memory.h"
+#include "utils/memory_arena.h"
+
+#include <stdint.h>
+#include <stdlib.h>
+#include <string.h>
+
+// *---------------------------------------------*
+// *              MACRO DEFINITIONS              *
+// *---------------------------------------------*
+
+#define BLOCK_SIZE 256
+
+// *---------------------------------------------*
+// *                  FIXTURES                   *
+// *---------------------------------------------*
+
+static int setup_arena(void **const arena_ptr) {
+  MemoryArena *const arena = malloc(sizeof(*arena));
+  if (arena == NULL) return -1;
+  memory_arena_init(arena, BLOCK_SIZE, memory_manage);
+
+  *arena_ptr = arena;
+  return 0;
+}
+
+static int teardown_arena(void **const arena_ptr) {
+  memory_arena_destroy(*arena_ptr);
+  free(*arena_ptr);
+
+  return 0;
+}
+
+// *---------------------------------------------*
+// *                 TEST CASES                  *
+// *---------------------------------------------*
+
+static void manage__allocates_aligned_non_overlapping_objects(void **const arena) {
+  unsigned char *const first_object = memory_arena_manage(*arena, NULL, 0, 3);
+  unsigned char *const second_object = memory_arena_manage(*arena, NULL, 0, 5);
+  memset(first_object, 1, 3);
+  memset(second_object, 2, 5);
+
+  assert_int_equal((uintptr_t)first_object % MEMORY_ARENA_ALIGNMENT, 0);
+  assert_int_equal((uintptr_t)second_object % MEMORY_ARENA_ALIGNMENT, 0);
+  assert_true(second_object >= first_object + 3);
+  assert_int_equal(first_object[2], 1);
+}
+
+static void manage__allocates_objects_exceeding_block_size(void **const arena) {
+  unsigned char *const large_object = memory_arena_manage(*arena, NULL, 0, BLOCK_SIZE * 3);
+  memset(large_object, 1, BLOCK_SIZE * 3);
+  unsigned char *const small_object = memory_arena_manage(*arena, NULL, 0, 1);
+  *small_object = 2;
+
+  assert_int_equal(large_object[BLOCK_SIZE * 3 - 1], 1);
+}
+
+static void manage__resizes_the_most_recent_object_in_place(void **const arena) {
+  unsigned char *const object = memory_arena_manage(*arena, NULL, 0, 8);
+  memset(object, 1, 8);
+
+  unsigned char *const expanded_object = memory_arena_manage(*arena, object, 8, 64);
+  unsigned char *const next_object = memory_arena_manage(*arena, NULL, 0, 8);
+
+  assert_ptr_equal(expanded_object, object);
+  assert_true(next_object >= object + 64);
+}
+
+static void manage__moves_expanded_objects_preserving_their_content(void **const arena) {
+  unsigned char *const object = memory_arena_manage(*arena, NULL, 0, 8);
+  memset(object, 1, 8);
+  memory_arena_manage(*arena, NULL, 0, 8);
+
+  unsigned char *const expanded_object = memory_arena_manage(*arena, object, 8, BLOCK_SIZE);
+
+  assert_ptr_not_equal(expanded_object, object);
+  for (int i = 0; i < 8; i++) assert_int_equal(expanded_object[i], 1);
+}
+
+static void manage__reuses_memory_of_deallocated_most_recent_object(void **const arena) {
+  void *const object = memory_arena_manage(*arena, NULL, 0, 16);
+
+  assert_null(memory_arena_manage(*arena, object, 16, 0));
+  void *const next_object = memory_arena_manage(*arena, NULL, 0, 16);
+
+  assert_ptr_equal(next_object, object);
+}
+
+static void reset__releases_every_object_reusing_retained_blocks(void **const arena) {
+  void *const first_object = memory_arena_manage(*arena, NULL, 0, 16);
+  for (int i = 0; i < 16; i++) memory_arena_manage(*arena, NULL, 0, BLOCK_SIZE / 2);
+  MemoryArenaBlock *const last_block = ((MemoryArena *)*arena)->current_block;
+
+  memory_arena_reset(*arena);
+  void *const reallocated_object = memory_arena_manage(*arena, NULL, 0, 16);
+  for (int i = 0; i < 16; i++) memory_arena_manage(*arena, NULL, 0, BLOCK_SIZE / 2);
+
+  assert_ptr_equal(reallocated_object, first_object);
+  assert_ptr_equal(((MemoryArena *)*arena)->current_block, last_block);
+}
+
+static void make_allocator__makes_allocator_backed_by_arena(void **const arena) {
+  MemoryAllocator const allocator = memory_arena_make_allocator(*arena);
+
+  void *const object = allocator.manage(allocator.context, NULL, 0, 16);
+  allocator.reset(allocator.context);
+
+  assert_ptr_equal(allocator.context, *arena);
+  assert_ptr_equal(memory_arena_manage(*arena, NULL, 0, 16), object);
+}
+
+int main(void) {
+  struct CMUnitTest const tests[] = {
+    cmocka_unit_test_setup_teardown(manage__allocates_aligned_non_overlapping_objects, setup_arena, teardown_arena),
+    cmocka_unit_test_setup_teardown(manage__allocates_objects_exceeding_block_size, setup_arena, teardown_arena),
+    cmocka_unit_test_setup_teardown(manage__resizes_the_most_recent_object_in_place, setup_arena, teardown_arena),
+    cmocka_unit_test_setup_teardown(
+      manage__moves_expanded_objects_preserving_their_content, setup_arena, teardown_arena
+    ),
+    cmocka_unit_test_setup_teardown(
+      manage__reuses_memory_of_deallocated_most_recent_object, setup_arena, teardown_arena
+    ),
+    cmocka_unit_test_setup_teardown(reset__releases_every_object_reusing_retained_blocks, setup_arena, teardown_arena),
+    cmocka_unit_test_setup_teardown(make_allocator__makes_allocator_backed_by_arena, setup_arena, teardown_arena),
+  };
+
+  return cmocka_run_group_tests(tests, NULL, NULL);
+}
@@ -0,0 +1 @@
+${unit_test_mk_target_prefix}/utils/memory_arena_spec: $(addprefix ${unit_test_mk_prerequisite_prefix}/utils/,memory_arena.o memory.o)
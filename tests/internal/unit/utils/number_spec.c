@@ -1,7 +1,11 @@
 #include "unit/unit_test.h"
 #include "utils/number.h"
 
+#include <float.h>
 #include <math.h>
+#include <stdint.h>
+#include <stdlib.h>
+#include <string.h>
 
 // *---------------------------------------------*
 // *                 TEST CASES                  *
@@ -51,12 +55,173 @@ static void number_is_integer__returns_false_for_nan(void **const _) {
   assert_false(nan_result);
 }
 
+static void number_to_string__formats_shortest_round_trip_representation(void **const _) {
+  typedef struct {
+    double input_number;
+    char *expected_str;
+  } TestCase;
+
+  TestCase const test_cases[] = {
+    // integers
+    {0, "0"},
+    {-0.0, "-0"},
+    {123, "123"},
+    {-987654, "-987654"},
+    {1234567, "1234567"},
+    {9007199254740991, "9007199254740991"},
+    {1e20, "100000000000000000000"},
+
+    // fractions
+    {0.5, "0.5"},
+    {-0.001, "-0.001"},
+    {123.456, "123.456"},
+    {0.1 + 0.2, "0.30000000000000004"},
+    {1.0 / 3, "0.3333333333333333"},
+    {0.000001, "0.000001"},
+
+    // exponential notation
+    {1e21, "1e+21"},
+    {1.5e300, "1.5e+300"},
+    {1e-7, "1e-7"},
+    {-1.2345e-7, "-1.2345e-7"},
+    {DBL_MAX, "1.7976931348623157e+308"},
+    {DBL_MIN, "2.2250738585072014e-308"},
+    {5e-324, "5e-324"},
+
+    // non-finite numbers
+    {INFINITY, "inf"},
+    {-INFINITY, "-inf"},
+    {NAN, "nan"},
+  };
+
+  for (size_t i = 0; i < sizeof(test_cases) / sizeof(test_cases[0]); i++) {
+    TestCase const test_case = test_cases[i];
+    char result_str[NUMBER_STRING_MAX_SIZE];
+
+    int const result_length = number_to_string(test_case.input_number, result_str);
+
+    assert_string_equal(result_str, test_case.expected_str);
+    assert_int_equal(result_length, strlen(test_case.expected_str));
+  }
+}
+
+static void number_to_string__round_trips(void **const _) {
+  uint64_t bits = 0x9E3779B97F4A7C15u;
+
+  for (int i = 0; i < 100000; i++) {
+    // xorshift64 pseudo-random bit patterns cover the whole double range
+    bits ^= bits << 13;
+    bits ^= bits >> 7;
+    bits ^= bits << 17;
+
+    double number;
+    memcpy(&number, &bits, sizeof(number));
+    if (isnan(number)) continue;
+    char result_str[NUMBER_STRING_MAX_SIZE];
+
+    number_to_string(number, result_str);
+
+    assert_true(strtod(result_str, NULL) == number);
+  }
+}
+
+static void number_parse__parses_decimal_numbers(void **const _) {
+  typedef struct {
+    char *input_str;
+    double expected_number;
+  } TestCase;
+
+  TestCase const test_cases[] = {
+    {"0", 0},
+    {"000", 0},
+    {"0.000", 0},
+    {"7", 7},
+    {"123.456", 123.456},
+    {"0.1", 0.1},
+    {"0.30000000000000004", 0.1 + 0.2},
+    {"9007199254740993", 9007199254740992}, // halfway case rounds to even
+    {"123456789012345678901234567890", 123456789012345678901234567890.0},
+    {"2.2250738585072014", 2.2250738585072014},
+    {"179769313486231570000000000000000000000000000000000000000000000000000000000000000000000000000000000000000000"
+     "000000000000000000000000000000000000000000000000000000000000000000000000000000000000000000000000000000000000"
+     "000000000000000000000000000000000000000000000000000000000000000000000000000000000000000000000",
+     DBL_MAX},
+  };
+
+  for (size_t i = 0; i < sizeof(test_cases) / sizeof(test_cases[0]); i++) {
+    TestCase const test_case = test_cases[i];
+    double result;
+
+    bool const is_within_range = number_parse(test_case.input_str, strlen(test_case.input_str), &result);
+
+    assert_true(is_within_range);
+    assert_true(result == test_case.expected_number);
+  }
+}
+
+static void number_parse__respects_string_length(void **const _) {
+  char const *const str = "12.5..3";
+  double result;
+
+  bool const is_within_range = number_parse(str, 4, &result);
+
+  assert_true(is_within_range);
+  assert_true(result == 12.5);
+}
+
+static void number_parse__returns_false_for_out_of_range_numbers(void **const _) {
+  char str[400];
+  memset(str, '0', sizeof(str));
+  str[0] = '1';
+  double result;
+
+  bool const is_within_range = number_parse(str, sizeof(str), &result); // 1e399
+
+  assert_false(is_within_range);
+}
+
+static void number_parse__is_bit_exact_with_strtod(void **const _) {
+  uint64_t bits = 0x9E3779B97F4A7C15u;
+
+  for (int i = 0; i < 100000; i++) {
+    // xorshift64 pseudo-random digits
+    bits ^= bits << 13;
+    bits ^= bits >> 7;
+    bits ^= bits << 17;
+
+    char str[64];
+    int const integral_digit_count = 1 + bits % 24;
+    int const fractional_digit_count = (bits >> 8) % 24;
+    int length = 0;
+
+    uint64_t digit_bits = bits;
+    for (int j = 0; j < integral_digit_count + fractional_digit_count; j++) {
+      if (j == integral_digit_count) str[length++] = '.';
+      str[length++] = '0' + digit_bits % 10;
+      digit_bits = digit_bits / 10 == 0 ? bits ^ (uint64_t)j * 0x9E3779B97F4A7C15u : digit_bits / 10;
+    }
+    str[length] = '\0';
+    double result;
+
+    bool const is_within_range = number_parse(str, length, &result);
+
+    assert_true(is_within_range);
+    assert_memory_equal(&result, &(double){strtod(str, NULL)}, sizeof(result));
+  }
+}
+
 int main(void) {
   struct CMUnitTest const tests[] = {
     cmocka_unit_test(number_is_integer__returns_true_for_ints),
     cmocka_unit_test(number_is_integer__returns_false_for_floats),
     cmocka_unit_test(number_is_integer__returns_false_for_infs),
     cmocka_unit_test(number_is_integer__returns_false_for_nan),
+    cmocka_unit_test(number_to_string__formats_shortest_round_trip_representation),
+    cmocka_unit_test(number_to_string__round_trips),
+    cmocka_unit_test(number_parse__parses_decimal_numbers),
+    cmocka_unit_test(number_parse__respects_string_length),
+    cmocka_unit_test(number_parse__returns_false_for_out_of_range_numbers),
+    cmocka_unit_test(number_parse__is_bit_exact_with_strtod),
   };
 
   return cmocka_run_group_tests(tests, NULL, NULL);
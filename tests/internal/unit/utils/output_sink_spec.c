@@ -0,0 +1,204 @@
+#ifndef _WIN32
+#define _POSIX_C_SOURCE 200809L
+#endif
+
+#include "unit/unit_test.h"
+#include "utils/output_sink.h"
+
+#include <errno.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#ifndef _WIN32
+#include <signal.h>
+#include <unistd.h>
+#endif
+
+// *---------------------------------------------*
+// *              MACRO DEFINITIONS              *
+// *---------------------------------------------*
+
+#define LARGE_DATA_LENGTH (OUTPUT_SINK_BUFFER_SIZE * 50 + 7) // written twice, wrapping asynchronous writer ring around
+
+// *---------------------------------------------*
+// *         INTERNAL-LINKAGE FUNCTIONS          *
+// *---------------------------------------------*
+
+/// Assert that `stream` holds `expected_content` of `expected_length`.
+static void assert_stream_content(FILE *const stream, char const *const expected_content, size_t const expected_length) {
+  if (fflush(stream) == EOF) fail();
+  if (fseek(stream, 0, SEEK_END)) fail();
+  assert_int_equal(ftell(stream), expected_length);
+
+  char *const content = malloc(expected_length + 1);
+  assert_non_null(content);
+  if (fseek(stream, 0, SEEK_SET)) fail();
+  assert_int_equal(fread(content, 1, expected_length, stream), expected_length);
+
+  assert_memory_equal(content, expected_content, expected_length);
+
+  free(content);
+}
+
+/// Write data exceeding OUTPUT_SINK_BUFFER_SIZE through (a)synchronous sink and assert that its order is preserved.
+static void assert_write_preserves_order_of_data_exceeding_buffer_size(bool const is_async) {
+  FILE *const stream = tmpfile();
+  assert_non_null(stream);
+  OutputSink sink;
+  output_sink_init(&sink, stream, is_async);
+
+  char *const large_data = malloc(LARGE_DATA_LENGTH);
+  assert_non_null(large_data);
+  for (size_t i = 0; i < LARGE_DATA_LENGTH; i++) large_data[i] = 'a' + i % 26;
+
+  char *const expected_content = malloc(LARGE_DATA_LENGTH * 2 + 2);
+  assert_non_null(expected_content);
+  expected_content[0] = '<';
+  memcpy(expected_content + 1, large_data, LARGE_DATA_LENGTH);
+  memcpy(expected_content + 1 + LARGE_DATA_LENGTH, large_data, LARGE_DATA_LENGTH);
+  expected_content[LARGE_DATA_LENGTH * 2 + 1] = '>';
+
+  output_sink_write_char(&sink, '<');
+  output_sink_write(&sink, large_data, LARGE_DATA_LENGTH); // written through along with buffered content
+  for (size_t i = 0; i < LARGE_DATA_LENGTH; i += 100) { // buffered in pieces
+    size_t const remaining_length = LARGE_DATA_LENGTH - i;
+    output_sink_write(&sink, large_data + i, remaining_length < 100 ? remaining_length : 100);
+  }
+  output_sink_write_char(&sink, '>');
+  output_sink_destroy(&sink);
+
+  assert_stream_content(stream, expected_content, LARGE_DATA_LENGTH * 2 + 2);
+
+  free(expected_content);
+  free(large_data);
+  fclose(stream);
+}
+
+// *---------------------------------------------*
+// *                 TEST CASES                  *
+// *---------------------------------------------*
+
+static void write__buffers_data_until_flush(void **const _) {
+  FILE *const stream = tmpfile();
+  assert_non_null(stream);
+  OutputSink sink;
+  output_sink_init(&sink, stream, false);
+
+  output_sink_write(&sink, "abc", 3);
+  output_sink_write_char(&sink, '\n');
+
+  assert_stream_content(stream, "", 0);
+  output_sink_flush(&sink);
+  assert_stream_content(stream, "abc\n", 4);
+
+  output_sink_destroy(&sink);
+  fclose(stream);
+}
+
+static void write__preserves_order_of_data_exceeding_buffer_size(void **const _) {
+  assert_write_preserves_order_of_data_exceeding_buffer_size(false);
+}
+
+static void write__preserves_order_of_data_exceeding_buffer_size_when_async(void **const _) {
+  assert_write_preserves_order_of_data_exceeding_buffer_size(true);
+}
+
+static void flush__waits_for_async_writer(void **const _) {
+  FILE *const stream = tmpfile();
+  assert_non_null(stream);
+  OutputSink sink;
+  output_sink_init(&sink, stream, true);
+
+  for (int i = 0; i < 1000; i++) {
+    output_sink_write(&sink, "abc", 3);
+    output_sink_flush(&sink);
+
+    if (fseek(stream, 0, SEEK_END)) fail();
+    assert_int_equal(ftell(stream), (i + 1) * 3);
+  }
+
+  output_sink_destroy(&sink);
+  fclose(stream);
+}
+
+static void flush__keeps_data_written_through_stream_ordered(void **const _) {
+  FILE *const stream = tmpfile();
+  assert_non_null(stream);
+  OutputSink sink;
+  output_sink_init(&sink, stream, false);
+
+  fputs("a", stream);
+  output_sink_write(&sink, "b", 1);
+  output_sink_flush(&sink);
+  fputs("c", stream);
+  output_sink_write(&sink, "d", 1);
+  output_sink_destroy(&sink);
+
+  assert_stream_content(stream, "abcd", 4);
+
+  fclose(stream);
+}
+
+static void write__supports_stream_lacking_file_descriptor(void **const _) {
+#ifndef _WIN32
+  char *content;
+  size_t content_length;
+  FILE *const stream = open_memstream(&content, &content_length);
+  assert_non_null(stream);
+  OutputSink sink;
+  output_sink_init(&sink, stream, false);
+
+  output_sink_write(&sink, "abc", 3);
+  output_sink_flush(&sink);
+  assert_int_equal(content_length, 3);
+  assert_memory_equal(content, "abc", 3);
+
+  output_sink_destroy(&sink);
+  fclose(stream);
+  free(content);
+#endif
+}
+
+static void write__records_failure_of_failure_tolerant_sink(void **const _) {
+#ifndef _WIN32
+  int pipe_fds[2];
+  if (pipe(pipe_fds) < 0) fail();
+  if (signal(SIGPIPE, SIG_IGN) == SIG_ERR) fail();
+  close(pipe_fds[0]); // pipe reader is gone
+
+  FILE *const stream = fdopen(pipe_fds[1], "w");
+  assert_non_null(stream);
+  OutputSink sink;
+  output_sink_init(&sink, stream, false);
+  output_sink_tolerate_write_failures(&sink);
+
+  output_sink_write(&sink, "abc", 3);
+  output_sink_flush(&sink);
+  assert_int_equal(sink.write_errno, EPIPE);
+
+  // subsequent output gets discarded
+  output_sink_write(&sink, "def", 3);
+  output_sink_flush(&sink);
+  assert_int_equal(sink.count, 0);
+  assert_int_equal(sink.write_errno, EPIPE);
+
+  output_sink_destroy(&sink);
+  fclose(stream);
+  signal(SIGPIPE, SIG_DFL);
+#endif
+}
+
+int main(void) {
+  struct CMUnitTest const tests[] = {
+    cmocka_unit_test(write__buffers_data_until_flush),
+    cmocka_unit_test(write__preserves_order_of_data_exceeding_buffer_size),
+    cmocka_unit_test(write__preserves_order_of_data_exceeding_buffer_size_when_async),
+    cmocka_unit_test(flush__waits_for_async_writer),
+    cmocka_unit_test(flush__keeps_data_written_through_stream_ordered),
+    cmocka_unit_test(write__supports_stream_lacking_file_descriptor),
+    cmocka_unit_test(write__records_failure_of_failure_tolerant_sink),
+  };
+
+  return cmocka_run_group_tests(tests, NULL, NULL);
+}
@@ -0,0 +1 @@
+${unit_test_mk_target_prefix}/utils/output_sink_spec: ${unit_test_mk_prerequisite_prefix}/utils/output_sink.o
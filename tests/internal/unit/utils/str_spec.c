@@ -61,6 +61,36 @@ static void str_count_lines__returns_newline_count(void **const _) {
   }
 }
 
+static void str_hash__computes_fnv1a_hash(void **const _) {
+  typedef struct {
+    char *input_str;
+    uint32_t expected_hash;
+  } TestCase;
+
+  TestCase const test_cases[] = {
+    {"", 0x811c9dc5},
+    {"a", 0xe40c292c},
+    {"foobar", 0xbf9cf968},
+  };
+
+  for (size_t i = 0; i < sizeof(test_cases) / sizeof(test_cases[0]); i++) {
+    TestCase const test_case = test_cases[i];
+
+    uint32_t const result = str_hash(test_case.input_str, strlen(test_case.input_str));
+
+    assert_int_equal(result, test_case.expected_hash);
+  }
+}
+
+static void str_hash__hashes_only_given_length(void **const _) {
+  char const *const string = "foobar";
+
+  uint32_t const prefix_result = str_hash(string, 3);
+  uint32_t const expected_result = str_hash("foo", 3);
+
+  assert_int_equal(prefix_result, expected_result);
+}
+
 static void STR_ARRAY_LENGTH__computes_length_for_literals_and_arrays(void **const _) {
 #define STRING_LITERAL "literal"
   size_t const string_literal_length = strlen(STRING_LITERAL);
@@ -91,6 +121,8 @@ int main(void) {
     cmocka_unit_test_prestate(str_is_all_whitespace__returns_true_for_whitespace_string, whitespace_str),
     cmocka_unit_test_prestate(str_is_all_whitespace__returns_false_for_non_whitespace_strings, whitespace_str),
     cmocka_unit_test(str_count_lines__returns_newline_count),
+    cmocka_unit_test(str_hash__computes_fnv1a_hash),
+    cmocka_unit_test(str_hash__hashes_only_given_length),
     cmocka_unit_test(STR_ARRAY_LENGTH__computes_length_for_literals_and_arrays),
   };
 
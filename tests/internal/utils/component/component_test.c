@@ -27,8 +27,8 @@ void component_test_assert_file_content(FILE *const file_bin_stream, char const
   free(content_string);
 }
 
-/// Assert `value_a` and `value_b` equality.
-void component_test_assert_value_equality(Value const value_a, Value const value_b) {
+/// Assert `value_a` and `value_b` (both belonging to `vm`) equality.
+void component_test_assert_value_equality(VM *const vm, Value const value_a, Value const value_b) {
   assert_int_equal(value_a.type, value_b.type);
 
   static_assert(VALUE_TYPE_COUNT == 4, "Exhaustive ValueType handling");
@@ -49,11 +49,13 @@ void component_test_assert_value_equality(Value const value_a, Value const value
       break;
     }
     case VALUE_OBJECT: {
-      static_assert(OBJECT_TYPE_COUNT == 1, "Exhaustive ObjectType handling");
+      static_assert(OBJECT_TYPE_COUNT == 2, "Exhaustive ObjectType handling");
       switch (value_a.as.object->type) {
-        case OBJECT_STRING: {
-          ObjectString const *const string_object_a = (ObjectString *)value_a.as.object;
-          ObjectString const *const string_object_b = (ObjectString *)value_b.as.object;
+        case OBJECT_STRING:
+        case OBJECT_ROPE: {
+          assert_true(object_is_string(value_b.as.object));
+          ObjectString const *const string_object_a = object_flatten_string(vm, value_a.as.object);
+          ObjectString const *const string_object_b = object_flatten_string(vm, value_b.as.object);
 
           assert_int_equal(string_object_a->length, string_object_b->length);
           assert_int_equal(string_object_a->is_content_owner, string_object_b->is_content_owner);
@@ -2,6 +2,7 @@
 #define COMPONENT_TEST_H
 
 #include "backend/value.h"
+#include "backend/vm.h"
 #include "common/common_test.h"
 
 #include <stdio.h>
@@ -21,6 +22,6 @@
 // *---------------------------------------------*
 
 void component_test_assert_file_content(FILE *file_bin_stream, char const *expected_content);
-void component_test_assert_value_equality(Value value_a, Value value_b);
+void component_test_assert_value_equality(VM *vm, Value value_a, Value value_b);
 
 #endif // COMPONENT_TEST_H